@@ -1,1569 +1,3026 @@
-#include <GL/glew.h>
-#include <GLFW/glfw3.h>
-#include <iostream>
-#include <cstdlib>
-#define STB_IMAGE_IMPLEMENTATION
-#include <stb_image.h>      // Image loading Utility functions
-
-#include <glm/glm.hpp>
-#include <glm/gtx/transform.hpp>
-#include <glm/gtc/type_ptr.hpp>
-
-#include "camera.h"
-
-
-
-using namespace std;
-
-/*shader macro*/
-#ifndef GLSL
-#define GLSL(Version, Source) "#version " #Version " core \n" #Source
-#endif
-
-//unnamed namespace
-namespace
-{
-    const char* const WINDOW_TITLE = "Final Project"; // Macro for window title
-
-    //vars for window width and height
-    const int WINDOW_WIDTH = 1600;
-    const int WINDOW_HEIGHT = 900;
-
-    //stores GL data relative to a mesh
-    struct GLMesh
-    {
-        GLuint vao;         // Handle for the vertex array object
-        GLuint vbo;         // Handle for the vertex buffer object
-        GLuint nVertices;    // Number of indices of the mesh
-    };
-
-    //main GLFW window
-    GLFWwindow* gWindow = nullptr;
-
-    //triangle mesh data
-    GLMesh gMeshKnifeBlade;
-    GLMesh gMeshKnifeHandle;
-    GLMesh gLightMesh;
-    GLMesh gPlaneMesh;
-    GLMesh gCuttingBoardMesh;
-    GLMesh gCheeseMesh;
-    GLMesh gSalamiBodyMesh;
-    GLMesh gSalamiEndsMesh;
-
-    //texture
-    GLuint gHandleTexture;
-    GLuint gBladeTexture;
-    GLuint gCuttingBoardTexture;
-    GLuint gCounterTexture;
-    GLuint gCheeseTexture;
-    GLuint gSalamiBodyTexture;
-    GLuint gSalamiEndsTexture;
-    glm::vec2 gUVScale(1.0f, 1.0f);
-
-    // Shader programs
-    GLuint gProgramId;
-    GLuint gLampProgramId;
-
-    //camera
-    Camera gCamera(glm::vec3(0.0f, 0.0f, 7.0f));
-    float gLastX = WINDOW_WIDTH / 2.0f;
-    float gLastY = WINDOW_HEIGHT / 2.0f;
-    bool gFirstMouse = true;
-
-    //timing
-    float gDeltaTime = 0.0f; // time between current frame and last frame
-    float gLastFrame = 0.0f;
-
-    //cube and light color
-    glm::vec3 gObjectColor(1.f, 0.2f, 0.0f);
-    glm::vec3 gLightColor(1.0f, 1.0f, 1.0f);
-
-    //light position and scale
-    glm::vec3 gLightPosition(4.0f, 8.5f, -3.0f);
-    glm::vec3 gLightScale(0.5f);
-
-    //bool to track to see if using perspective mode
-    bool perspectiveMode = true;
-
-    //tracks the button event for p so that is doesnt execute the code rapidly
-    bool click = false;
-
-    //tracks mouse down event for better control over scean
-    bool mouseClick = false;
-
-}
-
-//function prototypes
-bool UInitialize(int, char* [], GLFWwindow** window);
-void UResizeWindow(GLFWwindow* window, int width, int height);
-void UProcessInput(GLFWwindow* window);
-void UMousePositionCallback(GLFWwindow* window, double xpos, double ypos);
-void UMouseScrollCallback(GLFWwindow* window, double xoffset, double yoffset);
-void UCreateKnifeBladeMesh(GLMesh& mesh);
-void UCreateKnifeHandleMesh(GLMesh& mesh);
-void UCreateCubeMesh(GLMesh& mesh);
-void UCreateCheeseMesh(GLMesh& mesh);
-void UCreatePlaneMesh(GLMesh& mesh);
-void UCreateCuttingBoardMesh(GLMesh& mesh);
-void UCreateSalamiBodyMesh(GLMesh& mesh);
-void UCreateSalamiEndsMesh(GLMesh& mesh);
-void UDestroyMesh(GLMesh& mesh);
-bool UCreateTexture(const char* filename, GLuint& textureId, int location);
-void UDestroyTexture(GLuint textureId);
-void URender();
-bool UCreateShaderProgram(const char* vtxShaderSource, const char* fragShaderSource, GLuint& programId);
-void UDestroyShaderProgram(GLuint programId);
-
-
-/* Cube Vertex Shader Source Code*/
-const GLchar* cubeVertexShaderSource = GLSL(440,
-
-    layout(location = 0) in vec3 position; // VAP position 0 for vertex position data
-layout(location = 1) in vec3 normal; // VAP position 1 for normals
-layout(location = 2) in vec2 textureCoordinate;
-
-out vec3 vertexNormal; // For outgoing normals to fragment shader
-out vec3 vertexFragmentPos; // For outgoing color / pixels to fragment shader
-out vec2 vertexTextureCoordinate;
-
-//Uniform / Global variables for the  transform matrices
-uniform mat4 model;
-uniform mat4 view;
-uniform mat4 projection;
-
-void main()
-{
-    gl_Position = projection * view * model * vec4(position, 1.0f); // Transforms vertices into clip coordinates
-
-    vertexFragmentPos = vec3(model * vec4(position, 1.0f)); // Gets fragment / pixel position in world space only (exclude view and projection)
-
-    vertexNormal = mat3(transpose(inverse(model))) * normal; // get normal vectors in world space only and exclude normal translation properties
-    vertexTextureCoordinate = textureCoordinate;
-}
-);
-
-
-/* Cube Fragment Shader Source Code*/
-const GLchar* cubeFragmentShaderSource = GLSL(440,
-
-    in vec3 vertexNormal; // For incoming normals
-in vec3 vertexFragmentPos; // For incoming fragment position
-in vec2 vertexTextureCoordinate;
-
-out vec4 fragmentColor; // For outgoing cube color to the GPU
-
-// Uniform / Global variables for object color, light color, light position, and camera/view position
-uniform vec3 objectColor;
-uniform vec3 lightColor;
-uniform vec3 lightPos;
-uniform vec3 viewPosition;
-uniform sampler2D uTexture; // Useful when working with multiple textures
-uniform vec2 uvScale;
-
-void main()
-{
-    /*Phong lighting model calculations to generate ambient, diffuse, and specular components*/
-
-    //Calculate Ambient lighting*/
-    float ambientStrength = 0.1f; // Set ambient or global lighting strength
-    vec3 ambient = ambientStrength * lightColor; // Generate ambient light color
-
-    //Calculate Diffuse lighting*/
-    vec3 norm = normalize(vertexNormal); // Normalize vectors to 1 unit
-    vec3 lightDirection = normalize(lightPos - vertexFragmentPos); // Calculate distance (light direction) between light source and fragments/pixels on cube
-    float impact = max(dot(norm, lightDirection), 0.0);// Calculate diffuse impact by generating dot product of normal and light
-    vec3 diffuse = impact * lightColor; // Generate diffuse light color
-
-    //Calculate Specular lighting*/
-    float specularIntensity = 0.8f; // Set specular light strength
-    float highlightSize = 16.0f; // Set specular highlight size
-    vec3 viewDir = normalize(viewPosition - vertexFragmentPos); // Calculate view direction
-    vec3 reflectDir = reflect(-lightDirection, norm);// Calculate reflection vector
-    //Calculate specular component
-    float specularComponent = pow(max(dot(viewDir, reflectDir), 0.0), highlightSize);
-    vec3 specular = specularIntensity * specularComponent * lightColor;
-
-    // Texture holds the color to be used for all three components
-    vec4 textureColor = texture(uTexture, vertexTextureCoordinate * uvScale);
-
-    // Calculate phong result
-    vec3 phong = (ambient + diffuse + specular) * textureColor.xyz;
-
-    fragmentColor = vec4(phong, 1.0); // Send lighting results to GPU
-}
-);
-
-
-/* Lamp Shader Source Code*/
-const GLchar* lampVertexShaderSource = GLSL(440,
-
-    layout(location = 0) in vec3 position; // VAP position 0 for vertex position data
-
-        //Uniform / Global variables for the  transform matrices
-uniform mat4 model;
-uniform mat4 view;
-uniform mat4 projection;
-
-void main()
-{
-    gl_Position = projection * view * model * vec4(position, 1.0f); // Transforms vertices into clip coordinates
-}
-);
-
-
-/* Fragment Shader Source Code*/
-const GLchar* lampFragmentShaderSource = GLSL(440,
-
-    out vec4 fragmentColor; // For outgoing lamp color (smaller cube) to the GPU
-
-void main()
-{
-    fragmentColor = vec4(1.0f); // Set color to white (1.0f,1.0f,1.0f) with alpha 1.0
-}
-);
-
-
-
-//flip image
-void flipImageVertically(unsigned char* image, int width, int height, int channels) {
-    for (int j = 0; j < height / 2; ++j) {
-        int index1 = j * width * channels;
-        int index2 = (height - 1 - j) * width * channels;
-
-        for (int i = width * channels; i > 0; --i) {
-            unsigned char temp = image[index1];
-            image[index1] = image[index2];
-            image[index2] = temp;
-            ++index1;
-            ++index2;
-        }
-    }
-}
-
-
-int main(int argc, char* argv[])
-{
-    if (!UInitialize(argc, argv, &gWindow))
-        return EXIT_FAILURE;
-
-    //create the meshes
-    UCreateKnifeHandleMesh(gMeshKnifeHandle);
-    UCreateKnifeBladeMesh(gMeshKnifeBlade);
-    UCreateCubeMesh(gLightMesh);
-    UCreateCheeseMesh(gCheeseMesh);
-    UCreatePlaneMesh(gPlaneMesh);
-    UCreateCuttingBoardMesh(gCuttingBoardMesh);
-    UCreateSalamiBodyMesh(gSalamiBodyMesh);
-    UCreateSalamiEndsMesh(gSalamiEndsMesh);
-
-    //create the shader programs
-    if (!UCreateShaderProgram(cubeVertexShaderSource, cubeFragmentShaderSource, gProgramId))
-        return EXIT_FAILURE;
-
-    if (!UCreateShaderProgram(lampVertexShaderSource, lampFragmentShaderSource, gLampProgramId))
-        return EXIT_FAILURE;
-
-
-
-    //load knife handle textur
-    const char* handleTexFile = "../resources/textures/wood.jpg";
-    if (!UCreateTexture(handleTexFile, gHandleTexture, 0))
-    {
-        cout << "Failed to load handle texture " << handleTexFile << endl;
-        return EXIT_FAILURE;
-    }
-
-    //load knife blade texture
-    const char* bladeTexFile = "../resources/textures/metal.jpg";
-    if (!UCreateTexture(bladeTexFile, gBladeTexture, 1))
-    {
-        cout << "Failed to load blade texture " << bladeTexFile << endl;
-        return EXIT_FAILURE;
-    }
-
-    //load Cutting Board texture
-    const char* CuttingBoardTexFile = "../resources/textures/CuttingBoard.jpg";
-    if (!UCreateTexture(CuttingBoardTexFile, gCuttingBoardTexture, 2))
-    {
-        cout << "Failed to load blade texture " << CuttingBoardTexFile << endl;
-        return EXIT_FAILURE;
-    }
-
-    //load counbter texture
-    const char* CounterTexFile = "../resources/textures/Counter.jpg";
-    if (!UCreateTexture(CounterTexFile, gCounterTexture, 3))
-    {
-        cout << "Failed to load blade texture " << CounterTexFile << endl;
-        return EXIT_FAILURE;
-    }
-
-    //load cheese texture
-    const char* CheeseTexFile = "../resources/textures/Cheese.jpg";
-    if (!UCreateTexture(CheeseTexFile, gCheeseTexture, 4))
-    {
-        cout << "Failed to load blade texture " << CheeseTexFile << endl;
-        return EXIT_FAILURE;
-    }
-
-    //load salami body texture
-    const char* SalamiBodyTexFile = "../resources/textures/SalamiSkin.jpg";
-    if (!UCreateTexture(SalamiBodyTexFile, gSalamiBodyTexture, 5))
-    {
-        cout << "Failed to load blade texture " << SalamiBodyTexFile << endl;
-        return EXIT_FAILURE;
-    }
-
-    //load salami ends texture
-    const char* SalamiEndsTexFile = "../resources/textures/SalamiInside.jpg";
-    if (!UCreateTexture(SalamiEndsTexFile, gSalamiEndsTexture, 6))
-    {
-        cout << "Failed to load blade texture " << SalamiEndsTexFile << endl;
-        return EXIT_FAILURE;
-    }
-
-    //tell opengl which texture unit it belongs to
-    glUseProgram(gProgramId);
-    glUniform1i(glGetUniformLocation(gProgramId, "gHandleTexture"), 0);
-    glUniform1i(glGetUniformLocation(gProgramId, "gBladeTexture"), 1);
-    glUniform1i(glGetUniformLocation(gProgramId, "gCuttingBoardTexture"), 2);
-    glUniform1i(glGetUniformLocation(gProgramId, "gCounterTexture"), 3);
-    glUniform1i(glGetUniformLocation(gProgramId, "gCheeseTexture"), 4);
-
-
-    // Sets the background color of the window to black (it will be implicitely used by glClear)
-    glClearColor(0.0f, 0.0f, 0.0f, 1.0f);
-
-    // render loop
-    // -----------
-    while (!glfwWindowShouldClose(gWindow))
-    {
-        // per-frame timing
-        // --------------------
-        float currentFrame = glfwGetTime();
-        gDeltaTime = currentFrame - gLastFrame;
-        gLastFrame = currentFrame;
-
-        // input
-        // -----
-        UProcessInput(gWindow);
-
-        // Render this frame
-        URender();
-
-        glfwPollEvents();
-    }
-
-    // Release mesh data
-    UDestroyMesh(gMeshKnifeHandle);
-    UDestroyMesh(gMeshKnifeBlade);
-    UDestroyMesh(gLightMesh);
-    UDestroyMesh(gPlaneMesh);
-    UDestroyMesh(gCuttingBoardMesh);
-    UDestroyMesh(gCheeseMesh);
-    UDestroyMesh(gSalamiBodyMesh);
-    UDestroyMesh(gSalamiEndsMesh);
-
-    // Release texture
-    UDestroyTexture(gHandleTexture);
-    UDestroyTexture(gBladeTexture);
-    UDestroyTexture(gCuttingBoardTexture);
-    UDestroyTexture(gCounterTexture);
-    UDestroyTexture(gCheeseTexture);
-    UDestroyTexture(gSalamiBodyTexture);
-    UDestroyTexture(gSalamiEndsTexture);
-
-    // Release shader programs
-    UDestroyShaderProgram(gProgramId);
-    UDestroyShaderProgram(gLampProgramId);
-
-    exit(EXIT_SUCCESS); // Terminates the program successfully
-}
-
-
-//initialize glfw, glew, and creates window
-bool UInitialize(int argc, char* argv[], GLFWwindow** window) {
-    //glfw initialize and config
-    glfwInit();
-    glfwWindowHint(GLFW_CONTEXT_VERSION_MAJOR, 4);
-    glfwWindowHint(GLFW_CONTEXT_VERSION_MINOR, 4);
-    glfwWindowHint(GLFW_OPENGL_PROFILE, GLFW_OPENGL_CORE_PROFILE);
-
-#ifdef __APPLE__
-    glfwWindowHint(GLFW_OPENGL_FORWARD_COMPAT, GL_TRUE);
-#endif
-
-    //window creation
-    * window = glfwCreateWindow(WINDOW_WIDTH, WINDOW_HEIGHT, WINDOW_TITLE, NULL, NULL);
-    if (*window == NULL)
-    {
-        std::cout << "Failed to create GLFW window" << std::endl;
-        glfwTerminate();
-        return false;
-    }
-    glfwMakeContextCurrent(*window);
-    glfwSetFramebufferSizeCallback(*window, UResizeWindow);
-    glfwSetCursorPosCallback(*window, UMousePositionCallback);
-    glfwSetScrollCallback(*window, UMouseScrollCallback);
-
-    //glew initialize
-    glewExperimental = GL_TRUE;
-    GLenum GlewInitResult = glewInit();
-
-    if (GLEW_OK != GlewInitResult)
-    {
-        std::cerr << glewGetErrorString(GlewInitResult) << std::endl;
-        return false;
-    }
-
-    // Displays GPU OpenGL version
-    cout << "INFO: OpenGL Version: " << glGetString(GL_VERSION) << endl;
-
-    return true;
-}
-
-
-//process all input: query GLFW whether relevant keys are pressed/released this frame and react accordingly
-void UProcessInput(GLFWwindow* window)
-{
-    static const float cameraSpeed = 2.5f;
-
-    if (glfwGetKey(window, GLFW_KEY_ESCAPE) == GLFW_PRESS) {
-        glfwSetWindowShouldClose(window, true);
-    }
-    if (glfwGetKey(window, GLFW_KEY_W) == GLFW_PRESS) {
-        gCamera.ProcessKeyboard(FORWARD, gDeltaTime);
-    }
-    if (glfwGetKey(window, GLFW_KEY_S) == GLFW_PRESS) {
-        gCamera.ProcessKeyboard(BACKWARD, gDeltaTime);
-    }
-    if (glfwGetKey(window, GLFW_KEY_A) == GLFW_PRESS) {
-        gCamera.ProcessKeyboard(LEFT, gDeltaTime);
-    }
-    if (glfwGetKey(window, GLFW_KEY_D) == GLFW_PRESS) {
-        gCamera.ProcessKeyboard(RIGHT, gDeltaTime);
-    }
-    if (glfwGetKey(window, GLFW_KEY_Q) == GLFW_PRESS) {
-        gCamera.ProcessKeyboard(DOWN, gDeltaTime);
-    }
-    if (glfwGetKey(window, GLFW_KEY_E) == GLFW_PRESS) {
-        gCamera.ProcessKeyboard(UP, gDeltaTime);
-    }
-    if (glfwGetKey(window, GLFW_KEY_Z) == GLFW_PRESS) {
-        gCamera.ProcessKeyboard(TURNL, gDeltaTime);
-    }
-    if (glfwGetKey(window, GLFW_KEY_C) == GLFW_PRESS) {
-        gCamera.ProcessKeyboard(TURNR, gDeltaTime);
-    }
-    if (glfwGetKey(window, GLFW_KEY_R) == GLFW_PRESS) {
-        gCamera.ProcessKeyboard(TURNU, gDeltaTime);
-    }
-    if (glfwGetKey(window, GLFW_KEY_F) == GLFW_PRESS) {
-        gCamera.ProcessKeyboard(TURND, gDeltaTime);
-    }
-    if (glfwGetKey(window, GLFW_KEY_P) == GLFW_PRESS) {
-        click = true;
-    }
-    if (glfwGetKey(window, GLFW_KEY_P) == GLFW_RELEASE && click) {
-
-        if (perspectiveMode) {
-            perspectiveMode = false;
-        }
-        else {
-            perspectiveMode = true;
-        }
-        click = false;
-    }
-}
-
-
-//glfw: whenever the window size changed (by OS or user resize) this callback function executes
-void UResizeWindow(GLFWwindow* window, int width, int height)
-{
-    glViewport(0, 0, width, height);
-}
-
-
-//glfw: whenever the mouse moves, this callback is called
-void UMousePositionCallback(GLFWwindow* window, double xpos, double ypos)
-{
-    if (gFirstMouse)
-    {
-       gLastX = xpos;
-       gLastY = ypos;
-       gFirstMouse = false;
-    }
-
-    float xoffset = xpos - gLastX;
-    float yoffset = gLastY - ypos; // reversed since y-coordinates go from bottom to top
-
-    gLastX = xpos;
-    gLastY = ypos;
-
-    gCamera.ProcessMouseMovement(xoffset, yoffset);
-}
-
-
-// glfw: whenever the mouse scroll wheel scrolls, this callback is called
-// ----------------------------------------------------------------------
-void UMouseScrollCallback(GLFWwindow* window, double xoffset, double yoffset)
-{
-    gCamera.ProcessMouseScroll(yoffset);
-}
-
-
-
-// Functioned called to render a frame
-void URender()
-{
-    //enable z-depth
-    glEnable(GL_DEPTH_TEST);
-
-    //clear the frame and z buffers
-    glClearColor(0.0f, 0.0f, 0.0f, 1.0f);
-    glClear(GL_COLOR_BUFFER_BIT | GL_DEPTH_BUFFER_BIT);
-
-
-    //knife handle--------------------------------------------
-    glBindVertexArray(gMeshKnifeHandle.vao);
-
-    glUseProgram(gProgramId);
-
-    // bind textures being used
-    glActiveTexture(GL_TEXTURE0);
-    glBindTexture(GL_TEXTURE_2D, gHandleTexture);
-
-    //set scale rotation and translation for object
-    glm::mat4 scale = glm::scale(glm::vec3(1.1f, 1.1f, 1.1f));
-    glm::mat4 rotation = glm::rotate(2.4f, glm::vec3(0.0f, 1.0f, 0.0f));
-    glm::mat4 translation = glm::translate(glm::vec3(3.5f, 0.94f, -0.9f));
-
-    //add the changes to the model data
-    glm::mat4 model = translation * rotation * scale;
-
-    //camera/view transformation
-    glm::mat4 view = gCamera.GetViewMatrix();
-
-
-    GLint projLoc;
-    glm::mat4 projection;
-    if (perspectiveMode) {
-        projection = glm::perspective(45.0f, (GLfloat)WINDOW_WIDTH / (GLfloat)WINDOW_HEIGHT, 0.1f, 100.0f);
-        GLint projLoc = glGetUniformLocation(gProgramId, "projection");
-        glUniformMatrix4fv(projLoc, 1, GL_FALSE, glm::value_ptr(projection));
-    }
-    else {
-        projection = glm::ortho(-40.0f, 40.0f, -40.0f, 40.0f, -1000.0f, 1000.0f);
-        GLint projLoc = glGetUniformLocation(gProgramId, "projection");
-        glUniformMatrix4fv(projLoc, 1, GL_FALSE, glm::value_ptr(projection));
-    }
-
-    //retrieve and passe matrices to the Shader program
-    GLint modelLoc = glGetUniformLocation(gProgramId, "model");
-    GLint viewLoc = glGetUniformLocation(gProgramId, "view");
-
-    glUniformMatrix4fv(modelLoc, 1, GL_FALSE, glm::value_ptr(model));
-    glUniformMatrix4fv(viewLoc, 1, GL_FALSE, glm::value_ptr(view));
-
-    //reference matrix uniforms from the Cube Shader program for the cub color, light color, light position, and camera position
-    GLint objectColorLoc = glGetUniformLocation(gProgramId, "objectColor");
-    GLint lightColorLoc = glGetUniformLocation(gProgramId, "lightColor");
-    GLint lightPositionLoc = glGetUniformLocation(gProgramId, "lightPos");
-    GLint viewPositionLoc = glGetUniformLocation(gProgramId, "viewPosition");
-
-    //pass data to the Cube Shader program's corresponding uniforms
-    glUniform3f(objectColorLoc, gObjectColor.r, gObjectColor.g, gObjectColor.b);
-
-    glUniform3f(lightColorLoc, gLightColor.r, gLightColor.g, gLightColor.b);
-    glUniform3f(lightPositionLoc, gLightPosition.x, gLightPosition.y, gLightPosition.z);
-
-    const glm::vec3 cameraPosition = gCamera.Position;
-    glUniform3f(viewPositionLoc, cameraPosition.x, cameraPosition.y, cameraPosition.z);
-
-    GLint UVScaleLoc = glGetUniformLocation(gProgramId, "uvScale");
-    glUniform2fv(UVScaleLoc, 1, glm::value_ptr(gUVScale));
-
-    // Draws the triangles
-    glDrawArrays(GL_TRIANGLES, 0, gMeshKnifeHandle.nVertices);
-
-    glBindTexture(GL_TEXTURE_2D, 0);
-
-    //knife blade-----------------------------------
-
-    // bind textures being used
-    glActiveTexture(GL_TEXTURE0);
-    glBindTexture(GL_TEXTURE_2D, gBladeTexture);
-
-    //tell program which mesh is being worked on
-    glBindVertexArray(gMeshKnifeBlade.vao);
-
-    // Draws the triangles
-    glDrawArrays(GL_TRIANGLES, 0, gMeshKnifeBlade.nVertices);
-
-    glBindTexture(GL_TEXTURE_2D, 0);
-
-
-    //Cheese-----------------------------------------------
-
-    // bind textures being used
-    glActiveTexture(GL_TEXTURE0);
-    glBindTexture(GL_TEXTURE_2D, gCheeseTexture);
-
-    //tell program which mesh is being worked on
-    glBindVertexArray(gCheeseMesh.vao);
-
-    //set scale rotation and translation for object
-    scale = glm::scale(glm::vec3(1.3f, 1.5f, 1.5f));
-    translation = glm::translate(glm::vec3(-1.5f, 1.3f, 2.5f));
-    rotation = glm::rotate(0.1f, glm::vec3(0.0f, 1.0f, 0.0f));
-
-    //transform the smaller cube used as a visual que for the light source
-    model = translation * scale * rotation;
-
-    //reference matrix uniforms from the Lamp Shader program
-    modelLoc = glGetUniformLocation(gProgramId, "model");
-    viewLoc = glGetUniformLocation(gProgramId, "view");
-    projLoc = glGetUniformLocation(gProgramId, "projection");
-
-    //pass matrix data to the Lamp Shader program's matrix uniforms
-    glUniformMatrix4fv(modelLoc, 1, GL_FALSE, glm::value_ptr(model));
-    glUniformMatrix4fv(viewLoc, 1, GL_FALSE, glm::value_ptr(view));
-    glUniformMatrix4fv(projLoc, 1, GL_FALSE, glm::value_ptr(projection));
-
-    // Draws the triangles
-    glDrawArrays(GL_TRIANGLES, 0, gCheeseMesh.nVertices);
-
-    glBindTexture(GL_TEXTURE_2D, 0);
-
-    //plane-------------------------------------------
-
-
-    // bind textures being used
-    glActiveTexture(GL_TEXTURE0);
-    glBindTexture(GL_TEXTURE_2D, gCounterTexture);
-
-    //tell program which mesh is being worked on
-    glBindVertexArray(gPlaneMesh.vao);
-
-    //set scale rotation and translation for object
-    scale = glm::scale(glm::vec3(1.0f, 1.0f, 1.0f));
-    translation = glm::translate(glm::vec3(0.0f, 0.0f, 0.0f));
-
-    //transform the smaller cube used as a visual que for the light source
-    model = translation * scale;
-
-    //reference matrix uniforms from the Lamp Shader program
-    modelLoc = glGetUniformLocation(gProgramId, "model");
-    viewLoc = glGetUniformLocation(gProgramId, "view");
-    projLoc = glGetUniformLocation(gProgramId, "projection");
-
-    //pass matrix data to the Lamp Shader program's matrix uniforms
-    glUniformMatrix4fv(modelLoc, 1, GL_FALSE, glm::value_ptr(model));
-    glUniformMatrix4fv(viewLoc, 1, GL_FALSE, glm::value_ptr(view));
-    glUniformMatrix4fv(projLoc, 1, GL_FALSE, glm::value_ptr(projection));
-
-    // Draws the triangles
-    glDrawArrays(GL_TRIANGLES, 0, gPlaneMesh.nVertices);
-
-    glBindTexture(GL_TEXTURE_2D, 0);
-
-    //Cutting Board-----------------------------------------
-
-    // bind textures being used
-    glActiveTexture(GL_TEXTURE0);
-    glBindTexture(GL_TEXTURE_2D, gCuttingBoardTexture);
-
-    //tell program which mesh is being worked on
-    glBindVertexArray(gCuttingBoardMesh.vao);
-
-    //set scale rotation and translation for object
-    scale = glm::scale(glm::vec3(1.3f, 1.0f, 1.3f));
-    translation = glm::translate(glm::vec3(0.0f, 0.0f, 0.0f));
-    rotation = glm::rotate(0.1f, glm::vec3(0.0f, 1.0f, 0.0f));
-
-    //transform the smaller cube used as a visual que for the light source
-    model = translation * scale * rotation;
-
-    //reference matrix uniforms from the Lamp Shader program
-    modelLoc = glGetUniformLocation(gProgramId, "model");
-    viewLoc = glGetUniformLocation(gProgramId, "view");
-    projLoc = glGetUniformLocation(gProgramId, "projection");
-
-    //pass matrix data to the Lamp Shader program's matrix uniforms
-    glUniformMatrix4fv(modelLoc, 1, GL_FALSE, glm::value_ptr(model));
-    glUniformMatrix4fv(viewLoc, 1, GL_FALSE, glm::value_ptr(view));
-    glUniformMatrix4fv(projLoc, 1, GL_FALSE, glm::value_ptr(projection));
-
-    // Draws the triangles
-    glDrawArrays(GL_TRIANGLES, 0, gCuttingBoardMesh.nVertices);
-
-    glBindTexture(GL_TEXTURE_2D, 0);
-
-    //Salami----------------------------------------------------------
-    
-    // bind textures being used for body
-    glActiveTexture(GL_TEXTURE0);
-    glBindTexture(GL_TEXTURE_2D, gSalamiBodyTexture);
-
-    //tell program which mesh is being worked on
-    glBindVertexArray(gSalamiBodyMesh.vao);
-
-    //set scale rotation and translation for object
-    scale = glm::scale(glm::vec3(1.6f, 0.7f, 0.7f));
-    translation = glm::translate(glm::vec3(1.7f, 1.6f, 0.0f));
-    rotation = glm::rotate(1.57f, glm::vec3(0.0f, 0.0f, 1.0f));
-
-    //transform the smaller cube used as a visual que for the light source
-    model = scale * rotation * translation;
-
-    //reference matrix uniforms from the Lamp Shader program
-    modelLoc = glGetUniformLocation(gProgramId, "model");
-    viewLoc = glGetUniformLocation(gProgramId, "view");
-    projLoc = glGetUniformLocation(gProgramId, "projection");
-
-    //pass matrix data to the Lamp Shader program's matrix uniforms
-    glUniformMatrix4fv(modelLoc, 1, GL_FALSE, glm::value_ptr(model));
-    glUniformMatrix4fv(viewLoc, 1, GL_FALSE, glm::value_ptr(view));
-    glUniformMatrix4fv(projLoc, 1, GL_FALSE, glm::value_ptr(projection));
-
-    // Draws the trianglesfor body
-    glDrawArrays(GL_TRIANGLES, 0, gSalamiBodyMesh.nVertices);
-
-    glBindTexture(GL_TEXTURE_2D, 0);
-
-    // bind textures being used for ends
-    glActiveTexture(GL_TEXTURE0);
-    glBindTexture(GL_TEXTURE_2D, gSalamiEndsTexture);
-
-    //tell program which mesh is being worked on
-    glBindVertexArray(gSalamiEndsMesh.vao);
-
-    // Draws the trianglesfor body
-    glDrawArrays(GL_TRIANGLES, 0, gSalamiEndsMesh.nVertices);
-
-    glBindTexture(GL_TEXTURE_2D, 0);
-
-
-
-    //light1-------------------------------------------=
-
-
-    glBindVertexArray(gLightMesh.vao);
-    glUseProgram(gLampProgramId);
-
-    //transform the smaller cube used as a visual que for the light source
-    model = glm::translate(gLightPosition) * glm::scale(gLightScale);
-
-    //reference matrix uniforms from the Lamp Shader program
-    modelLoc = glGetUniformLocation(gLampProgramId, "model");
-    viewLoc = glGetUniformLocation(gLampProgramId, "view");
-    projLoc = glGetUniformLocation(gLampProgramId, "projection");
-
-    //pass matrix data to the Lamp Shader program's matrix uniforms
-    glUniformMatrix4fv(modelLoc, 1, GL_FALSE, glm::value_ptr(model));
-    glUniformMatrix4fv(viewLoc, 1, GL_FALSE, glm::value_ptr(view));
-    glUniformMatrix4fv(projLoc, 1, GL_FALSE, glm::value_ptr(projection));
-
-    glDrawArrays(GL_TRIANGLES, 0, gLightMesh.nVertices);
-
-
-    //deactivate the vao and shader
-    glBindVertexArray(0);
-    glUseProgram(0);
-
-    glfwSwapBuffers(gWindow);
-}
-
-
-//creates the mesh for the light
-void UCreateCubeMesh(GLMesh& mesh)
-{
-    // Position and Color data
-    GLfloat verts[] = {
-        //Positions          //Normals
-        // ------------------------------------------------------
-        //Back Face          //Negative Z Normal  Texture Coords.
-       -0.5f, -0.5f, -0.5f,  0.0f,  0.0f, -1.0f,  0.0f, 0.0f,
-        0.5f, -0.5f, -0.5f,  0.0f,  0.0f, -1.0f,  1.0f, 0.0f,
-        0.5f,  0.5f, -0.5f,  0.0f,  0.0f, -1.0f,  1.0f, 1.0f,
-        0.5f,  0.5f, -0.5f,  0.0f,  0.0f, -1.0f,  1.0f, 1.0f,
-       -0.5f,  0.5f, -0.5f,  0.0f,  0.0f, -1.0f,  0.0f, 1.0f,
-       -0.5f, -0.5f, -0.5f,  0.0f,  0.0f, -1.0f,  0.0f, 0.0f,
-
-       //Front Face         //Positive Z Normal
-      -0.5f, -0.5f,  0.5f,  0.0f,  0.0f,  1.0f,  0.0f, 0.0f,
-       0.5f, -0.5f,  0.5f,  0.0f,  0.0f,  1.0f,  1.0f, 0.0f,
-       0.5f,  0.5f,  0.5f,  0.0f,  0.0f,  1.0f,  1.0f, 1.0f,
-       0.5f,  0.5f,  0.5f,  0.0f,  0.0f,  1.0f,  1.0f, 1.0f,
-      -0.5f,  0.5f,  0.5f,  0.0f,  0.0f,  1.0f,  0.0f, 1.0f,
-      -0.5f, -0.5f,  0.5f,  0.0f,  0.0f,  1.0f,  0.0f, 0.0f,
-
-      //Left Face          //Negative X Normal
-     -0.5f,  0.5f,  0.5f, -1.0f,  0.0f,  0.0f,  1.0f, 0.0f,
-     -0.5f,  0.5f, -0.5f, -1.0f,  0.0f,  0.0f,  1.0f, 1.0f,
-     -0.5f, -0.5f, -0.5f, -1.0f,  0.0f,  0.0f,  0.0f, 1.0f,
-     -0.5f, -0.5f, -0.5f, -1.0f,  0.0f,  0.0f,  0.0f, 1.0f,
-     -0.5f, -0.5f,  0.5f, -1.0f,  0.0f,  0.0f,  0.0f, 0.0f,
-     -0.5f,  0.5f,  0.5f, -1.0f,  0.0f,  0.0f,  1.0f, 0.0f,
-
-     //Right Face         //Positive X Normal
-     0.5f,  0.5f,  0.5f,  1.0f,  0.0f,  0.0f,  1.0f, 0.0f,
-     0.5f,  0.5f, -0.5f,  1.0f,  0.0f,  0.0f,  1.0f, 1.0f,
-     0.5f, -0.5f, -0.5f,  1.0f,  0.0f,  0.0f,  0.0f, 1.0f,
-     0.5f, -0.5f, -0.5f,  1.0f,  0.0f,  0.0f,  0.0f, 1.0f,
-     0.5f, -0.5f,  0.5f,  1.0f,  0.0f,  0.0f,  0.0f, 0.0f,
-     0.5f,  0.5f,  0.5f,  1.0f,  0.0f,  0.0f,  1.0f, 0.0f,
-
-     //Bottom Face        //Negative Y Normal
-    -0.5f, -0.5f, -0.5f,  0.0f, -1.0f,  0.0f,  0.0f, 1.0f,
-     0.5f, -0.5f, -0.5f,  0.0f, -1.0f,  0.0f,  1.0f, 1.0f,
-     0.5f, -0.5f,  0.5f,  0.0f, -1.0f,  0.0f,  1.0f, 0.0f,
-     0.5f, -0.5f,  0.5f,  0.0f, -1.0f,  0.0f,  1.0f, 0.0f,
-    -0.5f, -0.5f,  0.5f,  0.0f, -1.0f,  0.0f,  0.0f, 0.0f,
-    -0.5f, -0.5f, -0.5f,  0.0f, -1.0f,  0.0f,  0.0f, 1.0f,
-
-    //Top Face           //Positive Y Normal
-   -0.5f,  0.5f, -0.5f,  0.0f,  1.0f,  0.0f,  0.0f, 1.0f,
-    0.5f,  0.5f, -0.5f,  0.0f,  1.0f,  0.0f,  1.0f, 1.0f,
-    0.5f,  0.5f,  0.5f,  0.0f,  1.0f,  0.0f,  1.0f, 0.0f,
-    0.5f,  0.5f,  0.5f,  0.0f,  1.0f,  0.0f,  1.0f, 0.0f,
-   -0.5f,  0.5f,  0.5f,  0.0f,  1.0f,  0.0f,  0.0f, 0.0f,
-   -0.5f,  0.5f, -0.5f,  0.0f,  1.0f,  0.0f,  0.0f, 1.0f
-    };
-
-    const GLuint floatsPerVertex = 3;
-    const GLuint floatsPerNormal = 3;
-    const GLuint floatsPerUV = 2;
-
-    mesh.nVertices = sizeof(verts) / (sizeof(verts[0]) * (floatsPerVertex + floatsPerNormal + floatsPerUV));
-
-    glGenVertexArrays(1, &mesh.vao);
-    glBindVertexArray(mesh.vao);
-
-    //create 2 buffers
-    glGenBuffers(1, &mesh.vbo);
-    glBindBuffer(GL_ARRAY_BUFFER, mesh.vbo);
-    glBufferData(GL_ARRAY_BUFFER, sizeof(verts), verts, GL_STATIC_DRAW);
-
-    //stride between vertexs
-    GLint stride = sizeof(float) * (floatsPerVertex + floatsPerNormal + floatsPerUV);
-
-    //create atribute pointers
-    glVertexAttribPointer(0, floatsPerVertex, GL_FLOAT, GL_FALSE, stride, 0);
-    glEnableVertexAttribArray(0);
-
-    glVertexAttribPointer(1, floatsPerNormal, GL_FLOAT, GL_FALSE, stride, (void*)(sizeof(float) * floatsPerVertex));
-    glEnableVertexAttribArray(1);
-
-    glVertexAttribPointer(2, floatsPerUV, GL_FLOAT, GL_FALSE, stride, (void*)(sizeof(float) * (floatsPerVertex + floatsPerNormal)));
-    glEnableVertexAttribArray(2);
-}
-
-void UCreateKnifeHandleMesh(GLMesh& mesh)
-{
-    // Position and Color data
-    GLfloat verts[] = {
-        //Positions          //Normals
-        // ------------------------------------------------------
-        //Back Face          //Negative Z Normal  Texture Coords.
-       -4.0f, -0.4f, 0.5f,  0.0f,  -1.0f, 0.0f,  0.0f, 0.0f,
-        0.0f, -0.4f, 0.5f,  0.0f,  -1.0f, 0.0f,  1.0f, 0.0f,
-        0.0f, -0.4f, -0.5f,  0.0f,  -1.0f, 0.0f,  1.0f, 1.0f,
-        0.0f, -0.4f, -0.5f,  0.0f,  -1.0f, 0.0f,  1.0f, 1.0f,
-       -4.0f, -0.4f, -0.5f,  0.0f,  -1.0f, 0.0f,  0.0f, 1.0f,
-       -4.0f, -0.4f, 0.5f,  0.0f,  -1.0f, 0.0f,  0.0f, 0.0f,
-
-       //Front Face         //Positive Z Normal
-      -4.0f,  0.4f, 0.5f,  0.0f,  1.0f,  0.0f,  0.0f, 0.0f,
-       0.0f,  0.4f, 0.5f,  0.0f,  1.0f,  0.0f,  1.0f, 0.0f,
-       0.0f,  0.4f, -0.5f,  0.0f,  1.0f,  0.0f,  1.0f, 1.0f,
-       0.0f,  0.4f, -0.5f,  0.0f,  1.0f,  0.0f,  1.0f, 1.0f,
-      -4.0f,  0.4f, -0.5f,  0.0f,  1.0f,  0.0f,  0.0f, 1.0f,
-      -4.0f,  0.4f, 0.5f,  0.0f,  1.0f,  0.0f,  0.0f, 0.0f,
-
-      //Left Face          //Negative X Normal
-      -4.0f, -0.4f, 0.5f, -1.0f,  0.0f,  0.0f,  1.0f, 0.0f,
-     -4.0f,  0.4f, 0.5f, -1.0f,  0.0f,  0.0f,  1.0f, 1.0f,
-     -4.0f,  0.4f, -0.5f, -1.0f,  0.0f,  0.0f,  0.0f, 1.0f,
-     -4.0f,  0.4f, -0.5f, -1.0f,  0.0f,  0.0f,  0.0f, 1.0f,
-      -4.0f, -0.4f, -0.5f, -1.0f,  0.0f,  0.0f,  0.0f, 0.0f,
-     -4.0f, -0.4f, 0.5f, -1.0f,  0.0f,  0.0f,  1.0f, 0.0f,
-
-     //Right Face         //Positive X Normal
-    0.0f, -0.4f, 0.5f,  1.0f,  0.0f,  0.0f,  1.0f, 0.0f,
-     0.0f,  0.4f, 0.5f,  1.0f,  0.0f,  0.0f,  1.0f, 1.0f,
-     0.0f,  0.4f, -0.5f,  1.0f,  0.0f,  0.0f,  0.0f, 1.0f,
-     0.0f,  0.4f, -0.5f,  1.0f,  0.0f,  0.0f,  0.0f, 1.0f,
-     0.0f, -0.4f, -0.5f,  1.0f,  0.0f,  0.0f,  0.0f, 0.0f,
-     0.0f, -0.4f, 0.5f,  1.0f,  0.0f,  0.0f,  1.0f, 0.0f,
-
-     //Bottom Face        //Negative Y Normal
-    -4.0f, -0.4f, -0.5f,  0.0f, 0.0f,  -1.0f,  0.0f, 1.0f,
-     0.0f, -0.4f, -0.5f,  0.0f, 0.0f,  -1.0f,  1.0f, 1.0f,
-     0.0f,  0.4f, -0.5f,  0.0f, 0.0f,  -1.0f,  1.0f, 0.0f,
-     0.0f,  0.4f, -0.5f,  0.0f, 0.0f,  -1.0f,  1.0f, 0.0f,
-    -4.0f,  0.4f, -0.5f,  0.0f, 0.0f,  -1.0f,  0.0f, 0.0f,
-    -4.0f, -0.4f, -0.5f,  0.0f, 0.0f,  -1.0f,  0.0f, 1.0f,
-
-    //Top Face           //Positive Y Normal
-   -4.0f, -0.4f, 0.5f,  0.0f,  0.0f,  1.0f,  0.0f, 1.0f,
-    0.0f, -0.4f, 0.5f,  0.0f,  0.0f,  1.0f,  1.0f, 1.0f,
-    0.0f,  0.4f, 0.5f,  0.0f,  0.0f,  1.0f,  1.0f, 0.0f,
-    0.0f,  0.4f, 0.5f,  0.0f,  0.0f,  1.0f,  1.0f, 0.0f,
-   -4.0f,  0.4f, 0.5f,  0.0f,  0.0f,  1.0f,  0.0f, 0.0f,
-   -4.0f, -0.4f, 0.5f,  0.0f,  0.0f,  1.0f,  0.0f, 1.0f
-    };
-
-    const GLuint floatsPerVertex = 3;
-    const GLuint floatsPerNormal = 3;
-    const GLuint floatsPerUV = 2;
-
-    mesh.nVertices = sizeof(verts) / (sizeof(verts[0]) * (floatsPerVertex + floatsPerNormal + floatsPerUV));
-
-    glGenVertexArrays(1, &mesh.vao);
-    glBindVertexArray(mesh.vao);
-
-    //create 2 buffers
-    glGenBuffers(1, &mesh.vbo);
-    glBindBuffer(GL_ARRAY_BUFFER, mesh.vbo);
-    glBufferData(GL_ARRAY_BUFFER, sizeof(verts), verts, GL_STATIC_DRAW);
-
-    //stride between vertexs
-    GLint stride = sizeof(float) * (floatsPerVertex + floatsPerNormal + floatsPerUV);
-
-    //create atribute pointers
-    glVertexAttribPointer(0, floatsPerVertex, GL_FLOAT, GL_FALSE, stride, 0);
-    glEnableVertexAttribArray(0);
-
-    glVertexAttribPointer(1, floatsPerNormal, GL_FLOAT, GL_FALSE, stride, (void*)(sizeof(float) * floatsPerVertex));
-    glEnableVertexAttribArray(1);
-
-    glVertexAttribPointer(2, floatsPerUV, GL_FLOAT, GL_FALSE, stride, (void*)(sizeof(float) * (floatsPerVertex + floatsPerNormal)));
-    glEnableVertexAttribArray(2);
-}
-
-void UCreateKnifeBladeMesh(GLMesh& mesh)
-{
-    // Position and Color data
-    GLfloat verts[] = {
-        //Positions         //Normals
-        // ------------------------------------------------------
-        //Back Face        //Negative Z Normal  Texture Coords.
-      6.0f, -0.05f, -1.1f, 0.0f,  0.0f, -1.0f,  0.0f, 0.0f,
-      0.0f, -0.05f, -1.1f, 0.0f,  0.0f, -1.0f,  1.0f, 0.0f,
-      0.0f,  0.05f, -1.1f, 0.0f,  0.0f, -1.0f,  1.0f, 1.0f,
-      0.0f,  0.05f, -1.1f, 0.0f,  0.0f, -1.0f,  1.0f, 1.0f,
-      6.0f,  0.05f, -1.1f, 0.0f,  0.0f, -1.0f,  0.0f, 1.0f,
-      6.0f, -0.05f, -1.1f, 0.0f,  0.0f, -1.0f,  0.0f, 0.0f,
-
-      //Front Face         //Positive Z Normal
-     6.0f, -0.05f, 0.5f,  0.0f,  0.0f,  1.0f,  0.0f, 0.0f,
-     0.0f, -0.05f, 0.5f,  0.0f,  0.0f,  1.0f,  1.0f, 0.0f,
-     0.0f,  0.05f, 0.5f,  0.0f,  0.0f,  1.0f,  1.0f, 1.0f,
-     0.0f,  0.05f, 0.5f,  0.0f,  0.0f,  1.0f,  1.0f, 1.0f,
-     6.0f,  0.05f, 0.5f,  0.0f,  0.0f,  1.0f,  0.0f, 1.0f,
-     6.0f, -0.05f, 0.5f,  0.0f,  0.0f,  1.0f,  0.0f, 0.0f,
-
-     //Left Face          //Negative X Normal
-    0.0f, -0.05f,  0.5f, -1.0f,  0.0f,  0.0f,  1.0f, 0.0f,
-    0.0f,  0.05f,  0.5f, -1.0f,  0.0f,  0.0f,  1.0f, 1.0f,
-    0.0f,  0.05f, -1.1f, -1.0f,  0.0f,  0.0f,  0.0f, 1.0f,
-    0.0f,  0.05f, -1.1f, -1.0f,  0.0f,  0.0f,  0.0f, 1.0f,
-    0.0f, -0.05f, -1.1f, -1.0f,  0.0f,  0.0f,  0.0f, 0.0f,
-    0.0f, -0.05f,  0.5f, -1.0f,  0.0f,  0.0f,  1.0f, 0.0f,
-
-    //Bottom Face        //Negative Y Normal
-    6.0f, -0.05f, 0.5f,  0.0f, -1.0f,  0.0f,  0.0f, 1.0f,
-    0.0f, -0.05f, 0.5f,  0.0f, -1.0f,  0.0f,  1.0f, 1.0f,
-    0.0f, -0.05f, -1.1f, 0.0f, -1.0f,  0.0f,  1.0f, 0.0f,
-    0.0f, -0.05f, -1.1f, 0.0f, -1.0f,  0.0f,  1.0f, 0.0f,
-    6.0f, -0.05f, -1.1f, 0.0f, -1.0f,  0.0f,  0.0f, 0.0f,
-    6.0f, -0.05f, 0.5f,  0.0f, -1.0f,  0.0f,  0.0f, 1.0f,
-
-    //Top Face           //Positive Y Normal
-     6.0f,  0.05f, 0.5f,  0.0f,  1.0f,  0.0f,  0.0f, 1.0f,
-     0.0f,  0.05f, 0.5f,  0.0f,  1.0f,  0.0f,  1.0f, 1.0f,
-     0.0f,  0.05f, -1.1f, 0.0f,  1.0f,  0.0f,  1.0f, 0.0f,
-     0.0f,  0.05f, -1.1f, 0.0f,  1.0f,  0.0f,  1.0f, 0.0f,
-     6.0f,  0.05f, -1.1f, 0.0f,  1.0f,  0.0f,  0.0f, 0.0f,
-     6.0f,  0.05f, 0.5f,  0.0f,  1.0f,  0.0f,  0.0f, 1.0f,
-
-     //pyr side 1 top
-     6.0f,  0.05f, -1.1f, 0.0f,  1.0f,  0.0f, 0.0f, 1.0f,//4
-     6.0f,  0.05f,  0.5f, 0.0f,  1.0f,  0.0f, 0.0f, 0.0f,//8
-     8.0f, 0.0f ,  0.0f, 0.0f,  1.0f,  0.0f, 1.0f, 0.5f,//x
-
-     //pyr side 2 back
-     6.0f, -0.05f, -1.1f, 0.0f,  0.0f, -1.0f, 0.0f, 1.0f,//1
-     6.0f,  0.05f, -1.1f, 0.0f,  0.0f, -1.0f, 0.0f, 0.0f,//4
-     8.0f, 0.0f ,  0.0f, 0.0f,  0.0f, -1.0f, 1.0f, 0.5f,//x
-
-     //pyr side 3 front
-     6.0f,  0.05f, 0.5f, 0.0f,  0.0f, 1.0f, 0.0f, 1.0f,//8
-     6.0f, -0.05f, 0.5f, 0.0f,  0.0f, 1.0f, 0.0f, 0.0f,//5
-     8.0f, 0.0f , 0.0f, 0.0f,  0.0f, 1.0f, 1.0f, 0.5f,//x
-
-     //pyr side 4 bottom
-     6.0f, -0.05f, 0.5f, 0.0f,  -1.0f,  0.0f, 0.0f, 0.0f,//5
-     6.0f, -0.05f, -1.1f, 0.0f, -1.0f,  0.0f, 0.0f, 1.0f,//1
-     8.0f, 0.0f ,  0.0f, 0.0f, -1.0f,  0.0f, 1.0f, 0.5f//x
-    };
-
-    const GLuint floatsPerVertex = 3;
-    const GLuint floatsPerNormal = 3;
-    const GLuint floatsPerUV = 2;
-
-    mesh.nVertices = sizeof(verts) / (sizeof(verts[0]) * (floatsPerVertex + floatsPerNormal + floatsPerUV));
-
-    glGenVertexArrays(1, &mesh.vao);
-    glBindVertexArray(mesh.vao);
-
-    //create 2 buffers
-    glGenBuffers(1, &mesh.vbo);
-    glBindBuffer(GL_ARRAY_BUFFER, mesh.vbo);
-    glBufferData(GL_ARRAY_BUFFER, sizeof(verts), verts, GL_STATIC_DRAW);
-
-    //stride between vertexs
-    GLint stride = sizeof(float) * (floatsPerVertex + floatsPerNormal + floatsPerUV);
-
-    //create atribute pointers
-    glVertexAttribPointer(0, floatsPerVertex, GL_FLOAT, GL_FALSE, stride, 0);
-    glEnableVertexAttribArray(0);
-
-    glVertexAttribPointer(1, floatsPerNormal, GL_FLOAT, GL_FALSE, stride, (void*)(sizeof(float) * floatsPerVertex));
-    glEnableVertexAttribArray(1);
-
-    glVertexAttribPointer(2, floatsPerUV, GL_FLOAT, GL_FALSE, stride, (void*)(sizeof(float) * (floatsPerVertex + floatsPerNormal)));
-    glEnableVertexAttribArray(2);
-}
-
-void UCreateCuttingBoardMesh(GLMesh& mesh)
-{
-    // Position and Color data
-    GLfloat verts[] = {
-        //Positions          //Normals
-        // ------------------------------------------------------
-        //Back Face          //Negative Z Normal  Texture Coords.
-       -4.0f,  0.0f, -3.0f,  0.0f,  0.0f, -1.0f,  0.15f, 0.2f,
-        4.0f,  0.0f, -3.0f,  0.0f,  0.0f, -1.0f,  0.15f, 0.9f,
-        4.0f,  0.5f, -3.0f,  0.0f,  0.0f, -1.0f,  0.18f, 0.9f,
-        4.0f,  0.5f, -3.0f,  0.0f,  0.0f, -1.0f,  0.18f, 0.9f,
-       -4.0f,  0.5f, -3.0f,  0.0f,  0.0f, -1.0f,  0.18f, 0.2f,
-       -4.0f,  0.0f, -3.0f,  0.0f,  0.0f, -1.0f,  0.15f, 0.2f,
-
-       //Front Face         //Positive Z Normal
-      -4.0f,  0.0f,  3.0f,  0.0f,  0.0f,  1.0f,  0.15f, 0.2f,
-       4.0f,  0.0f,  3.0f,  0.0f,  0.0f,  1.0f,  0.15f, 0.9f,
-       4.0f,  0.5f,  3.0f,  0.0f,  0.0f,  1.0f,  0.18f, 0.9f,
-       4.0f,  0.5f,  3.0f,  0.0f,  0.0f,  1.0f,  0.18f, 0.9f,
-      -4.0f,  0.5f,  3.0f,  0.0f,  0.0f,  1.0f,  0.18f, 0.2f,
-      -4.0f,  0.0f,  3.0f,  0.0f,  0.0f,  1.0f,  0.15f, 0.2f,
-
-      //Left Face          //Negative X Normal
-     -4.0f,  0.5f,  3.0f, -1.0f,  0.0f,  0.0f,  0.15f, 0.2f,
-     -4.0f,  0.5f, -3.0f, -1.0f,  0.0f,  0.0f,  0.15f, 0.9f,
-     -4.0f,  0.0f, -3.0f, -1.0f,  0.0f,  0.0f,  0.18f, 0.9f,
-     -4.0f,  0.0f, -3.0f, -1.0f,  0.0f,  0.0f,  0.18f, 0.9f,
-     -4.0f,  0.0f,  3.0f, -1.0f,  0.0f,  0.0f,  0.18f, 0.2f,
-     -4.0f,  0.5f,  3.0f, -1.0f,  0.0f,  0.0f,  0.15f, 0.2f,
-
-     //Right Face         //Positive X Normal
-     4.0f,  0.5f,  3.0f,  1.0f,  0.0f,  0.0f,  0.15f, 0.2f,
-     4.0f,  0.5f, -3.0f,  1.0f,  0.0f,  0.0f,  0.15f, 0.9f,
-     4.0f,  0.0f, -3.0f,  1.0f,  0.0f,  0.0f,  0.18f, 0.9f,
-     4.0f,  0.0f, -3.0f,  1.0f,  0.0f,  0.0f,  0.18f, 0.9f,
-     4.0f,  0.0f,  3.0f,  1.0f,  0.0f,  0.0f,  0.18f, 0.2f,
-     4.0f,  0.5f,  3.0f,  1.0f,  0.0f,  0.0f,  0.15f, 0.2f,
-
-     //Bottom Face        //Negative Y Normal
-    -4.0f,  0.0f, -3.0f,  0.0f,  1.0f,  0.0f,  0.15f, 0.1f,
-     4.0f,  0.0f, -3.0f,  0.0f,  1.0f,  0.0f,  0.15f, 0.9f,
-     4.0f,  0.0f,  3.0f,  0.0f,  1.0f,  0.0f,  0.85f, 0.9f,
-     4.0f,  0.0f,  3.0f,  0.0f,  1.0f,  0.0f,  0.85f, 0.9f,
-    -4.0f,  0.0f,  3.0f,  0.0f,  1.0f,  0.0f,  0.85f, 0.1f,
-    -4.0f,  0.0f, -3.0f,  0.0f,  1.0f,  0.0f,  0.15f, 0.1f,
-
-    //Top Face           //Positive Y Normal
-   -4.0f,  0.5f, -3.0f,  0.0f,  1.0f,  0.0f,  0.15f, 0.1f,
-    4.0f,  0.5f, -3.0f,  0.0f,  1.0f,  0.0f,  0.15f, 0.9f,
-    4.0f,  0.5f,  3.0f,  0.0f,  1.0f,  0.0f,  0.85f, 0.9f,
-    4.0f,  0.5f,  3.0f,  0.0f,  1.0f,  0.0f,  0.85f, 0.9f,
-   -4.0f,  0.5f,  3.0f,  0.0f,  1.0f,  0.0f,  0.85f, 0.1f,
-   -4.0f,  0.5f, -3.0f,  0.0f,  1.0f,  0.0f,  0.15f, 0.1f
-    };
-
-    const GLuint floatsPerVertex = 3;
-    const GLuint floatsPerNormal = 3;
-    const GLuint floatsPerUV = 2;
-
-    mesh.nVertices = sizeof(verts) / (sizeof(verts[0]) * (floatsPerVertex + floatsPerNormal + floatsPerUV));
-
-    glGenVertexArrays(1, &mesh.vao);
-    glBindVertexArray(mesh.vao);
-
-    //create 2 buffers
-    glGenBuffers(1, &mesh.vbo);
-    glBindBuffer(GL_ARRAY_BUFFER, mesh.vbo);
-    glBufferData(GL_ARRAY_BUFFER, sizeof(verts), verts, GL_STATIC_DRAW);
-
-    //stride between vertexs
-    GLint stride = sizeof(float) * (floatsPerVertex + floatsPerNormal + floatsPerUV);
-
-    //create atribute pointers
-    glVertexAttribPointer(0, floatsPerVertex, GL_FLOAT, GL_FALSE, stride, 0);
-    glEnableVertexAttribArray(0);
-
-    glVertexAttribPointer(1, floatsPerNormal, GL_FLOAT, GL_FALSE, stride, (void*)(sizeof(float) * floatsPerVertex));
-    glEnableVertexAttribArray(1);
-
-    glVertexAttribPointer(2, floatsPerUV, GL_FLOAT, GL_FALSE, stride, (void*)(sizeof(float) * (floatsPerVertex + floatsPerNormal)));
-    glEnableVertexAttribArray(2);
-}
-
-void UCreatePlaneMesh(GLMesh& mesh)
-{
-    GLuint repeatUp = 2.0f;
-    GLuint RepeatHori = 3.0f;
-    // Position and Color data
-    GLfloat verts[] = {
-        //Positions            //Normals
-        // ------------------------------------------------------
-        //Top Face             //Positive Y Normal
-       -15.0f,  0.0f, -15.0f,  0.0f,  1.0f,  0.0f,  0.0f,     0.0f,
-        15.0f,  0.0f, -15.0f,  0.0f,  1.0f,  0.0f,  0.0f,     RepeatHori,
-        15.0f,  0.0f,  15.0f,  0.0f,  1.0f,  0.0f,  repeatUp, RepeatHori,
-        15.0f,  0.0f,  15.0f,  0.0f,  1.0f,  0.0f,  repeatUp, RepeatHori,
-       -15.0f,  0.0f,  15.0f,  0.0f,  1.0f,  0.0f,  repeatUp, 0.0f,
-       -15.0f,  0.0f, -15.0f,  0.0f,  1.0f,  0.0f,  0.0f,     0.0f
-    };
-
-    const GLuint floatsPerVertex = 3;
-    const GLuint floatsPerNormal = 3;
-    const GLuint floatsPerUV = 2;
-
-    mesh.nVertices = sizeof(verts) / (sizeof(verts[0]) * (floatsPerVertex + floatsPerNormal + floatsPerUV));
-
-    glGenVertexArrays(1, &mesh.vao);
-    glBindVertexArray(mesh.vao);
-
-    //create 2 buffers
-    glGenBuffers(1, &mesh.vbo);
-    glBindBuffer(GL_ARRAY_BUFFER, mesh.vbo);
-    glBufferData(GL_ARRAY_BUFFER, sizeof(verts), verts, GL_STATIC_DRAW);
-
-    //stride between vertexs
-    GLint stride = sizeof(float) * (floatsPerVertex + floatsPerNormal + floatsPerUV);
-
-    //create atribute pointers
-    glVertexAttribPointer(0, floatsPerVertex, GL_FLOAT, GL_FALSE, stride, 0);
-    glEnableVertexAttribArray(0);
-
-    glVertexAttribPointer(1, floatsPerNormal, GL_FLOAT, GL_FALSE, stride, (void*)(sizeof(float) * floatsPerVertex));
-    glEnableVertexAttribArray(1);
-
-    glVertexAttribPointer(2, floatsPerUV, GL_FLOAT, GL_FALSE, stride, (void*)(sizeof(float) * (floatsPerVertex + floatsPerNormal)));
-    glEnableVertexAttribArray(2);
-}
-
-//creates the mesh for the salami ends
-void UCreateSalamiEndsMesh(GLMesh& mesh) {
-    GLfloat verts[] = {
-        //Positions          //Normals
-        // ------------------------------------------------------
-
-        //Bottom Face        //Negative Y Normal
-       -0.4f, -1.0f, -1.0f,  0.0f, -1.0f,  0.0f,  0.33f, 1.0f,
-        0.4f, -1.0f, -1.0f,  0.0f, -1.0f,  0.0f,  0.66f, 1.0f,
-        0.0f, -1.0f,  0.0f,  0.0f, -1.0f,  0.0f,  0.5f, 0.5f,
-        0.4f, -1.0f, -1.0f,  0.0f, -1.0f,  0.0f,  0.66f, 1.0f,
-        1.0f, -1.0f, -0.4f,  0.0f, -1.0f,  0.0f,  1.0f, 0.66f,
-        0.0f, -1.0f,  0.0f,  0.0f, -1.0f,  0.0f,  0.5f, 0.5f,
-        1.0f, -1.0f,  0.4f,  0.0f, -1.0f,  0.0f,  1.00f, 0.33f,
-        1.0f, -1.0f, -0.4f,  0.0f, -1.0f,  0.0f,  1.0f, 0.66f,
-        0.0f, -1.0f,  0.0f,  0.0f, -1.0f,  0.0f,  0.5f, 0.5f,
-        0.4f, -1.0f,  1.0f,  0.0f, -1.0f,  0.0f,  0.66f, 0.0f,
-        1.0f, -1.0f,  0.4f,  0.0f, -1.0f,  0.0f,  1.00f, 0.33f,
-        0.0f, -1.0f,  0.0f,  0.0f, -1.0f,  0.0f,  0.5f, 0.5f,
-        0.4f, -1.0f,  1.0f,  0.0f, -1.0f,  0.0f,  0.66f, 0.0f,
-        1.0f, -1.0f,  0.4f,  0.0f, -1.0f,  0.0f,  1.00f, 0.33f,
-        0.0f, -1.0f,  0.0f,  0.0f, -1.0f,  0.0f,  0.5f, 0.5f,
-        0.4f, -1.0f,  1.0f,  0.0f, -1.0f,  0.0f,  0.66f, 0.0f,
-       -0.4f, -1.0f,  1.0f,  0.0f, -1.0f,  0.0f,  0.33f, 0.00f,
-        0.0f, -1.0f,  0.0f,  0.0f, -1.0f,  0.0f,  0.5f, 0.5f,
-       -1.0f, -1.0f,  0.4f,  0.0f, -1.0f,  0.0f,  0.0f, 0.33f,
-       -0.4f, -1.0f,  1.0f,  0.0f, -1.0f,  0.0f,  0.33f, 0.0f,
-        0.0f, -1.0f,  0.0f,  0.0f, -1.0f,  0.0f,  0.5f, 0.5f,
-       -1.0f, -1.0f,  0.4f,  0.0f, -1.0f,  0.0f,  0.0f, 0.33f,
-       -1.0f, -1.0f, -0.4f,  0.0f, -1.0f,  0.0f,  0.0f, 0.66f,
-        0.0f, -1.0f,  0.0f,  0.0f, -1.0f,  0.0f,  0.5f, 0.5f,
-       -0.4f, -1.0f, -1.0f,  0.0f, -1.0f,  0.0f,  0.33f, 1.0f,
-       -1.0f, -1.0f, -0.4f,  0.0f, -1.0f,  0.0f,  0.0f, 0.66f,
-        0.0f, -1.0f,  0.0f,  0.0f, -1.0f,  0.0f,  0.5f, 0.5f,
-
-        //Top Face        //Positive Y Normal
-       -0.4f,  1.0f, -1.0f,  0.0f,  1.0f,  0.0f,  0.33f, 1.0f,
-        0.4f,  1.0f, -1.0f,  0.0f,  1.0f,  0.0f,  0.66f, 1.0f,
-        0.0f,  1.0f,  0.0f,  0.0f,  1.0f,  0.0f,  0.5f, 0.5f,
-        0.4f,  1.0f, -1.0f,  0.0f,  1.0f,  0.0f,  0.66f, 1.0f,
-        1.0f,  1.0f, -0.4f,  0.0f,  1.0f,  0.0f,  1.0f, 0.66f,
-        0.0f,  1.0f,  0.0f,  0.0f,  1.0f,  0.0f,  0.5f, 0.5f,
-        1.0f,  1.0f,  0.4f,  0.0f,  1.0f,  0.0f,  1.00f, 0.33f,
-        1.0f,  1.0f, -0.4f,  0.0f,  1.0f,  0.0f,  1.0f, 0.66f,
-        0.0f,  1.0f,  0.0f,  0.0f,  1.0f,  0.0f,  0.5f, 0.5f,
-        0.4f,  1.0f,  1.0f,  0.0f,  1.0f,  0.0f,  0.66f, 0.0f,
-        1.0f,  1.0f,  0.4f,  0.0f,  1.0f,  0.0f,  1.00f, 0.33f,
-        0.0f,  1.0f,  0.0f,  0.0f,  1.0f,  0.0f,  0.5f, 0.5f,
-        0.4f,  1.0f,  1.0f,  0.0f,  1.0f,  0.0f,  0.66f, 0.0f,
-        1.0f,  1.0f,  0.4f,  0.0f,  1.0f,  0.0f,  1.00f, 0.33f,
-        0.0f,  1.0f,  0.0f,  0.0f,  1.0f,  0.0f,  0.5f, 0.5f,
-        0.4f,  1.0f,  1.0f,  0.0f,  1.0f,  0.0f,  0.66f, 0.0f,
-       -0.4f,  1.0f,  1.0f,  0.0f,  1.0f,  0.0f,  0.33f, 0.00f,
-        0.0f,  1.0f,  0.0f,  0.0f,  1.0f,  0.0f,  0.5f, 0.5f,
-       -1.0f,  1.0f,  0.4f,  0.0f,  1.0f,  0.0f,  0.0f, 0.33f,
-       -0.4f,  1.0f,  1.0f,  0.0f,  1.0f,  0.0f,  0.33f, 0.0f,
-        0.0f,  1.0f,  0.0f,  0.0f,  1.0f,  0.0f,  0.5f, 0.5f,
-       -1.0f,  1.0f,  0.4f,  0.0f,  1.0f,  0.0f,  0.0f, 0.33f,
-       -1.0f,  1.0f, -0.4f,  0.0f,  1.0f,  0.0f,  0.0f, 0.66f,
-        0.0f,  1.0f,  0.0f,  0.0f,  1.0f,  0.0f,  0.5f, 0.5f,
-       -0.4f,  1.0f, -1.0f,  0.0f,  1.0f,  0.0f,  0.33f, 1.0f,
-       -1.0f,  1.0f, -0.4f,  0.0f,  1.0f,  0.0f,  0.0f, 0.66f,
-        0.0f,  1.0f,  0.0f,  0.0f,  1.0f,  0.0f,  0.5f, 0.5f
-    };
-
-    const GLuint floatsPerVertex = 3;
-    const GLuint floatsPerNormal = 3;
-    const GLuint floatsPerUV = 2;
-
-    mesh.nVertices = sizeof(verts) / (sizeof(verts[0]) * (floatsPerVertex + floatsPerNormal + floatsPerUV));
-
-    glGenVertexArrays(1, &mesh.vao); // we can also generate multiple VAOs or buffers at the same time
-    glBindVertexArray(mesh.vao);
-
-    // Create 2 buffers: first one for the vertex data; second one for the indices
-    glGenBuffers(1, &mesh.vbo);
-    glBindBuffer(GL_ARRAY_BUFFER, mesh.vbo); // Activates the buffer
-    glBufferData(GL_ARRAY_BUFFER, sizeof(verts), verts, GL_STATIC_DRAW); // Sends vertex or coordinate data to the GPU
-
-    // Strides between vertex coordinates is 6 (x, y, z, r, g, b, a). A tightly packed stride is 0.
-    GLint stride = sizeof(float) * (floatsPerVertex + floatsPerNormal + floatsPerUV);// The number of floats before each
-
-    // Create Vertex Attribute Pointers
-    glVertexAttribPointer(0, floatsPerVertex, GL_FLOAT, GL_FALSE, stride, 0);
-    glEnableVertexAttribArray(0);
-
-    glVertexAttribPointer(1, floatsPerNormal, GL_FLOAT, GL_FALSE, stride, (void*)(sizeof(float) * floatsPerVertex));
-    glEnableVertexAttribArray(1);
-
-    glVertexAttribPointer(2, floatsPerUV, GL_FLOAT, GL_FALSE, stride, (void*)(sizeof(float) * (floatsPerVertex + floatsPerNormal)));
-    glEnableVertexAttribArray(2);
-}
-
-//creates the mesh for the salami body
-void UCreateSalamiBodyMesh(GLMesh& mesh) {
-    // Position and Color data
-    GLfloat verts[] = {
-        //South Face         //Positive Z Normal
-       -0.4f, -1.0f, 1.0f, 0.0f, 0.0f, 1.0f, 0.0f, 0.0f,
-        0.4f, -1.0f, 1.0f, 0.0f, 0.0f, 1.0f, 1.0f, 0.0f,
-        0.4f, 1.0f, 1.0f, 0.0f, 0.0f, 1.0f, 1.0f, 1.0f,
-        0.4f, 1.0f, 1.0f, 0.0f, 0.0f, 1.0f, 1.0f, 1.0f,
-       -0.4f, 1.0f, 1.0f, 0.0f, 0.0f, 1.0f, 0.0f, 1.0f,
-       -0.4f, -1.0f, 1.0f, 0.0f, 0.0f, 1.0f, 0.0f, 0.0f,
-
-       //North Face         //Negative Z Normal
-      -0.4f, -1.0f, -1.0f, 0.0f, 0.0f, -1.0f, 0.0f, 0.0f,
-       0.4f, -1.0f, -1.0f, 0.0f, 0.0f, -1.0f, 1.0f, 0.0f,
-       0.4f, 1.0f, -1.0f, 0.0f, 0.0f, -1.0f, 1.0f, 1.0f,
-       0.4f, 1.0f, -1.0f, 0.0f, 0.0f, -1.0f, 1.0f, 1.0f,
-      -0.4f, 1.0f, -1.0f, 0.0f, 0.0f, -1.0f, 0.0f, 1.0f,
-      -0.4f, -1.0f, -1.0f, 0.0f, 0.0f, -1.0f, 0.0f, 0.0f,
-
-      //East Face         //Positive X Normal
-      1.0f, 1.0f, 0.4f, 1.0f, 0.0f, 0.0f, 0.0f, 0.0f,
-      1.0f, 1.0f, -0.4f, 1.0f, 0.0f, 0.0f, 1.0f, 0.0f,
-      1.0f, -1.0f, -0.4f, 1.0f, 0.0f, 0.0f, 1.0f, 1.0f,
-      1.0f, -1.0f, -0.4f, 1.0f, 0.0f, 0.0f, 1.0f, 1.0f,
-      1.0f, -1.0f, 0.4f, 1.0f, 0.0f, 0.0f, 0.0f, 1.0f,
-      1.0f, 1.0f, 0.4f, 1.0f, 0.0f, 0.0f, 0.0f, 0.0f,
-
-      //West Face         //Negative X Normal
-    -1.0f, 1.0f, 0.4f, -1.0f, 0.0f, 0.0f, 0.0f, 0.0f,
-    -1.0f, 1.0f, -0.4f, -1.0f, 0.0f, 0.0f, 1.0f, 0.0f,
-    -1.0f, -1.0f, -0.4f, -1.0f, 0.0f, 0.0f, 1.0f, 1.0f,
-    -1.0f, -1.0f, -0.4f, -1.0f, 0.0f, 0.0f, 1.0f, 1.0f,
-    -1.0f, -1.0f, 0.4f, -1.0f, 0.0f, 0.0f, 0.0f, 1.0f,
-    -1.0f, 1.0f, 0.4f, -1.0f, 0.0f, 0.0f, 0.0f, 0.0f,
-
-    //NorthEst Face       
-    1.0f, -1.0f, -0.4f, 0.5f, 0.0f, -0.5f, 0.0f, 0.0f,
-    0.4f, -1.0f, -1.0f, 0.5f, 0.0f, -0.5f, 1.0f, 0.0f,
-    0.4f, 1.0f, -1.0f, 0.5f, 0.0f, -0.5f, 1.0f, 1.0f,
-    0.4f, 1.0f, -1.0f, 0.5f, 0.0f, -0.5f, 1.0f, 1.0f,
-    1.0f, 1.0f, -0.4f, 0.5f, 0.0f, -0.5f, 0.0f, 1.0f,
-    1.0f, -1.0f, -0.4f, 0.5f, 0.0f, -0.5f, 0.0f, 0.0f,
-
-    //Southwest Face       
-    -0.4f, -1.0f, 1.0f, -0.5f, 0.0f, 0.5f, 0.0f, 0.0f,
-    -1.0f, -1.0f, 0.4f, -0.5f, 0.0f, 0.5f, 1.0f, 0.0f,
-    -1.0f, 1.0f, 0.4f, -0.5f, 0.0f, 0.5f, 1.0f, 1.0f,
-    -1.0f, 1.0f, 0.4f, -0.5f, 0.0f, 0.5f, 1.0f, 1.0f,
-    -0.4f, 1.0f, 1.0f, -0.5f, 0.0f, 0.5f, 0.0f, 1.0f,
-    -0.4f, -1.0f, 1.0f, -0.5f, 0.0f, 0.5f, 0.0f, 0.0f,
-
-    //Northwest Face
-    -1.0f, -1.0f, -0.4f, -0.5f, 0.0f, -0.5f, 0.0f, 0.0f,
-    -0.4f, -1.0f, -1.0f, -0.5f, 0.0f, -0.5f, 1.0f, 0.0f,
-    -0.4f, 1.0f, -1.0f, -0.5f, 0.0f, -0.5f, 1.0f, 1.0f,
-    -0.4f, 1.0f, -1.0f, -0.5f, 0.0f, -0.5f, 1.0f, 1.0f,
-    -1.0f, 1.0f, -0.4f, -0.5f, 0.0f, -0.5f, 0.0f, 1.0f,
-    -1.0f, -1.0f, -0.4f, -0.5f, 0.0f, -0.5f, 0.0f, 0.0f,
-
-    //Southeast Face
-    1.0f, -1.0f, 0.4f, 0.5f, 0.0f, 0.5f, 0.0f, 0.0f,
-    0.4f, -1.0f, 1.0f, 0.5f, 0.0f, 0.5f, 1.0f, 0.0f,
-    0.4f, 1.0f, 1.0f, 0.5f, 0.0f, 0.5f, 1.0f, 1.0f,
-    0.4f, 1.0f, 1.0f, 0.5f, 0.0f, 0.5f, 1.0f, 1.0f,
-    1.0f, 1.0f, 0.4f, 0.5f, 0.0f, 0.5f, 0.0f, 1.0f,
-    1.0f, -1.0f, 0.4f, 0.5f, 0.0f, 0.5f, 0.0f, 0.0f,
-    };
-
-    const GLuint floatsPerVertex = 3;
-    const GLuint floatsPerNormal = 3;
-    const GLuint floatsPerUV = 2;
-
-    mesh.nVertices = sizeof(verts) / (sizeof(verts[0]) * (floatsPerVertex + floatsPerNormal + floatsPerUV));
-
-    glGenVertexArrays(1, &mesh.vao); // we can also generate multiple VAOs or buffers at the same time
-    glBindVertexArray(mesh.vao);
-
-    // Create 2 buffers: first one for the vertex data; second one for the indices
-    glGenBuffers(1, &mesh.vbo);
-    glBindBuffer(GL_ARRAY_BUFFER, mesh.vbo); // Activates the buffer
-    glBufferData(GL_ARRAY_BUFFER, sizeof(verts), verts, GL_STATIC_DRAW); // Sends vertex or coordinate data to the GPU
-
-    // Strides between vertex coordinates is 6 (x, y, z, r, g, b, a). A tightly packed stride is 0.
-    GLint stride = sizeof(float) * (floatsPerVertex + floatsPerNormal + floatsPerUV);// The number of floats before each
-
-    // Create Vertex Attribute Pointers
-    glVertexAttribPointer(0, floatsPerVertex, GL_FLOAT, GL_FALSE, stride, 0);
-    glEnableVertexAttribArray(0);
-
-    glVertexAttribPointer(1, floatsPerNormal, GL_FLOAT, GL_FALSE, stride, (void*)(sizeof(float) * floatsPerVertex));
-    glEnableVertexAttribArray(1);
-
-    glVertexAttribPointer(2, floatsPerUV, GL_FLOAT, GL_FALSE, stride, (void*)(sizeof(float) * (floatsPerVertex + floatsPerNormal)));
-    glEnableVertexAttribArray(2);
-}
-
-//creates the mesh for the light
-void UCreateCheeseMesh(GLMesh& mesh)
-{
-    // Position and Color data
-    GLfloat verts[] = {
-        //Positions          //Normals
-        // ------------------------------------------------------
-        //Back Face          //Negative Z Normal  Texture Coords.
-       -0.5f, -0.5f, -0.5f,  0.0f,  0.0f, -1.0f,  0.0f, 0.0f,
-        0.5f, -0.5f, -0.5f,  0.0f,  0.0f, -1.0f,  1.0f, 0.0f,
-        0.5f,  0.5f, -0.5f,  0.0f,  0.0f, -1.0f,  1.0f, 1.0f,
-        0.5f,  0.5f, -0.5f,  0.0f,  0.0f, -1.0f,  1.0f, 1.0f,
-       -0.5f,  0.5f, -0.5f,  0.0f,  0.0f, -1.0f,  0.0f, 1.0f,
-       -0.5f, -0.5f, -0.5f,  0.0f,  0.0f, -1.0f,  0.0f, 0.0f,
-
-       //Front Face         //Positive Z Normal
-      -0.5f, -0.5f,  0.5f,  0.0f,  0.0f,  1.0f,  0.0f, 0.0f,
-       0.5f, -0.5f,  0.5f,  0.0f,  0.0f,  1.0f,  1.0f, 0.0f,
-       0.5f,  0.5f,  0.5f,  0.0f,  0.0f,  1.0f,  1.0f, 1.0f,
-       0.5f,  0.5f,  0.5f,  0.0f,  0.0f,  1.0f,  1.0f, 1.0f,
-      -0.5f,  0.5f,  0.5f,  0.0f,  0.0f,  1.0f,  0.0f, 1.0f,
-      -0.5f, -0.5f,  0.5f,  0.0f,  0.0f,  1.0f,  0.0f, 0.0f,
-
-      //Left Face          //Negative X Normal
-     -0.5f,  0.5f,  0.5f, -1.0f,  0.0f,  0.0f,  1.0f, 0.0f,
-     -0.5f,  0.5f, -0.5f, -1.0f,  0.0f,  0.0f,  1.0f, 1.0f,
-     -0.5f, -0.5f, -0.5f, -1.0f,  0.0f,  0.0f,  0.0f, 1.0f,
-     -0.5f, -0.5f, -0.5f, -1.0f,  0.0f,  0.0f,  0.0f, 1.0f,
-     -0.5f, -0.5f,  0.5f, -1.0f,  0.0f,  0.0f,  0.0f, 0.0f,
-     -0.5f,  0.5f,  0.5f, -1.0f,  0.0f,  0.0f,  1.0f, 0.0f,
-
-     //Right Face         //Positive X Normal
-     0.5f,  0.5f,  0.5f,  1.0f,  0.0f,  0.0f,  1.0f, 0.0f,
-     0.5f,  0.5f, -0.5f,  1.0f,  0.0f,  0.0f,  1.0f, 1.0f,
-     0.5f, -0.5f, -0.5f,  1.0f,  0.0f,  0.0f,  0.0f, 1.0f,
-     0.5f, -0.5f, -0.5f,  1.0f,  0.0f,  0.0f,  0.0f, 1.0f,
-     0.5f, -0.5f,  0.5f,  1.0f,  0.0f,  0.0f,  0.0f, 0.0f,
-     0.5f,  0.5f,  0.5f,  1.0f,  0.0f,  0.0f,  1.0f, 0.0f,
-
-     //Bottom Face        //Negative Y Normal
-    -0.5f, -0.5f, -0.5f,  0.0f, -1.0f,  0.0f,  0.0f, 1.0f,
-     0.5f, -0.5f, -0.5f,  0.0f, -1.0f,  0.0f,  1.0f, 1.0f,
-     0.5f, -0.5f,  0.5f,  0.0f, -1.0f,  0.0f,  1.0f, 0.0f,
-     0.5f, -0.5f,  0.5f,  0.0f, -1.0f,  0.0f,  1.0f, 0.0f,
-    -0.5f, -0.5f,  0.5f,  0.0f, -1.0f,  0.0f,  0.0f, 0.0f,
-    -0.5f, -0.5f, -0.5f,  0.0f, -1.0f,  0.0f,  0.0f, 1.0f,
-
-    //Top Face           //Positive Y Normal
-   -0.5f,  0.5f, -0.5f,  0.0f,  1.0f,  0.0f,  0.0f, 1.0f,
-    0.5f,  0.5f, -0.5f,  0.0f,  1.0f,  0.0f,  1.0f, 1.0f,
-    0.5f,  0.5f,  0.5f,  0.0f,  1.0f,  0.0f,  1.0f, 0.0f,
-    0.5f,  0.5f,  0.5f,  0.0f,  1.0f,  0.0f,  1.0f, 0.0f,
-   -0.5f,  0.5f,  0.5f,  0.0f,  1.0f,  0.0f,  0.0f, 0.0f,
-   -0.5f,  0.5f, -0.5f,  0.0f,  1.0f,  0.0f,  0.0f, 1.0f
-    };
-
-    const GLuint floatsPerVertex = 3;
-    const GLuint floatsPerNormal = 3;
-    const GLuint floatsPerUV = 2;
-
-    mesh.nVertices = sizeof(verts) / (sizeof(verts[0]) * (floatsPerVertex + floatsPerNormal + floatsPerUV));
-
-    glGenVertexArrays(1, &mesh.vao);
-    glBindVertexArray(mesh.vao);
-
-    //create 2 buffers
-    glGenBuffers(1, &mesh.vbo);
-    glBindBuffer(GL_ARRAY_BUFFER, mesh.vbo);
-    glBufferData(GL_ARRAY_BUFFER, sizeof(verts), verts, GL_STATIC_DRAW);
-
-    //stride between vertexs
-    GLint stride = sizeof(float) * (floatsPerVertex + floatsPerNormal + floatsPerUV);
-
-    //create atribute pointers
-    glVertexAttribPointer(0, floatsPerVertex, GL_FLOAT, GL_FALSE, stride, 0);
-    glEnableVertexAttribArray(0);
-
-    glVertexAttribPointer(1, floatsPerNormal, GL_FLOAT, GL_FALSE, stride, (void*)(sizeof(float) * floatsPerVertex));
-    glEnableVertexAttribArray(1);
-
-    glVertexAttribPointer(2, floatsPerUV, GL_FLOAT, GL_FALSE, stride, (void*)(sizeof(float) * (floatsPerVertex + floatsPerNormal)));
-    glEnableVertexAttribArray(2);
-}
-
-//load the texture
-bool UCreateTexture(const char* filename, GLuint& textureId, int position) {
-    if (position == 0) {
-        glActiveTexture(GL_TEXTURE0);
-    }
-    else if (position == 1) {
-        glActiveTexture(GL_TEXTURE1);
-    }
-    else if (position == 2) {
-        glActiveTexture(GL_TEXTURE2);
-    }
-    else if (position == 3) {
-        glActiveTexture(GL_TEXTURE3);
-    }
-    else if (position == 4) {
-        glActiveTexture(GL_TEXTURE4);
-    }
-    else if (position == 5) {
-        glActiveTexture(GL_TEXTURE5);
-    }
-    else if (position == 6) {
-        glActiveTexture(GL_TEXTURE6);
-    }
-
-    glGenTextures(1, &textureId);
-    glBindTexture(GL_TEXTURE_2D, textureId);
-
-    //set tex wrapping param
-    glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_WRAP_S, GL_REPEAT);
-    glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_WRAP_T, GL_REPEAT);
-
-    //set tex filtering param
-    glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MIN_FILTER, GL_LINEAR);
-    glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MAG_FILTER, GL_LINEAR);
-
-    //load image, create tex, and generate mipmaps
-    int width, height, channels;
-    stbi_set_flip_vertically_on_load(true);
-    unsigned char* image = stbi_load(filename, &width, &height, &channels, 0);
-    if (image) {
-        glTexImage2D(GL_TEXTURE_2D, 0, GL_RGB, width, height, 0, GL_RGB, GL_UNSIGNED_BYTE, image);
-        glGenerateMipmap(GL_TEXTURE_2D);
-
-        stbi_image_free(image);
-
-        //unbinds the texture
-        glBindTexture(GL_TEXTURE_2D, position);
-
-        return true;
-    }
-    else {
-        return false;
-    }
-}
-
-//destroys texture 
-void UDestroyTexture(GLuint textureId) {
-    glGenTextures(1, &textureId);
-}
-
-
-void UDestroyMesh(GLMesh& mesh) {
-    glDeleteVertexArrays(1, &mesh.vao);
-    glDeleteBuffers(1, &mesh.vbo);
-}
-
-//implements the UCreateShaders function
-bool UCreateShaderProgram(const char* vtxShaderSource, const char* fragShaderSource, GLuint& programId)
-{
-    //compilation and error reporting
-    int success = 0;
-    char infoLog[512];
-
-    //creates shader object.
-    programId = glCreateProgram();
-
-    //create the vertex and shader objects
-    GLuint vertexShaderId = glCreateShader(GL_VERTEX_SHADER);
-    GLuint fragmentShaderId = glCreateShader(GL_FRAGMENT_SHADER);
-
-    //retrive shader source
-    glShaderSource(vertexShaderId, 1, &vtxShaderSource, NULL);
-    glShaderSource(fragmentShaderId, 1, &fragShaderSource, NULL);
-
-    //compile vertex shader and print compilation errors 
-    glCompileShader(vertexShaderId);
-    glGetShaderiv(vertexShaderId, GL_COMPILE_STATUS, &success);
-    if (!success)
-    {
-        glGetShaderInfoLog(vertexShaderId, 512, NULL, infoLog);
-        std::cout << "ERROR::SHADER::VERTEX::COMPILATION_FAILED\n" << infoLog << std::endl;
-        return false;
-    }
-
-    glCompileShader(fragmentShaderId);
-
-    glGetShaderiv(fragmentShaderId, GL_COMPILE_STATUS, &success);
-    if (!success)
-    {
-        glGetShaderInfoLog(fragmentShaderId, sizeof(infoLog), NULL, infoLog);
-        std::cout << "ERROR::SHADER::FRAGMENT::COMPILATION_FAILED\n" << infoLog << std::endl;
-        return false;
-    }
-
-    //attached compiled shaders to the shader program
-    glAttachShader(programId, vertexShaderId);
-    glAttachShader(programId, fragmentShaderId);
-
-    glLinkProgram(programId);
-    //check for linking errors
-    glGetProgramiv(programId, GL_LINK_STATUS, &success);
-    if (!success)
-    {
-        glGetProgramInfoLog(programId, sizeof(infoLog), NULL, infoLog);
-        std::cout << "ERROR::SHADER::PROGRAM::LINKING_FAILED\n" << infoLog << std::endl;
-        return false;
-    }
-
-
-    glUseProgram(programId);
-
-    return true;
-}
-
-
-void UDestroyShaderProgram(GLuint programId)
-{
-    glDeleteProgram(programId);
-}
\ No newline at end of file
+#include <GL/glew.h>
+#include <GLFW/glfw3.h>
+#include <iostream>
+#include <cstdlib>
+#include <cmath>
+#include <cstring>
+#include <cctype>
+#include <map>
+#include <sstream>
+#include <string>
+#include <vector>
+
+#include <glm/glm.hpp>
+#include <glm/gtx/transform.hpp>
+#include <glm/gtc/type_ptr.hpp>
+
+#include "camera.h"
+#include "camerapath.h"
+#include "jobsystem.h"
+#include "transforms.h"
+#include "framepacing.h"
+#include "ringbuffer.h"
+#include "bvh.h"
+#include "softrender.h"
+#include "input.h"
+#include "profiler.h"
+#include "glstate.h"
+#include "renderqueue.h"
+#include "antialiasing.h"
+#include "dynamicresolution.h"
+#include "meshes.h"
+#include "image.h"
+#include "vertexformat.h"
+#include "meshoptimize.h"
+#include "gpuculling.h"
+#include "occlusion.h"
+#include "capture.h"
+#include "imagecompare.h"
+#include "ibl.h"
+
+//the implementations go after every header that includes stb_image.h or stb_image_write.h, a second
+//include with them defined would repeat them
+#define STB_IMAGE_IMPLEMENTATION
+#include <stb_image.h>      // Image loading Utility functions
+#define STB_IMAGE_WRITE_IMPLEMENTATION
+#include <stb_image_write.h>
+
+
+
+using namespace std;
+
+//generated data kept between runs, the CMake build points it at the build folder
+#ifndef FP_CACHE_DIR
+#define FP_CACHE_DIR "."
+#endif
+
+/*shader macro*/
+#ifndef GLSL
+#define GLSL(Version, Source) "#version " #Version " core \n" #Source
+#endif
+
+//unnamed namespace
+namespace
+{
+    const char* const WINDOW_TITLE = "Final Project"; // Macro for window title
+
+    //vars for window width and height
+    const int WINDOW_WIDTH = 1600;
+    const int WINDOW_HEIGHT = 900;
+
+    //stores GL data relative to a mesh
+    struct GLMesh
+    {
+        GLuint vao;         // Handle for the vertex array object
+        GLuint vbo;         // Handle for the vertex buffer object
+        GLuint ebo;         // Handle for the index buffer object
+        GLuint nVertices;    // Number of distinct vertices of the mesh
+        GLuint nIndices;     // Number of indices of the mesh
+        glm::vec3 boundsMin; // Local space bounding box, used for culling
+        glm::vec3 boundsMax;
+        std::vector<glm::vec3> positions; // Local space triangle corners kept on the CPU for picking
+        std::vector<GLfloat> vertices;    // Interleaved copy of the buffer for the software renderer, float format
+        std::vector<PackedVertex> packedVertices; // Same for the packed format
+        glm::vec3 positionOffset;   // Turns stored positions back into local space, offset + stored * scale
+        glm::vec3 positionScale;
+        std::vector<GLuint> indices;      // Copy of the index buffer for the software renderer
+        std::vector<Meshlet> meshlets;    // Runs of the index buffer with culling bounds
+    };
+
+    //main GLFW window
+    GLFWwindow* gWindow = nullptr;
+
+    //triangle mesh data
+    GLMesh gMeshKnifeBlade;
+    GLMesh gMeshKnifeHandle;
+    GLMesh gLightMesh;
+    GLMesh gPlaneMesh;
+    GLMesh gCuttingBoardMesh;
+    GLMesh gCheeseMesh;
+    GLMesh gSalamiBodyMesh;
+    GLMesh gSalamiEndsMesh;
+
+    //texture
+    GLuint gHandleTexture;
+    GLuint gBladeTexture;
+    GLuint gCuttingBoardTexture;
+    GLuint gCounterTexture;
+    GLuint gCheeseTexture;
+    GLuint gSalamiBodyTexture;
+    GLuint gSalamiEndsTexture;
+    glm::vec2 gUVScale(1.0f, 1.0f);
+
+    // Shader programs
+    GLuint gProgramId;
+    GLuint gLampProgramId;
+    GLuint gFxaaProgramId;
+    GLuint gTaaProgramId;
+    GLuint gIndirectProgramId;          // gProgramId and gLampProgramId reading their object from a storage buffer
+    GLuint gLampIndirectProgramId;
+    GLuint gCullProgramId;
+    GLuint gDepthPyramidProgramId;
+    GLuint gOcclusionProgramId;
+
+    //camera
+    Camera gCamera(glm::vec3(0.0f, 0.0f, 7.0f));
+    Camera gPreviousCamera = gCamera;   // state before the latest simulation step
+    Camera gRenderCamera = gCamera;     // blend of the two that the frame is drawn from
+
+    //window events queued by the callbacks and read back once per simulation step
+    InputSystem gInput;
+
+    //viewpoints on keys 1-4, shift + key saves the current one and key alone flies back to it
+    const int VIEWPOINT_COUNT = 4;
+    const float VIEWPOINT_TRANSITION_TIME = 1.0f; // seconds
+    CameraViewpoint gViewpoints[VIEWPOINT_COUNT];
+    bool gViewpointSaved[VIEWPOINT_COUNT] = {};
+
+    //timing
+    float gDeltaTime = 0.0f; // time covered by the current simulation step
+    double gLastFrame = 0.0;
+    double gAccumulator = 0.0; // frame time not yet simulated
+
+    //the scene updates at a fixed rate no matter how fast frames are drawn
+    const double SIMULATION_STEP = 1.0 / 120.0;
+    const int MAX_SIMULATION_STEPS = 8; // per frame, past this the sim slows down instead of spiralling
+
+    //how far the frame is between the previous and the latest simulation step
+    float gInterpolation = 1.0f;
+
+    //simulated seconds since the loop started, the clock camera paths are recorded and played on
+    double gSimulationTime = 0.0;
+
+    //camera path recording and playback, set from the command line
+    CameraPath gCameraPath;
+    const char* gRecordPathFile = nullptr;
+    const char* gPlayPathFile = nullptr;
+    double gPlaybackFrameStep = 0.0;    // path seconds per frame for repeatable renders, 0 to follow the clock
+    unsigned long long gFrameCount = 0;     // frames drawn since the loop started
+    unsigned long long gFrameLimit = 0;     // exit after this many frames, 0 to run until closed
+    double gLoopStart = 0.0;
+
+    //swap interval and frame rate cap, set from the command line
+    FramePacer gPacer;
+
+    //cube and light color
+    glm::vec3 gObjectColor(1.f, 0.2f, 0.0f);
+    glm::vec3 gLightColor(1.0f, 1.0f, 1.0f);
+
+    //light position and scale
+    glm::vec3 gLightPosition(4.0f, 8.5f, -3.0f);
+    glm::vec3 gLightScale(0.5f);
+
+    //physically based shading lit by the lamp and precomputed environment lighting, --shading phong
+    //goes back to the original model. the tables are built once and then loaded from the cache file
+    bool gPbrShading = true;
+    GLuint gIrradianceTexture = 0;
+    GLuint gSpecularTexture = 0;
+    GLuint gBrdfTexture = 0;
+    const char* ENVIRONMENT_CACHE_FILE = FP_CACHE_DIR "/environment.ibl";
+    const int IRRADIANCE_TEXTURE_UNIT = 8;  // above the scene textures, bound once and never touched again
+    const int SPECULAR_TEXTURE_UNIT = 9;
+    const int BRDF_TEXTURE_UNIT = 10;
+
+    //metallic and roughness of what the scene is made of
+    const PbrMaterial MATERIAL_STEEL = { 1.0f, 0.25f };
+    const PbrMaterial MATERIAL_WOOD = { 0.0f, 0.65f };
+    const PbrMaterial MATERIAL_STONE = { 0.0f, 0.5f };
+    const PbrMaterial MATERIAL_FOOD = { 0.0f, 0.45f };
+    const PbrMaterial MATERIAL_NONE = { 0.0f, 1.0f };   // the lamp, which isn't lit
+
+    //bool to track to see if using perspective mode
+    bool perspectiveMode = true;
+
+    //one draw in the scene
+    struct SceneObject
+    {
+        const char* name;
+        GLMesh* mesh;
+        GLuint program;
+        GLuint texture;         // 0 when the program doesn't sample a texture
+        size_t transform;       // Index into gTransforms, objects that move together share one
+        bool occluder;          // Large enough to hide others, always drawn and never occlusion tested
+        PbrMaterial material;   // Read by the PBR shader, Phong ignores it
+
+        bool visible;           // Written by the cull stage each frame
+        uint64_t stateKey;      // Sort key without the depth, built once the scene is laid out
+    };
+
+    //everything drawn by URender, in draw order
+    std::vector<SceneObject> gScene;
+
+    //copies of scene objects that never move, laid out on a grid around the scene to load the culling.
+    //they're outside gTransforms and the picking BVH, render queue items past gScene index them
+    struct StaticObject
+    {
+        size_t object;          // Index into gScene of what it's a copy of
+        glm::mat4 model;
+        bool visible;           // Written by the cull stage each frame
+    };
+    std::vector<StaticObject> gStaticObjects;
+    size_t gExtraObjects = 0;               // set from the command line
+    const float EXTRA_OBJECT_SPACING = 12.0f;
+
+    //object transforms and the matrices built from them each frame, indexed by SceneObject::transform.
+    //the simulation writes gTransforms, the renderer draws a blend of it and the previous step
+    TransformSoA gTransforms;
+    TransformSoA gPreviousTransforms;
+    TransformSoA gRenderTransforms;
+    std::vector<glm::mat4> gModels;
+    std::vector<glm::mat4> gModelViewProjections;
+
+    //worker threads and the per frame CPU stages that run on them
+    JobSystem gJobs;
+    FrameGraph gFrameGraph;
+
+    //camera matrices for the frame being built
+    glm::mat4 gView;
+    glm::mat4 gProjection;
+
+    //world space triangles of the scene for picking and spatial queries, object ids are gScene indices
+    Bvh gSceneBvh;
+
+    //draws on the CPU instead of the GPU, the finished image is blitted to the window
+    bool gSoftwareRendering = false;
+    bool gValidateSoftware = false;     // render one frame both ways, compare and exit
+    SoftRenderer gSoftRenderer;
+    std::map<GLuint, SoftTexture> gSoftTextures;    // CPU copies of the loaded textures by GL id
+    GLuint gSoftwareTarget = 0;                     // texture the software image is uploaded to
+    GLuint gSoftwareFramebuffer = 0;
+
+    //objects per job for the per object loops, small enough to spread a 100k object scene over 64 cores
+    const size_t OBJECTS_PER_JOB = 256;
+
+    //size of the light array in the shaders' FrameData block
+    const int MAX_LIGHTS = 8;
+
+    //std140 layout of the FrameData uniform block, shared by every draw in a frame
+    struct LightUniforms
+    {
+        glm::vec4 position;
+        glm::vec4 color;
+    };
+
+    struct FrameUniforms
+    {
+        glm::mat4 view;
+        glm::mat4 projection;
+        glm::vec4 viewPosition;
+        GLint lightCount;
+        GLint padding[3];
+        LightUniforms lights[MAX_LIGHTS];
+    };
+
+    //std140 layout of the DrawData uniform block, one per draw
+    struct DrawUniforms
+    {
+        glm::mat4 model;
+        glm::vec4 positionOffset;
+        glm::vec4 positionScale;
+        glm::vec4 material;         // metallic, roughness
+    };
+
+    //uniform block binding points
+    const GLuint FRAME_DATA_BINDING = 0;
+    const GLuint DRAW_DATA_BINDING = 1;
+
+    //per frame uniform, instance and light data is written straight into this mapped buffer
+    RingBuffer gUploadRing;
+    const size_t UPLOAD_BYTES_PER_FRAME = 1024 * 1024; // the least a frame gets, a few thousand draws at 256 byte offset alignment
+
+    //visible draws for the frame in sort key order, and the state switches walking it took
+    RenderQueue gRenderQueue;
+    RenderQueueStats gQueueStats = {};
+    RenderQueueStats gQueueTotals = {};     // summed over the run for the averages printed on exit
+    const float SORT_DEPTH_RANGE = 100.0f;  // distance mapped to the deepest sort key, the far plane
+
+    //textures are flipped and expanded on the CPU at load, the mip levels too when a filter is chosen
+    bool gMipFilterOnCpu = false;           // false leaves them to glGenerateMipmap
+    MipFilter gMipFilter = MIP_FILTER_BOX;
+    double gTextureImportTime = 0.0;        // seconds spent decoding, converting and uploading
+
+    //meshes are uploaded as 16 byte packed vertices unless --vertex-format float asks for 32 byte ones
+    bool gPackedVertices = true;
+    size_t gVertexBytes = 0;                // what went into vertex buffers
+    size_t gFloatVertexBytes = 0;           // what the same meshes take as floats
+    float gMaxPositionError = 0.0f;         // worst quantization over every mesh
+    float gMaxNormalError = 0.0f;
+
+    //what mesh optimization did, summed over every mesh for the startup report
+    size_t gSourceVertices = 0;             // vertices as the meshes were written, three to a triangle
+    VertexCacheStats gCacheBefore;          // welded, in the written triangle order
+    VertexCacheStats gCacheAfter;
+    size_t gMeshletCount = 0;
+
+    //offscreen targets and resolve passes for the selected anti-aliasing mode, GL path only
+    AntiAliasing gAntiAliasing;
+
+    //--culling gpu moves culling and draw submission onto the GPU, the CPU only issues one draw per batch
+    bool gGpuCulling = false;
+    GpuCulling gGpuCuller;
+
+    //objects hidden behind the occluders last frame are drawn conditionally on their box's query, CPU culling only
+    OcclusionCulling gOcclusion;
+    size_t gFrustumCulled = 0;              // objects the cull stage dropped this frame
+
+    //scale the scene is drawn at relative to the window, adjusted each frame to fit the frame budget
+    DynamicResolution gDynamicResolution;
+    float gRenderScale = 1.0f;              // fixed scale, or the starting one with a budget
+    double gFrameWorkStart = 0.0;           // when this frame's work began, after any pacing wait
+
+    //every GL state change in the render loop goes through this, so repeats of the current state are dropped
+    GLStateCache gGLState;
+
+    //golden image test, draws fixed views and compares them with reference images in a folder
+    struct GoldenView
+    {
+        const char* name;       // reference file is <name>.png
+        glm::vec3 position;
+        float yaw;
+        float pitch;
+    };
+    const GoldenView GOLDEN_VIEWS[] = {
+        { "front", glm::vec3(0.0f, 0.0f, 7.0f), -90.0f, 0.0f },         // the starting view
+        { "above", glm::vec3(0.0f, 9.0f, 3.0f), -90.0f, -70.0f },
+        { "knife", glm::vec3(5.5f, 2.5f, 1.5f), -130.0f, -26.0f },
+        { "salami", glm::vec3(1.5f, 2.5f, 4.0f), -87.0f, -13.0f },
+        { "cheese", glm::vec3(-6.0f, 1.2f, 5.0f), -29.0f, 0.0f }
+    };
+    const char* gGoldenFolder = nullptr;
+    bool gGoldenUpdate = false;             // write the references instead of comparing
+    double gGoldenThreshold = 0.98;         // lowest mean SSIM that passes
+    double gGoldenWorstThreshold = 0.9;     // lowest mean SSIM of any block, a small wrong patch barely moves the whole image
+    const char* GOLDEN_OUTPUT_PREFIX = FP_CACHE_DIR "/golden_";
+
+    //frames read back and written out while running, set from the command line
+    FrameCapture gCapture;
+    const char* gCaptureFile = nullptr;
+    const int CAPTURE_FRAME_RATE = 60;      // frame rate written to Y4M streams when the path isn't played at a fixed step
+
+    //profiler output, set from the command line
+    bool gProfileOverlay = false;           // rolling timings in the window title
+    const char* gTraceFile = nullptr;       // chrome trace written on exit
+    const double PROFILE_OVERLAY_INTERVAL = 0.5; // seconds between title updates
+
+}
+
+//function prototypes
+bool UInitialize(int, char* [], GLFWwindow** window);
+void UParseArguments(int argc, char* argv[]);
+void UResizeWindow(GLFWwindow* window, int width, int height);
+void UBindDefaultKeys();
+void UProcessInput(GLFWwindow* window);
+void USimulate(float step);
+void UKeyCallback(GLFWwindow* window, int key, int scancode, int action, int mods);
+void UMousePositionCallback(GLFWwindow* window, double xpos, double ypos);
+void UMouseScrollCallback(GLFWwindow* window, double xoffset, double yoffset);
+void UMouseButtonCallback(GLFWwindow* window, int button, int action, int mods);
+void UPickObject(double xpos, double ypos);
+void UShowProfile();
+void UCreateKnifeBladeMesh(GLMesh& mesh);
+void UCreateKnifeHandleMesh(GLMesh& mesh);
+void UCreateCubeMesh(GLMesh& mesh);
+void UCreateCheeseMesh(GLMesh& mesh);
+void UCreatePlaneMesh(GLMesh& mesh);
+void UCreateCuttingBoardMesh(GLMesh& mesh);
+void UCreateSalamiBodyMesh(GLMesh& mesh);
+void UCreateSalamiEndsMesh(GLMesh& mesh);
+void UDestroyMesh(GLMesh& mesh);
+void UCreateMeshBuffers(GLMesh& mesh, const GLfloat* verts, size_t vertsSize);
+void UCreateScene();
+void UCreateFrameGraph();
+void UCreateGpuCulling();
+bool UGpuDriven();
+bool UPbrShading();
+void UCreateEnvironmentLighting();
+const SceneObject& UItemObject(uint32_t item);
+const glm::mat4& UItemModel(uint32_t item);
+bool UIsInFrustum(const glm::mat4& modelViewProjection, const GLMesh& mesh);
+bool UCreateTexture(const char* filename, GLuint& textureId, int location);
+void UDestroyTexture(GLuint textureId);
+void URender();
+void URenderGL();
+void URenderSoftware();
+void UPresentSoftware();
+bool UValidateSoftwareRenderer();
+bool URunGoldenTest();
+bool UCreateShaderProgram(const char* vtxShaderSource, const char* fragShaderSource, GLuint& programId);
+bool UCreateComputeProgram(const char* shaderSource, GLuint& programId);
+void UDestroyShaderProgram(GLuint programId);
+
+
+/* Cube Vertex Shader Source Code*/
+const GLchar* cubeVertexShaderSource = GLSL(440,
+
+    layout(location = 0) in vec3 position; // VAP position 0 for vertex position data
+layout(location = 1) in vec3 normal; // VAP position 1 for normals
+layout(location = 2) in vec2 textureCoordinate;
+
+out vec3 vertexNormal; // For outgoing normals to fragment shader
+out vec3 vertexFragmentPos; // For outgoing color / pixels to fragment shader
+out vec2 vertexTextureCoordinate;
+flat out vec4 vertexMaterial;
+
+//Per frame and per draw data, read from the upload ring buffer
+struct Light
+{
+    vec4 position;
+    vec4 color;
+};
+
+layout(std140, binding = 0) uniform FrameData
+{
+    mat4 view;
+    mat4 projection;
+    vec4 viewPosition;
+    int lightCount;
+    Light lights[8];
+};
+
+layout(std140, binding = 1) uniform DrawData
+{
+    mat4 model;
+    vec4 positionOffset; // Packed positions arrive as 0..1 within the mesh bounds, float ones with offset 0 and scale 1
+    vec4 positionScale;
+    vec4 material; // Metallic and roughness, for the PBR fragment shader
+};
+
+void main()
+{
+    vec4 localPosition = vec4(positionOffset.xyz + position * positionScale.xyz, 1.0f);
+
+    gl_Position = projection * view * model * localPosition; // Transforms vertices into clip coordinates
+
+    vertexFragmentPos = vec3(model * localPosition); // Gets fragment / pixel position in world space only (exclude view and projection)
+
+    vertexNormal = mat3(transpose(inverse(model))) * normal; // get normal vectors in world space only and exclude normal translation properties
+    vertexTextureCoordinate = textureCoordinate;
+    vertexMaterial = material;
+}
+);
+
+
+/* Cube Fragment Shader Source Code*/
+const GLchar* cubeFragmentShaderSource = GLSL(440,
+
+    in vec3 vertexNormal; // For incoming normals
+in vec3 vertexFragmentPos; // For incoming fragment position
+in vec2 vertexTextureCoordinate;
+
+out vec4 fragmentColor; // For outgoing cube color to the GPU
+
+// Uniform / Global variables for object color and texture
+uniform vec3 objectColor;
+uniform sampler2D uTexture; // Useful when working with multiple textures
+uniform vec2 uvScale;
+
+// Camera position and light list, shared with the vertex shader
+struct Light
+{
+    vec4 position;
+    vec4 color;
+};
+
+layout(std140, binding = 0) uniform FrameData
+{
+    mat4 view;
+    mat4 projection;
+    vec4 viewPosition;
+    int lightCount;
+    Light lights[8];
+};
+
+void main()
+{
+    /*Phong lighting model calculations to generate ambient, diffuse, and specular components*/
+    vec3 norm = normalize(vertexNormal); // Normalize vectors to 1 unit
+    vec3 viewDir = normalize(viewPosition.xyz - vertexFragmentPos); // Calculate view direction
+    float ambientStrength = 0.1f; // Set ambient or global lighting strength
+    float specularIntensity = 0.8f; // Set specular light strength
+    float highlightSize = 16.0f; // Set specular highlight size
+
+    vec3 lighting = vec3(0.0f);
+    for (int i = 0; i < lightCount; ++i) {
+        vec3 lightColor = lights[i].color.rgb;
+
+        //Calculate Ambient lighting*/
+        vec3 ambient = ambientStrength * lightColor; // Generate ambient light color
+
+        //Calculate Diffuse lighting*/
+        vec3 lightDirection = normalize(lights[i].position.xyz - vertexFragmentPos); // Calculate distance (light direction) between light source and fragments/pixels on cube
+        float impact = max(dot(norm, lightDirection), 0.0);// Calculate diffuse impact by generating dot product of normal and light
+        vec3 diffuse = impact * lightColor; // Generate diffuse light color
+
+        //Calculate Specular lighting*/
+        vec3 reflectDir = reflect(-lightDirection, norm);// Calculate reflection vector
+        float specularComponent = pow(max(dot(viewDir, reflectDir), 0.0), highlightSize);
+        vec3 specular = specularIntensity * specularComponent * lightColor;
+
+        lighting += ambient + diffuse + specular;
+    }
+
+    // Texture holds the color to be used for all three components
+    vec4 textureColor = texture(uTexture, vertexTextureCoordinate * uvScale);
+
+    // Calculate phong result
+    vec3 phong = lighting * textureColor.xyz;
+
+    fragmentColor = vec4(phong, 1.0); // Send lighting results to GPU
+}
+);
+
+
+/* PBR Fragment Shader Source Code, metallic roughness Cook-Torrance lit by the lamp and the precomputed environment*/
+const GLchar* pbrFragmentShaderSource = GLSL(440,
+
+    in vec3 vertexNormal; // For incoming normals
+in vec3 vertexFragmentPos; // For incoming fragment position
+in vec2 vertexTextureCoordinate;
+flat in vec4 vertexMaterial; // Metallic and roughness
+
+out vec4 fragmentColor; // For outgoing cube color to the GPU
+
+uniform sampler2D uTexture; // Albedo
+uniform vec2 uvScale;
+uniform samplerCube irradianceMap; // Cosine weighted environment, irradiance over pi
+uniform samplerCube specularMap; // Environment prefiltered with GGX, roughness across the mip levels
+uniform sampler2D brdfLut; // Scale and bias to F0 by NdotV and roughness
+uniform float specularLevels; // Highest mip level of specularMap
+
+// Camera position and light list, shared with the vertex shader
+struct Light
+{
+    vec4 position;
+    vec4 color;
+};
+
+layout(std140, binding = 0) uniform FrameData
+{
+    mat4 view;
+    mat4 projection;
+    vec4 viewPosition;
+    int lightCount;
+    Light lights[8];
+};
+
+const float PI = 3.14159265f;
+
+//GGX normal distribution
+float distributionGgx(float NdotH, float roughness)
+{
+    float alpha = roughness * roughness;
+    float alpha2 = alpha * alpha;
+    float denominator = NdotH * NdotH * (alpha2 - 1.0f) + 1.0f;
+    return alpha2 / (PI * denominator * denominator);
+}
+
+//Smith shadowing and masking with Schlick-GGX, k for direct lights
+float geometrySmith(float NdotV, float NdotL, float roughness)
+{
+    float k = (roughness + 1.0f) * (roughness + 1.0f) / 8.0f;
+    return (NdotV / (NdotV * (1.0f - k) + k)) * (NdotL / (NdotL * (1.0f - k) + k));
+}
+
+vec3 fresnelSchlick(float cosTheta, vec3 F0)
+{
+    return F0 + (1.0f - F0) * pow(1.0f - cosTheta, 5.0f);
+}
+
+//rough surfaces reflect less at grazing angles than a mirror does, used for the environment
+vec3 fresnelSchlickRoughness(float cosTheta, vec3 F0, float roughness)
+{
+    return F0 + (max(vec3(1.0f - roughness), F0) - F0) * pow(1.0f - cosTheta, 5.0f);
+}
+
+//ACES filmic curve fit, keeps highlights from clipping to flat white
+vec3 toneMap(vec3 color)
+{
+    return clamp((color * (2.51f * color + 0.03f)) / (color * (2.43f * color + 0.59f) + 0.14f), 0.0f, 1.0f);
+}
+
+void main()
+{
+    vec3 albedo = pow(texture(uTexture, vertexTextureCoordinate * uvScale).rgb, vec3(2.2f)); // Textures are sRGB, lighting is linear
+    float metallic = vertexMaterial.x;
+    float roughness = max(vertexMaterial.y, 0.04f); // A perfect mirror's highlight is too small to sample
+
+    vec3 N = normalize(vertexNormal);
+    vec3 V = normalize(viewPosition.xyz - vertexFragmentPos);
+    float NdotV = max(dot(N, V), 1.0e-4f);
+    vec3 F0 = mix(vec3(0.04f), albedo, metallic); // Dielectrics reflect about 4%, metals tint by their color
+
+    //direct light, scaled by pi so a white surface facing the lamp is as bright as with Phong
+    vec3 lighting = vec3(0.0f);
+    for (int i = 0; i < lightCount; ++i) {
+        vec3 L = normalize(lights[i].position.xyz - vertexFragmentPos);
+        vec3 H = normalize(V + L);
+        float NdotL = max(dot(N, L), 0.0f);
+        vec3 radiance = lights[i].color.rgb * PI;
+
+        vec3 F = fresnelSchlick(max(dot(H, V), 0.0f), F0);
+        vec3 specular = distributionGgx(max(dot(N, H), 0.0f), roughness) * geometrySmith(NdotV, NdotL, roughness) * F
+            / (4.0f * NdotV * max(NdotL, 1.0e-4f));
+        vec3 kD = (1.0f - F) * (1.0f - metallic);
+        lighting += (kD * albedo / PI + specular) * radiance * NdotL;
+    }
+
+    //environment by the split sum approximation, the prefiltered radiance times the integrated BRDF
+    vec3 F = fresnelSchlickRoughness(NdotV, F0, roughness);
+    vec3 kD = (1.0f - F) * (1.0f - metallic);
+    vec3 diffuse = texture(irradianceMap, N).rgb * albedo;
+    vec3 prefiltered = textureLod(specularMap, reflect(-V, N), roughness * specularLevels).rgb;
+    vec2 brdf = texture(brdfLut, vec2(NdotV, roughness)).rg;
+    vec3 ambient = kD * diffuse + prefiltered * (F * brdf.x + brdf.y);
+
+    fragmentColor = vec4(pow(toneMap(lighting + ambient), vec3(1.0f / 2.2f)), 1.0); // Send lighting results to GPU
+}
+);
+
+
+/* Lamp Shader Source Code*/
+const GLchar* lampVertexShaderSource = GLSL(440,
+
+    layout(location = 0) in vec3 position; // VAP position 0 for vertex position data
+
+        //Per frame and per draw data, read from the upload ring buffer
+struct Light
+{
+    vec4 position;
+    vec4 color;
+};
+
+layout(std140, binding = 0) uniform FrameData
+{
+    mat4 view;
+    mat4 projection;
+    vec4 viewPosition;
+    int lightCount;
+    Light lights[8];
+};
+
+layout(std140, binding = 1) uniform DrawData
+{
+    mat4 model;
+    vec4 positionOffset;
+    vec4 positionScale;
+    vec4 material;
+};
+
+void main()
+{
+    gl_Position = projection * view * model * vec4(positionOffset.xyz + position * positionScale.xyz, 1.0f); // Transforms vertices into clip coordinates
+}
+);
+
+
+/* Fragment Shader Source Code*/
+const GLchar* lampFragmentShaderSource = GLSL(440,
+
+    out vec4 fragmentColor; // For outgoing lamp color (smaller cube) to the GPU
+
+void main()
+{
+    fragmentColor = vec4(1.0f); // Set color to white (1.0f,1.0f,1.0f) with alpha 1.0
+}
+);
+
+
+/* Occlusion Box Vertex Shader Source Code, bounding box proxies for the occlusion queries*/
+const GLchar* occlusionVertexShaderSource = GLSL(440,
+
+    layout(location = 0) in vec3 position; // Corner of the -1..1 cube
+
+uniform mat4 boxTransform; // Cube to the object's bounds, then to clip space
+
+void main()
+{
+    gl_Position = boxTransform * vec4(position, 1.0f);
+}
+);
+
+
+/* Occlusion Box Fragment Shader Source Code, only depth is tested and nothing is written*/
+const GLchar* occlusionFragmentShaderSource = GLSL(440,
+
+void main()
+{
+}
+);
+
+
+/* Indirect Cube Vertex Shader Source Code, the cube shader for GPU culled draws*/
+const GLchar* cubeIndirectVertexShaderSource = GLSL(440,
+
+    layout(location = 0) in vec3 position; // VAP position 0 for vertex position data
+layout(location = 1) in vec3 normal; // VAP position 1 for normals
+layout(location = 2) in vec2 textureCoordinate;
+layout(location = 3) in uint objectIndex; // Instanced, the draw command's base instance
+
+out vec3 vertexNormal; // For outgoing normals to fragment shader
+out vec3 vertexFragmentPos; // For outgoing color / pixels to fragment shader
+out vec2 vertexTextureCoordinate;
+flat out vec4 vertexMaterial;
+
+//Per frame data from the upload ring buffer, per object data from the culling pass's object buffer
+struct Light
+{
+    vec4 position;
+    vec4 color;
+};
+
+layout(std140, binding = 0) uniform FrameData
+{
+    mat4 view;
+    mat4 projection;
+    vec4 viewPosition;
+    int lightCount;
+    Light lights[8];
+};
+
+struct ObjectData
+{
+    mat4 model;
+    vec4 positionOffset;
+    vec4 positionScale;
+    vec4 boundsCenter;
+    vec4 boundsExtent;
+    uint batch;
+    uint firstIndex;
+    uint indexCount;
+    uint slot;
+    vec4 material;
+};
+
+layout(std430, binding = 0) readonly buffer Objects
+{
+    ObjectData objects[];
+};
+
+void main()
+{
+    mat4 model = objects[objectIndex].model;
+    vec4 localPosition = vec4(objects[objectIndex].positionOffset.xyz + position * objects[objectIndex].positionScale.xyz, 1.0f);
+
+    gl_Position = projection * view * model * localPosition; // Transforms vertices into clip coordinates
+
+    vertexFragmentPos = vec3(model * localPosition); // Gets fragment / pixel position in world space only (exclude view and projection)
+
+    vertexNormal = mat3(transpose(inverse(model))) * normal; // get normal vectors in world space only and exclude normal translation properties
+    vertexTextureCoordinate = textureCoordinate;
+    vertexMaterial = objects[objectIndex].material;
+}
+);
+
+
+/* Indirect Lamp Vertex Shader Source Code*/
+const GLchar* lampIndirectVertexShaderSource = GLSL(440,
+
+    layout(location = 0) in vec3 position; // VAP position 0 for vertex position data
+layout(location = 3) in uint objectIndex; // Instanced, the draw command's base instance
+
+struct Light
+{
+    vec4 position;
+    vec4 color;
+};
+
+layout(std140, binding = 0) uniform FrameData
+{
+    mat4 view;
+    mat4 projection;
+    vec4 viewPosition;
+    int lightCount;
+    Light lights[8];
+};
+
+struct ObjectData
+{
+    mat4 model;
+    vec4 positionOffset;
+    vec4 positionScale;
+    vec4 boundsCenter;
+    vec4 boundsExtent;
+    uint batch;
+    uint firstIndex;
+    uint indexCount;
+    uint slot;
+    vec4 material;
+};
+
+layout(std430, binding = 0) readonly buffer Objects
+{
+    ObjectData objects[];
+};
+
+void main()
+{
+    vec3 localPosition = objects[objectIndex].positionOffset.xyz + position * objects[objectIndex].positionScale.xyz;
+    gl_Position = projection * view * objects[objectIndex].model * vec4(localPosition, 1.0f); // Transforms vertices into clip coordinates
+}
+);
+
+
+/* Culling Compute Shader Source Code, one thread per object writes its indirect draw*/
+const GLchar* cullComputeShaderSource = GLSL(440,
+
+    layout(local_size_x = 64) in;
+
+struct ObjectData
+{
+    mat4 model;
+    vec4 positionOffset;
+    vec4 positionScale;
+    vec4 boundsCenter;
+    vec4 boundsExtent;
+    uint batch;
+    uint firstIndex;
+    uint indexCount;
+    uint slot;
+    vec4 material;
+};
+
+struct DrawCommand
+{
+    uint count;
+    uint instanceCount;
+    uint firstIndex;
+    int baseVertex;
+    uint baseInstance;
+};
+
+layout(std430, binding = 0) readonly buffer Objects
+{
+    ObjectData objects[];
+};
+
+layout(std430, binding = 1) writeonly buffer Commands
+{
+    DrawCommand commands[];
+};
+
+layout(std430, binding = 2) buffer Counts
+{
+    uint counts[]; // draws written per batch, the draw count when compacting
+};
+
+layout(std430, binding = 3) readonly buffer Batches
+{
+    uint firstCommands[];
+};
+
+uniform mat4 viewProjection;
+uniform mat4 occlusionViewProjection; // what the depth pyramid was drawn with
+uniform int pyramidLevels; // 0 before there's a pyramid, only the frustum is tested then
+uniform uint objectCount;
+uniform bool compact;
+uniform sampler2D depthPyramid;
+
+//the box against the six frustum planes in its own space, the same test as UIsInFrustum
+bool inFrustum(mat4 modelViewProjection, vec3 center, vec3 extent)
+{
+    for (int row = 0; row < 3; ++row) {
+        for (int side = -1; side <= 1; side += 2) {
+            vec4 plane;
+            for (int column = 0; column < 4; ++column) {
+                plane[column] = modelViewProjection[column][3] + float(side) * modelViewProjection[column][row];
+            }
+            float distance = dot(plane.xyz, center) + plane.w;
+            float radius = dot(abs(plane.xyz), extent);
+            if (distance + radius < 0.0f) {
+                return false;
+            }
+        }
+    }
+    return true;
+}
+
+//true when the box's screen rectangle is behind everything the last frame drew over it. the level
+//is picked so the rectangle spans at most 2x2 texels
+bool isOccluded(mat4 modelViewProjection, vec3 center, vec3 extent)
+{
+    vec3 boxMin = vec3(1.0f);
+    vec3 boxMax = vec3(0.0f);
+    for (int i = 0; i < 8; ++i) {
+        vec3 corner = center + extent * vec3((i & 1) != 0 ? 1.0f : -1.0f, (i & 2) != 0 ? 1.0f : -1.0f, (i & 4) != 0 ? 1.0f : -1.0f);
+        vec4 clip = modelViewProjection * vec4(corner, 1.0f);
+        if (clip.w <= 0.0f) {
+            return false; // reaches behind the camera, keep it
+        }
+        vec3 window = clip.xyz / clip.w * 0.5f + 0.5f;
+        boxMin = min(boxMin, window);
+        boxMax = max(boxMax, window);
+    }
+    boxMin.xy = clamp(boxMin.xy, vec2(0.0f), vec2(1.0f));
+    boxMax.xy = clamp(boxMax.xy, vec2(0.0f), vec2(1.0f));
+
+    vec2 texels = (boxMax.xy - boxMin.xy) * vec2(textureSize(depthPyramid, 0));
+    int level = clamp(int(ceil(log2(max(max(texels.x, texels.y), 1.0f)))), 0, pyramidLevels - 1);
+    ivec2 size = textureSize(depthPyramid, level);
+    ivec2 first = min(ivec2(boxMin.xy * vec2(size)), size - 1);
+    ivec2 last = min(ivec2(boxMax.xy * vec2(size)), size - 1);
+
+    float occluderDepth = 0.0f;
+    for (int y = first.y; y <= last.y; ++y) {
+        for (int x = first.x; x <= last.x; ++x) {
+            occluderDepth = max(occluderDepth, texelFetch(depthPyramid, ivec2(x, y), level).r);
+        }
+    }
+    return boxMin.z > occluderDepth;
+}
+
+void main()
+{
+    uint index = gl_GlobalInvocationID.x;
+    if (index >= objectCount) {
+        return;
+    }
+
+    mat4 model = objects[index].model;
+    vec3 center = objects[index].boundsCenter.xyz;
+    vec3 extent = objects[index].boundsExtent.xyz;
+    bool visible = inFrustum(viewProjection * model, center, extent)
+        && (pyramidLevels == 0 || !isOccluded(occlusionViewProjection * model, center, extent));
+
+    //compacted, survivors take the next free command of their batch. otherwise every object
+    //keeps its own command and a culled one draws no instances
+    uint batch = objects[index].batch;
+    uint slot = objects[index].slot;
+    if (compact) {
+        if (!visible) {
+            return;
+        }
+        slot = atomicAdd(counts[batch], 1u);
+    }
+    commands[firstCommands[batch] + slot] = DrawCommand(objects[index].indexCount, visible ? 1u : 0u, objects[index].firstIndex, 0, index);
+}
+);
+
+
+/* Depth Pyramid Compute Shader Source Code, one level from the one above it*/
+const GLchar* depthPyramidComputeShaderSource = GLSL(440,
+
+    layout(local_size_x = 8, local_size_y = 8) in;
+
+layout(r32f, binding = 0) writeonly uniform image2D destination;
+uniform sampler2D source;
+uniform ivec2 sourceSize;
+uniform int sourceLevel;
+
+void main()
+{
+    ivec2 size = imageSize(destination);
+    ivec2 texel = ivec2(gl_GlobalInvocationID.xy);
+    if (any(greaterThanEqual(texel, size))) {
+        return;
+    }
+
+    //farthest depth of every source texel this one overlaps, three across where the source size is odd
+    ivec2 first = texel * sourceSize / size;
+    ivec2 last = min(((texel + 1) * sourceSize + size - 1) / size, sourceSize) - 1;
+    float depth = 0.0f;
+    for (int y = first.y; y <= last.y; ++y) {
+        for (int x = first.x; x <= last.x; ++x) {
+            depth = max(depth, texelFetch(source, ivec2(x, y), sourceLevel).r);
+        }
+    }
+    imageStore(destination, texel, vec4(depth));
+}
+);
+
+
+/* Fullscreen Triangle Vertex Shader Source Code, shared by the post passes*/
+const GLchar* fullscreenVertexShaderSource = GLSL(440,
+
+    out vec2 uv;
+
+void main()
+{
+    //three corners from the vertex id, the triangle covers the whole screen
+    vec2 corner = vec2((gl_VertexID << 1) & 2, gl_VertexID & 2);
+    uv = corner;
+    gl_Position = vec4(corner * 2.0f - 1.0f, 0.0f, 1.0f);
+}
+);
+
+
+/* FXAA Fragment Shader Source Code*/
+const GLchar* fxaaFragmentShaderSource = GLSL(440,
+
+    in vec2 uv;
+
+out vec4 fragmentColor;
+
+uniform sampler2D sceneColor;
+uniform vec2 texelSize;
+
+float luma(vec3 color)
+{
+    return dot(color, vec3(0.299f, 0.587f, 0.114f));
+}
+
+void main()
+{
+    vec3 center = texture(sceneColor, uv).rgb;
+    float lumaCenter = luma(center);
+    float lumaNW = luma(texture(sceneColor, uv + vec2(-1.0f, 1.0f) * texelSize).rgb);
+    float lumaNE = luma(texture(sceneColor, uv + vec2(1.0f, 1.0f) * texelSize).rgb);
+    float lumaSW = luma(texture(sceneColor, uv + vec2(-1.0f, -1.0f) * texelSize).rgb);
+    float lumaSE = luma(texture(sceneColor, uv + vec2(1.0f, -1.0f) * texelSize).rgb);
+    float lumaMin = min(lumaCenter, min(min(lumaNW, lumaNE), min(lumaSW, lumaSE)));
+    float lumaMax = max(lumaCenter, max(max(lumaNW, lumaNE), max(lumaSW, lumaSE)));
+
+    //low contrast areas are left alone
+    if (lumaMax - lumaMin < max(0.0312f, lumaMax * 0.125f)) {
+        fragmentColor = vec4(center, 1.0f);
+        return;
+    }
+
+    //blur along the edge, across the direction the brightness changes fastest
+    vec2 direction = vec2((lumaSW + lumaSE) - (lumaNW + lumaNE), (lumaNW + lumaSW) - (lumaNE + lumaSE));
+    float reduce = max((lumaNW + lumaNE + lumaSW + lumaSE) * 0.25f * 0.125f, 1.0f / 128.0f);
+    float scale = 1.0f / (min(abs(direction.x), abs(direction.y)) + reduce);
+    direction = clamp(direction * scale, vec2(-8.0f), vec2(8.0f)) * texelSize;
+
+    vec3 inner = 0.5f * (texture(sceneColor, uv + direction * (1.0f / 3.0f - 0.5f)).rgb
+        + texture(sceneColor, uv + direction * (2.0f / 3.0f - 0.5f)).rgb);
+    vec3 outer = inner * 0.5f + 0.25f * (texture(sceneColor, uv - direction * 0.5f).rgb
+        + texture(sceneColor, uv + direction * 0.5f).rgb);
+
+    //the wider blur is only used if it didn't pick up something from across another edge
+    float lumaOuter = luma(outer);
+    fragmentColor = vec4((lumaOuter < lumaMin || lumaOuter > lumaMax) ? inner : outer, 1.0f);
+}
+);
+
+
+/* TAA Fragment Shader Source Code*/
+const GLchar* taaFragmentShaderSource = GLSL(440,
+
+    in vec2 uv;
+
+out vec4 fragmentColor;
+
+uniform sampler2D sceneColor;
+uniform sampler2D sceneDepth;
+uniform sampler2D history;
+uniform mat4 reprojection; // this frame's clip space to last frame's
+uniform vec2 jitter;       // sub-pixel offset the scene was drawn with, in clip space
+uniform vec2 texelSize;
+uniform float currentWeight;
+
+void main()
+{
+    vec3 current = texture(sceneColor, uv).rgb;
+
+    //history outside the range of the neighbouring colors belongs to something that has moved away
+    vec3 neighbourMin = current;
+    vec3 neighbourMax = current;
+    for (int y = -1; y <= 1; ++y) {
+        for (int x = -1; x <= 1; ++x) {
+            vec3 neighbour = texture(sceneColor, uv + vec2(x, y) * texelSize).rgb;
+            neighbourMin = min(neighbourMin, neighbour);
+            neighbourMax = max(neighbourMax, neighbour);
+        }
+    }
+
+    //where this pixel was on screen last frame, the scene is static so only the camera moves it
+    float depth = texture(sceneDepth, uv).r;
+    vec4 previous = reprojection * vec4(uv * 2.0f - 1.0f - jitter, depth * 2.0f - 1.0f, 1.0f);
+    vec2 previousUv = previous.xy / previous.w * 0.5f + 0.5f;
+
+    float weight = currentWeight;
+    if (any(lessThan(previousUv, vec2(0.0f))) || any(greaterThan(previousUv, vec2(1.0f)))) {
+        weight = 1.0f;
+    }
+    vec3 previousColor = clamp(texture(history, previousUv).rgb, neighbourMin, neighbourMax);
+    fragmentColor = vec4(mix(previousColor, current, weight), 1.0f);
+}
+);
+
+
+
+int main(int argc, char* argv[])
+{
+    if (!UInitialize(argc, argv, &gWindow))
+        return EXIT_FAILURE;
+
+    //create the meshes
+    UCreateKnifeHandleMesh(gMeshKnifeHandle);
+    UCreateKnifeBladeMesh(gMeshKnifeBlade);
+    UCreateCubeMesh(gLightMesh);
+    UCreateCheeseMesh(gCheeseMesh);
+    UCreatePlaneMesh(gPlaneMesh);
+    UCreateCuttingBoardMesh(gCuttingBoardMesh);
+    UCreateSalamiBodyMesh(gSalamiBodyMesh);
+    UCreateSalamiEndsMesh(gSalamiEndsMesh);
+    cout << "INFO: Meshes welded from " << gSourceVertices << " to " << gCacheAfter.Vertices << " vertices, ACMR "
+        << gCacheBefore.Acmr() << " -> " << gCacheAfter.Acmr() << ", ATVR " << gCacheBefore.Atvr() << " -> " << gCacheAfter.Atvr()
+        << " (" << VERTEX_CACHE_SIZE << " entry cache), " << gMeshletCount << " meshlets" << endl;
+    if (gPackedVertices) {
+        cout << "INFO: Vertex data " << gVertexBytes / 1024.0 << " KB packed, " << gFloatVertexBytes / 1024.0
+            << " KB as floats, worst error " << gMaxPositionError << " units and " << gMaxNormalError << " degrees" << endl;
+    }
+
+    //create the shader programs
+    const GLchar* litFragmentShaderSource = UPbrShading() ? pbrFragmentShaderSource : cubeFragmentShaderSource;
+    if (!UCreateShaderProgram(cubeVertexShaderSource, litFragmentShaderSource, gProgramId))
+        return EXIT_FAILURE;
+
+    if (!UCreateShaderProgram(lampVertexShaderSource, lampFragmentShaderSource, gLampProgramId))
+        return EXIT_FAILURE;
+
+    if (!UCreateShaderProgram(fullscreenVertexShaderSource, fxaaFragmentShaderSource, gFxaaProgramId))
+        return EXIT_FAILURE;
+
+    if (!UCreateShaderProgram(fullscreenVertexShaderSource, taaFragmentShaderSource, gTaaProgramId))
+        return EXIT_FAILURE;
+
+    gAntiAliasing.Create(gFxaaProgramId, gTaaProgramId);
+
+    if (!UCreateShaderProgram(occlusionVertexShaderSource, occlusionFragmentShaderSource, gOcclusionProgramId))
+        return EXIT_FAILURE;
+
+    gOcclusion.Create(gGLState, gOcclusionProgramId);
+
+    //culling and draw variants for GPU driven rendering
+    if (UGpuDriven()) {
+        if (!UCreateShaderProgram(cubeIndirectVertexShaderSource, litFragmentShaderSource, gIndirectProgramId))
+            return EXIT_FAILURE;
+
+        if (!UCreateShaderProgram(lampIndirectVertexShaderSource, lampFragmentShaderSource, gLampIndirectProgramId))
+            return EXIT_FAILURE;
+
+        if (!UCreateComputeProgram(cullComputeShaderSource, gCullProgramId))
+            return EXIT_FAILURE;
+
+        if (!UCreateComputeProgram(depthPyramidComputeShaderSource, gDepthPyramidProgramId))
+            return EXIT_FAILURE;
+
+        gGpuCuller.Create(gCullProgramId, gDepthPyramidProgramId);
+        gAntiAliasing.SetKeepDepth(true);
+
+        glUseProgram(gIndirectProgramId);
+        glUniform3f(glGetUniformLocation(gIndirectProgramId, "objectColor"), gObjectColor.r, gObjectColor.g, gObjectColor.b);
+        glUniform2fv(glGetUniformLocation(gIndirectProgramId, "uvScale"), 1, glm::value_ptr(gUVScale));
+    }
+
+
+
+    //load knife handle textur
+    const char* handleTexFile = "../resources/textures/wood.jpg";
+    if (!UCreateTexture(handleTexFile, gHandleTexture, 0))
+    {
+        cout << "Failed to load handle texture " << handleTexFile << endl;
+        return EXIT_FAILURE;
+    }
+
+    //load knife blade texture
+    const char* bladeTexFile = "../resources/textures/metal.jpg";
+    if (!UCreateTexture(bladeTexFile, gBladeTexture, 1))
+    {
+        cout << "Failed to load blade texture " << bladeTexFile << endl;
+        return EXIT_FAILURE;
+    }
+
+    //load Cutting Board texture
+    const char* CuttingBoardTexFile = "../resources/textures/CuttingBoard.jpg";
+    if (!UCreateTexture(CuttingBoardTexFile, gCuttingBoardTexture, 2))
+    {
+        cout << "Failed to load blade texture " << CuttingBoardTexFile << endl;
+        return EXIT_FAILURE;
+    }
+
+    //load counbter texture
+    const char* CounterTexFile = "../resources/textures/Counter.jpg";
+    if (!UCreateTexture(CounterTexFile, gCounterTexture, 3))
+    {
+        cout << "Failed to load blade texture " << CounterTexFile << endl;
+        return EXIT_FAILURE;
+    }
+
+    //load cheese texture
+    const char* CheeseTexFile = "../resources/textures/Cheese.jpg";
+    if (!UCreateTexture(CheeseTexFile, gCheeseTexture, 4))
+    {
+        cout << "Failed to load blade texture " << CheeseTexFile << endl;
+        return EXIT_FAILURE;
+    }
+
+    //load salami body texture
+    const char* SalamiBodyTexFile = "../resources/textures/SalamiSkin.jpg";
+    if (!UCreateTexture(SalamiBodyTexFile, gSalamiBodyTexture, 5))
+    {
+        cout << "Failed to load blade texture " << SalamiBodyTexFile << endl;
+        return EXIT_FAILURE;
+    }
+
+    //load salami ends texture
+    const char* SalamiEndsTexFile = "../resources/textures/SalamiInside.jpg";
+    if (!UCreateTexture(SalamiEndsTexFile, gSalamiEndsTexture, 6))
+    {
+        cout << "Failed to load blade texture " << SalamiEndsTexFile << endl;
+        return EXIT_FAILURE;
+    }
+    cout << "INFO: Imported textures in " << gTextureImportTime * 1000.0 << " ms, mip levels by "
+        << (!gMipFilterOnCpu ? "glGenerateMipmap" : gMipFilter == MIP_FILTER_KAISER ? "kaiser filter" : "box filter") << endl;
+
+    //tell opengl which texture unit it belongs to
+    glUseProgram(gProgramId);
+    glUniform1i(glGetUniformLocation(gProgramId, "gHandleTexture"), 0);
+    glUniform1i(glGetUniformLocation(gProgramId, "gBladeTexture"), 1);
+    glUniform1i(glGetUniformLocation(gProgramId, "gCuttingBoardTexture"), 2);
+    glUniform1i(glGetUniformLocation(gProgramId, "gCounterTexture"), 3);
+    glUniform1i(glGetUniformLocation(gProgramId, "gCheeseTexture"), 4);
+
+    //cube color and uv scale never change, so they're set once here rather than on every program switch
+    glUniform3f(glGetUniformLocation(gProgramId, "objectColor"), gObjectColor.r, gObjectColor.g, gObjectColor.b);
+    glUniform2fv(glGetUniformLocation(gProgramId, "uvScale"), 1, glm::value_ptr(gUVScale));
+
+    //the PBR shader's environment lighting sits on its own units for the whole run
+    if (UPbrShading()) {
+        UCreateEnvironmentLighting();
+        for (GLuint program : { gProgramId, gIndirectProgramId }) {
+            if (program != 0) {
+                glUseProgram(program);
+                glUniform1i(glGetUniformLocation(program, "irradianceMap"), IRRADIANCE_TEXTURE_UNIT);
+                glUniform1i(glGetUniformLocation(program, "specularMap"), SPECULAR_TEXTURE_UNIT);
+                glUniform1i(glGetUniformLocation(program, "brdfLut"), BRDF_TEXTURE_UNIT);
+                glUniform1f(glGetUniformLocation(program, "specularLevels"), (float)(IBL_SPECULAR_LEVELS - 1));
+            }
+        }
+    }
+
+    //lay out the scene and the per frame work that updates it
+    UCreateScene();
+    UCreateFrameGraph();
+    gOcclusion.Resize(gScene.size() + gStaticObjects.size());
+    if (UGpuDriven()) {
+        UCreateGpuCulling();
+        cout << "INFO: GPU culling " << gGpuCuller.ObjectCount() << " objects in " << gGpuCuller.BatchCount() << " batches, "
+            << (gGpuCuller.Compacting() ? "compacted with a GPU draw count" : "uncompacted, ARB_indirect_parameters is missing") << endl;
+    }
+
+    //a played path replaces live camera input from the first step
+    if (gPlayPathFile != nullptr)
+    {
+        if (!gCameraPath.Load(gPlayPathFile))
+        {
+            cout << "Failed to load camera path " << gPlayPathFile << endl;
+            return EXIT_FAILURE;
+        }
+        gCameraPath.Sample(0.0, gCamera);
+        gPreviousCamera = gCamera;
+    }
+
+    //triple buffered storage for the per frame uniforms. the CPU path takes a slice per draw, so each frame
+    //has room for every object being visible at once, GPU culled draws read their objects from elsewhere
+    size_t uploadBytes = UPLOAD_BYTES_PER_FRAME;
+    if (!UGpuDriven())
+    {
+        size_t objectCount = gScene.size() + gStaticObjects.size();
+        uploadBytes = std::max(uploadBytes,
+            RingBuffer::AllocationSize(sizeof(FrameUniforms)) + objectCount * RingBuffer::AllocationSize(sizeof(DrawUniforms)));
+    }
+    if (!gUploadRing.Create(uploadBytes))
+    {
+        cout << "Failed to map the upload ring buffer, " << uploadBytes * RingBuffer::FRAMES_IN_FLIGHT / (1024 * 1024)
+            << " MB for " << gScene.size() + gStaticObjects.size() << " objects" << endl;
+        return EXIT_FAILURE;
+    }
+
+    //captured at the window's size, a played path at a fixed step sets the video's frame rate
+    if (gCaptureFile != nullptr && !gValidateSoftware)
+    {
+        int width, height;
+        glfwGetFramebufferSize(gWindow, &width, &height);
+        int frameRate = gPlaybackFrameStep > 0.0 ? (int)lround(1.0 / gPlaybackFrameStep) : CAPTURE_FRAME_RATE;
+        if (!gCapture.Start(gCaptureFile, width, height, frameRate))
+        {
+            cout << "Failed to open capture file " << gCaptureFile << endl;
+            return EXIT_FAILURE;
+        }
+    }
+
+    // Sets the background color of the window to black (it will be implicitely used by glClear)
+    glClearColor(0.0f, 0.0f, 0.0f, 1.0f);
+
+    //compare the two backends on the first frame instead of running interactively
+    int exitCode = EXIT_SUCCESS;
+    if (gValidateSoftware) {
+        if (!UValidateSoftwareRenderer()) {
+            exitCode = EXIT_FAILURE;
+        }
+        glfwSetWindowShouldClose(gWindow, true);
+    }
+    else if (gGoldenFolder != nullptr) {
+        if (!URunGoldenTest()) {
+            exitCode = EXIT_FAILURE;
+        }
+        glfwSetWindowShouldClose(gWindow, true);
+    }
+
+    //loading bound textures, buffers and programs behind the state cache's back
+    gGLState.Invalidate();
+
+    //the starting view is always on key 1
+    gViewpoints[0] = gCamera.SaveViewpoint();
+    gViewpointSaved[0] = true;
+
+    // render loop
+    // -----------
+    gLastFrame = glfwGetTime();
+    gLoopStart = gLastFrame;
+    while (!glfwWindowShouldClose(gWindow))
+    {
+        Profiler::Instance().BeginFrame();
+
+        //low latency waits out the frame before reading input so what's drawn is as fresh as possible
+        if (gPacer.LowLatency) {
+            gPacer.WaitForNextFrame();
+            glfwPollEvents();
+        }
+
+        // per-frame timing
+        // --------------------
+        double currentFrame = glfwGetTime();
+        gFrameWorkStart = currentFrame;
+        //real elapsed time, smoothing here would drift the simulation away from the wall clock;
+        //a long stall is clamped and anything past MAX_SIMULATION_STEPS is dropped below
+        gAccumulator += std::max(0.0, std::min(currentFrame - gLastFrame, MAX_DELTA));
+        gLastFrame = currentFrame;
+
+        // input and simulation in fixed steps
+        // -----
+        if (gPlayPathFile != nullptr && gPlaybackFrameStep > 0.0) {
+            //every frame shows the path at exactly frame * step, whatever the machine
+            PROFILE_SCOPE("simulate");
+            USimulate((float)gPlaybackFrameStep);
+            gAccumulator = 0.0;
+            gInterpolation = 1.0f;
+        }
+        else {
+            PROFILE_SCOPE("simulate");
+            int steps = 0;
+            while (gAccumulator >= SIMULATION_STEP && steps < MAX_SIMULATION_STEPS) {
+                USimulate((float)SIMULATION_STEP);
+                gAccumulator -= SIMULATION_STEP;
+                ++steps;
+            }
+            if (steps == MAX_SIMULATION_STEPS) {
+                //too far behind to catch up, drop the backlog
+                gAccumulator = fmod(gAccumulator, SIMULATION_STEP);
+            }
+
+            // Render this frame, part way from the previous step to the latest
+            gInterpolation = (float)(gAccumulator / SIMULATION_STEP);
+        }
+        URender();
+        ++gFrameCount;
+        if (gFrameLimit > 0 && gFrameCount >= gFrameLimit) {
+            glfwSetWindowShouldClose(gWindow, true);
+        }
+
+        if (gPacer.LowLatency) {
+            //don't let the driver queue frames behind the input
+            PROFILE_SCOPE("gpu wait");
+            glFinish();
+        }
+        else {
+            glfwPollEvents();
+            PROFILE_SCOPE("frame wait");
+            gPacer.WaitForNextFrame();
+        }
+
+        Profiler::Instance().EndFrame();
+        UShowProfile();
+    }
+
+    // Release mesh data
+    UDestroyMesh(gMeshKnifeHandle);
+    UDestroyMesh(gMeshKnifeBlade);
+    UDestroyMesh(gLightMesh);
+    UDestroyMesh(gPlaneMesh);
+    UDestroyMesh(gCuttingBoardMesh);
+    UDestroyMesh(gCheeseMesh);
+    UDestroyMesh(gSalamiBodyMesh);
+    UDestroyMesh(gSalamiEndsMesh);
+
+    // Release texture
+    UDestroyTexture(gHandleTexture);
+    UDestroyTexture(gBladeTexture);
+    UDestroyTexture(gCuttingBoardTexture);
+    UDestroyTexture(gCounterTexture);
+    UDestroyTexture(gCheeseTexture);
+    UDestroyTexture(gSalamiBodyTexture);
+    UDestroyTexture(gSalamiEndsTexture);
+    glDeleteTextures(1, &gIrradianceTexture);
+    glDeleteTextures(1, &gSpecularTexture);
+    glDeleteTextures(1, &gBrdfTexture);
+
+    // Release shader programs
+    UDestroyShaderProgram(gProgramId);
+    UDestroyShaderProgram(gLampProgramId);
+    UDestroyShaderProgram(gFxaaProgramId);
+    UDestroyShaderProgram(gTaaProgramId);
+    UDestroyShaderProgram(gOcclusionProgramId);
+    if (UGpuDriven()) {
+        gGpuCuller.Destroy(gGLState);
+        UDestroyShaderProgram(gIndirectProgramId);
+        UDestroyShaderProgram(gLampIndirectProgramId);
+        UDestroyShaderProgram(gCullProgramId);
+        UDestroyShaderProgram(gDepthPyramidProgramId);
+    }
+
+    //camera path results
+    if (gRecordPathFile != nullptr) {
+        if (gCameraPath.Save(gRecordPathFile)) {
+            cout << "INFO: Recorded " << gCameraPath.Keys.size() << " camera keys over " << gCameraPath.Duration() << " s to " << gRecordPathFile << endl;
+        }
+        else {
+            cout << "Failed to save camera path " << gRecordPathFile << endl;
+        }
+    }
+    if (gPlayPathFile != nullptr) {
+        double wallTime = glfwGetTime() - gLoopStart;
+        cout << "INFO: Played " << gPlayPathFile << " in " << gFrameCount << " frames, " << wallTime << " s, "
+            << (wallTime > 0.0 ? gFrameCount / wallTime : 0.0) << " fps average" << endl;
+    }
+
+    //frames written, and the ones the readbacks or the encoder couldn't keep up with
+    if (gCapture.Active()) {
+        gCapture.Stop();
+        const CaptureStats& captureStats = gCapture.Stats();
+        cout << "INFO: Captured " << captureStats.Written << " of " << captureStats.Frames << " frames to " << gCapture.Path() << ", dropped "
+            << captureStats.DroppedBusy << " waiting on readbacks, " << captureStats.DroppedQueue << " behind the encoder, "
+            << captureStats.DroppedSize << " after a resize, encoding "
+            << (captureStats.Written > 0 ? captureStats.EncodeTime / captureStats.Written * 1000.0 : 0.0) << " ms per frame" << endl;
+    }
+
+    //frames that had to wait for the GPU to finish with their part of the upload ring
+    const RingBufferStats& ringStats = gUploadRing.Stats();
+    cout << "INFO: Upload ring waited on the GPU in " << ringStats.FenceWaits << " of " << ringStats.Frames
+        << " frames, " << ringStats.WaitTime * 1000.0 << " ms in total, peak " << ringStats.PeakBytesUsed << " bytes per frame";
+    if (ringStats.Overflows > 0) {
+        cout << ", " << ringStats.Overflows << " draws skipped for lack of space";
+    }
+    cout << endl;
+    gUploadRing.Destroy();
+
+    //switches walking the sorted queue, per frame
+    if (gFrameCount > 0 && !UGpuDriven()) {
+        cout << "INFO: Render queue per frame: " << (double)gQueueTotals.Items / gFrameCount << " draws, "
+            << (double)gQueueTotals.ProgramSwitches / gFrameCount << " program, " << (double)gQueueTotals.MaterialSwitches / gFrameCount
+            << " texture and " << (double)gQueueTotals.MeshSwitches / gFrameCount << " mesh switches" << endl;
+    }
+
+    //what culling removed, by the view and by the occluders
+    const OcclusionStats& occlusionStats = gOcclusion.Stats();
+    if (occlusionStats.Frames > 0) {
+        double frames = (double)occlusionStats.Frames;
+        cout << "INFO: Culling per frame of " << occlusionStats.Objects / frames << " objects: " << occlusionStats.FrustumCulled / frames
+            << " outside the view, " << occlusionStats.OcclusionCulled / frames << " hidden by occlusion queries, "
+            << occlusionStats.Tested / frames << " boxes tested" << endl;
+    }
+    gOcclusion.Destroy();
+
+    //what each anti-aliasing mode used this run cost, scene draw plus resolve
+    for (int mode = 0; mode < AA_MODE_COUNT; ++mode) {
+        const AntiAliasCost& cost = gAntiAliasing.Cost((AntiAliasMode)mode);
+        if (cost.Frames == 0) {
+            continue;
+        }
+        cout << "INFO: Anti-aliasing " << ANTI_ALIAS_MODE_NAMES[mode] << ": " << cost.Frames << " frames, cpu "
+            << cost.CpuTime / cost.Frames * 1000.0 << " ms";
+        if (cost.GpuFrames > 0) {
+            cout << ", gpu " << cost.GpuTime / cost.GpuFrames * 1000.0 << " ms";
+        }
+        cout << " per frame" << endl;
+    }
+    gAntiAliasing.Destroy(gGLState);
+
+    //how far the resolution had to drop to hold the budget, and how often it still wasn't enough
+    if (gDynamicResolution.Budget > 0.0 && gDynamicResolution.Frames() > 0) {
+        cout << "INFO: Dynamic resolution: " << gDynamicResolution.Misses() << " of " << gDynamicResolution.Frames() << " frames over the "
+            << gDynamicResolution.Budget * 1000.0 << " ms budget, average scale " << gDynamicResolution.AverageScale() << ", "
+            << gDynamicResolution.ScaleChanges() << " scale changes, ending at " << gDynamicResolution.Scale() << endl;
+    }
+
+    //state calls the cache let through and the ones that would only have repeated the current state
+    cout << "INFO: GL state calls per frame: " << gGLState.IssuedPerFrame() << " issued, " << gGLState.RedundantPerFrame()
+        << " redundant" << (gGLState.Filtering ? " and skipped" : " but issued anyway") << endl;
+
+    //where the frame time went, and what measuring it cost
+    Profiler& profiler = Profiler::Instance();
+    if (profiler.Enabled) {
+        cout << "INFO: Profile, rolling averages per frame" << endl << profiler.Summary();
+        cout << "INFO: Profiler recorded " << profiler.MarkersPerFrame() << " markers per frame at " << profiler.MarkerCost()
+            << " ns each, " << profiler.MarkersPerFrame() * profiler.MarkerCost() / 1000.0 << " us per frame";
+        if (profiler.GpuFramesDropped() > 0 || profiler.GpuRangesSkipped() > 0) {
+            cout << ", " << profiler.GpuFramesDropped() << " GPU frames dropped, " << profiler.GpuRangesSkipped() << " GPU ranges skipped";
+        }
+        cout << endl;
+    }
+    if (gTraceFile != nullptr) {
+        if (profiler.WriteTrace(gTraceFile)) {
+            cout << "INFO: Wrote " << profiler.CapturedEvents() << " trace events to " << gTraceFile << endl;
+        }
+        else {
+            cout << "Failed to write trace " << gTraceFile << endl;
+        }
+    }
+    profiler.Shutdown();
+
+    if (gSoftwareFramebuffer != 0) {
+        glDeleteFramebuffers(1, &gSoftwareFramebuffer);
+        glDeleteTextures(1, &gSoftwareTarget);
+    }
+
+    exit(exitCode); // Terminates the program successfully
+}
+
+
+//initialize glfw, glew, and creates window
+bool UInitialize(int argc, char* argv[], GLFWwindow** window) {
+    UBindDefaultKeys();
+#ifdef HEADLESS_RENDER
+    //nobody is watching, so don't hold frames back for the display
+    gPacer.Mode = PRESENT_VSYNC_OFF;
+#endif
+    UParseArguments(argc, argv);
+    gDynamicResolution.SetScale(gRenderScale);
+
+    //glfw initialize and config
+    glfwInit();
+    glfwWindowHint(GLFW_CONTEXT_VERSION_MAJOR, 4);
+    glfwWindowHint(GLFW_CONTEXT_VERSION_MINOR, 4);
+    glfwWindowHint(GLFW_OPENGL_PROFILE, GLFW_OPENGL_CORE_PROFILE);
+
+#ifdef __APPLE__
+    glfwWindowHint(GLFW_OPENGL_FORWARD_COMPAT, GL_TRUE);
+#endif
+#ifdef HEADLESS_RENDER
+    glfwWindowHint(GLFW_VISIBLE, GLFW_FALSE);
+#endif
+
+    //window creation
+    * window = glfwCreateWindow(WINDOW_WIDTH, WINDOW_HEIGHT, WINDOW_TITLE, NULL, NULL);
+    if (*window == NULL)
+    {
+        std::cout << "Failed to create GLFW window" << std::endl;
+        glfwTerminate();
+        return false;
+    }
+    glfwMakeContextCurrent(*window);
+    glfwSetFramebufferSizeCallback(*window, UResizeWindow);
+    glfwSetKeyCallback(*window, UKeyCallback);
+    glfwSetCursorPosCallback(*window, UMousePositionCallback);
+    glfwSetScrollCallback(*window, UMouseScrollCallback);
+    glfwSetMouseButtonCallback(*window, UMouseButtonCallback);
+
+    //glew initialize
+    glewExperimental = GL_TRUE;
+    GLenum GlewInitResult = glewInit();
+
+    if (GLEW_OK != GlewInitResult)
+    {
+        std::cerr << glewGetErrorString(GlewInitResult) << std::endl;
+        return false;
+    }
+
+    // Displays GPU OpenGL version
+    cout << "INFO: OpenGL Version: " << glGetString(GL_VERSION) << endl;
+
+    //vsync setting needs the context
+    gPacer.ApplySwapInterval();
+
+    //timer queries need the context too
+    Profiler::Instance().Initialize(true);
+
+    return true;
+}
+
+
+//reads the command line options
+//  --vsync on|off|adaptive   presentation mode (default on, off in the headless build)
+//  --fps N                   frame rate cap, 0 for none (default)
+//  --low-latency             poll input right before rendering and wait for the GPU each frame
+//  --renderer gl|software    draw with OpenGL (default) or the CPU rasterizer
+//  --validate-software       render the first frame with both and report how far apart they are
+//  --golden DIR              draw fixed views, compare them with DIR/<view>.png by SSIM and exit, failing
+//                            views leave golden_<view>_actual.png and golden_<view>_diff.png in the build
+//                            folder. ctest runs it as the golden test against resources/golden
+//  --golden-update           write the views to DIR as the new references instead, run by hand when a
+//                            change is meant to alter the image
+//  --golden-threshold S      lowest mean SSIM that passes (default 0.98)
+//  --golden-worst-threshold S  lowest mean SSIM of any 32x32 block that passes (default 0.9)
+//  --record-path FILE        save the camera's movement to FILE on exit
+//  --play-path FILE          fly the camera along a recorded path, exits when it ends
+//  --play-frame-step S       advance the path S seconds per frame instead of following the clock
+//  --frames N                exit after drawing N frames
+//  --capture FILE            write every frame to FILE, a .y4m stream or numbered PNGs, without stalling the renderer
+//  --bind ACTION=KEY         bind a letter or digit key to an action, e.g. --bind forward=I
+//  --profile                 show CPU/GPU timings in the window title and print them on exit
+//  --trace FILE              write every profiler marker to FILE as a chrome trace on exit
+//  --gl-state-filter on|off  drop GL state calls that repeat the current state (default on)
+//  --aa off|msaa2|msaa4|msaa8|fxaa|taa   anti-aliasing for the GL renderer (default off), M cycles through them
+//  --mip-filter gpu|box|kaiser   build texture mip levels with glGenerateMipmap (default) or on the CPU
+//  --vertex-format packed|float  16 byte quantized vertices (default) or the original 32 byte float ones
+//  --frame-budget MS         lower the render resolution to keep frames under MS milliseconds
+//  --min-render-scale S      lowest scale the frame budget may drop to (default 0.5)
+//  --render-scale S          draw at S times the window size, the starting scale with a budget (default 1)
+//  --culling cpu|gpu         cull and build draws on the CPU (default) or in a compute pass with indirect draws
+//  --extra-objects N         add N static copies of scene objects around the scene to load the culling
+//  --occlusion-queries on|off  skip objects whose bounding box was hidden last frame (default on, CPU culling only)
+//  --shading pbr|phong       metallic/roughness PBR lit by cached environment lighting (default) or the original Phong
+void UParseArguments(int argc, char* argv[])
+{
+    for (int i = 1; i < argc; ++i) {
+        if (strcmp(argv[i], "--vsync") == 0 && i + 1 < argc) {
+            const char* mode = argv[++i];
+            if (strcmp(mode, "off") == 0) {
+                gPacer.Mode = PRESENT_VSYNC_OFF;
+            }
+            else if (strcmp(mode, "adaptive") == 0) {
+                gPacer.Mode = PRESENT_VSYNC_ADAPTIVE;
+            }
+            else {
+                gPacer.Mode = PRESENT_VSYNC_ON;
+            }
+        }
+        else if (strcmp(argv[i], "--fps") == 0 && i + 1 < argc) {
+            gPacer.SetFrameRateCap(atof(argv[++i]));
+        }
+        else if (strcmp(argv[i], "--low-latency") == 0) {
+            gPacer.LowLatency = true;
+        }
+        else if (strcmp(argv[i], "--renderer") == 0 && i + 1 < argc) {
+            gSoftwareRendering = strcmp(argv[++i], "software") == 0;
+        }
+        else if (strcmp(argv[i], "--validate-software") == 0) {
+            gValidateSoftware = true;
+        }
+        else if (strcmp(argv[i], "--golden") == 0 && i + 1 < argc) {
+            gGoldenFolder = argv[++i];
+        }
+        else if (strcmp(argv[i], "--golden-update") == 0) {
+            gGoldenUpdate = true;
+        }
+        else if (strcmp(argv[i], "--golden-threshold") == 0 && i + 1 < argc) {
+            gGoldenThreshold = atof(argv[++i]);
+        }
+        else if (strcmp(argv[i], "--golden-worst-threshold") == 0 && i + 1 < argc) {
+            gGoldenWorstThreshold = atof(argv[++i]);
+        }
+        else if (strcmp(argv[i], "--record-path") == 0 && i + 1 < argc) {
+            gRecordPathFile = argv[++i];
+        }
+        else if (strcmp(argv[i], "--play-path") == 0 && i + 1 < argc) {
+            gPlayPathFile = argv[++i];
+        }
+        else if (strcmp(argv[i], "--play-frame-step") == 0 && i + 1 < argc) {
+            gPlaybackFrameStep = atof(argv[++i]);
+        }
+        else if (strcmp(argv[i], "--frames") == 0 && i + 1 < argc) {
+            gFrameLimit = strtoull(argv[++i], nullptr, 10);
+        }
+        else if (strcmp(argv[i], "--capture") == 0 && i + 1 < argc) {
+            gCaptureFile = argv[++i];
+        }
+        else if (strcmp(argv[i], "--profile") == 0) {
+            gProfileOverlay = true;
+            Profiler::Instance().Enabled = true;
+        }
+        else if (strcmp(argv[i], "--trace") == 0 && i + 1 < argc) {
+            gTraceFile = argv[++i];
+            Profiler::Instance().Enabled = true;
+            Profiler::Instance().Capture = true;
+        }
+        else if (strcmp(argv[i], "--aa") == 0 && i + 1 < argc) {
+            AntiAliasMode mode = AntiAliasing::FindMode(argv[++i]);
+            if (mode != AA_MODE_COUNT) {
+                gAntiAliasing.SetMode(mode);
+            }
+            else {
+                cout << "Unknown anti-aliasing mode " << argv[i] << endl;
+            }
+        }
+        else if (strcmp(argv[i], "--mip-filter") == 0 && i + 1 < argc) {
+            const char* filter = argv[++i];
+            gMipFilterOnCpu = strcmp(filter, "box") == 0 || strcmp(filter, "kaiser") == 0;
+            gMipFilter = strcmp(filter, "kaiser") == 0 ? MIP_FILTER_KAISER : MIP_FILTER_BOX;
+        }
+        else if (strcmp(argv[i], "--vertex-format") == 0 && i + 1 < argc) {
+            gPackedVertices = strcmp(argv[++i], "float") != 0;
+        }
+        else if (strcmp(argv[i], "--frame-budget") == 0 && i + 1 < argc) {
+            gDynamicResolution.Budget = atof(argv[++i]) / 1000.0;
+        }
+        else if (strcmp(argv[i], "--min-render-scale") == 0 && i + 1 < argc) {
+            gDynamicResolution.MinScale = std::min(std::max((float)atof(argv[++i]), 0.1f), 1.0f);
+        }
+        else if (strcmp(argv[i], "--render-scale") == 0 && i + 1 < argc) {
+            gRenderScale = (float)atof(argv[++i]);
+        }
+        else if (strcmp(argv[i], "--culling") == 0 && i + 1 < argc) {
+            gGpuCulling = strcmp(argv[++i], "gpu") == 0;
+        }
+        else if (strcmp(argv[i], "--occlusion-queries") == 0 && i + 1 < argc) {
+            gOcclusion.Enabled = strcmp(argv[++i], "off") != 0;
+        }
+        else if (strcmp(argv[i], "--shading") == 0 && i + 1 < argc) {
+            gPbrShading = strcmp(argv[++i], "phong") != 0;
+        }
+        else if (strcmp(argv[i], "--extra-objects") == 0 && i + 1 < argc) {
+            gExtraObjects = strtoull(argv[++i], nullptr, 10);
+        }
+        else if (strcmp(argv[i], "--gl-state-filter") == 0 && i + 1 < argc) {
+            gGLState.Filtering = strcmp(argv[++i], "off") != 0;
+        }
+        else if (strcmp(argv[i], "--bind") == 0 && i + 1 < argc) {
+            //the new key replaces the defaults for that action
+            std::string binding = argv[++i];
+            size_t equals = binding.find('=');
+            InputAction action = equals == std::string::npos ? ACTION_COUNT : InputSystem::FindAction(binding.substr(0, equals).c_str());
+            char key = equals + 2 == binding.size() ? (char)toupper(binding[equals + 1]) : 0;
+            if (action != ACTION_COUNT && ((key >= 'A' && key <= 'Z') || (key >= '0' && key <= '9'))) {
+                gInput.ClearBindings(action);
+                gInput.Bind(action, key); // glfw key codes for letters and digits are their ascii values
+            }
+            else {
+                cout << "Bad key binding " << binding << endl;
+            }
+        }
+        else {
+            cout << "Unknown option " << argv[i] << endl;
+        }
+    }
+}
+
+
+//default key bindings, --bind can replace them
+void UBindDefaultKeys()
+{
+    gInput.Bind(ACTION_QUIT, GLFW_KEY_ESCAPE);
+    gInput.Bind(ACTION_MOVE_FORWARD, GLFW_KEY_W);
+    gInput.Bind(ACTION_MOVE_BACKWARD, GLFW_KEY_S);
+    gInput.Bind(ACTION_MOVE_LEFT, GLFW_KEY_A);
+    gInput.Bind(ACTION_MOVE_RIGHT, GLFW_KEY_D);
+    gInput.Bind(ACTION_MOVE_DOWN, GLFW_KEY_Q);
+    gInput.Bind(ACTION_MOVE_UP, GLFW_KEY_E);
+    gInput.Bind(ACTION_TURN_LEFT, GLFW_KEY_Z);
+    gInput.Bind(ACTION_TURN_RIGHT, GLFW_KEY_C);
+    gInput.Bind(ACTION_TURN_UP, GLFW_KEY_R);
+    gInput.Bind(ACTION_TURN_DOWN, GLFW_KEY_F);
+    gInput.Bind(ACTION_ROLL_LEFT, GLFW_KEY_X);
+    gInput.Bind(ACTION_ROLL_RIGHT, GLFW_KEY_V);
+    gInput.Bind(ACTION_TOGGLE_PROJECTION, GLFW_KEY_P);
+    gInput.Bind(ACTION_SAVE_VIEWPOINT, GLFW_KEY_LEFT_SHIFT);
+    gInput.Bind(ACTION_SAVE_VIEWPOINT, GLFW_KEY_RIGHT_SHIFT);
+    for (int i = 0; i < VIEWPOINT_COUNT; ++i) {
+        gInput.Bind((InputAction)(ACTION_VIEWPOINT_1 + i), GLFW_KEY_1 + i);
+    }
+    gInput.Bind(ACTION_PICK, MouseButtonCode(GLFW_MOUSE_BUTTON_LEFT));
+    gInput.Bind(ACTION_CYCLE_ANTIALIASING, GLFW_KEY_M);
+}
+
+
+//process all input: react to the actions gathered by the last gInput.Update()
+void UProcessInput(GLFWwindow* window)
+{
+    //held actions that drive the camera every step
+    static const struct {
+        InputAction action;
+        Camera_Movement movement;
+    } cameraActions[] = {
+        { ACTION_MOVE_FORWARD, FORWARD }, { ACTION_MOVE_BACKWARD, BACKWARD },
+        { ACTION_MOVE_LEFT, LEFT }, { ACTION_MOVE_RIGHT, RIGHT },
+        { ACTION_MOVE_UP, UP }, { ACTION_MOVE_DOWN, DOWN },
+        { ACTION_TURN_LEFT, TURNL }, { ACTION_TURN_RIGHT, TURNR },
+        { ACTION_TURN_UP, TURNU }, { ACTION_TURN_DOWN, TURND },
+        { ACTION_ROLL_LEFT, ROLLL }, { ACTION_ROLL_RIGHT, ROLLR }
+    };
+
+    if (gInput.Pressed(ACTION_QUIT)) {
+        glfwSetWindowShouldClose(window, true);
+    }
+
+    for (const auto& cameraAction : cameraActions) {
+        if (gInput.Held(cameraAction.action)) {
+            gCamera.ProcessKeyboard(cameraAction.movement, gDeltaTime);
+        }
+    }
+
+    //saved viewpoints, acted on when the key goes down
+    for (int i = 0; i < VIEWPOINT_COUNT; ++i) {
+        if (!gInput.Pressed((InputAction)(ACTION_VIEWPOINT_1 + i))) {
+            continue;
+        }
+        if (gInput.Held(ACTION_SAVE_VIEWPOINT)) {
+            gViewpoints[i] = gCamera.SaveViewpoint();
+            gViewpointSaved[i] = true;
+        }
+        else if (gViewpointSaved[i]) {
+            gCamera.TransitionTo(gViewpoints[i], VIEWPOINT_TRANSITION_TIME);
+        }
+    }
+
+    if (gInput.Pressed(ACTION_TOGGLE_PROJECTION)) {
+        perspectiveMode = !perspectiveMode;
+    }
+
+    if (gInput.Pressed(ACTION_CYCLE_ANTIALIASING)) {
+        AntiAliasMode mode = (AntiAliasMode)((gAntiAliasing.Mode() + 1) % AA_MODE_COUNT);
+        gAntiAliasing.SetMode(mode);
+        cout << "Anti-aliasing " << ANTI_ALIAS_MODE_NAMES[mode] << endl;
+    }
+
+    if (gInput.Pressed(ACTION_PICK)) {
+        UPickObject(gInput.CursorX(), gInput.CursorY());
+    }
+}
+
+
+//advances the camera and scene by one fixed step
+void USimulate(float step)
+{
+    //keep the state the renderer blends from
+    gPreviousCamera = gCamera;
+    gPreviousTransforms = gTransforms;
+
+    gDeltaTime = step;
+
+    //everything queued since the last step. the first step of a frame gets all of the mouse
+    //motion as one delta, later steps in the same frame see none
+    gInput.Update();
+    if (gInput.MouseDeltaX() != 0.0f || gInput.MouseDeltaY() != 0.0f) {
+        gCamera.ProcessMouseMovement(gInput.MouseDeltaX(), gInput.MouseDeltaY());
+    }
+    if (gInput.ScrollDelta() != 0.0f) {
+        gCamera.ProcessMouseScroll(gInput.ScrollDelta());
+    }
+
+    UProcessInput(gWindow);
+    gCamera.Update(step);
+    gSimulationTime += step;
+
+    //a played path overrides whatever input did to the camera
+    if (gPlayPathFile != nullptr && !gCameraPath.Sample(gSimulationTime, gCamera)) {
+        glfwSetWindowShouldClose(gWindow, true);
+    }
+
+    if (gRecordPathFile != nullptr) {
+        gCameraPath.Record(gSimulationTime, gCamera);
+    }
+}
+
+
+//glfw: whenever the window size changed (by OS or user resize) this callback function executes
+void UResizeWindow(GLFWwindow* window, int width, int height)
+{
+    gGLState.Viewport(0, 0, width, height);
+}
+
+
+//glfw: whenever a key is pressed or released, this callback is called
+void UKeyCallback(GLFWwindow* window, int key, int scancode, int action, int mods)
+{
+    gInput.OnKey(key, action);
+}
+
+
+//glfw: whenever the mouse moves, this callback is called
+void UMousePositionCallback(GLFWwindow* window, double xpos, double ypos)
+{
+    gInput.OnCursor(xpos, ypos);
+}
+
+
+// glfw: whenever the mouse scroll wheel scrolls, this callback is called
+// ----------------------------------------------------------------------
+void UMouseScrollCallback(GLFWwindow* window, double xoffset, double yoffset)
+{
+    gInput.OnScroll(yoffset);
+}
+
+
+
+//glfw: whenever a mouse button is pressed or released, this callback is called
+// ----------------------------------------------------------------------------
+void UMouseButtonCallback(GLFWwindow* window, int button, int action, int mods)
+{
+    gInput.OnMouseButton(button, action);
+}
+
+
+//casts a ray from the cursor through the last drawn frame and reports the closest object it hits
+void UPickObject(double xpos, double ypos)
+{
+    int width, height;
+    glfwGetWindowSize(gWindow, &width, &height);
+    if (width <= 0 || height <= 0) {
+        return;
+    }
+
+    double start = glfwGetTime();
+    Ray ray = ScreenRay(xpos, ypos, width, height, gView, gProjection);
+    RayHit hit = gSceneBvh.Intersect(ray);
+    double elapsed = glfwGetTime() - start;
+
+    if (hit.Hit) {
+        cout << "Picked " << gScene[hit.Object].name << " at (" << hit.Position.x << ", " << hit.Position.y << ", " << hit.Position.z
+            << ") in " << elapsed * 1000000.0 << " us" << endl;
+    }
+    else {
+        cout << "Picked nothing in " << elapsed * 1000000.0 << " us" << endl;
+    }
+}
+
+
+//lays out every object in the scene, called once the meshes, textures and shaders exist
+void UCreateScene()
+{
+    const glm::vec3 yAxis(0.0f, 1.0f, 0.0f);
+    const glm::vec3 zAxis(0.0f, 0.0f, 1.0f);
+
+    //knife handle and blade share a transform
+    size_t knife = gTransforms.Add(glm::vec3(3.5f, 0.94f, -0.9f), glm::angleAxis(2.4f, yAxis), glm::vec3(1.1f, 1.1f, 1.1f), TRANSLATE_ROTATE_SCALE);
+    gScene.push_back({ "knife handle", &gMeshKnifeHandle, gProgramId, gHandleTexture, knife, false, MATERIAL_WOOD });
+    gScene.push_back({ "knife blade", &gMeshKnifeBlade, gProgramId, gBladeTexture, knife, false, MATERIAL_STEEL });
+
+    size_t cheese = gTransforms.Add(glm::vec3(-1.5f, 1.3f, 2.5f), glm::angleAxis(0.1f, yAxis), glm::vec3(1.3f, 1.5f, 1.5f), TRANSLATE_SCALE_ROTATE);
+    gScene.push_back({ "cheese", &gCheeseMesh, gProgramId, gCheeseTexture, cheese, false, MATERIAL_FOOD });
+
+    size_t counter = gTransforms.Add(glm::vec3(0.0f, 0.0f, 0.0f), glm::quat(1.0f, 0.0f, 0.0f, 0.0f), glm::vec3(1.0f, 1.0f, 1.0f), TRANSLATE_ROTATE_SCALE);
+    gScene.push_back({ "counter", &gPlaneMesh, gProgramId, gCounterTexture, counter, true, MATERIAL_STONE });
+
+    size_t cuttingBoard = gTransforms.Add(glm::vec3(0.0f, 0.0f, 0.0f), glm::angleAxis(0.1f, yAxis), glm::vec3(1.3f, 1.0f, 1.3f), TRANSLATE_SCALE_ROTATE);
+    gScene.push_back({ "cutting board", &gCuttingBoardMesh, gProgramId, gCuttingBoardTexture, cuttingBoard, true, MATERIAL_WOOD });
+
+    //salami body and ends share a transform
+    size_t salami = gTransforms.Add(glm::vec3(1.7f, 1.6f, 0.0f), glm::angleAxis(1.57f, zAxis), glm::vec3(1.6f, 0.7f, 0.7f), SCALE_ROTATE_TRANSLATE);
+    gScene.push_back({ "salami body", &gSalamiBodyMesh, gProgramId, gSalamiBodyTexture, salami, false, MATERIAL_FOOD });
+    gScene.push_back({ "salami ends", &gSalamiEndsMesh, gProgramId, gSalamiEndsTexture, salami, false, MATERIAL_FOOD });
+
+    //smaller cube used as a visual que for the light source
+    size_t light = gTransforms.Add(gLightPosition, glm::quat(1.0f, 0.0f, 0.0f, 0.0f), gLightScale, TRANSLATE_ROTATE_SCALE);
+    gScene.push_back({ "light", &gLightMesh, gLampProgramId, 0, light, false, MATERIAL_NONE });
+
+    gPreviousTransforms = gTransforms;
+    gRenderTransforms = gTransforms;
+
+    gModels.resize(gTransforms.Size());
+    gModelViewProjections.resize(gTransforms.Size());
+
+    //objects sharing a program, texture or mesh get the same id so they sort next to each other
+    SortKeyIds programIds, materialIds, meshIds;
+    for (SceneObject& object : gScene) {
+        object.stateKey = MakeStateKey(PASS_OPAQUE, programIds.Id(object.program), materialIds.Id(object.texture),
+            meshIds.Id((uintptr_t)object.mesh));
+    }
+
+    //picking BVH over where everything starts, the frame graph refits it as things move
+    ComposeWorldMatrices(gTransforms, 0, gTransforms.Size(), gModels.data());
+    for (const SceneObject& object : gScene) {
+        gSceneBvh.AddObject(object.mesh->positions.data(), object.mesh->positions.size(), gModels[object.transform]);
+    }
+    gSceneBvh.Build();
+
+    //extra copies of the tabletop, everything but the light, filling a square grid of cells outwards
+    //from the scene. cell 0 is the scene itself
+    size_t copied = gScene.size() - 1;
+    size_t cells = (gExtraObjects + copied - 1) / copied + 1;
+    int side = (int)ceil(sqrt((double)cells));
+    gStaticObjects.reserve(gExtraObjects);
+    for (size_t i = 0; i < gExtraObjects; ++i) {
+        int cell = (int)(i / copied) + 1;
+        glm::vec3 offset((cell % side - side / 2) * EXTRA_OBJECT_SPACING, 0.0f, -(cell / side) * EXTRA_OBJECT_SPACING);
+        size_t object = i % copied;
+        gStaticObjects.push_back({ object, glm::translate(offset) * gModels[gScene[object].transform], false });
+    }
+}
+
+
+//hands the scene to the GPU culling pass, after UCreateScene
+void UCreateGpuCulling()
+{
+    for (size_t i = 0; i < gScene.size() + gStaticObjects.size(); ++i) {
+        const SceneObject& object = UItemObject((uint32_t)i);
+        GLuint program = object.program == gLampProgramId ? gLampIndirectProgramId : gIndirectProgramId;
+
+        GpuObject gpuObject = {};
+        gpuObject.Model = UItemModel((uint32_t)i);
+        gpuObject.PositionOffset = glm::vec4(object.mesh->positionOffset, 0.0f);
+        gpuObject.PositionScale = glm::vec4(object.mesh->positionScale, 0.0f);
+        gpuObject.BoundsCenter = glm::vec4((object.mesh->boundsMin + object.mesh->boundsMax) * 0.5f, 0.0f);
+        gpuObject.BoundsExtent = glm::vec4((object.mesh->boundsMax - object.mesh->boundsMin) * 0.5f, 0.0f);
+        gpuObject.Batch = gGpuCuller.Batch(program, object.texture, object.mesh->vao);
+        gpuObject.FirstIndex = 0;
+        gpuObject.IndexCount = object.mesh->nIndices;
+        gpuObject.Material = glm::vec4(object.material.Metallic, object.material.Roughness, 0.0f, 0.0f);
+        gGpuCuller.AddObject(gpuObject);
+    }
+    gGpuCuller.Upload(gGLState);
+}
+
+
+//culling and draw submission run on the GPU, only for the GL renderer outside validation
+bool UGpuDriven()
+{
+    return gGpuCulling && !gSoftwareRendering && !gValidateSoftware;
+}
+
+
+//the GL renderer shades with PBR unless asked not to, the software renderer and its validation stay Phong
+bool UPbrShading()
+{
+    return gPbrShading && !gSoftwareRendering && !gValidateSoftware;
+}
+
+
+//builds the PBR shader's environment lighting from the lamp, or loads it from the cache when that was
+//built for the same lamp and sizes, and binds it to its texture units
+void UCreateEnvironmentLighting()
+{
+    double start = glfwGetTime();
+    EnvironmentParams params = { glm::normalize(gLightPosition), gLightColor };
+    EnvironmentLighting lighting;
+    bool cached = LoadEnvironmentLighting(ENVIRONMENT_CACHE_FILE, params, lighting);
+    if (!cached) {
+        BuildEnvironmentLighting(gJobs, params, lighting);
+        if (!SaveEnvironmentLighting(ENVIRONMENT_CACHE_FILE, params, lighting)) {
+            cout << "Failed to write environment cache " << ENVIRONMENT_CACHE_FILE << endl;
+        }
+    }
+
+    //filtering runs across cube faces instead of clamping at their edges
+    glEnable(GL_TEXTURE_CUBE_MAP_SEAMLESS);
+
+    glActiveTexture(GL_TEXTURE0 + IRRADIANCE_TEXTURE_UNIT);
+    glGenTextures(1, &gIrradianceTexture);
+    glBindTexture(GL_TEXTURE_CUBE_MAP, gIrradianceTexture);
+    size_t faceValues = (size_t)IBL_IRRADIANCE_SIZE * IBL_IRRADIANCE_SIZE * 3;
+    for (int face = 0; face < 6; ++face) {
+        glTexImage2D(GL_TEXTURE_CUBE_MAP_POSITIVE_X + face, 0, GL_RGB16F, IBL_IRRADIANCE_SIZE, IBL_IRRADIANCE_SIZE, 0, GL_RGB, GL_HALF_FLOAT,
+            &lighting.Irradiance[face * faceValues]);
+    }
+    glTexParameteri(GL_TEXTURE_CUBE_MAP, GL_TEXTURE_MIN_FILTER, GL_LINEAR);
+    glTexParameteri(GL_TEXTURE_CUBE_MAP, GL_TEXTURE_MAG_FILTER, GL_LINEAR);
+    glTexParameteri(GL_TEXTURE_CUBE_MAP, GL_TEXTURE_MAX_LEVEL, 0);
+
+    //one mip level per roughness step
+    glActiveTexture(GL_TEXTURE0 + SPECULAR_TEXTURE_UNIT);
+    glGenTextures(1, &gSpecularTexture);
+    glBindTexture(GL_TEXTURE_CUBE_MAP, gSpecularTexture);
+    for (int level = 0; level < IBL_SPECULAR_LEVELS; ++level) {
+        int size = IBL_SPECULAR_SIZE >> level;
+        faceValues = (size_t)size * size * 3;
+        for (int face = 0; face < 6; ++face) {
+            glTexImage2D(GL_TEXTURE_CUBE_MAP_POSITIVE_X + face, level, GL_RGB16F, size, size, 0, GL_RGB, GL_HALF_FLOAT,
+                &lighting.Specular[level][face * faceValues]);
+        }
+    }
+    glTexParameteri(GL_TEXTURE_CUBE_MAP, GL_TEXTURE_MIN_FILTER, GL_LINEAR_MIPMAP_LINEAR);
+    glTexParameteri(GL_TEXTURE_CUBE_MAP, GL_TEXTURE_MAG_FILTER, GL_LINEAR);
+    glTexParameteri(GL_TEXTURE_CUBE_MAP, GL_TEXTURE_MAX_LEVEL, IBL_SPECULAR_LEVELS - 1);
+
+    glActiveTexture(GL_TEXTURE0 + BRDF_TEXTURE_UNIT);
+    glGenTextures(1, &gBrdfTexture);
+    glBindTexture(GL_TEXTURE_2D, gBrdfTexture);
+    glTexImage2D(GL_TEXTURE_2D, 0, GL_RG16F, IBL_BRDF_SIZE, IBL_BRDF_SIZE, 0, GL_RG, GL_HALF_FLOAT, lighting.Brdf.data());
+    glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_WRAP_S, GL_CLAMP_TO_EDGE);
+    glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_WRAP_T, GL_CLAMP_TO_EDGE);
+    glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MIN_FILTER, GL_LINEAR);
+    glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MAG_FILTER, GL_LINEAR);
+    glActiveTexture(GL_TEXTURE0);
+
+    cout << "INFO: Environment lighting " << (cached ? "loaded from " : "built and cached to ") << ENVIRONMENT_CACHE_FILE
+        << " in " << (glfwGetTime() - start) * 1000.0 << " ms" << endl;
+}
+
+
+//what a render queue item draws, scene objects first and then the static copies
+const SceneObject& UItemObject(uint32_t item)
+{
+    return item < gScene.size() ? gScene[item] : gScene[gStaticObjects[item - gScene.size()].object];
+}
+
+const glm::mat4& UItemModel(uint32_t item)
+{
+    return item < gScene.size() ? gModels[gScene[item].transform] : gStaticObjects[item - gScene.size()].model;
+}
+
+
+//sets up the CPU work done every frame before anything is drawn
+void UCreateFrameGraph()
+{
+    //camera/view transformation
+    FrameGraph::StageId cameraStage = gFrameGraph.AddStage("camera", []() {
+        PROFILE_SCOPE("camera");
+        gRenderCamera = Camera::Interpolate(gPreviousCamera, gCamera, gInterpolation);
+        gView = gRenderCamera.GetViewMatrix();
+
+        if (perspectiveMode) {
+            gProjection = glm::perspective(45.0f, (GLfloat)WINDOW_WIDTH / (GLfloat)WINDOW_HEIGHT, 0.1f, 100.0f);
+        }
+        else {
+            gProjection = glm::ortho(-40.0f, 40.0f, -40.0f, 40.0f, -1000.0f, 1000.0f);
+        }
+    });
+
+    //model matrices in SIMD batches, independent of the camera so both run at once
+    FrameGraph::StageId transformStage = gFrameGraph.AddStage("transforms", []() {
+        PROFILE_SCOPE("transforms");
+        gJobs.ParallelFor(gTransforms.Size(), OBJECTS_PER_JOB, [](size_t begin, size_t end) {
+            InterpolateTransforms(gPreviousTransforms, gTransforms, gInterpolation, begin, end, gRenderTransforms);
+            ComposeWorldMatrices(gRenderTransforms, begin, end, gModels.data());
+        });
+    });
+
+    //keeps the picking BVH on the drawn positions, only objects whose matrix changed are refit
+    gFrameGraph.AddStage("bvh refit", []() {
+        PROFILE_SCOPE("bvh refit");
+        for (size_t i = 0; i < gScene.size(); ++i) {
+            gSceneBvh.SetObjectTransform((uint32_t)i, gModels[gScene[i].transform]);
+        }
+        gSceneBvh.Refit();
+    }, { transformStage });
+
+    //full clip space transform of every model, the cull test works on these directly
+    FrameGraph::StageId clipStage = gFrameGraph.AddStage("clip", []() {
+        PROFILE_SCOPE("clip");
+        const glm::mat4 viewProjection = gProjection * gView;
+
+        gJobs.ParallelFor(gTransforms.Size(), OBJECTS_PER_JOB, [&viewProjection](size_t begin, size_t end) {
+            MultiplyViewProjection(viewProjection, &gModels[begin], end - begin, &gModelViewProjections[begin]);
+        });
+    }, { cameraStage, transformStage });
+
+    //drop anything outside the view
+    FrameGraph::StageId cullStage = gFrameGraph.AddStage("cull", []() {
+        if (UGpuDriven()) {
+            return;
+        }
+        PROFILE_SCOPE("cull");
+        gJobs.ParallelFor(gScene.size(), OBJECTS_PER_JOB, [](size_t begin, size_t end) {
+            for (size_t i = begin; i < end; ++i) {
+                gScene[i].visible = UIsInFrustum(gModelViewProjections[gScene[i].transform], *gScene[i].mesh);
+            }
+        });
+
+        //static copies have no clip stage entry, their matrix is built here
+        const glm::mat4 viewProjection = gProjection * gView;
+        gJobs.ParallelFor(gStaticObjects.size(), OBJECTS_PER_JOB, [&viewProjection](size_t begin, size_t end) {
+            for (size_t i = begin; i < end; ++i) {
+                StaticObject& copy = gStaticObjects[i];
+                copy.visible = UIsInFrustum(viewProjection * copy.model, *gScene[copy.object].mesh);
+            }
+        });
+    }, { clipStage });
+
+    //what survived culling in draw order, by state and then front to back
+    gFrameGraph.AddStage("queue", []() {
+        gRenderQueue.Clear();
+        if (UGpuDriven()) {
+            return;
+        }
+        PROFILE_SCOPE("queue");
+        for (size_t i = 0; i < gScene.size() + gStaticObjects.size(); ++i) {
+            bool visible = i < gScene.size() ? gScene[i].visible : gStaticObjects[i - gScene.size()].visible;
+            if (!visible) {
+                continue;
+            }
+
+            const SceneObject& object = UItemObject((uint32_t)i);
+            glm::vec3 center = glm::vec3(UItemModel((uint32_t)i) * glm::vec4((object.mesh->boundsMin + object.mesh->boundsMax) * 0.5f, 1.0f));
+            float depth = glm::length(center - gRenderCamera.Position) / SORT_DEPTH_RANGE;
+            gRenderQueue.Submit(AddSortDepth(object.stateKey, depth), (uint32_t)i);
+        }
+        gRenderQueue.Sort();
+        gFrustumCulled = gScene.size() + gStaticObjects.size() - gRenderQueue.Items().size();
+    }, { cullStage });
+}
+
+
+//tests the mesh's local bounding box against the six planes of the view frustum
+bool UIsInFrustum(const glm::mat4& modelViewProjection, const GLMesh& mesh)
+{
+    glm::vec3 center = (mesh.boundsMin + mesh.boundsMax) * 0.5f;
+    glm::vec3 extent = (mesh.boundsMax - mesh.boundsMin) * 0.5f;
+
+    //planes come from adding/subtracting the rows of the matrix from the last one, in the mesh's own space
+    for (int row = 0; row < 3; ++row) {
+        for (int side = -1; side <= 1; side += 2) {
+            glm::vec4 plane;
+            for (int column = 0; column < 4; ++column) {
+                plane[column] = modelViewProjection[column][3] + side * modelViewProjection[column][row];
+            }
+
+            glm::vec3 normal(plane.x, plane.y, plane.z);
+            float distance = glm::dot(normal, center) + plane.w;
+            float radius = fabs(normal.x) * extent.x + fabs(normal.y) * extent.y + fabs(normal.z) * extent.z;
+            if (distance + radius < 0.0f) {
+                return false;
+            }
+        }
+    }
+
+    return true;
+}
+
+
+// Functioned called to render a frame
+void URender()
+{
+    gGLState.BeginFrame();
+
+    //camera, transforms and culling for this frame
+    {
+        PROFILE_SCOPE("frame graph");
+        gFrameGraph.Execute(gJobs);
+    }
+
+    if (gSoftwareRendering) {
+        URenderSoftware();
+        UPresentSoftware();
+    }
+    else {
+        URenderGL();
+    }
+
+    //readback of what's about to be shown, collected a few frames later
+    if (gCapture.Active()) {
+        PROFILE_SCOPE("capture");
+        int width, height;
+        glfwGetFramebufferSize(gWindow, &width, &height);
+        gCapture.Capture(gGLState, width, height);
+    }
+
+    //the swap and pacing waits aren't the frame's own cost. the GPU time lags a few frames behind,
+    //it's whichever of the two is slower that the scale has to bring down
+    double workTime = glfwGetTime() - gFrameWorkStart;
+    if (!gSoftwareRendering) {
+        workTime = std::max(workTime, gAntiAliasing.LastGpuTime());
+    }
+    gDynamicResolution.Update(workTime);
+
+    PROFILE_SCOPE("swap");
+    glfwSwapBuffers(gWindow);
+}
+
+
+//draws the visible objects with OpenGL
+void URenderGL()
+{
+    PROFILE_GPU_SCOPE("draw");
+
+    //into the anti-aliasing mode's target, or straight into the window when it's off and unscaled
+    int width, height, renderWidth, renderHeight;
+    glfwGetFramebufferSize(gWindow, &width, &height);
+    gDynamicResolution.ScaledSize(width, height, renderWidth, renderHeight);
+    gAntiAliasing.BeginScene(gGLState, renderWidth, renderHeight, width, height);
+
+    //enable z-depth
+    gGLState.Enable(GL_DEPTH_TEST);
+
+    //clear the frame and z buffers
+    gGLState.ClearColor(0.0f, 0.0f, 0.0f, 1.0f);
+    glClear(GL_COLOR_BUFFER_BIT | GL_DEPTH_BUFFER_BIT);
+
+    //waits only if the GPU is still reading this segment from three frames back
+    {
+        PROFILE_SCOPE("ring wait");
+        gUploadRing.BeginFrame();
+    }
+    const GLuint uploadBuffer = gUploadRing.Buffer();
+
+    //camera matrices and lights for every draw
+    RingAllocation frameData = gUploadRing.Allocate(sizeof(FrameUniforms));
+    if (frameData.Data) {
+        FrameUniforms* frame = (FrameUniforms*)frameData.Data;
+        frame->view = gView;
+        frame->projection = gAntiAliasing.JitterProjection(gProjection);
+        frame->viewPosition = glm::vec4(gRenderCamera.Position, 1.0f);
+        frame->lightCount = 1;
+        frame->lights[0].position = glm::vec4(gLightPosition, 1.0f);
+        frame->lights[0].color = glm::vec4(gLightColor, 1.0f);
+        gGLState.BindUniformRange(FRAME_DATA_BINDING, uploadBuffer, frameData.Offset, sizeof(FrameUniforms));
+    }
+
+    //everything culled and drawn from buffers the GPU fills, the CPU cost is per batch not per object
+    glm::mat4 viewProjection = gAntiAliasing.JitterProjection(gProjection) * gView;
+    if (UGpuDriven()) {
+        for (size_t i = 0; i < gScene.size(); ++i) {
+            gGpuCuller.SetModel(i, gModels[gScene[i].transform]);
+        }
+        {
+            PROFILE_GPU_SCOPE("gpu cull");
+            gGpuCuller.Cull(gGLState, viewProjection);
+        }
+        gGpuCuller.Draw(gGLState);
+    }
+
+    //sorted draws, only what differs from the previous item is set
+    if (!UGpuDriven()) {
+        gOcclusion.BeginFrame(gScene.size() + gStaticObjects.size(), gFrustumCulled);
+    }
+    gQueueStats = RenderQueueStats{ (uint32_t)gRenderQueue.Items().size(), 0, 0, 0 };
+    uint64_t previousKey = 0;
+    bool first = true;
+    for (const RenderItem& item : gRenderQueue.Items()) {
+        const SceneObject& object = UItemObject(item.Item);
+        PROFILE_GPU_SCOPE(object.name);
+
+        //model matrix goes in its own slice of the ring, a full ring skips the draw rather than stalling
+        RingAllocation drawData = gUploadRing.Allocate(sizeof(DrawUniforms));
+        if (!drawData.Data) {
+            continue;
+        }
+        DrawUniforms* uniforms = (DrawUniforms*)drawData.Data;
+        uniforms->model = UItemModel(item.Item);
+        uniforms->positionOffset = glm::vec4(object.mesh->positionOffset, 0.0f);
+        uniforms->positionScale = glm::vec4(object.mesh->positionScale, 0.0f);
+        uniforms->material = glm::vec4(object.material.Metallic, object.material.Roughness, 0.0f, 0.0f);
+        gGLState.BindUniformRange(DRAW_DATA_BINDING, uploadBuffer, drawData.Offset, sizeof(DrawUniforms));
+
+        if (first || SortKeyChanged(item.Key, previousKey, SORT_KEY_PROGRAM_SHIFT, SORT_KEY_PROGRAM_BITS)) {
+            gGLState.UseProgram(object.program);
+            ++gQueueStats.ProgramSwitches;
+        }
+
+        // bind textures being used, the lamp samples nothing so whatever is bound can stay
+        if (first || SortKeyChanged(item.Key, previousKey, SORT_KEY_MATERIAL_SHIFT, SORT_KEY_MATERIAL_BITS)) {
+            if (object.texture != 0) {
+                gGLState.ActiveTexture(GL_TEXTURE0);
+                gGLState.BindTexture(GL_TEXTURE_2D, object.texture);
+            }
+            ++gQueueStats.MaterialSwitches;
+        }
+
+        //tell program which mesh is being worked on
+        if (first || SortKeyChanged(item.Key, previousKey, SORT_KEY_MESH_SHIFT, SORT_KEY_MESH_BITS)) {
+            gGLState.BindVertexArray(object.mesh->vao);
+            ++gQueueStats.MeshSwitches;
+        }
+
+        // Draws the triangles, skipped by the GPU if the object's box was hidden last frame
+        bool conditional = !object.occluder && gOcclusion.BeginDraw(item.Item);
+        glDrawElements(GL_TRIANGLES, object.mesh->nIndices, GL_UNSIGNED_INT, nullptr);
+        gOcclusion.EndDraw(conditional);
+
+        previousKey = item.Key;
+        first = false;
+    }
+
+    gQueueTotals.Items += gQueueStats.Items;
+    gQueueTotals.ProgramSwitches += gQueueStats.ProgramSwitches;
+    gQueueTotals.MaterialSwitches += gQueueStats.MaterialSwitches;
+    gQueueTotals.MeshSwitches += gQueueStats.MeshSwitches;
+
+    //bounding boxes against the finished depth, for next frame's conditional draws
+    if (gOcclusion.Enabled && !gRenderQueue.Items().empty()) {
+        PROFILE_GPU_SCOPE("occlusion tests");
+        gOcclusion.BeginTests(gGLState);
+        for (const RenderItem& item : gRenderQueue.Items()) {
+            const SceneObject& object = UItemObject(item.Item);
+            if (!object.occluder) {
+                gOcclusion.Test(item.Item, viewProjection * UItemModel(item.Item), object.mesh->boundsMin, object.mesh->boundsMax);
+            }
+        }
+        gOcclusion.EndTests();
+    }
+
+    //resolve or filter into the back buffer
+    {
+        PROFILE_GPU_SCOPE("antialias");
+        gAntiAliasing.EndScene(gGLState, gProjection * gView);
+    }
+
+    //next frame's occlusion test runs against what this one drew
+    if (UGpuDriven()) {
+        PROFILE_GPU_SCOPE("depth pyramid");
+        gGpuCuller.BuildDepthPyramid(gGLState, gAntiAliasing.DepthTexture(), renderWidth, renderHeight, viewProjection);
+    }
+
+    //the segment can be reused once the GPU gets past this frame's draws
+    gUploadRing.EndFrame();
+}
+
+
+//draws the visible objects on the CPU into gSoftRenderer's image
+void URenderSoftware()
+{
+    PROFILE_SCOPE("draw software");
+
+    int width, height;
+    glfwGetFramebufferSize(gWindow, &width, &height);
+    gDynamicResolution.ScaledSize(width, height, width, height);
+    gSoftRenderer.Resize(width, height);
+
+    SoftLight light = { gLightPosition, gLightColor };
+    gSoftRenderer.BeginFrame(gView, gProjection, gRenderCamera.Position, &light, 1, glm::vec3(0.0f));
+
+    for (const RenderItem& item : gRenderQueue.Items()) {
+        const SceneObject& object = UItemObject(item.Item);
+        std::map<GLuint, SoftTexture>::const_iterator texture = gSoftTextures.find(object.texture);
+        const SoftTexture* softTexture = texture != gSoftTextures.end() ? &texture->second : nullptr;
+        if (!object.mesh->packedVertices.empty()) {
+            gSoftRenderer.Draw(object.mesh->packedVertices.data(), object.mesh->nVertices, object.mesh->indices.data(), object.mesh->nIndices,
+                object.mesh->positionOffset, object.mesh->positionScale, UItemModel(item.Item), softTexture, gUVScale, object.program == gProgramId);
+        }
+        else {
+            gSoftRenderer.Draw(object.mesh->vertices.data(), object.mesh->nVertices, object.mesh->indices.data(), object.mesh->nIndices,
+                UItemModel(item.Item), softTexture, gUVScale, object.program == gProgramId);
+        }
+    }
+
+    gSoftRenderer.EndFrame(gJobs);
+}
+
+
+//copies the software image to the window's back buffer, scaling it up if it was drawn smaller
+void UPresentSoftware()
+{
+    PROFILE_GPU_SCOPE("present software");
+
+    int width = gSoftRenderer.Width();
+    int height = gSoftRenderer.Height();
+    int windowWidth, windowHeight;
+    glfwGetFramebufferSize(gWindow, &windowWidth, &windowHeight);
+
+    //target texture is recreated whenever the window size changes
+    static int targetWidth = 0, targetHeight = 0;
+    if (gSoftwareFramebuffer == 0) {
+        glGenFramebuffers(1, &gSoftwareFramebuffer);
+    }
+    if (width != targetWidth || height != targetHeight) {
+        if (gSoftwareTarget != 0) {
+            gGLState.DeleteTexture(gSoftwareTarget);
+        }
+        glGenTextures(1, &gSoftwareTarget);
+        gGLState.ActiveTexture(GL_TEXTURE0);
+        gGLState.BindTexture(GL_TEXTURE_2D, gSoftwareTarget);
+        glTexStorage2D(GL_TEXTURE_2D, 1, GL_RGBA8, width, height);
+
+        gGLState.BindFramebuffer(GL_READ_FRAMEBUFFER, gSoftwareFramebuffer);
+        glFramebufferTexture2D(GL_READ_FRAMEBUFFER, GL_COLOR_ATTACHMENT0, GL_TEXTURE_2D, gSoftwareTarget, 0);
+        targetWidth = width;
+        targetHeight = height;
+    }
+
+    gGLState.ActiveTexture(GL_TEXTURE0);
+    gGLState.BindTexture(GL_TEXTURE_2D, gSoftwareTarget);
+    gGLState.PixelStore(GL_UNPACK_ALIGNMENT, 4);
+    glTexSubImage2D(GL_TEXTURE_2D, 0, 0, 0, width, height, GL_RGBA, GL_UNSIGNED_BYTE, gSoftRenderer.Pixels());
+
+    gGLState.BindFramebuffer(GL_READ_FRAMEBUFFER, gSoftwareFramebuffer);
+    gGLState.BindFramebuffer(GL_DRAW_FRAMEBUFFER, 0);
+    bool scaled = width != windowWidth || height != windowHeight;
+    glBlitFramebuffer(0, 0, width, height, 0, 0, windowWidth, windowHeight, GL_COLOR_BUFFER_BIT, scaled ? GL_LINEAR : GL_NEAREST);
+}
+
+
+//draws the first frame with OpenGL and with the software renderer and compares them pixel by pixel.
+//edges and texture filtering round a little differently, so a few off pixels are expected
+bool UValidateSoftwareRenderer()
+{
+    const int TOLERANCE = 16;               // per channel difference still counted as a match
+    const double MAX_MISMATCHED = 0.01;     // share of pixels allowed past the tolerance
+
+    //both at the window's size, a scaled image would be compared after filtering
+    gDynamicResolution.SetScale(1.0f);
+    gFrameGraph.Execute(gJobs);
+
+    URenderGL();
+    int width, height;
+    glfwGetFramebufferSize(gWindow, &width, &height);
+    std::vector<uint32_t> reference((size_t)width * height);
+    gGLState.BindFramebuffer(GL_READ_FRAMEBUFFER, 0);
+    gGLState.PixelStore(GL_PACK_ALIGNMENT, 4);
+    glReadBuffer(GL_BACK);
+    glReadPixels(0, 0, width, height, GL_RGBA, GL_UNSIGNED_BYTE, reference.data());
+
+    URenderSoftware();
+
+    size_t mismatched = 0;
+    double totalDifference = 0.0;
+    int largestDifference = 0;
+    const uint32_t* pixels = gSoftRenderer.Pixels();
+    for (size_t i = 0; i < reference.size(); ++i) {
+        int difference = 0;
+        for (int channel = 0; channel < 3; ++channel) {
+            int a = (reference[i] >> (channel * 8)) & 0xff;
+            int b = (pixels[i] >> (channel * 8)) & 0xff;
+            difference = std::max(difference, abs(a - b));
+        }
+        totalDifference += difference;
+        largestDifference = std::max(largestDifference, difference);
+        if (difference > TOLERANCE) {
+            ++mismatched;
+        }
+    }
+
+    double mismatchedShare = reference.empty() ? 0.0 : (double)mismatched / reference.size();
+    cout << "Software vs GL at " << width << "x" << height << ": mean difference " << (reference.empty() ? 0.0 : totalDifference / reference.size())
+        << ", largest " << largestDifference << ", " << mismatchedShare * 100.0 << "% of pixels off by more than " << TOLERANCE << endl;
+
+    return mismatchedShare <= MAX_MISMATCHED;
+}
+
+
+//draws every golden view with the selected renderer and compares it with its reference. each view is
+//drawn twice and the second frame is used, so culling that feeds back a frame late has settled on it
+bool URunGoldenTest()
+{
+    //at the window's size with nothing carried over between views
+    gDynamicResolution.SetScale(1.0f);
+    gInterpolation = 1.0f;
+
+    int passed = 0;
+    int viewCount = (int)(sizeof(GOLDEN_VIEWS) / sizeof(GOLDEN_VIEWS[0]));
+    for (const GoldenView& view : GOLDEN_VIEWS) {
+        gCamera.SetPose(view.position, view.yaw, view.pitch);
+        gPreviousCamera = gCamera;
+        gAntiAliasing.SetMode(gAntiAliasing.Mode());
+
+        int width = 0, height = 0;
+        std::vector<unsigned char> pixels;
+        for (int frame = 0; frame < 2; ++frame) {
+            gFrameGraph.Execute(gJobs);
+            if (gSoftwareRendering) {
+                URenderSoftware();
+            }
+            else {
+                URenderGL();
+            }
+        }
+        if (gSoftwareRendering) {
+            width = gSoftRenderer.Width();
+            height = gSoftRenderer.Height();
+            const unsigned char* image = (const unsigned char*)gSoftRenderer.Pixels();
+            pixels.assign(image, image + (size_t)width * height * 4);
+        }
+        else {
+            glfwGetFramebufferSize(gWindow, &width, &height);
+            pixels.resize((size_t)width * height * 4);
+            gGLState.BindFramebuffer(GL_READ_FRAMEBUFFER, 0);
+            gGLState.PixelStore(GL_PACK_ALIGNMENT, 4);
+            glReadBuffer(GL_BACK);
+            glReadPixels(0, 0, width, height, GL_RGBA, GL_UNSIGNED_BYTE, pixels.data());
+        }
+        FlipRows(pixels.data(), width, height, 4);
+        for (size_t i = 3; i < pixels.size(); i += 4) {
+            pixels[i] = 255;
+        }
+
+        std::string folder = gGoldenFolder;
+        std::string referenceFile = folder + "/" + view.name + ".png";
+        if (gGoldenUpdate) {
+            if (stbi_write_png(referenceFile.c_str(), width, height, 4, pixels.data(), width * 4)) {
+                cout << "Golden " << view.name << ": wrote " << referenceFile << endl;
+                ++passed;
+            }
+            else {
+                cout << "Golden " << view.name << ": failed to write " << referenceFile << endl;
+            }
+            continue;
+        }
+
+        int referenceWidth = 0, referenceHeight = 0, channels = 0;
+        stbi_set_flip_vertically_on_load(false);
+        unsigned char* reference = stbi_load(referenceFile.c_str(), &referenceWidth, &referenceHeight, &channels, 4);
+        if (!reference) {
+            cout << "Golden " << view.name << ": no reference " << referenceFile << ", --golden-update writes one" << endl;
+            continue;
+        }
+        if (referenceWidth != width || referenceHeight != height) {
+            cout << "Golden " << view.name << ": reference is " << referenceWidth << "x" << referenceHeight << ", drawn at "
+                << width << "x" << height << endl;
+            stbi_image_free(reference);
+            continue;
+        }
+
+        std::vector<unsigned char> diff;
+        ImageDifference difference = CompareImages(reference, pixels.data(), width, height, 4, &diff);
+        stbi_image_free(reference);
+        bool pass = difference.Ssim >= gGoldenThreshold && difference.WorstBlockSsim >= gGoldenWorstThreshold;
+        cout << "Golden " << view.name << ": SSIM " << difference.Ssim << " (worst block " << difference.WorstBlockSsim << ", worst window "
+            << difference.WorstSsim << "), mean difference "
+            << difference.MeanDifference << ", largest " << difference.LargestDifference << (pass ? ", pass" : ", FAIL") << endl;
+        if (pass) {
+            ++passed;
+            continue;
+        }
+
+        //next to the build instead of the references, which are checked in
+        std::string actualFile = GOLDEN_OUTPUT_PREFIX + std::string(view.name) + "_actual.png";
+        std::string diffFile = GOLDEN_OUTPUT_PREFIX + std::string(view.name) + "_diff.png";
+        stbi_write_png(actualFile.c_str(), width, height, 4, pixels.data(), width * 4);
+        stbi_write_png(diffFile.c_str(), width, height, 3, diff.data(), width * 3);
+        cout << "Golden " << view.name << ": wrote " << actualFile << " and " << diffFile << endl;
+    }
+
+    if (gGoldenUpdate) {
+        cout << "Golden images: " << passed << " of " << viewCount << " written" << endl;
+    }
+    else {
+        cout << "Golden images: " << passed << " of " << viewCount << " passed at SSIM >= " << gGoldenThreshold
+            << " with no block below " << gGoldenWorstThreshold << endl;
+    }
+    return passed == viewCount;
+}
+
+
+//creates the mesh for the light
+void UCreateCubeMesh(GLMesh& mesh)
+{
+    std::vector<GLfloat> verts;
+    BuildCubeVertices(verts);
+    UCreateMeshBuffers(mesh, verts.data(), verts.size() * sizeof(GLfloat));
+}
+
+void UCreateKnifeHandleMesh(GLMesh& mesh)
+{
+    std::vector<GLfloat> verts;
+    BuildKnifeHandleVertices(verts);
+    UCreateMeshBuffers(mesh, verts.data(), verts.size() * sizeof(GLfloat));
+}
+
+void UCreateKnifeBladeMesh(GLMesh& mesh)
+{
+    std::vector<GLfloat> verts;
+    BuildKnifeBladeVertices(verts);
+    UCreateMeshBuffers(mesh, verts.data(), verts.size() * sizeof(GLfloat));
+}
+
+void UCreateCuttingBoardMesh(GLMesh& mesh)
+{
+    std::vector<GLfloat> verts;
+    BuildCuttingBoardVertices(verts);
+    UCreateMeshBuffers(mesh, verts.data(), verts.size() * sizeof(GLfloat));
+}
+
+void UCreatePlaneMesh(GLMesh& mesh)
+{
+    std::vector<GLfloat> verts;
+    BuildPlaneVertices(verts);
+    UCreateMeshBuffers(mesh, verts.data(), verts.size() * sizeof(GLfloat));
+}
+
+//creates the mesh for the salami ends
+void UCreateSalamiEndsMesh(GLMesh& mesh) {
+    std::vector<GLfloat> verts;
+    BuildSalamiEndsVertices(verts);
+    UCreateMeshBuffers(mesh, verts.data(), verts.size() * sizeof(GLfloat));
+}
+
+//creates the mesh for the salami body
+void UCreateSalamiBodyMesh(GLMesh& mesh) {
+    std::vector<GLfloat> verts;
+    BuildSalamiBodyVertices(verts);
+    UCreateMeshBuffers(mesh, verts.data(), verts.size() * sizeof(GLfloat));
+}
+
+//creates the mesh for the light
+void UCreateCheeseMesh(GLMesh& mesh)
+{
+    std::vector<GLfloat> verts;
+    BuildCheeseVertices(verts);
+    UCreateMeshBuffers(mesh, verts.data(), verts.size() * sizeof(GLfloat));
+}
+
+//load the texture
+bool UCreateTexture(const char* filename, GLuint& textureId, int position) {
+    if (position == 0) {
+        glActiveTexture(GL_TEXTURE0);
+    }
+    else if (position == 1) {
+        glActiveTexture(GL_TEXTURE1);
+    }
+    else if (position == 2) {
+        glActiveTexture(GL_TEXTURE2);
+    }
+    else if (position == 3) {
+        glActiveTexture(GL_TEXTURE3);
+    }
+    else if (position == 4) {
+        glActiveTexture(GL_TEXTURE4);
+    }
+    else if (position == 5) {
+        glActiveTexture(GL_TEXTURE5);
+    }
+    else if (position == 6) {
+        glActiveTexture(GL_TEXTURE6);
+    }
+
+    glGenTextures(1, &textureId);
+    glBindTexture(GL_TEXTURE_2D, textureId);
+
+    //set tex wrapping param
+    glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_WRAP_S, GL_REPEAT);
+    glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_WRAP_T, GL_REPEAT);
+
+    //set tex filtering param
+    glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MIN_FILTER, GL_LINEAR);
+    glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MAG_FILTER, GL_LINEAR);
+
+    //load image, create tex, and generate mipmaps
+    double start = glfwGetTime();
+    int width, height, channels;
+    unsigned char* image = LoadTextureImage(filename, width, height, channels);
+    if (image) {
+        //bottom row first for GL, and RGBA so the upload is a straight copy whatever the file held
+        FlipImageVertically(image, width, height, channels, &gJobs);
+        std::vector<unsigned char> pixels((size_t)width * height * 4);
+        ExpandToRgba(image, width, height, channels, pixels.data(), &gJobs);
+        stbi_image_free(image);
+
+        gGLState.PixelStore(GL_UNPACK_ALIGNMENT, 4);
+        glTexImage2D(GL_TEXTURE_2D, 0, GL_RGBA8, width, height, 0, GL_RGBA, GL_UNSIGNED_BYTE, pixels.data());
+        if (gMipFilterOnCpu) {
+            //filtered here in linear space, and sampled trilinearly so the choice of filter shows
+            std::vector<MipLevel> levels;
+            BuildMipChain(pixels.data(), width, height, gMipFilter, levels, &gJobs);
+            for (size_t level = 0; level < levels.size(); ++level) {
+                glTexImage2D(GL_TEXTURE_2D, (GLint)level + 1, GL_RGBA8, levels[level].Width, levels[level].Height, 0, GL_RGBA,
+                    GL_UNSIGNED_BYTE, levels[level].Pixels.data());
+            }
+            glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MAX_LEVEL, (GLint)levels.size());
+            glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MIN_FILTER, GL_LINEAR_MIPMAP_LINEAR);
+        }
+        else {
+            glGenerateMipmap(GL_TEXTURE_2D);
+        }
+
+        //the software renderer samples its own copy
+        if (gSoftwareRendering || gValidateSoftware) {
+            SoftTexture& copy = gSoftTextures[textureId];
+            copy.Width = width;
+            copy.Height = height;
+            copy.Channels = 4;
+            copy.Texels.swap(pixels);
+        }
+        gTextureImportTime += glfwGetTime() - start;
+
+        //unbinds the texture
+        glBindTexture(GL_TEXTURE_2D, position);
+
+        return true;
+    }
+    else {
+        return false;
+    }
+}
+
+//destroys texture 
+void UDestroyTexture(GLuint textureId) {
+    glGenTextures(1, &textureId);
+}
+
+
+//welds and optimizes interleaved position/normal/uv vertices, uploads them with their index buffer and
+//sets up the attribute layout shared by every mesh. the packed format quantizes them first, the
+//shaders and the software renderer undo it per draw
+void UCreateMeshBuffers(GLMesh& mesh, const GLfloat* verts, size_t vertsSize)
+{
+    const GLuint floatsPerVertex = 3;
+    const GLuint floatsPerNormal = 3;
+    const GLuint floatsPerUV = 2;
+    const GLuint floatsPerEntry = floatsPerVertex + floatsPerNormal + floatsPerUV;
+
+    size_t sourceVertices = vertsSize / (sizeof(verts[0]) * floatsPerEntry);
+
+    //positions for the BVH and their bounding box
+    ExtractPositions(verts, sourceVertices, mesh.positions, mesh.boundsMin, mesh.boundsMax);
+
+    //shared corners become one vertex, then triangles are ordered for the post transform cache and
+    //overdraw and vertices for fetch
+    OptimizedMesh optimized;
+    OptimizeMesh(verts, sourceVertices, floatsPerEntry, optimized);
+    mesh.nVertices = optimized.Vertices.size() / floatsPerEntry;
+    mesh.nIndices = optimized.Indices.size();
+    mesh.meshlets.swap(optimized.Meshlets);
+    gSourceVertices += sourceVertices;
+    gCacheBefore += optimized.Before;
+    gCacheAfter += optimized.After;
+    gMeshletCount += mesh.meshlets.size();
+
+    glGenVertexArrays(1, &mesh.vao);
+    glBindVertexArray(mesh.vao);
+
+    //create 3 buffers, the index one is recorded in the vertex array
+    glGenBuffers(1, &mesh.vbo);
+    glBindBuffer(GL_ARRAY_BUFFER, mesh.vbo);
+    glGenBuffers(1, &mesh.ebo);
+    glBindBuffer(GL_ELEMENT_ARRAY_BUFFER, mesh.ebo);
+    glBufferData(GL_ELEMENT_ARRAY_BUFFER, optimized.Indices.size() * sizeof(GLuint), optimized.Indices.data(), GL_STATIC_DRAW);
+    gFloatVertexBytes += optimized.Vertices.size() * sizeof(float);
+
+    //indices stay on the CPU for the software renderer
+    mesh.indices.swap(optimized.Indices);
+
+    if (gPackedVertices) {
+        //16 bit positions within the bounds, 10:10:10:2 normals and half float uvs, all normalized
+        //by the vertex fetch so the shaders still see floats
+        PackedMesh packed;
+        CompressMesh(optimized.Vertices.data(), mesh.nVertices, packed);
+        mesh.positionOffset = packed.PositionOffset;
+        mesh.positionScale = packed.PositionScale;
+        gMaxPositionError = max(gMaxPositionError, packed.MaxPositionError);
+        gMaxNormalError = max(gMaxNormalError, packed.MaxNormalError);
+
+        GLsizeiptr bytes = packed.Vertices.size() * sizeof(PackedVertex);
+        glBufferData(GL_ARRAY_BUFFER, bytes, packed.Vertices.data(), GL_STATIC_DRAW);
+        gVertexBytes += bytes;
+
+        GLint stride = sizeof(PackedVertex);
+        glVertexAttribPointer(0, 3, GL_UNSIGNED_SHORT, GL_TRUE, stride, (void*)offsetof(PackedVertex, Position));
+        glEnableVertexAttribArray(0);
+
+        glVertexAttribPointer(1, 4, GL_INT_2_10_10_10_REV, GL_TRUE, stride, (void*)offsetof(PackedVertex, Normal));
+        glEnableVertexAttribArray(1);
+
+        glVertexAttribPointer(2, 2, GL_HALF_FLOAT, GL_FALSE, stride, (void*)offsetof(PackedVertex, TexCoord));
+        glEnableVertexAttribArray(2);
+
+        //vertices stay on the CPU for the software renderer
+        mesh.packedVertices.swap(packed.Vertices);
+        mesh.vertices.clear();
+        return;
+    }
+
+    mesh.positionOffset = glm::vec3(0.0f);
+    mesh.positionScale = glm::vec3(1.0f);
+    GLsizeiptr bytes = optimized.Vertices.size() * sizeof(float);
+    glBufferData(GL_ARRAY_BUFFER, bytes, optimized.Vertices.data(), GL_STATIC_DRAW);
+    gVertexBytes += bytes;
+
+    //stride between vertexs
+    GLint stride = sizeof(float) * floatsPerEntry;
+
+    //create atribute pointers
+    glVertexAttribPointer(0, floatsPerVertex, GL_FLOAT, GL_FALSE, stride, 0);
+    glEnableVertexAttribArray(0);
+
+    glVertexAttribPointer(1, floatsPerNormal, GL_FLOAT, GL_FALSE, stride, (void*)(sizeof(float) * floatsPerVertex));
+    glEnableVertexAttribArray(1);
+
+    glVertexAttribPointer(2, floatsPerUV, GL_FLOAT, GL_FALSE, stride, (void*)(sizeof(float) * (floatsPerVertex + floatsPerNormal)));
+    glEnableVertexAttribArray(2);
+
+    //vertices stay on the CPU for the software renderer
+    mesh.vertices.swap(optimized.Vertices);
+    mesh.packedVertices.clear();
+}
+
+
+void UDestroyMesh(GLMesh& mesh) {
+    glDeleteVertexArrays(1, &mesh.vao);
+    glDeleteBuffers(1, &mesh.vbo);
+    glDeleteBuffers(1, &mesh.ebo);
+}
+
+//implements the UCreateShaders function
+bool UCreateShaderProgram(const char* vtxShaderSource, const char* fragShaderSource, GLuint& programId)
+{
+    //compilation and error reporting
+    int success = 0;
+    char infoLog[512];
+
+    //creates shader object.
+    programId = glCreateProgram();
+
+    //create the vertex and shader objects
+    GLuint vertexShaderId = glCreateShader(GL_VERTEX_SHADER);
+    GLuint fragmentShaderId = glCreateShader(GL_FRAGMENT_SHADER);
+
+    //retrive shader source
+    glShaderSource(vertexShaderId, 1, &vtxShaderSource, NULL);
+    glShaderSource(fragmentShaderId, 1, &fragShaderSource, NULL);
+
+    //compile vertex shader and print compilation errors 
+    glCompileShader(vertexShaderId);
+    glGetShaderiv(vertexShaderId, GL_COMPILE_STATUS, &success);
+    if (!success)
+    {
+        glGetShaderInfoLog(vertexShaderId, 512, NULL, infoLog);
+        std::cout << "ERROR::SHADER::VERTEX::COMPILATION_FAILED\n" << infoLog << std::endl;
+        return false;
+    }
+
+    glCompileShader(fragmentShaderId);
+
+    glGetShaderiv(fragmentShaderId, GL_COMPILE_STATUS, &success);
+    if (!success)
+    {
+        glGetShaderInfoLog(fragmentShaderId, sizeof(infoLog), NULL, infoLog);
+        std::cout << "ERROR::SHADER::FRAGMENT::COMPILATION_FAILED\n" << infoLog << std::endl;
+        return false;
+    }
+
+    //attached compiled shaders to the shader program
+    glAttachShader(programId, vertexShaderId);
+    glAttachShader(programId, fragmentShaderId);
+
+    glLinkProgram(programId);
+    //check for linking errors
+    glGetProgramiv(programId, GL_LINK_STATUS, &success);
+    if (!success)
+    {
+        glGetProgramInfoLog(programId, sizeof(infoLog), NULL, infoLog);
+        std::cout << "ERROR::SHADER::PROGRAM::LINKING_FAILED\n" << infoLog << std::endl;
+        return false;
+    }
+
+
+    glUseProgram(programId);
+
+    return true;
+}
+
+
+//compiles and links a single compute shader
+bool UCreateComputeProgram(const char* shaderSource, GLuint& programId)
+{
+    //compilation and error reporting
+    int success = 0;
+    char infoLog[512];
+
+    programId = glCreateProgram();
+    GLuint computeShaderId = glCreateShader(GL_COMPUTE_SHADER);
+    glShaderSource(computeShaderId, 1, &shaderSource, NULL);
+
+    glCompileShader(computeShaderId);
+    glGetShaderiv(computeShaderId, GL_COMPILE_STATUS, &success);
+    if (!success)
+    {
+        glGetShaderInfoLog(computeShaderId, sizeof(infoLog), NULL, infoLog);
+        std::cout << "ERROR::SHADER::COMPUTE::COMPILATION_FAILED\n" << infoLog << std::endl;
+        return false;
+    }
+
+    glAttachShader(programId, computeShaderId);
+    glLinkProgram(programId);
+    glGetProgramiv(programId, GL_LINK_STATUS, &success);
+    if (!success)
+    {
+        glGetProgramInfoLog(programId, sizeof(infoLog), NULL, infoLog);
+        std::cout << "ERROR::SHADER::PROGRAM::LINKING_FAILED\n" << infoLog << std::endl;
+        return false;
+    }
+
+    return true;
+}
+
+
+void UDestroyShaderProgram(GLuint programId)
+{
+    glDeleteProgram(programId);
+}
+
+
+//puts the main timings in the window title every so often
+void UShowProfile()
+{
+    static double lastUpdate = 0.0;
+    double now = glfwGetTime();
+    if (!gProfileOverlay || now - lastUpdate < PROFILE_OVERLAY_INTERVAL) {
+        return;
+    }
+    lastUpdate = now;
+
+    const Profiler& profiler = Profiler::Instance();
+    const ProfileStat* frame = profiler.Find("frame");
+    const ProfileStat* graph = profiler.Find("frame graph");
+    const ProfileStat* draw = profiler.Find(gSoftwareRendering ? "draw software" : "draw");
+    const ProfileStat* swap = profiler.Find("swap");
+
+    std::ostringstream title;
+    title.setf(std::ios::fixed);
+    title.precision(2);
+    title << WINDOW_TITLE;
+    if (frame != nullptr) {
+        title << " - frame " << frame->Cpu << " ms (max " << frame->CpuMax << ")";
+    }
+    if (graph != nullptr) {
+        title << " | frame graph " << graph->Cpu;
+    }
+    if (draw != nullptr) {
+        title << " | draw cpu " << draw->Cpu;
+        if (draw->HasGpu) {
+            title << " gpu " << draw->Gpu;
+        }
+    }
+    if (swap != nullptr) {
+        title << " | swap " << swap->Cpu;
+    }
+    title << " | " << gQueueStats.Items << " draws, " << gQueueStats.ProgramSwitches << " programs, " << gQueueStats.MaterialSwitches << " textures";
+    if (!gSoftwareRendering) {
+        title << " | aa " << ANTI_ALIAS_MODE_NAMES[gAntiAliasing.Mode()];
+    }
+    title << " | scale " << gDynamicResolution.Scale();
+    if (gDynamicResolution.Budget > 0.0) {
+        title << ", " << gDynamicResolution.Misses() << " over budget";
+    }
+    title << " | gl state " << gGLState.LastFrame().Issued << " set, " << gGLState.LastFrame().Redundant << " redundant";
+    glfwSetWindowTitle(gWindow, title.str().c_str());
+}
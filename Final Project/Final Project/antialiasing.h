@@ -0,0 +1,411 @@
+#ifndef ANTIALIASING_H
+#define ANTIALIASING_H
+
+#include <GL/glew.h>
+#include <glm/glm.hpp>
+#include <glm/gtc/matrix_transform.hpp>
+#include <glm/gtc/type_ptr.hpp>
+
+#include <chrono>
+#include <cstdint>
+#include <cstring>
+
+#include "glstate.h"
+
+//ways the GL path can smooth edges
+enum AntiAliasMode {
+    AA_OFF,
+    AA_MSAA2,
+    AA_MSAA4,
+    AA_MSAA8,
+    AA_FXAA,    // edge blur post pass on the finished image
+    AA_TAA,     // jittered frames blended with the reprojected history
+    AA_MODE_COUNT
+};
+
+//names used on the command line and in the cost report, same order as AntiAliasMode
+const char* const ANTI_ALIAS_MODE_NAMES[AA_MODE_COUNT] = { "off", "msaa2", "msaa4", "msaa8", "fxaa", "taa" };
+
+//anti-aliasing values
+const int TAA_JITTER_COUNT = 8;             // Halton(2, 3) points cycled through
+const float TAA_CURRENT_WEIGHT = 0.1f;      // share of the new frame in the blend, the rest is history
+const int AA_TIMER_FRAMES = 4;              // timer queries in flight before one is read back
+
+//time spent drawing the scene and resolving it, per mode
+struct AntiAliasCost {
+    uint64_t Frames;
+    double CpuTime;     // seconds in total
+    uint64_t GpuFrames;
+    double GpuTime;
+};
+
+//owns the offscreen targets and passes for the selected mode. the scene is drawn between
+//BeginScene and EndScene, which leaves the anti-aliased image in the window's back buffer.
+//the scene can be drawn smaller than the window, it's then upscaled bilinearly, or by the
+//FXAA pass itself under FXAA so edges stay sharp. the post pass programs are compiled by the
+//caller with the rest of the shaders
+class AntiAliasing {
+public:
+    AntiAliasing() : mode(AA_OFF), width(0), height(0), outputWidth(0), outputHeight(0), lastGpuTime(0.0), fxaaProgram(0), taaProgram(0), emptyVao(0),
+        msaaFramebuffer(0), msaaColor(0), msaaDepth(0), sceneFramebuffer(0), sceneColor(0), sceneDepth(0),
+        historyIndex(0), historyValid(false), frameIndex(0), keepDepth(false), timerIndex(0), timerStarted(false) {
+        memset(historyFramebuffers, 0, sizeof(historyFramebuffers));
+        memset(historyTextures, 0, sizeof(historyTextures));
+        memset(timers, 0, sizeof(timers));
+        memset(timerModes, 0, sizeof(timerModes));
+        memset(timerPending, 0, sizeof(timerPending));
+        memset(costs, 0, sizeof(costs));
+    }
+
+    //programs take the fullscreen triangle's uv and sample sceneColor on unit 0. TAA also reads
+    //sceneDepth on unit 1 and history on unit 2
+    void Create(GLuint fxaa, GLuint taa) {
+        fxaaProgram = fxaa;
+        taaProgram = taa;
+        glGenVertexArrays(1, &emptyVao);
+        glGenQueries(AA_TIMER_FRAMES, timers);
+
+        glUseProgram(fxaaProgram);
+        glUniform1i(glGetUniformLocation(fxaaProgram, "sceneColor"), 0);
+        glUseProgram(taaProgram);
+        glUniform1i(glGetUniformLocation(taaProgram, "sceneColor"), 0);
+        glUniform1i(glGetUniformLocation(taaProgram, "sceneDepth"), 1);
+        glUniform1i(glGetUniformLocation(taaProgram, "history"), 2);
+        glUseProgram(0);
+    }
+
+    void Destroy(GLStateCache& state) {
+        destroyTargets(state);
+        glDeleteVertexArrays(1, &emptyVao);
+        glDeleteQueries(AA_TIMER_FRAMES, timers);
+        emptyVao = 0;
+    }
+
+    AntiAliasMode Mode() const {
+        return mode;
+    }
+
+    void SetMode(AntiAliasMode newMode) {
+        mode = newMode;
+        width = height = 0; // targets are rebuilt on the next BeginScene
+    }
+
+    //keeps the scene's depth in a texture whatever the mode, for passes that read it after EndScene
+    void SetKeepDepth(bool keep) {
+        keepDepth = keep;
+        width = height = 0;
+    }
+
+    //single sample depth of the last scene, 0 when the mode draws straight into the window
+    GLuint DepthTexture() const {
+        return sceneDepth;
+    }
+
+    static AntiAliasMode FindMode(const char* name) {
+        for (int i = 0; i < AA_MODE_COUNT; ++i) {
+            if (strcmp(ANTI_ALIAS_MODE_NAMES[i], name) == 0) {
+                return (AntiAliasMode)i;
+            }
+        }
+        return AA_MODE_COUNT;
+    }
+
+    //moves the projection by this frame's sub-pixel offset, only under TAA
+    glm::mat4 JitterProjection(const glm::mat4& projection) const {
+        if (mode != AA_TAA || width == 0 || height == 0) {
+            return projection;
+        }
+        glm::vec2 offset = jitter();
+        return glm::translate(glm::mat4(1.0f), glm::vec3(offset.x, offset.y, 0.0f)) * projection;
+    }
+
+    //points drawing at the target for the mode, rebuilding it if the render size changed. the
+    //scene is drawn at width x height and ends up in the window at outWidth x outHeight
+    void BeginScene(GLStateCache& state, int newWidth, int newHeight, int outWidth, int outHeight) {
+        bool wasScaled = isScaled();
+        outputWidth = outWidth;
+        outputHeight = outHeight;
+        if (newWidth != width || newHeight != height || isScaled() != wasScaled) {
+            createTargets(state, newWidth, newHeight);
+        }
+
+        readTimers();
+        cpuStart = std::chrono::steady_clock::now();
+        if (!timerPending[timerIndex]) {
+            glBeginQuery(GL_TIME_ELAPSED, timers[timerIndex]);
+            timerStarted = true;
+        }
+
+        if (isMultisampled()) {
+            state.BindFramebuffer(GL_FRAMEBUFFER, msaaFramebuffer);
+        }
+        else if (sceneFramebuffer != 0) {
+            state.BindFramebuffer(GL_FRAMEBUFFER, sceneFramebuffer);
+        }
+        else {
+            state.BindFramebuffer(GL_FRAMEBUFFER, 0);
+        }
+        state.Viewport(0, 0, width, height);
+    }
+
+    //resolves or filters the scene into the back buffer. viewProjection is the frame's unjittered one,
+    //TAA uses it to find where each pixel was in the previous frame
+    void EndScene(GLStateCache& state, const glm::mat4& viewProjection) {
+        if (isMultisampled()) {
+            //a multisampled blit can't scale, so a smaller image is resolved first and scaled after.
+            //depth comes along when it's being kept
+            state.BindFramebuffer(GL_READ_FRAMEBUFFER, msaaFramebuffer);
+            state.BindFramebuffer(GL_DRAW_FRAMEBUFFER, sceneFramebuffer);
+            glBlitFramebuffer(0, 0, width, height, 0, 0, width, height,
+                sceneFramebuffer != 0 ? GL_COLOR_BUFFER_BIT | GL_DEPTH_BUFFER_BIT : GL_COLOR_BUFFER_BIT, GL_NEAREST);
+            if (sceneFramebuffer != 0) {
+                present(state, sceneFramebuffer);
+            }
+        }
+        else if (mode == AA_FXAA) {
+            state.BindFramebuffer(GL_FRAMEBUFFER, 0);
+            state.Viewport(0, 0, outputWidth, outputHeight);
+            beginFullscreen(state, fxaaProgram);
+            glUniform2f(glGetUniformLocation(fxaaProgram, "texelSize"), 1.0f / width, 1.0f / height);
+            glDrawArrays(GL_TRIANGLES, 0, 3);
+        }
+        else if (mode == AA_TAA) {
+            int next = 1 - historyIndex;
+            state.BindFramebuffer(GL_FRAMEBUFFER, historyFramebuffers[next]);
+            beginFullscreen(state, taaProgram);
+            state.ActiveTexture(GL_TEXTURE1);
+            state.BindTexture(GL_TEXTURE_2D, sceneDepth);
+            state.ActiveTexture(GL_TEXTURE2);
+            state.BindTexture(GL_TEXTURE_2D, historyTextures[historyIndex]);
+            state.ActiveTexture(GL_TEXTURE0);
+
+            //clip position this frame -> clip position last frame, jitter is taken off in the shader
+            glm::mat4 reprojection = previousViewProjection * glm::inverse(viewProjection);
+            glm::vec2 offset = jitter();
+            glUniformMatrix4fv(glGetUniformLocation(taaProgram, "reprojection"), 1, GL_FALSE, glm::value_ptr(reprojection));
+            glUniform2f(glGetUniformLocation(taaProgram, "jitter"), offset.x, offset.y);
+            glUniform2f(glGetUniformLocation(taaProgram, "texelSize"), 1.0f / width, 1.0f / height);
+            glUniform1f(glGetUniformLocation(taaProgram, "currentWeight"), historyValid ? TAA_CURRENT_WEIGHT : 1.0f);
+            glDrawArrays(GL_TRIANGLES, 0, 3);
+
+            present(state, historyFramebuffers[next]);
+
+            historyIndex = next;
+            historyValid = true;
+            previousViewProjection = viewProjection;
+        }
+        else if (sceneFramebuffer != 0) {
+            present(state, sceneFramebuffer);
+        }
+        state.Viewport(0, 0, outputWidth, outputHeight);
+
+        if (timerStarted) {
+            glEndQuery(GL_TIME_ELAPSED);
+            timerPending[timerIndex] = true;
+            timerModes[timerIndex] = mode;
+            timerStarted = false;
+        }
+        timerIndex = (timerIndex + 1) % AA_TIMER_FRAMES;
+
+        AntiAliasCost& cost = costs[mode];
+        ++cost.Frames;
+        cost.CpuTime += std::chrono::duration<double>(std::chrono::steady_clock::now() - cpuStart).count();
+        ++frameIndex;
+    }
+
+    const AntiAliasCost& Cost(AntiAliasMode costMode) const {
+        return costs[costMode];
+    }
+
+    //GPU time of the most recent frame whose timer has come back
+    double LastGpuTime() const {
+        return lastGpuTime;
+    }
+
+private:
+    AntiAliasMode mode;
+    int width;          // size the scene is drawn at
+    int height;
+    int outputWidth;    // size of the window it's shown in
+    int outputHeight;
+    double lastGpuTime;
+
+    GLuint fxaaProgram;
+    GLuint taaProgram;
+    GLuint emptyVao;    // the fullscreen triangle is generated from gl_VertexID
+
+    GLuint msaaFramebuffer;
+    GLuint msaaColor;
+    GLuint msaaDepth;
+
+    GLuint sceneFramebuffer;
+    GLuint sceneColor;
+    GLuint sceneDepth;
+
+    GLuint historyFramebuffers[2];
+    GLuint historyTextures[2];
+    int historyIndex;
+    bool historyValid;
+    glm::mat4 previousViewProjection;
+    uint64_t frameIndex;
+    bool keepDepth;
+
+    GLuint timers[AA_TIMER_FRAMES];
+    AntiAliasMode timerModes[AA_TIMER_FRAMES];
+    bool timerPending[AA_TIMER_FRAMES];
+    int timerIndex;
+    bool timerStarted;
+    std::chrono::steady_clock::time_point cpuStart;
+
+    AntiAliasCost costs[AA_MODE_COUNT];
+
+    bool isMultisampled() const {
+        return mode == AA_MSAA2 || mode == AA_MSAA4 || mode == AA_MSAA8;
+    }
+
+    bool isScaled() const {
+        return width != outputWidth || height != outputHeight;
+    }
+
+    //copies a finished image into the window, filtered when the sizes differ
+    void present(GLStateCache& state, GLuint framebuffer) {
+        state.BindFramebuffer(GL_READ_FRAMEBUFFER, framebuffer);
+        state.BindFramebuffer(GL_DRAW_FRAMEBUFFER, 0);
+        glBlitFramebuffer(0, 0, width, height, 0, 0, outputWidth, outputHeight, GL_COLOR_BUFFER_BIT, isScaled() ? GL_LINEAR : GL_NEAREST);
+    }
+
+    int samples() const {
+        return mode == AA_MSAA2 ? 2 : mode == AA_MSAA4 ? 4 : mode == AA_MSAA8 ? 8 : 1;
+    }
+
+    //Halton(2, 3) in -1..1 pixel units, converted to clip space
+    glm::vec2 jitter() const {
+        int index = (int)(frameIndex % TAA_JITTER_COUNT) + 1;
+        glm::vec2 point(halton(index, 2), halton(index, 3));
+        return (point - glm::vec2(0.5f)) * glm::vec2(2.0f / width, 2.0f / height);
+    }
+
+    static float halton(int index, int base) {
+        float result = 0.0f;
+        float fraction = 1.0f;
+        while (index > 0) {
+            fraction /= base;
+            result += fraction * (index % base);
+            index /= base;
+        }
+        return result;
+    }
+
+    void beginFullscreen(GLStateCache& state, GLuint program) {
+        state.Disable(GL_DEPTH_TEST);
+        state.UseProgram(program);
+        state.BindVertexArray(emptyVao);
+        state.ActiveTexture(GL_TEXTURE0);
+        state.BindTexture(GL_TEXTURE_2D, sceneColor);
+    }
+
+    //folds in the timers that have finished, never waits for one
+    void readTimers() {
+        for (int i = 0; i < AA_TIMER_FRAMES; ++i) {
+            if (!timerPending[i]) {
+                continue;
+            }
+            GLint available = 0;
+            glGetQueryObjectiv(timers[i], GL_QUERY_RESULT_AVAILABLE, &available);
+            if (available) {
+                GLuint64 elapsed = 0;
+                glGetQueryObjectui64v(timers[i], GL_QUERY_RESULT, &elapsed);
+                lastGpuTime = elapsed / 1.0e9;
+                costs[timerModes[i]].GpuTime += lastGpuTime;
+                ++costs[timerModes[i]].GpuFrames;
+                timerPending[i] = false;
+            }
+        }
+    }
+
+    static GLuint createTexture(GLenum format, GLsizei textureWidth, GLsizei textureHeight, GLStateCache& state) {
+        GLuint texture;
+        glGenTextures(1, &texture);
+        state.ActiveTexture(GL_TEXTURE0);
+        state.BindTexture(GL_TEXTURE_2D, texture);
+        glTexStorage2D(GL_TEXTURE_2D, 1, format, textureWidth, textureHeight);
+        glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MIN_FILTER, GL_LINEAR);
+        glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MAG_FILTER, GL_LINEAR);
+        glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_WRAP_S, GL_CLAMP_TO_EDGE);
+        glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_WRAP_T, GL_CLAMP_TO_EDGE);
+        return texture;
+    }
+
+    void createTargets(GLStateCache& state, int newWidth, int newHeight) {
+        destroyTargets(state);
+        width = newWidth;
+        height = newHeight;
+        historyValid = false;
+        if (width <= 0 || height <= 0) {
+            return;
+        }
+
+        if (isMultisampled()) {
+            glGenRenderbuffers(1, &msaaColor);
+            glBindRenderbuffer(GL_RENDERBUFFER, msaaColor);
+            glRenderbufferStorageMultisample(GL_RENDERBUFFER, samples(), GL_RGBA8, width, height);
+            glGenRenderbuffers(1, &msaaDepth);
+            glBindRenderbuffer(GL_RENDERBUFFER, msaaDepth);
+            glRenderbufferStorageMultisample(GL_RENDERBUFFER, samples(), GL_DEPTH_COMPONENT24, width, height);
+            glBindRenderbuffer(GL_RENDERBUFFER, 0);
+
+            glGenFramebuffers(1, &msaaFramebuffer);
+            state.BindFramebuffer(GL_FRAMEBUFFER, msaaFramebuffer);
+            glFramebufferRenderbuffer(GL_FRAMEBUFFER, GL_COLOR_ATTACHMENT0, GL_RENDERBUFFER, msaaColor);
+            glFramebufferRenderbuffer(GL_FRAMEBUFFER, GL_DEPTH_ATTACHMENT, GL_RENDERBUFFER, msaaDepth);
+        }
+
+        //single sample target for the post passes, to resolve into before scaling and to keep depth in
+        if (mode == AA_FXAA || mode == AA_TAA || isScaled() || keepDepth) {
+            sceneColor = createTexture(GL_RGBA8, width, height, state);
+            sceneDepth = createTexture(GL_DEPTH_COMPONENT24, width, height, state);
+            glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MIN_FILTER, GL_NEAREST);
+            glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MAG_FILTER, GL_NEAREST);
+
+            glGenFramebuffers(1, &sceneFramebuffer);
+            state.BindFramebuffer(GL_FRAMEBUFFER, sceneFramebuffer);
+            glFramebufferTexture2D(GL_FRAMEBUFFER, GL_COLOR_ATTACHMENT0, GL_TEXTURE_2D, sceneColor, 0);
+            glFramebufferTexture2D(GL_FRAMEBUFFER, GL_DEPTH_ATTACHMENT, GL_TEXTURE_2D, sceneDepth, 0);
+
+            if (mode == AA_TAA) {
+                for (int i = 0; i < 2; ++i) {
+                    historyTextures[i] = createTexture(GL_RGBA8, width, height, state);
+                    glGenFramebuffers(1, &historyFramebuffers[i]);
+                    state.BindFramebuffer(GL_FRAMEBUFFER, historyFramebuffers[i]);
+                    glFramebufferTexture2D(GL_FRAMEBUFFER, GL_COLOR_ATTACHMENT0, GL_TEXTURE_2D, historyTextures[i], 0);
+                }
+            }
+        }
+        state.BindFramebuffer(GL_FRAMEBUFFER, 0);
+    }
+
+    void destroyTargets(GLStateCache& state) {
+        GLuint* framebuffers[] = { &msaaFramebuffer, &sceneFramebuffer, &historyFramebuffers[0], &historyFramebuffers[1] };
+        for (GLuint* framebuffer : framebuffers) {
+            if (*framebuffer != 0) {
+                state.DeleteFramebuffer(*framebuffer);
+                *framebuffer = 0;
+            }
+        }
+        GLuint* textures[] = { &sceneColor, &sceneDepth, &historyTextures[0], &historyTextures[1] };
+        for (GLuint* texture : textures) {
+            if (*texture != 0) {
+                state.DeleteTexture(*texture);
+                *texture = 0;
+            }
+        }
+        GLuint* renderbuffers[] = { &msaaColor, &msaaDepth };
+        for (GLuint* renderbuffer : renderbuffers) {
+            if (*renderbuffer != 0) {
+                glDeleteRenderbuffers(1, renderbuffer);
+                *renderbuffer = 0;
+            }
+        }
+    }
+};
+#endif
@@ -0,0 +1,531 @@
+#ifndef BVH_H
+#define BVH_H
+
+#include <glm/glm.hpp>
+
+#include <algorithm>
+#include <cfloat>
+#include <cmath>
+#include <cstdint>
+#include <cstring>
+#include <vector>
+
+//half line starting at Origin, Direction doesn't need to be normalized
+struct Ray {
+    glm::vec3 Origin;
+    glm::vec3 Direction;
+};
+
+//closest triangle a ray ran into
+struct RayHit {
+    bool Hit = false;
+    float Distance = FLT_MAX;       // along the ray, in units of Direction
+    uint32_t Object = 0;            // id the triangle was added under
+    uint32_t Triangle = 0;          // index within that object's triangles
+    glm::vec3 Position = glm::vec3(0.0f);
+    glm::vec3 Normal = glm::vec3(0.0f); // geometric normal, facing back along the ray
+};
+
+//ray through a cursor position. x and y are window coordinates with the origin at the top left,
+//works for perspective and orthographic projections alike
+inline Ray ScreenRay(double x, double y, int width, int height, const glm::mat4& view, const glm::mat4& projection)
+{
+    float ndcX = (float)(2.0 * x / width - 1.0);
+    float ndcY = (float)(1.0 - 2.0 * y / height);
+
+    glm::mat4 inverseViewProjection = glm::inverse(projection * view);
+    glm::vec4 nearPoint = inverseViewProjection * glm::vec4(ndcX, ndcY, -1.0f, 1.0f);
+    glm::vec4 farPoint = inverseViewProjection * glm::vec4(ndcX, ndcY, 1.0f, 1.0f);
+    nearPoint /= nearPoint.w;
+    farPoint /= farPoint.w;
+
+    Ray ray;
+    ray.Origin = glm::vec3(nearPoint);
+    ray.Direction = glm::normalize(glm::vec3(farPoint) - glm::vec3(nearPoint));
+    return ray;
+}
+
+//bounding volume hierarchy over the world space triangles of the scene. built top down with a
+//binned surface area heuristic and stored as a flat depth first array, a node's left child is the
+//next node so walking it mostly moves forward through memory. objects that move refit the boxes
+//in place instead of rebuilding, fine as long as they don't move far from where the build put them
+class Bvh {
+public:
+    //leaves stop splitting at this many triangles
+    static const uint32_t MAX_LEAF_TRIANGLES = 4;
+    static const int SAH_BINS = 16;
+
+    //deepest the tree gets, keeps the fixed size traversal stacks safe on degenerate input
+    static const int MAX_DEPTH = 48;
+
+    //adds an object's triangles, three local space corners per triangle, placed with the given model
+    //matrix. returns the object id used by hits and SetObjectTransform
+    uint32_t AddObject(const glm::vec3* corners, size_t cornerCount, const glm::mat4& model) {
+        ObjectRange object;
+        object.FirstTriangle = (uint32_t)localCorners.size() / 3;
+        object.TriangleCount = (uint32_t)(cornerCount / 3);
+        object.Model = model;
+        objects.push_back(object);
+
+        localCorners.insert(localCorners.end(), corners, corners + object.TriangleCount * 3);
+        return (uint32_t)objects.size() - 1;
+    }
+
+    size_t TriangleCount() const {
+        return triangles.size();
+    }
+
+    size_t NodeCount() const {
+        return nodes.size();
+    }
+
+    //full rebuild, needed after adding objects
+    void Build() {
+        size_t count = localCorners.size() / 3;
+        triangles.resize(count);
+        order.resize(count);
+        owners.resize(count);
+        for (uint32_t id = 0; id < (uint32_t)objects.size(); ++id) {
+            const ObjectRange& object = objects[id];
+            for (uint32_t i = 0; i < object.TriangleCount; ++i) {
+                owners[object.FirstTriangle + i] = id;
+            }
+            transformObject(id);
+        }
+
+        std::vector<glm::vec3> centroids(count);
+        for (size_t i = 0; i < count; ++i) {
+            order[i] = (uint32_t)i;
+            centroids[i] = (triangles[i].V0 + triangles[i].V1 + triangles[i].V2) * (1.0f / 3.0f);
+        }
+
+        nodes.clear();
+        nodes.reserve(count > 0 ? count * 2 : 1);
+        nodes.push_back(Node());
+        if (count == 0) {
+            nodes[0].Count = 0;
+            nodes[0].Min = glm::vec3(FLT_MAX);
+            nodes[0].Max = glm::vec3(-FLT_MAX);
+            return;
+        }
+        buildNode(0, 0, (uint32_t)count, 0, centroids);
+
+        //store the triangles in leaf order so a leaf reads one contiguous run
+        std::vector<Triangle> sorted(count);
+        std::vector<uint32_t> sortedOwners(count);
+        for (size_t i = 0; i < count; ++i) {
+            sorted[i] = triangles[order[i]];
+            sortedOwners[i] = owners[order[i]];
+        }
+        triangles.swap(sorted);
+        owners.swap(sortedOwners);
+        dirty = false;
+    }
+
+    //moves an object, the boxes catch up on the next Refit. an unchanged matrix costs a compare
+    void SetObjectTransform(uint32_t id, const glm::mat4& model) {
+        ObjectRange& object = objects[id];
+        if (memcmp(&object.Model, &model, sizeof(glm::mat4)) == 0) {
+            return;
+        }
+        object.Model = model;
+        object.Moved = true;
+        dirty = true;
+    }
+
+    //recomputes the world space triangles of moved objects and the boxes above them, bottom up
+    void Refit() {
+        if (!dirty || nodes.empty()) {
+            return;
+        }
+
+        for (size_t i = 0; i < triangles.size(); ++i) {
+            const ObjectRange& object = objects[owners[i]];
+            if (object.Moved) {
+                triangles[i] = transformTriangle(object.Model, &localCorners[(size_t)order[i] * 3]);
+            }
+        }
+        for (ObjectRange& object : objects) {
+            object.Moved = false;
+        }
+
+        //children always come after their parent, so a reverse sweep sees them first
+        for (size_t i = nodes.size(); i-- > 0;) {
+            Node& node = nodes[i];
+            if (node.Count > 0) {
+                fitLeaf(node);
+            }
+            else {
+                const Node& left = nodes[i + 1];
+                const Node& right = nodes[node.Offset];
+                node.Min = glm::min(left.Min, right.Min);
+                node.Max = glm::max(left.Max, right.Max);
+            }
+        }
+        dirty = false;
+    }
+
+    //closest hit within maxDistance
+    RayHit Intersect(const Ray& ray, float maxDistance = FLT_MAX) const {
+        RayHit hit;
+        hit.Distance = maxDistance;
+        if (nodes.empty() || triangles.empty()) {
+            return hit;
+        }
+
+        glm::vec3 inverseDirection(1.0f / ray.Direction.x, 1.0f / ray.Direction.y, 1.0f / ray.Direction.z);
+
+        uint32_t stack[64];
+        int stackSize = 0;
+        uint32_t current = 0;
+        if (!slab(nodes[0], ray.Origin, inverseDirection, hit.Distance)) {
+            return hit;
+        }
+
+        while (true) {
+            const Node& node = nodes[current];
+            if (node.Count > 0) {
+                for (uint32_t i = node.Offset; i < node.Offset + node.Count; ++i) {
+                    intersectTriangle(ray, i, hit);
+                }
+            }
+            else {
+                //visit the nearer child first, the far one is often skipped once something is hit
+                uint32_t nearChild = current + 1;
+                uint32_t farChild = node.Offset;
+                float nearDistance = slabDistance(nodes[nearChild], ray.Origin, inverseDirection, hit.Distance);
+                float farDistance = slabDistance(nodes[farChild], ray.Origin, inverseDirection, hit.Distance);
+                if (farDistance < nearDistance) {
+                    std::swap(nearChild, farChild);
+                    std::swap(nearDistance, farDistance);
+                }
+
+                if (nearDistance != FLT_MAX) {
+                    if (farDistance != FLT_MAX) {
+                        stack[stackSize++] = farChild;
+                    }
+                    current = nearChild;
+                    continue;
+                }
+            }
+
+            if (stackSize == 0) {
+                break;
+            }
+            current = stack[--stackSize];
+        }
+
+        if (hit.Hit) {
+            hit.Position = ray.Origin + ray.Direction * hit.Distance;
+        }
+        return hit;
+    }
+
+    //ids of the objects with a triangle box touching the given box, for collision and broad phase queries
+    void QueryBox(const glm::vec3& min, const glm::vec3& max, std::vector<uint32_t>& hitObjects) const {
+        hitObjects.clear();
+        if (nodes.empty()) {
+            return;
+        }
+
+        std::vector<bool> seen(objects.size(), false);
+        uint32_t stack[64];
+        int stackSize = 0;
+        stack[stackSize++] = 0;
+        while (stackSize > 0) {
+            uint32_t index = stack[--stackSize];
+            const Node& node = nodes[index];
+            if (!overlaps(node.Min, node.Max, min, max)) {
+                continue;
+            }
+
+            if (node.Count > 0) {
+                for (uint32_t i = node.Offset; i < node.Offset + node.Count; ++i) {
+                    const Triangle& t = triangles[i];
+                    if (!seen[owners[i]] && overlaps(glm::min(t.V0, glm::min(t.V1, t.V2)), glm::max(t.V0, glm::max(t.V1, t.V2)), min, max)) {
+                        seen[owners[i]] = true;
+                        hitObjects.push_back(owners[i]);
+                    }
+                }
+            }
+            else {
+                stack[stackSize++] = node.Offset;
+                stack[stackSize++] = index + 1;
+            }
+        }
+    }
+
+    //ids of the objects with geometry inside the view volume, whole subtrees are accepted or
+    //rejected at once so large scenes skip most of the per object tests
+    void QueryFrustum(const glm::mat4& viewProjection, std::vector<uint32_t>& visibleObjects) const {
+        visibleObjects.clear();
+        if (nodes.empty()) {
+            return;
+        }
+
+        //planes from the rows of the matrix, same as the per object cull
+        glm::vec4 planes[6];
+        for (int row = 0; row < 3; ++row) {
+            for (int side = 0; side < 2; ++side) {
+                glm::vec4& plane = planes[row * 2 + side];
+                for (int column = 0; column < 4; ++column) {
+                    plane[column] = viewProjection[column][3] + (side ? 1.0f : -1.0f) * viewProjection[column][row];
+                }
+            }
+        }
+
+        std::vector<bool> seen(objects.size(), false);
+        uint32_t stack[64];
+        int stackSize = 0;
+        stack[stackSize++] = 0;
+        while (stackSize > 0) {
+            uint32_t index = stack[--stackSize];
+            const Node& node = nodes[index];
+
+            glm::vec3 center = (node.Min + node.Max) * 0.5f;
+            glm::vec3 extent = (node.Max - node.Min) * 0.5f;
+            bool outside = false;
+            for (int i = 0; i < 6 && !outside; ++i) {
+                glm::vec3 normal(planes[i]);
+                float distance = glm::dot(normal, center) + planes[i].w;
+                float radius = fabsf(normal.x) * extent.x + fabsf(normal.y) * extent.y + fabsf(normal.z) * extent.z;
+                outside = distance + radius < 0.0f;
+            }
+            if (outside) {
+                continue;
+            }
+
+            if (node.Count > 0) {
+                for (uint32_t i = node.Offset; i < node.Offset + node.Count; ++i) {
+                    if (!seen[owners[i]]) {
+                        seen[owners[i]] = true;
+                        visibleObjects.push_back(owners[i]);
+                    }
+                }
+            }
+            else {
+                stack[stackSize++] = node.Offset;
+                stack[stackSize++] = index + 1;
+            }
+        }
+    }
+
+private:
+    //32 bytes, two to a cache line. leaves have Count > 0 and Offset is their first triangle,
+    //inner nodes have Count == 0 and Offset is the right child
+    struct Node {
+        glm::vec3 Min;
+        uint32_t Offset;
+        glm::vec3 Max;
+        uint32_t Count;
+    };
+
+    struct Triangle {
+        glm::vec3 V0;
+        glm::vec3 V1;
+        glm::vec3 V2;
+    };
+
+    struct ObjectRange {
+        uint32_t FirstTriangle;
+        uint32_t TriangleCount;
+        glm::mat4 Model;
+        bool Moved = false;
+    };
+
+    struct Bin {
+        glm::vec3 Min = glm::vec3(FLT_MAX);
+        glm::vec3 Max = glm::vec3(-FLT_MAX);
+        uint32_t Count = 0;
+    };
+
+    std::vector<Node> nodes;
+    std::vector<Triangle> triangles;    // world space, in leaf order
+    std::vector<uint32_t> owners;       // object id of each triangle, in leaf order
+    std::vector<uint32_t> order;        // leaf order position to original triangle index
+    std::vector<ObjectRange> objects;
+    std::vector<glm::vec3> localCorners;
+    bool dirty = false;
+
+    static Triangle transformTriangle(const glm::mat4& model, const glm::vec3* corners) {
+        Triangle t;
+        t.V0 = glm::vec3(model * glm::vec4(corners[0], 1.0f));
+        t.V1 = glm::vec3(model * glm::vec4(corners[1], 1.0f));
+        t.V2 = glm::vec3(model * glm::vec4(corners[2], 1.0f));
+        return t;
+    }
+
+    void transformObject(uint32_t id) {
+        const ObjectRange& object = objects[id];
+        for (uint32_t i = 0; i < object.TriangleCount; ++i) {
+            uint32_t index = object.FirstTriangle + i;
+            triangles[index] = transformTriangle(object.Model, &localCorners[index * 3]);
+        }
+    }
+
+    static float area(const glm::vec3& min, const glm::vec3& max) {
+        glm::vec3 size = max - min;
+        return size.x * size.y + size.y * size.z + size.z * size.x;
+    }
+
+    static bool overlaps(const glm::vec3& aMin, const glm::vec3& aMax, const glm::vec3& bMin, const glm::vec3& bMax) {
+        return aMin.x <= bMax.x && aMax.x >= bMin.x
+            && aMin.y <= bMax.y && aMax.y >= bMin.y
+            && aMin.z <= bMax.z && aMax.z >= bMin.z;
+    }
+
+    void fitLeaf(Node& node) const {
+        node.Min = glm::vec3(FLT_MAX);
+        node.Max = glm::vec3(-FLT_MAX);
+        for (uint32_t i = node.Offset; i < node.Offset + node.Count; ++i) {
+            const Triangle& t = triangles[i];
+            node.Min = glm::min(node.Min, glm::min(t.V0, glm::min(t.V1, t.V2)));
+            node.Max = glm::max(node.Max, glm::max(t.V0, glm::max(t.V1, t.V2)));
+        }
+    }
+
+    //splits order[first, first + count) and writes the subtree starting at nodes[index]
+    void buildNode(uint32_t index, uint32_t first, uint32_t count, int depth, const std::vector<glm::vec3>& centroids) {
+        glm::vec3 min(FLT_MAX), max(-FLT_MAX), centroidMin(FLT_MAX), centroidMax(-FLT_MAX);
+        for (uint32_t i = first; i < first + count; ++i) {
+            const Triangle& t = triangles[order[i]];
+            min = glm::min(min, glm::min(t.V0, glm::min(t.V1, t.V2)));
+            max = glm::max(max, glm::max(t.V0, glm::max(t.V1, t.V2)));
+            centroidMin = glm::min(centroidMin, centroids[order[i]]);
+            centroidMax = glm::max(centroidMax, centroids[order[i]]);
+        }
+        nodes[index].Min = min;
+        nodes[index].Max = max;
+
+        //cheapest split over a handful of bins on each axis
+        int bestAxis = -1;
+        int bestSplit = 0;
+        float bestCost = FLT_MAX;
+        if (count > MAX_LEAF_TRIANGLES && depth < MAX_DEPTH) {
+            for (int axis = 0; axis < 3; ++axis) {
+                float extent = centroidMax[axis] - centroidMin[axis];
+                if (extent <= 0.0f) {
+                    continue;
+                }
+
+                Bin bins[SAH_BINS];
+                float scale = SAH_BINS / extent;
+                for (uint32_t i = first; i < first + count; ++i) {
+                    int bin = std::min(SAH_BINS - 1, (int)((centroids[order[i]][axis] - centroidMin[axis]) * scale));
+                    const Triangle& t = triangles[order[i]];
+                    bins[bin].Min = glm::min(bins[bin].Min, glm::min(t.V0, glm::min(t.V1, t.V2)));
+                    bins[bin].Max = glm::max(bins[bin].Max, glm::max(t.V0, glm::max(t.V1, t.V2)));
+                    ++bins[bin].Count;
+                }
+
+                //sweep from the right to get the area and count above every plane, then from the left
+                float rightArea[SAH_BINS];
+                uint32_t rightCount[SAH_BINS];
+                Bin right;
+                for (int i = SAH_BINS - 1; i > 0; --i) {
+                    right.Min = glm::min(right.Min, bins[i].Min);
+                    right.Max = glm::max(right.Max, bins[i].Max);
+                    right.Count += bins[i].Count;
+                    rightArea[i] = right.Count > 0 ? area(right.Min, right.Max) : 0.0f;
+                    rightCount[i] = right.Count;
+                }
+
+                Bin left;
+                for (int i = 0; i < SAH_BINS - 1; ++i) {
+                    left.Min = glm::min(left.Min, bins[i].Min);
+                    left.Max = glm::max(left.Max, bins[i].Max);
+                    left.Count += bins[i].Count;
+                    if (left.Count == 0 || rightCount[i + 1] == 0) {
+                        continue;
+                    }
+
+                    float cost = left.Count * area(left.Min, left.Max) + rightCount[i + 1] * rightArea[i + 1];
+                    if (cost < bestCost) {
+                        bestCost = cost;
+                        bestAxis = axis;
+                        bestSplit = i + 1;
+                    }
+                }
+            }
+        }
+
+        //a split has to beat intersecting every triangle here
+        float leafCost = count * area(min, max);
+        if (bestAxis < 0 || bestCost >= leafCost) {
+            nodes[index].Offset = first;
+            nodes[index].Count = count;
+            return;
+        }
+
+        float scale = SAH_BINS / (centroidMax[bestAxis] - centroidMin[bestAxis]);
+        uint32_t* begin = &order[first];
+        uint32_t* middle = std::partition(begin, begin + count, [&](uint32_t triangle) {
+            int bin = std::min(SAH_BINS - 1, (int)((centroids[triangle][bestAxis] - centroidMin[bestAxis]) * scale));
+            return bin < bestSplit;
+        });
+        uint32_t leftCount = (uint32_t)(middle - begin);
+
+        nodes[index].Count = 0;
+        uint32_t leftIndex = (uint32_t)nodes.size();
+        nodes.push_back(Node());
+        buildNode(leftIndex, first, leftCount, depth + 1, centroids);
+
+        uint32_t rightIndex = (uint32_t)nodes.size();
+        nodes.push_back(Node());
+        nodes[index].Offset = rightIndex;
+        buildNode(rightIndex, first + leftCount, count - leftCount, depth + 1, centroids);
+    }
+
+    static bool slab(const Node& node, const glm::vec3& origin, const glm::vec3& inverseDirection, float maxDistance) {
+        return slabDistance(node, origin, inverseDirection, maxDistance) != FLT_MAX;
+    }
+
+    //entry distance into the node's box, FLT_MAX on a miss
+    static float slabDistance(const Node& node, const glm::vec3& origin, const glm::vec3& inverseDirection, float maxDistance) {
+        glm::vec3 t0 = (node.Min - origin) * inverseDirection;
+        glm::vec3 t1 = (node.Max - origin) * inverseDirection;
+        glm::vec3 tNear = glm::min(t0, t1);
+        glm::vec3 tFar = glm::max(t0, t1);
+        float enter = std::max(std::max(tNear.x, tNear.y), std::max(tNear.z, 0.0f));
+        float exit = std::min(std::min(tFar.x, tFar.y), std::min(tFar.z, maxDistance));
+        return enter <= exit ? enter : FLT_MAX;
+    }
+
+    //moller trumbore
+    void intersectTriangle(const Ray& ray, uint32_t index, RayHit& hit) const {
+        const Triangle& t = triangles[index];
+        glm::vec3 edge1 = t.V1 - t.V0;
+        glm::vec3 edge2 = t.V2 - t.V0;
+        glm::vec3 p = glm::cross(ray.Direction, edge2);
+        float determinant = glm::dot(edge1, p);
+        if (fabsf(determinant) < 1e-12f) {
+            return;
+        }
+
+        float inverseDeterminant = 1.0f / determinant;
+        glm::vec3 s = ray.Origin - t.V0;
+        float u = glm::dot(s, p) * inverseDeterminant;
+        if (u < 0.0f || u > 1.0f) {
+            return;
+        }
+
+        glm::vec3 q = glm::cross(s, edge1);
+        float v = glm::dot(ray.Direction, q) * inverseDeterminant;
+        if (v < 0.0f || u + v > 1.0f) {
+            return;
+        }
+
+        float distance = glm::dot(edge2, q) * inverseDeterminant;
+        if (distance <= 0.0f || distance >= hit.Distance) {
+            return;
+        }
+
+        hit.Hit = true;
+        hit.Distance = distance;
+        hit.Object = owners[index];
+        hit.Triangle = order[index] - objects[owners[index]].FirstTriangle;
+        glm::vec3 normal = glm::normalize(glm::cross(edge1, edge2));
+        hit.Normal = glm::dot(normal, ray.Direction) > 0.0f ? -normal : normal;
+    }
+};
+#endif
@@ -1,168 +1,328 @@
-#ifndef CAMERA_H
-#define CAMERA_H
-
-//#include <glad/glad.h>
-#include <glm/glm.hpp>
-#include <glm/gtc/matrix_transform.hpp>
-
-#include <vector>
-
-//possible camera movements
-enum Camera_Movement {
-    FORWARD,
-    BACKWARD,
-    LEFT,
-    RIGHT,
-    UP,
-    DOWN,
-    TURNL,
-    TURNR,
-    TURNU,
-    TURND
-};
-
-//camera values
-const float YAW = -90.0f;
-const float PITCH = 0.0f;
-const float SPEED = 2.5f;
-const float SENSITIVITY = 0.1f;
-const float ZOOM = 45.0f;
-
-class Camera {
-public:
-    //attributes
-    glm::vec3 Position;
-    glm::vec3 Front;
-    glm::vec3 Up;
-    glm::vec3 Right;
-    glm::vec3 WorldUp;
-
-    //amngles
-    float Yaw;
-    float Pitch;
-
-    //camera
-    float MovementSpeed;
-    float MouseSensitivity;
-    float Zoom;
-
-    //constructor with vecs
-    Camera(glm::vec3 position = glm::vec3(0.0f, 3.0f, 0.0f), glm::vec3 up = glm::vec3(0.0f, 1.0f, 0.0f), float yaw = YAW, float pitch = PITCH) :
-        Front(glm::vec3(0.0f, 0.0f, -1.0f)), MovementSpeed(SPEED), MouseSensitivity(SENSITIVITY), Zoom(ZOOM) {
-
-
-        Position = position;
-        WorldUp = up;
-        Yaw = yaw;
-        Pitch = pitch;
-        updateCameraVectors();
-    }
-    //constructor with scalar
-    Camera(float posX, float posY, float posZ, float upX, float upY, float upZ, float yaw, float pitch) :
-        Front(glm::vec3(0.0f, 0.0f, -1.0f)), MovementSpeed(SPEED), MouseSensitivity(SENSITIVITY), Zoom(ZOOM) {
-
-
-        Position = glm::vec3(posX, posY, posZ);
-        WorldUp = glm::vec3(upX, upY, upZ);
-        Yaw = yaw;
-        Pitch = pitch;
-        updateCameraVectors();
-    }
-
-    //return view matrix calcualated with angles and look at matrix
-    glm::mat4 GetViewMatrix() const
-    {
-        return glm::lookAt(Position, Position + Front, Up);
-    }
-
-    //processes input
-    void ProcessKeyboard(Camera_Movement direction, float deltaTime) {
-        float velocity = MovementSpeed * deltaTime;
-        float turnSpeed = velocity * 10.0f;
-
-        if (direction == FORWARD) {
-            Position += Front * velocity;
-        }
-        if (direction == BACKWARD) {
-            Position -= Front * velocity;
-        }
-        if (direction == LEFT) {
-            Position -= Right * velocity;
-        }
-        if (direction == RIGHT) {
-            Position += Right * velocity;
-        }
-        if (direction == UP) {
-            Position += Up * velocity;
-        }
-        if (direction == DOWN) {
-            Position -= Up * velocity;
-        }
-        if (direction == TURNL) {
-            Yaw -= turnSpeed;
-            updateCameraVectors();
-        }
-        if (direction == TURNR) {
-            Yaw += turnSpeed;
-            updateCameraVectors();
-        }
-        if (direction == TURNU && Pitch >-89.0f ) {
-            Pitch += turnSpeed;
-            updateCameraVectors();
-        }
-        if (direction == TURND && Pitch < 89.0f) {
-            Pitch -= turnSpeed;
-            updateCameraVectors();
-        }
-    }
-
-    //process input from mouse poisition
-    void ProcessMouseMovement(float xoffset, float yoffset, GLboolean constrainPitch = true) {
-        xoffset *= MouseSensitivity;
-        yoffset *= MouseSensitivity;
-
-        Yaw += xoffset;
-        Pitch += yoffset;
-
-        //when pitch is out of bounds screen doesn't get flipped
-        if (constrainPitch)
-        {
-            if (Pitch > 89.0f)
-                Pitch = 89.0f;
-            if (Pitch < -89.0f)
-                Pitch = -89.0f;
-        }
-
-        //update camera vectors using the updated angles
-        updateCameraVectors();
-    }
-
-    // processes input received from a mouse scroll-wheel event. Only requires input on the vertical wheel-axis
-    void ProcessMouseScroll(float yoffset)
-    {
-        MovementSpeed += yoffset;
-
-        if (MovementSpeed < 0.5f) {
-            MovementSpeed = 0.5f;
-        }
-        if (MovementSpeed > 50.0f) {
-            MovementSpeed = 50.0f;
-        }
-    }
-
-private:
-    //calculate fron vector from cameras anfles
-    void updateCameraVectors()
-    {
-        //calculate the Front vector
-        glm::vec3 front;
-        front.x = cos(glm::radians(Yaw)) * cos(glm::radians(Pitch));
-        front.y = sin(glm::radians(Pitch));
-        front.z = sin(glm::radians(Yaw)) * cos(glm::radians(Pitch));
-        Front = glm::normalize(front);
-        //calculate the Right and Up vector
-        Right = glm::normalize(glm::cross(Front, WorldUp));
-        Up = glm::normalize(glm::cross(Right, Front));
-    }
-};
-#endif
\ No newline at end of file
+#ifndef CAMERA_H
+#define CAMERA_H
+
+//#include <glad/glad.h>
+#include <glm/glm.hpp>
+#include <glm/gtc/matrix_transform.hpp>
+#include <glm/gtc/quaternion.hpp>
+
+#include <vector>
+
+//possible camera movements
+enum Camera_Movement {
+    FORWARD,
+    BACKWARD,
+    LEFT,
+    RIGHT,
+    UP,
+    DOWN,
+    TURNL,
+    TURNR,
+    TURNU,
+    TURND,
+    ROLLL,
+    ROLLR
+};
+
+//camera values
+const float YAW = -90.0f;
+const float PITCH = 0.0f;
+const float ROLL = 0.0f;
+const float SPEED = 2.5f;
+const float SENSITIVITY = 0.1f;
+const float ZOOM = 45.0f;
+
+//where the camera is and which way it faces, saved to fly back to later
+struct CameraViewpoint {
+    glm::vec3 Position;
+    float Yaw;
+    float Pitch;
+    float Roll;
+};
+
+class Camera {
+public:
+    //attributes
+    glm::vec3 Position;
+    glm::vec3 WorldUp;
+
+    //camera
+    float MovementSpeed;
+    float MouseSensitivity;
+    float Zoom;
+
+    //constructor with vecs
+    Camera(glm::vec3 position = glm::vec3(0.0f, 3.0f, 0.0f), glm::vec3 up = glm::vec3(0.0f, 1.0f, 0.0f), float yaw = YAW, float pitch = PITCH) :
+        MovementSpeed(SPEED), MouseSensitivity(SENSITIVITY), Zoom(ZOOM) {
+
+
+        Position = position;
+        WorldUp = up;
+        setAngles(yaw, pitch, ROLL);
+    }
+    //constructor with scalar
+    Camera(float posX, float posY, float posZ, float upX, float upY, float upZ, float yaw, float pitch) :
+        MovementSpeed(SPEED), MouseSensitivity(SENSITIVITY), Zoom(ZOOM) {
+
+
+        Position = glm::vec3(posX, posY, posZ);
+        WorldUp = glm::vec3(upX, upY, upZ);
+        setAngles(yaw, pitch, ROLL);
+    }
+
+    //angles in degrees. yaw turns around WorldUp, pitch around the camera's right and roll around its front
+    float Yaw() const { return yaw; }
+    float Pitch() const { return pitch; }
+    float Roll() const { return roll; }
+
+    //basis and orientation, rebuilt on first use after the angles change
+    const glm::vec3& Front() const { updateOrientation(); return front; }
+    const glm::vec3& Right() const { updateOrientation(); return right; }
+    const glm::vec3& Up() const { updateOrientation(); return up; }
+    const glm::quat& Orientation() const { updateOrientation(); return orientation; }
+
+    //return view matrix, cached until the position or orientation changes
+    const glm::mat4& GetViewMatrix() const
+    {
+        updateOrientation();
+        if (viewDirty || viewPosition != Position) {
+            //rows are the camera axes, same matrix lookAt would build from them
+            view = glm::mat4(1.0f);
+            for (int column = 0; column < 3; ++column) {
+                view[column][0] = right[column];
+                view[column][1] = up[column];
+                view[column][2] = -front[column];
+            }
+            view[3][0] = -glm::dot(right, Position);
+            view[3][1] = -glm::dot(up, Position);
+            view[3][2] = glm::dot(front, Position);
+            viewPosition = Position;
+            viewDirty = false;
+        }
+        return view;
+    }
+
+    //processes input
+    void ProcessKeyboard(Camera_Movement direction, float deltaTime) {
+        //a viewpoint transition has the camera until it lands
+        if (InTransition()) {
+            return;
+        }
+
+        float velocity = MovementSpeed * deltaTime;
+        float turnSpeed = velocity * 10.0f;
+
+        if (direction == FORWARD) {
+            Position += Front() * velocity;
+        }
+        if (direction == BACKWARD) {
+            Position -= Front() * velocity;
+        }
+        if (direction == LEFT) {
+            Position -= Right() * velocity;
+        }
+        if (direction == RIGHT) {
+            Position += Right() * velocity;
+        }
+        if (direction == UP) {
+            Position += Up() * velocity;
+        }
+        if (direction == DOWN) {
+            Position -= Up() * velocity;
+        }
+        if (direction == TURNL) {
+            setAngles(yaw - turnSpeed, pitch, roll);
+        }
+        if (direction == TURNR) {
+            setAngles(yaw + turnSpeed, pitch, roll);
+        }
+        if (direction == TURNU && pitch >-89.0f ) {
+            setAngles(yaw, pitch + turnSpeed, roll);
+        }
+        if (direction == TURND && pitch < 89.0f) {
+            setAngles(yaw, pitch - turnSpeed, roll);
+        }
+        if (direction == ROLLL) {
+            setAngles(yaw, pitch, roll - turnSpeed);
+        }
+        if (direction == ROLLR) {
+            setAngles(yaw, pitch, roll + turnSpeed);
+        }
+    }
+
+    //process input from mouse poisition. only the angles change here, the basis is rebuilt once
+    //when it's next needed however many events arrive before then
+    void ProcessMouseMovement(float xoffset, float yoffset, bool constrainPitch = true) {
+        if (InTransition()) {
+            return;
+        }
+
+        xoffset *= MouseSensitivity;
+        yoffset *= MouseSensitivity;
+
+        float newPitch = pitch + yoffset;
+
+        //when pitch is out of bounds screen doesn't get flipped
+        if (constrainPitch)
+        {
+            if (newPitch > 89.0f)
+                newPitch = 89.0f;
+            if (newPitch < -89.0f)
+                newPitch = -89.0f;
+        }
+
+        setAngles(yaw + xoffset, newPitch, roll);
+    }
+
+    //places the camera directly, used when a recorded path drives it instead of input
+    void SetPose(const glm::vec3& position, float newYaw, float newPitch, float newRoll = ROLL)
+    {
+        Position = position;
+        setAngles(newYaw, newPitch, newRoll);
+    }
+
+    CameraViewpoint SaveViewpoint() const
+    {
+        CameraViewpoint viewpoint = { Position, yaw, pitch, roll };
+        return viewpoint;
+    }
+
+    //flies to a saved viewpoint over the given time, moving along a straight line and turning
+    //along the shortest arc. input is ignored until it arrives
+    void TransitionTo(const CameraViewpoint& target, float duration)
+    {
+        if (duration <= 0.0f) {
+            SetPose(target.Position, target.Yaw, target.Pitch, target.Roll);
+            return;
+        }
+
+        transitionStart = SaveViewpoint();
+        transitionStartOrientation = Orientation();
+        transitionTarget = target;
+        transitionTargetOrientation = angleOrientation(target.Yaw, target.Pitch, target.Roll);
+        transitionDuration = duration;
+        transitionTime = 0.0f;
+    }
+
+    bool InTransition() const
+    {
+        return transitionDuration > 0.0f;
+    }
+
+    //advances a running transition, call once per simulation step
+    void Update(float deltaTime)
+    {
+        if (!InTransition()) {
+            return;
+        }
+
+        transitionTime += deltaTime;
+        if (transitionTime >= transitionDuration) {
+            transitionDuration = 0.0f;
+            SetPose(transitionTarget.Position, transitionTarget.Yaw, transitionTarget.Pitch, transitionTarget.Roll);
+            return;
+        }
+
+        //ease in and out so the start and stop don't jerk
+        float t = transitionTime / transitionDuration;
+        t = t * t * (3.0f - 2.0f * t);
+
+        Position = glm::mix(transitionStart.Position, transitionTarget.Position, t);
+        yaw = glm::mix(transitionStart.Yaw, transitionTarget.Yaw, t);
+        pitch = glm::mix(transitionStart.Pitch, transitionTarget.Pitch, t);
+        roll = glm::mix(transitionStart.Roll, transitionTarget.Roll, t);
+        setOrientation(glm::slerp(transitionStartOrientation, transitionTargetOrientation, t));
+    }
+
+    //blends position and orientation between two camera states, used to draw in between simulation steps
+    static Camera Interpolate(const Camera& from, const Camera& to, float alpha)
+    {
+        Camera camera = to;
+        camera.Position = glm::mix(from.Position, to.Position, alpha);
+        camera.yaw = glm::mix(from.yaw, to.yaw, alpha);
+        camera.pitch = glm::mix(from.pitch, to.pitch, alpha);
+        camera.roll = glm::mix(from.roll, to.roll, alpha);
+        camera.setOrientation(glm::slerp(from.Orientation(), to.Orientation(), alpha));
+        return camera;
+    }
+
+    // processes input received from a mouse scroll-wheel event. Only requires input on the vertical wheel-axis
+    void ProcessMouseScroll(float yoffset)
+    {
+        MovementSpeed += yoffset;
+
+        if (MovementSpeed < 0.5f) {
+            MovementSpeed = 0.5f;
+        }
+        if (MovementSpeed > 50.0f) {
+            MovementSpeed = 50.0f;
+        }
+    }
+
+private:
+    //angles input works on, in degrees
+    float yaw;
+    float pitch;
+    float roll;
+
+    //derived from the angles, or set straight from a slerp
+    mutable glm::quat orientation;
+    mutable glm::vec3 front;
+    mutable glm::vec3 right;
+    mutable glm::vec3 up;
+    mutable bool orientationDirty = true;
+
+    mutable glm::mat4 view;
+    mutable glm::vec3 viewPosition;
+    mutable bool viewDirty = true;
+
+    //viewpoint transition in progress, duration is zero when there is none
+    CameraViewpoint transitionStart;
+    CameraViewpoint transitionTarget;
+    glm::quat transitionStartOrientation;
+    glm::quat transitionTargetOrientation;
+    float transitionDuration = 0.0f;
+    float transitionTime = 0.0f;
+
+    void setAngles(float newYaw, float newPitch, float newRoll)
+    {
+        yaw = newYaw;
+        pitch = newPitch;
+        roll = newRoll;
+        orientationDirty = true;
+    }
+
+    void setOrientation(const glm::quat& newOrientation) const
+    {
+        orientation = newOrientation;
+        updateBasis();
+    }
+
+    //yaw -90 looks down -z like the original camera, so yaw turns by (yaw + 90) away from it
+    glm::quat angleOrientation(float newYaw, float newPitch, float newRoll) const
+    {
+        return glm::angleAxis(glm::radians(-(newYaw - YAW)), WorldUp)
+            * glm::angleAxis(glm::radians(newPitch), glm::vec3(1.0f, 0.0f, 0.0f))
+            * glm::angleAxis(glm::radians(newRoll), glm::vec3(0.0f, 0.0f, -1.0f));
+    }
+
+    //calculate the camera axes from the angles, only when they've changed since the last call
+    void updateOrientation() const
+    {
+        if (orientationDirty) {
+            orientation = angleOrientation(yaw, pitch, roll);
+            updateBasis();
+        }
+    }
+
+    void updateBasis() const
+    {
+        glm::mat3 axes = glm::mat3_cast(orientation);
+        right = axes[0];
+        up = axes[1];
+        front = -axes[2];
+        orientationDirty = false;
+        viewDirty = true;
+    }
+};
+#endif
@@ -0,0 +1,180 @@
+#ifndef CAMERAPATH_H
+#define CAMERAPATH_H
+
+#include <glm/glm.hpp>
+
+#include <cstdint>
+#include <cstring>
+#include <fstream>
+#include <vector>
+
+#include "camera.h"
+
+//camera pose at a point in time, 32 bytes on disk. the time stays double so a long recording
+//still resolves individual simulation steps
+struct CameraKey {
+    double Time;
+    glm::vec3 Position;
+    float Yaw;
+    float Pitch;
+    float Roll;
+};
+
+//file header, followed by the keys. version 1 files have no roll, versions 1 and 2 store the time as a float
+const char CAMERA_PATH_MAGIC[4] = { 'C', 'P', 'T', 'H' };
+const uint32_t CAMERA_PATH_VERSION = 3;
+
+//timestamped camera poses, recorded from a live run and played back through the Camera class.
+//playback goes through a Catmull-Rom spline so a path recorded at one rate plays smoothly at any other
+class CameraPath {
+public:
+    std::vector<CameraKey> Keys;
+
+    void Clear() {
+        Keys.clear();
+    }
+
+    double Duration() const {
+        return Keys.empty() ? 0.0 : Keys.back().Time;
+    }
+
+    //appends the camera's pose. while the camera sits still the last key is stretched instead of
+    //adding more, so idle stretches cost nothing in the file
+    void Record(double time, const Camera& camera) {
+        CameraKey key = { time, camera.Position, camera.Yaw(), camera.Pitch(), camera.Roll() };
+        size_t count = Keys.size();
+        if (count > 0 && time <= Keys.back().Time) {
+            return;
+        }
+        if (count >= 2 && samePose(Keys[count - 1], key) && samePose(Keys[count - 2], key)) {
+            Keys.back().Time = time;
+            return;
+        }
+        Keys.push_back(key);
+    }
+
+    bool Save(const char* filename) const {
+        std::ofstream file(filename, std::ios::binary);
+        if (!file) {
+            return false;
+        }
+
+        uint32_t count = (uint32_t)Keys.size();
+        file.write(CAMERA_PATH_MAGIC, sizeof(CAMERA_PATH_MAGIC));
+        file.write((const char*)&CAMERA_PATH_VERSION, sizeof(CAMERA_PATH_VERSION));
+        file.write((const char*)&count, sizeof(count));
+        for (const CameraKey& key : Keys) {
+            float values[6] = { key.Position.x, key.Position.y, key.Position.z, key.Yaw, key.Pitch, key.Roll };
+            file.write((const char*)&key.Time, sizeof(key.Time));
+            file.write((const char*)values, sizeof(values));
+        }
+        return (bool)file;
+    }
+
+    bool Load(const char* filename) {
+        Keys.clear();
+        std::ifstream file(filename, std::ios::binary);
+        if (!file) {
+            return false;
+        }
+
+        char magic[4];
+        uint32_t version = 0, count = 0;
+        file.read(magic, sizeof(magic));
+        file.read((char*)&version, sizeof(version));
+        file.read((char*)&count, sizeof(count));
+        if (!file || memcmp(magic, CAMERA_PATH_MAGIC, sizeof(magic)) != 0 || version < 1 || version > CAMERA_PATH_VERSION) {
+            return false;
+        }
+
+        std::streamsize poseSize = version == 1 ? 5 * sizeof(float) : 6 * sizeof(float);
+        Keys.reserve(count);
+        for (uint32_t i = 0; i < count; ++i) {
+            double time = 0.0;
+            float values[6] = { 0.0f, 0.0f, 0.0f, 0.0f, 0.0f, 0.0f };
+            if (version < 3) {
+                float oldTime = 0.0f;
+                file.read((char*)&oldTime, sizeof(oldTime));
+                time = oldTime;
+            }
+            else {
+                file.read((char*)&time, sizeof(time));
+            }
+            if (!file.read((char*)values, poseSize)) {
+                Keys.clear();
+                return false;
+            }
+            CameraKey key = { time, glm::vec3(values[0], values[1], values[2]), values[3], values[4], values[5] };
+            Keys.push_back(key);
+        }
+        return true;
+    }
+
+    //moves the camera to where the path is at the given time, false once the path has ended
+    bool Sample(double time, Camera& camera) const {
+        if (Keys.empty()) {
+            return false;
+        }
+        if (time >= Keys.back().Time) {
+            camera.SetPose(Keys.back().Position, Keys.back().Yaw, Keys.back().Pitch, Keys.back().Roll);
+            return false;
+        }
+        if (time <= Keys.front().Time) {
+            camera.SetPose(Keys.front().Position, Keys.front().Yaw, Keys.front().Pitch, Keys.front().Roll);
+            return true;
+        }
+
+        //segment holding the time, keys are sorted
+        size_t low = 0, high = Keys.size() - 1;
+        while (high - low > 1) {
+            size_t middle = (low + high) / 2;
+            if (Keys[middle].Time <= time) {
+                low = middle;
+            }
+            else {
+                high = middle;
+            }
+        }
+
+        const CameraKey& k0 = Keys[low > 0 ? low - 1 : low];
+        const CameraKey& k1 = Keys[low];
+        const CameraKey& k2 = Keys[high];
+        const CameraKey& k3 = Keys[high + 1 < Keys.size() ? high + 1 : high];
+
+        //a held pose stays put rather than drifting with its neighbours' tangents
+        if (samePose(k1, k2)) {
+            camera.SetPose(k1.Position, k1.Yaw, k1.Pitch, k1.Roll);
+            return true;
+        }
+
+        double t = (time - k1.Time) / (k2.Time - k1.Time);
+        glm::vec3 position;
+        for (int axis = 0; axis < 3; ++axis) {
+            position[axis] = catmullRom(k0.Time, k1.Time, k2.Time, k3.Time, k0.Position[axis], k1.Position[axis], k2.Position[axis], k3.Position[axis], t);
+        }
+        float yaw = catmullRom(k0.Time, k1.Time, k2.Time, k3.Time, k0.Yaw, k1.Yaw, k2.Yaw, k3.Yaw, t);
+        float pitch = catmullRom(k0.Time, k1.Time, k2.Time, k3.Time, k0.Pitch, k1.Pitch, k2.Pitch, k3.Pitch, t);
+        float roll = catmullRom(k0.Time, k1.Time, k2.Time, k3.Time, k0.Roll, k1.Roll, k2.Roll, k3.Roll, t);
+        camera.SetPose(position, yaw, glm::clamp(pitch, -89.0f, 89.0f), roll);
+        return true;
+    }
+
+private:
+    static bool samePose(const CameraKey& a, const CameraKey& b) {
+        return a.Position == b.Position && a.Yaw == b.Yaw && a.Pitch == b.Pitch && a.Roll == b.Roll;
+    }
+
+    //Catmull-Rom through p1 and p2 as a cubic Hermite, tangents scaled by the key spacing so
+    //unevenly timed keys don't speed up or slow down across a segment boundary
+    static float catmullRom(double t0, double t1, double t2, double t3, float p0, float p1, float p2, float p3, double t) {
+        double span = t2 - t1;
+        double m1 = t2 > t0 ? (p2 - p0) / (t2 - t0) * span : 0.0;
+        double m2 = t3 > t1 ? (p3 - p1) / (t3 - t1) * span : 0.0;
+
+        double tSquared = t * t;
+        double tCubed = tSquared * t;
+        return (float)((2.0 * tCubed - 3.0 * tSquared + 1.0) * p1 + (tCubed - 2.0 * tSquared + t) * m1
+            + (-2.0 * tCubed + 3.0 * tSquared) * p2 + (tCubed - tSquared) * m2);
+    }
+};
+#endif
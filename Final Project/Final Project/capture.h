@@ -0,0 +1,339 @@
+#ifndef CAPTURE_H
+#define CAPTURE_H
+
+#include <GL/glew.h>
+#include <stb_image_write.h>
+
+#include <algorithm>
+#include <chrono>
+#include <condition_variable>
+#include <cstdint>
+#include <cstdio>
+#include <cstring>
+#include <deque>
+#include <mutex>
+#include <string>
+#include <thread>
+#include <vector>
+
+#include "glstate.h"
+
+//what captured frames are written as
+enum CaptureFormat {
+    CAPTURE_PNG,    // numbered PNG per frame
+    CAPTURE_Y4M     // one uncompressed 4:2:0 YUV4MPEG2 stream
+};
+
+//capture values
+const int CAPTURE_READBACKS = 3;            // pixel pack buffers in flight, the GPU fills one while older ones are read
+const size_t CAPTURE_QUEUE_FRAMES = 8;      // frames waiting for the encoder before new ones are dropped
+
+//what happened to the frames asked for, summed over the capture
+struct CaptureStats {
+    uint64_t Frames;            // frames Capture was called for
+    uint64_t Written;
+    uint64_t DroppedBusy;       // every readback buffer was still waiting on the GPU
+    uint64_t DroppedQueue;      // the encoder was too far behind
+    uint64_t DroppedSize;       // the window no longer matched the size the capture started at
+    double EncodeTime;          // seconds the encoder thread spent converting and writing
+};
+
+//reads finished frames back without stalling the render thread and writes them out on an encoder
+//thread. each frame is read into a pixel pack buffer and fenced, a buffer is only mapped once its
+//fence has passed, a few frames later, so glReadPixels never waits for the GPU. the copies go into
+//a bounded queue, when the encoder falls behind new frames are dropped and counted rather than
+//holding up rendering
+class FrameCapture {
+public:
+    FrameCapture() : format(CAPTURE_PNG), width(0), height(0), frameRate(60), file(nullptr), readback(0), nextIndex(0),
+        running(false), stats() {
+        memset(buffers, 0, sizeof(buffers));
+        memset(fences, 0, sizeof(fences));
+        memset(frameIndices, 0, sizeof(frameIndices));
+    }
+
+    ~FrameCapture() {
+        stopEncoder();
+    }
+
+    FrameCapture(const FrameCapture&) = delete;
+    FrameCapture& operator=(const FrameCapture&) = delete;
+
+    //a path ending in .y4m is written as one stream, anything else as numbered PNGs, frame.png becomes
+    //frame_00000.png, frame_00001.png and so on. needs a current GL context, the frame size is fixed here
+    bool Start(const std::string& newPath, int newWidth, int newHeight, int newFrameRate) {
+        path = newPath;
+        width = newWidth;
+        height = newHeight;
+        frameRate = std::max(1, newFrameRate);
+        stats = CaptureStats();
+        format = path.size() >= 4 && path.compare(path.size() - 4, 4, ".y4m") == 0 ? CAPTURE_Y4M : CAPTURE_PNG;
+
+        if (format == CAPTURE_Y4M) {
+            file = fopen(path.c_str(), "wb");
+            if (!file) {
+                return false;
+            }
+            //the samples are full range, without the tag players and encoders assume 16-235 and crush the blacks
+            fprintf(file, "YUV4MPEG2 W%d H%d F%d:1 Ip A1:1 C420jpeg XCOLORRANGE=FULL\n", width, height, frameRate);
+        }
+
+        size_t bytes = (size_t)width * height * 4;
+        glGenBuffers(CAPTURE_READBACKS, buffers);
+        for (int i = 0; i < CAPTURE_READBACKS; ++i) {
+            glBindBuffer(GL_PIXEL_PACK_BUFFER, buffers[i]);
+            glBufferData(GL_PIXEL_PACK_BUFFER, bytes, nullptr, GL_STREAM_READ);
+        }
+        glBindBuffer(GL_PIXEL_PACK_BUFFER, 0);
+
+        running = true;
+        encoder = std::thread([this]() { encodeLoop(); });
+        return true;
+    }
+
+    bool Active() const {
+        return running;
+    }
+
+    //hands over whatever readbacks have finished, then starts one of the back buffer just drawn. call
+    //before the swap with the size of the window's framebuffer
+    void Capture(GLStateCache& state, int frameWidth, int frameHeight) {
+        if (!running) {
+            return;
+        }
+        ++stats.Frames;
+        collect(false);
+
+        if (frameWidth != width || frameHeight != height) {
+            ++stats.DroppedSize;
+            return;
+        }
+        if (fences[readback] != 0) {
+            ++stats.DroppedBusy;
+            return;
+        }
+
+        state.BindFramebuffer(GL_READ_FRAMEBUFFER, 0);
+        state.PixelStore(GL_PACK_ALIGNMENT, 4);
+        glReadBuffer(GL_BACK);
+        glBindBuffer(GL_PIXEL_PACK_BUFFER, buffers[readback]);
+        glReadPixels(0, 0, width, height, GL_RGBA, GL_UNSIGNED_BYTE, nullptr);
+        glBindBuffer(GL_PIXEL_PACK_BUFFER, 0);
+        fences[readback] = glFenceSync(GL_SYNC_GPU_COMMANDS_COMPLETE, 0);
+        frameIndices[readback] = nextIndex++;
+        readback = (readback + 1) % CAPTURE_READBACKS;
+    }
+
+    //waits for the readbacks in flight and for the encoder to write everything queued
+    void Stop() {
+        if (!running) {
+            return;
+        }
+        collect(true);
+        stopEncoder();
+        glDeleteBuffers(CAPTURE_READBACKS, buffers);
+        memset(buffers, 0, sizeof(buffers));
+        if (file) {
+            fclose(file);
+            file = nullptr;
+        }
+    }
+
+    //safe once Stop has returned
+    const CaptureStats& Stats() const {
+        return stats;
+    }
+
+    const std::string& Path() const {
+        return path;
+    }
+
+private:
+    //one frame as read back, rows bottom up
+    struct Frame {
+        uint64_t Index;
+        std::vector<unsigned char> Pixels;
+    };
+
+    CaptureFormat format;
+    std::string path;
+    int width;
+    int height;
+    int frameRate;
+    FILE* file;
+
+    GLuint buffers[CAPTURE_READBACKS];
+    GLsync fences[CAPTURE_READBACKS];
+    uint64_t frameIndices[CAPTURE_READBACKS];
+    int readback;           // the buffer the next frame is read into, the oldest in flight
+    uint64_t nextIndex;     // frames read back so far, numbers the PNGs
+
+    std::thread encoder;
+    std::mutex lock;
+    std::condition_variable queueChanged;
+    std::deque<Frame> queue;
+    std::vector<std::vector<unsigned char>> spare;  // pixel storage the encoder is done with
+    bool running;
+
+    CaptureStats stats;     // the encoder only writes EncodeTime and Written, under the lock
+
+    //maps readbacks oldest first until one isn't done, or waits for each when draining
+    void collect(bool wait) {
+        for (int i = 0; i < CAPTURE_READBACKS; ++i) {
+            int index = (readback + i) % CAPTURE_READBACKS;
+            if (fences[index] == 0) {
+                continue;
+            }
+            GLenum result = glClientWaitSync(fences[index], wait ? GL_SYNC_FLUSH_COMMANDS_BIT : 0, wait ? 1000000000 : 0);
+            if (result == GL_TIMEOUT_EXPIRED) {
+                break;
+            }
+            glDeleteSync(fences[index]);
+            fences[index] = 0;
+
+            Frame frame;
+            frame.Index = frameIndices[index];
+            {
+                std::lock_guard<std::mutex> guard(lock);
+                if (queue.size() >= CAPTURE_QUEUE_FRAMES && !wait) {
+                    ++stats.DroppedQueue;
+                    continue;
+                }
+                if (!spare.empty()) {
+                    frame.Pixels.swap(spare.back());
+                    spare.pop_back();
+                }
+            }
+
+            size_t bytes = (size_t)width * height * 4;
+            frame.Pixels.resize(bytes);
+            glBindBuffer(GL_PIXEL_PACK_BUFFER, buffers[index]);
+            const void* mapped = glMapBufferRange(GL_PIXEL_PACK_BUFFER, 0, bytes, GL_MAP_READ_BIT);
+            if (mapped) {
+                memcpy(frame.Pixels.data(), mapped, bytes);
+                glUnmapBuffer(GL_PIXEL_PACK_BUFFER);
+            }
+            glBindBuffer(GL_PIXEL_PACK_BUFFER, 0);
+            if (!mapped) {
+                continue;
+            }
+
+            {
+                std::lock_guard<std::mutex> guard(lock);
+                queue.push_back(std::move(frame));
+            }
+            queueChanged.notify_one();
+        }
+    }
+
+    void stopEncoder() {
+        {
+            std::lock_guard<std::mutex> guard(lock);
+            running = false;
+        }
+        queueChanged.notify_one();
+        if (encoder.joinable()) {
+            encoder.join();
+        }
+    }
+
+    void encodeLoop() {
+        std::vector<unsigned char> scratch;
+        for (;;) {
+            Frame frame;
+            {
+                std::unique_lock<std::mutex> guard(lock);
+                queueChanged.wait(guard, [this]() { return !queue.empty() || !running; });
+                if (queue.empty()) {
+                    return;
+                }
+                frame = std::move(queue.front());
+                queue.pop_front();
+            }
+
+            std::chrono::steady_clock::time_point start = std::chrono::steady_clock::now();
+            bool written = format == CAPTURE_Y4M ? writeY4m(frame, scratch) : writePng(frame, scratch);
+            double elapsed = std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+
+            std::lock_guard<std::mutex> guard(lock);
+            stats.EncodeTime += elapsed;
+            stats.Written += written ? 1 : 0;
+            spare.push_back(std::move(frame.Pixels));
+        }
+    }
+
+    //flips to top down and drops alpha, the back buffer's isn't meaningful
+    bool writePng(const Frame& frame, std::vector<unsigned char>& rgb) const {
+        rgb.resize((size_t)width * height * 3);
+        for (int y = 0; y < height; ++y) {
+            const unsigned char* source = frame.Pixels.data() + (size_t)(height - 1 - y) * width * 4;
+            unsigned char* target = rgb.data() + (size_t)y * width * 3;
+            for (int x = 0; x < width; ++x) {
+                target[x * 3] = source[x * 4];
+                target[x * 3 + 1] = source[x * 4 + 1];
+                target[x * 3 + 2] = source[x * 4 + 2];
+            }
+        }
+
+        std::string name = path;
+        size_t dot = name.find_last_of('.');
+        size_t slash = name.find_last_of("/\\");
+        if (dot == std::string::npos || (slash != std::string::npos && dot < slash)) {
+            dot = name.size();
+        }
+        char number[32];
+        snprintf(number, sizeof(number), "_%05llu", (unsigned long long)frame.Index);
+        name.insert(dot, number);
+        if (dot == path.size()) {
+            name += ".png";
+        }
+        return stbi_write_png(name.c_str(), width, height, 3, rgb.data(), width * 3) != 0;
+    }
+
+    //full range BT.601 in 8.8 fixed point, chroma averaged over each 2x2 block (one pixel wide or
+    //tall at odd edges), planes top down
+    bool writeY4m(const Frame& frame, std::vector<unsigned char>& planes) const {
+        int chromaWidth = (width + 1) / 2;
+        int chromaHeight = (height + 1) / 2;
+        size_t lumaSize = (size_t)width * height;
+        size_t chromaSize = (size_t)chromaWidth * chromaHeight;
+        planes.resize(lumaSize + chromaSize * 2);
+        unsigned char* luma = planes.data();
+        unsigned char* cb = luma + lumaSize;
+        unsigned char* cr = cb + chromaSize;
+
+        for (int y = 0; y < height; ++y) {
+            const unsigned char* source = frame.Pixels.data() + (size_t)(height - 1 - y) * width * 4;
+            unsigned char* target = luma + (size_t)y * width;
+            for (int x = 0; x < width; ++x) {
+                int r = source[x * 4], g = source[x * 4 + 1], b = source[x * 4 + 2];
+                target[x] = (unsigned char)((77 * r + 150 * g + 29 * b + 128) >> 8);
+            }
+        }
+
+        for (int cy = 0; cy < chromaHeight; ++cy) {
+            for (int cx = 0; cx < chromaWidth; ++cx) {
+                int r = 0, g = 0, b = 0, count = 0;
+                for (int y = cy * 2; y < std::min(cy * 2 + 2, height); ++y) {
+                    const unsigned char* source = frame.Pixels.data() + (size_t)(height - 1 - y) * width * 4;
+                    for (int x = cx * 2; x < std::min(cx * 2 + 2, width); ++x) {
+                        r += source[x * 4];
+                        g += source[x * 4 + 1];
+                        b += source[x * 4 + 2];
+                        ++count;
+                    }
+                }
+                r /= count;
+                g /= count;
+                b /= count;
+                size_t index = (size_t)cy * chromaWidth + cx;
+                cb[index] = (unsigned char)std::min(255, (-43 * r - 85 * g + 128 * b + 32768 + 128) >> 8);
+                cr[index] = (unsigned char)std::min(255, (128 * r - 107 * g - 21 * b + 32768 + 128) >> 8);
+            }
+        }
+
+        fputs("FRAME\n", file);
+        return fwrite(planes.data(), 1, planes.size(), file) == planes.size();
+    }
+};
+#endif
@@ -0,0 +1,101 @@
+#ifndef DYNAMICRESOLUTION_H
+#define DYNAMICRESOLUTION_H
+
+#include <algorithm>
+#include <cmath>
+#include <cstdint>
+
+//resolution controller values
+const float RENDER_SCALE_STEP = 0.05f;      // scale moves in steps so targets aren't rebuilt every frame
+const double BUDGET_HEADROOM = 0.9;         // aim this far under the budget so small spikes don't miss it
+const double SCALE_DROP_RATE = 0.5;         // share of the way to the wanted scale covered per frame when over budget
+const double SCALE_RISE_RATE = 0.05;        // and when under, climbing back is slower so it doesn't oscillate
+
+//picks the render target scale each frame from how long the last frame took. pixel cost goes
+//with the square of the scale, so the scale that fits the budget is the current one times the
+//square root of budget over time
+class DynamicResolution {
+public:
+    double Budget;      // seconds per frame, 0 keeps the scale where it is
+    float MinScale;
+    float MaxScale;
+
+    DynamicResolution() : Budget(0.0), MinScale(0.5f), MaxScale(1.0f), scale(1.0f), wantedScale(1.0f),
+        frames(0), misses(0), scaleSum(0.0), scaleChanges(0) {}
+
+    //fixed scale, or the starting one when there's a budget
+    void SetScale(float newScale) {
+        scale = wantedScale = quantize(std::min(std::max(newScale, MinScale), MaxScale));
+    }
+
+    float Scale() const {
+        return scale;
+    }
+
+    //render target size for a window size, never below one pixel
+    void ScaledSize(int width, int height, int& scaledWidth, int& scaledHeight) const {
+        scaledWidth = std::max(1, (int)(width * scale + 0.5f));
+        scaledHeight = std::max(1, (int)(height * scale + 0.5f));
+    }
+
+    //feeds in the time the frame's work took, the new scale applies from the next frame
+    void Update(double frameTime) {
+        ++frames;
+        scaleSum += scale;
+        if (Budget <= 0.0) {
+            return;
+        }
+        if (frameTime > Budget) {
+            ++misses;
+        }
+
+        double fit = scale * sqrt(Budget * BUDGET_HEADROOM / std::max(frameTime, 1.0e-6));
+        double rate = fit < wantedScale ? SCALE_DROP_RATE : SCALE_RISE_RATE;
+        wantedScale += (float)((fit - wantedScale) * rate);
+        wantedScale = std::min(std::max(wantedScale, MinScale), MaxScale);
+
+        //only whole steps change the targets. dropping goes as soon as a lower step is wanted, rising
+        //waits until the wanted scale is a full step up so it doesn't flip between two neighbours
+        float stepped = quantize(wantedScale);
+        bool drop = stepped < scale;
+        bool rise = wantedScale >= scale + RENDER_SCALE_STEP && stepped > scale;
+        if (drop || rise) {
+            scale = stepped;
+            ++scaleChanges;
+        }
+    }
+
+    //--- metrics ---
+
+    uint64_t Frames() const {
+        return frames;
+    }
+
+    //frames that took longer than the budget
+    uint64_t Misses() const {
+        return misses;
+    }
+
+    double AverageScale() const {
+        return frames > 0 ? scaleSum / frames : scale;
+    }
+
+    uint64_t ScaleChanges() const {
+        return scaleChanges;
+    }
+
+private:
+    float scale;
+    float wantedScale;  // smoothed controller output, the scale follows it in steps
+
+    uint64_t frames;
+    uint64_t misses;
+    double scaleSum;
+    uint64_t scaleChanges;
+
+    float quantize(float value) const {
+        float stepped = floorf(value / RENDER_SCALE_STEP + 0.5f) * RENDER_SCALE_STEP;
+        return std::min(std::max(stepped, MinScale), MaxScale);
+    }
+};
+#endif
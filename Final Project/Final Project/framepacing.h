@@ -0,0 +1,164 @@
+#ifndef FRAMEPACING_H
+#define FRAMEPACING_H
+
+#include <GLFW/glfw3.h>
+
+#include <algorithm>
+#include <chrono>
+#include <thread>
+
+#ifdef _WIN32
+#ifndef NOMINMAX
+#define NOMINMAX
+#endif
+#ifndef WIN32_LEAN_AND_MEAN
+#define WIN32_LEAN_AND_MEAN
+#endif
+#include <windows.h>
+#include <timeapi.h>
+#pragma comment(lib, "winmm.lib")
+#endif
+
+//how frames are handed to the display
+enum PresentMode {
+    PRESENT_VSYNC_OFF,
+    PRESENT_VSYNC_ON,
+    PRESENT_VSYNC_ADAPTIVE  // vsync, but late frames are shown straight away instead of waiting another refresh
+};
+
+//frame limiter values
+const int DELTA_HISTORY = 8;            // frames averaged for the smoothed delta time
+const double MAX_DELTA = 0.25;          // longest frame movement is allowed to cover, hitches beyond it are clamped
+const double MAX_SPIN_TIME = 0.002;     // cap on the busy wait at the end of a frame
+
+//caps the frame rate and smooths the time step handed to the camera
+class FramePacer {
+public:
+    PresentMode Mode;
+    double TargetFrameTime;     // seconds per frame, 0 for no cap
+    bool LowLatency;            // sample input right before rendering and don't let the driver queue frames
+
+    FramePacer() : Mode(PRESENT_VSYNC_ON), TargetFrameTime(0.0), LowLatency(false),
+        sleepSlack(0.001), historyCount(0), historyIndex(0), timerPeriodSet(false) {
+        deadline = Clock::now();
+        for (int i = 0; i < DELTA_HISTORY; ++i) {
+            history[i] = 0.0;
+        }
+    }
+
+    ~FramePacer() {
+#ifdef _WIN32
+        if (timerPeriodSet) {
+            timeEndPeriod(1);
+        }
+#endif
+    }
+
+    //sets the swap interval for the current context, call after the context is made current
+    void ApplySwapInterval() {
+        int interval = 0;
+        if (Mode == PRESENT_VSYNC_ON) {
+            interval = 1;
+        }
+        else if (Mode == PRESENT_VSYNC_ADAPTIVE) {
+            //negative intervals only work with the tear control extension, plain vsync otherwise
+            bool tearControl = glfwExtensionSupported("WGL_EXT_swap_control_tear") || glfwExtensionSupported("GLX_EXT_swap_control_tear");
+            interval = tearControl ? -1 : 1;
+        }
+        glfwSwapInterval(interval);
+
+#ifdef _WIN32
+        //the default 15.6ms scheduler tick makes sleep useless for frame limiting
+        if (TargetFrameTime > 0.0 && !timerPeriodSet) {
+            timeBeginPeriod(1);
+            timerPeriodSet = true;
+        }
+#endif
+    }
+
+    void SetFrameRateCap(double framesPerSecond) {
+        TargetFrameTime = framesPerSecond > 0.0 ? 1.0 / framesPerSecond : 0.0;
+    }
+
+    //blocks until the next frame is due. sleeps for most of the wait so the core is free for
+    //other work, then spins the last stretch because sleep alone overshoots by up to a tick
+    void WaitForNextFrame() {
+        if (TargetFrameTime <= 0.0) {
+            return;
+        }
+
+        Clock::time_point now = Clock::now();
+        deadline += toDuration(TargetFrameTime);
+
+        //a frame that ran long resets the schedule rather than rushing the next few to catch up
+        if (now > deadline) {
+            deadline = now;
+            return;
+        }
+
+        double remaining = seconds(deadline - now);
+        double sleepTime = remaining - sleepSlack;
+        if (sleepTime > 0.0) {
+            Clock::time_point before = Clock::now();
+            std::this_thread::sleep_for(toDuration(sleepTime));
+            double overslept = seconds(Clock::now() - before) - sleepTime;
+
+            //learn how late the OS wakes us, grow fast and shrink slowly so a single good wake doesn't cause a miss
+            if (overslept > sleepSlack) {
+                sleepSlack = std::min(overslept * 1.25, MAX_SPIN_TIME);
+            }
+            else {
+                sleepSlack = std::max(sleepSlack * 0.99, 0.0001);
+            }
+        }
+
+        while (Clock::now() < deadline) {
+            std::this_thread::yield();
+        }
+    }
+
+    //average of the last few frame times with spikes clamped, keeps camera speed steady through a hitch
+    double SmoothDeltaTime(double rawDelta) {
+        double delta = std::max(0.0, std::min(rawDelta, MAX_DELTA));
+
+        //one slow frame shouldn't drag the average, limit it to twice the recent average
+        if (historyCount == DELTA_HISTORY) {
+            delta = std::min(delta, 2.0 * average());
+        }
+
+        history[historyIndex] = delta;
+        historyIndex = (historyIndex + 1) % DELTA_HISTORY;
+        historyCount = std::min(historyCount + 1, DELTA_HISTORY);
+
+        return average();
+    }
+
+private:
+    typedef std::chrono::steady_clock Clock;
+
+    Clock::time_point deadline;
+    double sleepSlack;
+
+    double history[DELTA_HISTORY];
+    int historyCount;
+    int historyIndex;
+
+    bool timerPeriodSet;
+
+    double average() const {
+        double sum = 0.0;
+        for (int i = 0; i < historyCount; ++i) {
+            sum += history[i];
+        }
+        return historyCount > 0 ? sum / historyCount : 0.0;
+    }
+
+    static Clock::duration toDuration(double time) {
+        return std::chrono::duration_cast<Clock::duration>(std::chrono::duration<double>(time));
+    }
+
+    static double seconds(Clock::duration duration) {
+        return std::chrono::duration<double>(duration).count();
+    }
+};
+#endif
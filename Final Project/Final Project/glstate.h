@@ -0,0 +1,305 @@
+#ifndef GLSTATE_H
+#define GLSTATE_H
+
+#include <GL/glew.h>
+
+#include <cstdint>
+
+//state cache values
+const int GL_STATE_TEXTURE_UNITS = 16;     // texture units whose 2D binding is tracked
+const int GL_STATE_BUFFER_BINDINGS = 16;   // indexed uniform buffer binding points tracked
+
+//state calls made in a frame, redundant ones set something to the value it already had
+struct GLStateStats {
+    uint64_t Issued;
+    uint64_t Redundant;
+};
+
+//shadow copy of the GL state the render loop touches. every setter compares against the copy and
+//only calls into GL when the value actually changes, so a draw loop can set what it needs without
+//knowing what the previous draw left behind. anything that changes state behind its back has to
+//call Invalidate() afterwards, unknown state is always issued
+class GLStateCache {
+public:
+    bool Filtering;     // false passes every call through, for measuring what the filtering saves
+
+    GLStateCache() : Filtering(true) {
+        Invalidate();
+        frame = GLStateStats{ 0, 0 };
+        lastFrame = frame;
+        total = frame;
+        frames = 0;
+    }
+
+    //forget everything, the next call of each kind goes to GL
+    void Invalidate() {
+        for (int i = 0; i < CAPABILITY_COUNT; ++i) {
+            capabilities[i].Known = false;
+        }
+        clearColor.Known = false;
+        viewport.Known = false;
+        program.Known = false;
+        vertexArray.Known = false;
+        activeTexture.Known = false;
+        for (int i = 0; i < GL_STATE_TEXTURE_UNITS; ++i) {
+            textures[i].Known = false;
+        }
+        for (int i = 0; i < GL_STATE_BUFFER_BINDINGS; ++i) {
+            uniformRanges[i].Known = false;
+        }
+        readFramebuffer.Known = false;
+        drawFramebuffer.Known = false;
+        packAlignment.Known = false;
+        unpackAlignment.Known = false;
+    }
+
+    //closes the previous frame's counts
+    void BeginFrame() {
+        lastFrame = frame;
+        total.Issued += frame.Issued;
+        total.Redundant += frame.Redundant;
+        frame = GLStateStats{ 0, 0 };
+        ++frames;
+    }
+
+    const GLStateStats& LastFrame() const {
+        return lastFrame;
+    }
+
+    //averages per frame over the whole run
+    double IssuedPerFrame() const {
+        return frames > 0 ? (double)total.Issued / frames : 0.0;
+    }
+
+    double RedundantPerFrame() const {
+        return frames > 0 ? (double)total.Redundant / frames : 0.0;
+    }
+
+    //--- fixed function switches ---
+
+    void Enable(GLenum capability) {
+        setCapability(capability, true);
+    }
+
+    void Disable(GLenum capability) {
+        setCapability(capability, false);
+    }
+
+    void ClearColor(float r, float g, float b, float a) {
+        Color color = { r, g, b, a };
+        if (changed(clearColor, color)) {
+            glClearColor(r, g, b, a);
+        }
+    }
+
+    void Viewport(GLint x, GLint y, GLsizei width, GLsizei height) {
+        Rect rect = { x, y, width, height };
+        if (changed(viewport, rect)) {
+            glViewport(x, y, width, height);
+        }
+    }
+
+    void PixelStore(GLenum name, GLint value) {
+        Tracked<GLint>* slot = name == GL_PACK_ALIGNMENT ? &packAlignment : name == GL_UNPACK_ALIGNMENT ? &unpackAlignment : nullptr;
+        if (slot == nullptr) {
+            ++frame.Issued;
+        }
+        else if (!changed(*slot, value)) {
+            return;
+        }
+        glPixelStorei(name, value);
+    }
+
+    //--- object bindings ---
+
+    void UseProgram(GLuint id) {
+        if (changed(program, id)) {
+            glUseProgram(id);
+        }
+    }
+
+    void BindVertexArray(GLuint id) {
+        if (changed(vertexArray, id)) {
+            glBindVertexArray(id);
+        }
+    }
+
+    void ActiveTexture(GLenum unit) {
+        if (changed(activeTexture, unit)) {
+            glActiveTexture(unit);
+        }
+    }
+
+    //only 2D bindings on the first units are tracked, anything else is passed through
+    void BindTexture(GLenum target, GLuint id) {
+        int unit = activeTexture.Known ? (int)(activeTexture.Value - GL_TEXTURE0) : -1;
+        if (target == GL_TEXTURE_2D && unit >= 0 && unit < GL_STATE_TEXTURE_UNITS) {
+            if (!changed(textures[unit], id)) {
+                return;
+            }
+        }
+        else {
+            ++frame.Issued;
+        }
+        glBindTexture(target, id);
+    }
+
+    //a deleted texture is unbound by GL, and its name can come back from glGenTextures
+    void DeleteTexture(GLuint id) {
+        for (int i = 0; i < GL_STATE_TEXTURE_UNITS; ++i) {
+            if (textures[i].Known && textures[i].Value == id) {
+                textures[i].Value = 0;
+            }
+        }
+        glDeleteTextures(1, &id);
+    }
+
+    //a deleted framebuffer that is bound reverts to the window's, and its name can be handed out again
+    void DeleteFramebuffer(GLuint id) {
+        if (readFramebuffer.Known && readFramebuffer.Value == id) {
+            readFramebuffer.Value = 0;
+        }
+        if (drawFramebuffer.Known && drawFramebuffer.Value == id) {
+            drawFramebuffer.Value = 0;
+        }
+        glDeleteFramebuffers(1, &id);
+    }
+
+    //binds part of a buffer to an indexed uniform block binding
+    void BindUniformRange(GLuint index, GLuint buffer, GLintptr offset, GLsizeiptr size) {
+        if (index < (GLuint)GL_STATE_BUFFER_BINDINGS) {
+            Range range = { buffer, offset, size };
+            if (!changed(uniformRanges[index], range)) {
+                return;
+            }
+        }
+        else {
+            ++frame.Issued;
+        }
+        glBindBufferRange(GL_UNIFORM_BUFFER, index, buffer, offset, size);
+    }
+
+    //GL_FRAMEBUFFER sets both the read and draw binding
+    void BindFramebuffer(GLenum target, GLuint id) {
+        bool read = target == GL_READ_FRAMEBUFFER || target == GL_FRAMEBUFFER;
+        bool draw = target == GL_DRAW_FRAMEBUFFER || target == GL_FRAMEBUFFER;
+        if (!(read && differs(readFramebuffer, id)) && !(draw && differs(drawFramebuffer, id))) {
+            ++frame.Redundant;
+            if (Filtering) {
+                return;
+            }
+        }
+
+        ++frame.Issued;
+        if (read) {
+            readFramebuffer.Value = id;
+            readFramebuffer.Known = true;
+        }
+        if (draw) {
+            drawFramebuffer.Value = id;
+            drawFramebuffer.Known = true;
+        }
+        glBindFramebuffer(target, id);
+    }
+
+private:
+    template <typename T>
+    struct Tracked {
+        T Value;
+        bool Known;
+    };
+
+    struct Color {
+        float R, G, B, A;
+        bool operator==(const Color& other) const {
+            return R == other.R && G == other.G && B == other.B && A == other.A;
+        }
+    };
+
+    struct Rect {
+        GLint X, Y;
+        GLsizei Width, Height;
+        bool operator==(const Rect& other) const {
+            return X == other.X && Y == other.Y && Width == other.Width && Height == other.Height;
+        }
+    };
+
+    struct Range {
+        GLuint Buffer;
+        GLintptr Offset;
+        GLsizeiptr Size;
+        bool operator==(const Range& other) const {
+            return Buffer == other.Buffer && Offset == other.Offset && Size == other.Size;
+        }
+    };
+
+    //capabilities the renderer switches, others are passed through untracked
+    static const int CAPABILITY_COUNT = 6;
+    static int capabilityIndex(GLenum capability) {
+        switch (capability) {
+        case GL_DEPTH_TEST: return 0;
+        case GL_CULL_FACE: return 1;
+        case GL_BLEND: return 2;
+        case GL_MULTISAMPLE: return 3;
+        case GL_FRAMEBUFFER_SRGB: return 4;
+        case GL_SCISSOR_TEST: return 5;
+        default: return -1;
+        }
+    }
+
+    Tracked<bool> capabilities[CAPABILITY_COUNT];
+    Tracked<Color> clearColor;
+    Tracked<Rect> viewport;
+    Tracked<GLuint> program;
+    Tracked<GLuint> vertexArray;
+    Tracked<GLenum> activeTexture;
+    Tracked<GLuint> textures[GL_STATE_TEXTURE_UNITS];
+    Tracked<Range> uniformRanges[GL_STATE_BUFFER_BINDINGS];
+    Tracked<GLuint> readFramebuffer;
+    Tracked<GLuint> drawFramebuffer;
+    Tracked<GLint> packAlignment;
+    Tracked<GLint> unpackAlignment;
+
+    GLStateStats frame;
+    GLStateStats lastFrame;
+    GLStateStats total;
+    uint64_t frames;
+
+    template <typename T>
+    static bool differs(const Tracked<T>& slot, const T& value) {
+        return !slot.Known || !(slot.Value == value);
+    }
+
+    //counts the call and records the new value, true when it has to go to GL
+    template <typename T>
+    bool changed(Tracked<T>& slot, const T& value) {
+        if (!differs(slot, value)) {
+            ++frame.Redundant;
+            if (Filtering) {
+                return false;
+            }
+        }
+        ++frame.Issued;
+        slot.Value = value;
+        slot.Known = true;
+        return true;
+    }
+
+    void setCapability(GLenum capability, bool enabled) {
+        int index = capabilityIndex(capability);
+        if (index < 0) {
+            ++frame.Issued;
+        }
+        else if (!changed(capabilities[index], enabled)) {
+            return;
+        }
+
+        if (enabled) {
+            glEnable(capability);
+        }
+        else {
+            glDisable(capability);
+        }
+    }
+};
+#endif
@@ -0,0 +1,338 @@
+#ifndef GPUCULLING_H
+#define GPUCULLING_H
+
+#include <GL/glew.h>
+#include <glm/glm.hpp>
+#include <glm/gtc/type_ptr.hpp>
+
+#include <algorithm>
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+
+#include "glstate.h"
+
+//buffer and attribute slots the cull pass and the indirect vertex shaders agree on
+const GLuint GPU_OBJECT_BINDING = 0;        // shader storage, one GpuObject per object
+const GLuint GPU_COMMAND_BINDING = 1;       // shader storage, the indirect draws
+const GLuint GPU_COUNT_BINDING = 2;         // shader storage, surviving draws per batch
+const GLuint GPU_BATCH_BINDING = 3;         // shader storage, first command of each batch
+const GLuint GPU_OBJECT_ID_ATTRIBUTE = 3;   // instanced vertex attribute, the object a draw is for
+
+//workgroup sizes of the compute programs, have to match their local_size
+const GLuint GPU_CULL_GROUP_SIZE = 64;
+const GLuint GPU_PYRAMID_GROUP_SIZE = 8;
+
+//std430 ObjectData, what the cull pass tests and the indirect vertex shaders draw with
+struct GpuObject {
+    glm::mat4 Model;
+    glm::vec4 PositionOffset;   // packed vertex decode, offset 0 and scale 1 for float vertices
+    glm::vec4 PositionScale;
+    glm::vec4 BoundsCenter;     // local space box
+    glm::vec4 BoundsExtent;
+    uint32_t Batch;
+    uint32_t FirstIndex;
+    uint32_t IndexCount;
+    uint32_t Slot;              // its command in the batch when draws aren't compacted
+    glm::vec4 Material;         // passed through to the fragment shader
+};
+static_assert(sizeof(GpuObject) == 160, "GpuObject matches the std430 ObjectData struct");
+
+//DrawElementsIndirectCommand
+struct GpuDrawCommand {
+    GLuint Count;
+    GLuint InstanceCount;
+    GLuint FirstIndex;
+    GLint BaseVertex;
+    GLuint BaseInstance;        // the object, read back through the instanced object id attribute
+};
+static_assert(sizeof(GpuDrawCommand) == 20, "GpuDrawCommand matches DrawElementsIndirectCommand");
+
+//objects drawn with the same program, texture and vertex array, one multi draw for all of them
+struct GpuBatch {
+    GLuint Program;
+    GLuint Texture;             // 0 when the program samples nothing
+    GLuint Vao;
+    GLuint FirstCommand;
+    GLuint Capacity;            // objects in the batch
+};
+
+//GPU driven drawing: objects live in a storage buffer, a compute pass frustum culls them and tests
+//them against a depth pyramid of the previous frame, then writes the survivors into an indirect
+//buffer that each batch draws with one call. with ARB_indirect_parameters the survivors are
+//compacted and the GPU supplies the draw count, otherwise every object keeps its command and the
+//culled ones get an instance count of 0. the CPU cost per frame depends on the number of batches,
+//not of objects. the compute programs are compiled by the caller with the rest of the shaders
+class GpuCulling {
+public:
+    bool Occlusion;             // test against the depth pyramid as well as the frustum
+
+    GpuCulling() : Occlusion(true), cullProgram(0), pyramidProgram(0), dirtyBegin(SIZE_MAX), dirtyEnd(0), objectBuffer(0), commandBuffer(0), countBuffer(0), batchBuffer(0),
+        objectIdBuffer(0), pyramid(0), pyramidWidth(0), pyramidHeight(0), pyramidLevels(0), pyramidValid(false), compact(false) {}
+
+    void Create(GLuint cull, GLuint depthPyramid) {
+        cullProgram = cull;
+        pyramidProgram = depthPyramid;
+        compact = GLEW_ARB_indirect_parameters != 0;
+
+        glUseProgram(cullProgram);
+        glUniform1i(glGetUniformLocation(cullProgram, "depthPyramid"), 0);
+        glUseProgram(pyramidProgram);
+        glUniform1i(glGetUniformLocation(pyramidProgram, "source"), 0);
+        glUseProgram(0);
+    }
+
+    void Destroy(GLStateCache& state) {
+        GLuint buffers[] = { objectBuffer, commandBuffer, countBuffer, batchBuffer, objectIdBuffer };
+        glDeleteBuffers(5, buffers);
+        objectBuffer = commandBuffer = countBuffer = batchBuffer = objectIdBuffer = 0;
+        if (pyramid != 0) {
+            state.DeleteTexture(pyramid);
+            pyramid = 0;
+        }
+    }
+
+    //the batch for this state, created the first time it's asked for
+    uint32_t Batch(GLuint program, GLuint texture, GLuint vao) {
+        for (size_t i = 0; i < batches.size(); ++i) {
+            if (batches[i].Program == program && batches[i].Texture == texture && batches[i].Vao == vao) {
+                return (uint32_t)i;
+            }
+        }
+        batches.push_back({ program, texture, vao, 0, 0 });
+        return (uint32_t)(batches.size() - 1);
+    }
+
+    //queues an object for Upload, Batch and Slot are filled in here. returns its index
+    size_t AddObject(GpuObject object) {
+        object.Slot = batches[object.Batch].Capacity++;
+        objects.push_back(object);
+        return objects.size() - 1;
+    }
+
+    size_t ObjectCount() const {
+        return objects.size();
+    }
+
+    size_t BatchCount() const {
+        return batches.size();
+    }
+
+    //whether the GPU compacts the draws and supplies their count
+    bool Compacting() const {
+        return compact;
+    }
+
+    //creates the buffers for everything added so far and gives every batch's vertex array the
+    //object id attribute. objects can't be added afterwards, only updated
+    void Upload(GLStateCache& state) {
+        GLuint firstCommand = 0;
+        std::vector<GLuint> firstCommands(batches.size());
+        for (size_t i = 0; i < batches.size(); ++i) {
+            batches[i].FirstCommand = firstCommand;
+            firstCommands[i] = firstCommand;
+            firstCommand += batches[i].Capacity;
+        }
+
+        //the moving objects are rewritten every frame, the rest once here
+        glGenBuffers(1, &objectBuffer);
+        glBindBuffer(GL_SHADER_STORAGE_BUFFER, objectBuffer);
+        glBufferData(GL_SHADER_STORAGE_BUFFER, std::max<size_t>(objects.size(), 1) * sizeof(GpuObject), objects.data(), GL_DYNAMIC_DRAW);
+
+        glGenBuffers(1, &commandBuffer);
+        glBindBuffer(GL_SHADER_STORAGE_BUFFER, commandBuffer);
+        glBufferData(GL_SHADER_STORAGE_BUFFER, std::max<size_t>(objects.size(), 1) * sizeof(GpuDrawCommand), nullptr, GL_DYNAMIC_COPY);
+
+        glGenBuffers(1, &countBuffer);
+        glBindBuffer(GL_SHADER_STORAGE_BUFFER, countBuffer);
+        glBufferData(GL_SHADER_STORAGE_BUFFER, std::max<size_t>(batches.size(), 1) * sizeof(GLuint), nullptr, GL_DYNAMIC_COPY);
+
+        glGenBuffers(1, &batchBuffer);
+        glBindBuffer(GL_SHADER_STORAGE_BUFFER, batchBuffer);
+        glBufferData(GL_SHADER_STORAGE_BUFFER, std::max<size_t>(batches.size(), 1) * sizeof(GLuint), firstCommands.data(), GL_STATIC_DRAW);
+        glBindBuffer(GL_SHADER_STORAGE_BUFFER, 0);
+
+        //instance i of a draw with base instance b reads entry b + i, so entry n holding n hands
+        //the vertex shader the object straight from the command
+        std::vector<GLuint> ids(std::max<size_t>(objects.size(), 1));
+        for (size_t i = 0; i < ids.size(); ++i) {
+            ids[i] = (GLuint)i;
+        }
+        glGenBuffers(1, &objectIdBuffer);
+        glBindBuffer(GL_ARRAY_BUFFER, objectIdBuffer);
+        glBufferData(GL_ARRAY_BUFFER, ids.size() * sizeof(GLuint), ids.data(), GL_STATIC_DRAW);
+        for (const GpuBatch& batch : batches) {
+            state.BindVertexArray(batch.Vao);
+            glEnableVertexAttribArray(GPU_OBJECT_ID_ATTRIBUTE);
+            glVertexAttribIPointer(GPU_OBJECT_ID_ATTRIBUTE, 1, GL_UNSIGNED_INT, sizeof(GLuint), nullptr);
+            glVertexAttribDivisor(GPU_OBJECT_ID_ATTRIBUTE, 1);
+        }
+        state.BindVertexArray(0);
+        glBindBuffer(GL_ARRAY_BUFFER, 0);
+    }
+
+    //moves an object, the changed range is uploaded by the next Cull
+    void SetModel(size_t object, const glm::mat4& model) {
+        objects[object].Model = model;
+        dirtyBegin = std::min(dirtyBegin, object);
+        dirtyEnd = std::max(dirtyEnd, object + 1);
+    }
+
+    //writes this frame's draws. occlusion uses the pyramid of the last frame and the matrix it was
+    //drawn with, so something uncovered this frame can be missing for one frame
+    void Cull(GLStateCache& state, const glm::mat4& viewProjection) {
+        if (objects.empty()) {
+            return;
+        }
+        if (dirtyBegin < dirtyEnd) {
+            glBindBuffer(GL_SHADER_STORAGE_BUFFER, objectBuffer);
+            glBufferSubData(GL_SHADER_STORAGE_BUFFER, dirtyBegin * sizeof(GpuObject), (dirtyEnd - dirtyBegin) * sizeof(GpuObject), &objects[dirtyBegin]);
+            dirtyBegin = SIZE_MAX;
+            dirtyEnd = 0;
+        }
+
+        const GLuint zero = 0;
+        glBindBuffer(GL_SHADER_STORAGE_BUFFER, countBuffer);
+        glClearBufferData(GL_SHADER_STORAGE_BUFFER, GL_R32UI, GL_RED_INTEGER, GL_UNSIGNED_INT, &zero);
+        glBindBuffer(GL_SHADER_STORAGE_BUFFER, 0);
+
+        bindBuffers();
+        state.UseProgram(cullProgram);
+        glUniformMatrix4fv(glGetUniformLocation(cullProgram, "viewProjection"), 1, GL_FALSE, glm::value_ptr(viewProjection));
+        glUniformMatrix4fv(glGetUniformLocation(cullProgram, "occlusionViewProjection"), 1, GL_FALSE, glm::value_ptr(pyramidViewProjection));
+        glUniform1i(glGetUniformLocation(cullProgram, "pyramidLevels"), Occlusion && pyramidValid ? pyramidLevels : 0);
+        glUniform1ui(glGetUniformLocation(cullProgram, "objectCount"), (GLuint)objects.size());
+        glUniform1i(glGetUniformLocation(cullProgram, "compact"), compact ? 1 : 0);
+        state.ActiveTexture(GL_TEXTURE0);
+        state.BindTexture(GL_TEXTURE_2D, pyramid);
+
+        glDispatchCompute((GLuint)((objects.size() + GPU_CULL_GROUP_SIZE - 1) / GPU_CULL_GROUP_SIZE), 1, 1);
+        glMemoryBarrier(GL_COMMAND_BARRIER_BIT | GL_SHADER_STORAGE_BARRIER_BIT);
+    }
+
+    //one multi draw per batch, the vertex shaders find their object through the object id attribute
+    void Draw(GLStateCache& state) {
+        if (objects.empty()) {
+            return;
+        }
+        bindBuffers();
+        glBindBuffer(GL_DRAW_INDIRECT_BUFFER, commandBuffer);
+        if (compact) {
+            glBindBuffer(GL_PARAMETER_BUFFER_ARB, countBuffer);
+        }
+        for (size_t i = 0; i < batches.size(); ++i) {
+            const GpuBatch& batch = batches[i];
+            state.UseProgram(batch.Program);
+            if (batch.Texture != 0) {
+                state.ActiveTexture(GL_TEXTURE0);
+                state.BindTexture(GL_TEXTURE_2D, batch.Texture);
+            }
+            state.BindVertexArray(batch.Vao);
+
+            const void* commands = (const void*)(batch.FirstCommand * sizeof(GpuDrawCommand));
+            if (compact) {
+                glMultiDrawElementsIndirectCountARB(GL_TRIANGLES, GL_UNSIGNED_INT, commands, (GLintptr)(i * sizeof(GLuint)),
+                    batch.Capacity, sizeof(GpuDrawCommand));
+            }
+            else {
+                glMultiDrawElementsIndirect(GL_TRIANGLES, GL_UNSIGNED_INT, commands, batch.Capacity, sizeof(GpuDrawCommand));
+            }
+        }
+        glBindBuffer(GL_DRAW_INDIRECT_BUFFER, 0);
+        if (compact) {
+            glBindBuffer(GL_PARAMETER_BUFFER_ARB, 0);
+        }
+    }
+
+    //max depth pyramid of the finished frame for the next frame's occlusion test, level 0 is half the
+    //depth texture's size. viewProjection is the matrix the frame was drawn with
+    void BuildDepthPyramid(GLStateCache& state, GLuint depthTexture, int width, int height, const glm::mat4& viewProjection) {
+        if (!Occlusion || depthTexture == 0 || width <= 0 || height <= 0) {
+            pyramidValid = false;
+            return;
+        }
+        int levelWidth = std::max(1, (width + 1) / 2);
+        int levelHeight = std::max(1, (height + 1) / 2);
+        if (levelWidth != pyramidWidth || levelHeight != pyramidHeight) {
+            createPyramid(state, levelWidth, levelHeight);
+        }
+
+        state.UseProgram(pyramidProgram);
+        state.ActiveTexture(GL_TEXTURE0);
+        GLint sourceSize = glGetUniformLocation(pyramidProgram, "sourceSize");
+        GLint sourceLevel = glGetUniformLocation(pyramidProgram, "sourceLevel");
+        int sourceWidth = width, sourceHeight = height;
+        for (int level = 0; level < pyramidLevels; ++level) {
+            //level 0 reads the depth texture, every other level the one above it
+            state.BindTexture(GL_TEXTURE_2D, level == 0 ? depthTexture : pyramid);
+            glUniform2i(sourceSize, sourceWidth, sourceHeight);
+            glUniform1i(sourceLevel, level == 0 ? 0 : level - 1);
+            glBindImageTexture(0, pyramid, level, GL_FALSE, 0, GL_WRITE_ONLY, GL_R32F);
+            glDispatchCompute((levelWidth + GPU_PYRAMID_GROUP_SIZE - 1) / GPU_PYRAMID_GROUP_SIZE,
+                (levelHeight + GPU_PYRAMID_GROUP_SIZE - 1) / GPU_PYRAMID_GROUP_SIZE, 1);
+            glMemoryBarrier(GL_TEXTURE_FETCH_BARRIER_BIT | GL_SHADER_IMAGE_ACCESS_BARRIER_BIT);
+
+            sourceWidth = levelWidth;
+            sourceHeight = levelHeight;
+            levelWidth = std::max(1, (levelWidth + 1) / 2);
+            levelHeight = std::max(1, (levelHeight + 1) / 2);
+        }
+        glBindImageTexture(0, 0, 0, GL_FALSE, 0, GL_WRITE_ONLY, GL_R32F);
+        pyramidViewProjection = viewProjection;
+        pyramidValid = true;
+    }
+
+private:
+    GLuint cullProgram;
+    GLuint pyramidProgram;
+
+    std::vector<GpuObject> objects;     // CPU copy, the moving ones are rewritten from it
+    std::vector<GpuBatch> batches;
+    size_t dirtyBegin;                  // objects moved since the last upload
+    size_t dirtyEnd;
+
+    GLuint objectBuffer;
+    GLuint commandBuffer;
+    GLuint countBuffer;
+    GLuint batchBuffer;
+    GLuint objectIdBuffer;
+
+    GLuint pyramid;
+    int pyramidWidth;
+    int pyramidHeight;
+    int pyramidLevels;
+    bool pyramidValid;                  // false until a frame has been drawn at the current size
+    glm::mat4 pyramidViewProjection;
+
+    bool compact;
+
+    void bindBuffers() {
+        glBindBufferBase(GL_SHADER_STORAGE_BUFFER, GPU_OBJECT_BINDING, objectBuffer);
+        glBindBufferBase(GL_SHADER_STORAGE_BUFFER, GPU_COMMAND_BINDING, commandBuffer);
+        glBindBufferBase(GL_SHADER_STORAGE_BUFFER, GPU_COUNT_BINDING, countBuffer);
+        glBindBufferBase(GL_SHADER_STORAGE_BUFFER, GPU_BATCH_BINDING, batchBuffer);
+    }
+
+    void createPyramid(GLStateCache& state, int width, int height) {
+        if (pyramid != 0) {
+            state.DeleteTexture(pyramid);
+        }
+        pyramidWidth = width;
+        pyramidHeight = height;
+        pyramidLevels = 1;
+        while ((width >> pyramidLevels) > 0 || (height >> pyramidLevels) > 0) {
+            ++pyramidLevels;
+        }
+
+        glGenTextures(1, &pyramid);
+        state.ActiveTexture(GL_TEXTURE0);
+        state.BindTexture(GL_TEXTURE_2D, pyramid);
+        glTexStorage2D(GL_TEXTURE_2D, pyramidLevels, GL_R32F, width, height);
+        glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MIN_FILTER, GL_NEAREST_MIPMAP_NEAREST);
+        glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MAG_FILTER, GL_NEAREST);
+        glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_WRAP_S, GL_CLAMP_TO_EDGE);
+        glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_WRAP_T, GL_CLAMP_TO_EDGE);
+        pyramidValid = false;
+    }
+};
+#endif
@@ -0,0 +1,295 @@
+#ifndef IBL_H
+#define IBL_H
+
+#include <glm/glm.hpp>
+
+#include <algorithm>
+#include <cmath>
+#include <cstdint>
+#include <cstdio>
+#include <cstring>
+#include <vector>
+
+#include "jobsystem.h"
+#include "vertexformat.h"
+
+//sizes of the precomputed lighting, bump IBL_CACHE_VERSION when anything that changes the data does
+const int IBL_IRRADIANCE_SIZE = 16;         // per face, irradiance has no detail to keep
+const int IBL_SPECULAR_SIZE = 64;           // per face of the sharpest level
+const int IBL_SPECULAR_LEVELS = 5;          // roughness 0, 0.25, 0.5, 0.75 and 1, each half the size of the last
+const int IBL_BRDF_SIZE = 64;
+const int IBL_SAMPLES = 256;                // per texel, for every table
+const uint32_t IBL_CACHE_VERSION = 1;
+
+//the surroundings the scene is lit by: a kitchen like sky above the counter, walls at the horizon,
+//a dark floor, and a broad glow around the lamp. direct light from the lamp is shaded separately
+const glm::vec3 ENVIRONMENT_ZENITH(0.32f, 0.36f, 0.42f);
+const glm::vec3 ENVIRONMENT_HORIZON(0.30f, 0.27f, 0.24f);
+const glm::vec3 ENVIRONMENT_FLOOR(0.06f, 0.05f, 0.04f);
+const float ENVIRONMENT_GLOW_POWER = 8.0f;
+const float ENVIRONMENT_GLOW_STRENGTH = 0.6f;
+
+//a PBR material, textures supply the albedo
+struct PbrMaterial {
+    float Metallic;
+    float Roughness;
+};
+
+//what the environment is built from, stored in the cache so a change rebuilds it
+struct EnvironmentParams {
+    glm::vec3 LightDirection;   // toward the lamp, normalized
+    glm::vec3 LightColor;
+};
+
+//split sum image based lighting, all half floats: cube faces in GL order +X -X +Y -Y +Z -Z with rows
+//starting at t = 0. Brdf is the scale and bias applied to F0, by NdotV across and roughness up
+struct EnvironmentLighting {
+    std::vector<uint16_t> Irradiance;                       // RGB, cosine weighted mean radiance (irradiance / pi)
+    std::vector<uint16_t> Specular[IBL_SPECULAR_LEVELS];    // RGB, radiance prefiltered with GGX
+    std::vector<uint16_t> Brdf;                             // RG
+};
+
+//--- sampling ---
+
+inline glm::vec3 EnvironmentRadiance(const EnvironmentParams& params, const glm::vec3& direction)
+{
+    glm::vec3 color;
+    if (direction.y >= 0.0f) {
+        color = glm::mix(ENVIRONMENT_HORIZON, ENVIRONMENT_ZENITH, sqrtf(direction.y));
+    }
+    else {
+        color = glm::mix(ENVIRONMENT_HORIZON, ENVIRONMENT_FLOOR, std::min(-direction.y * 4.0f, 1.0f));
+    }
+    float facing = std::max(glm::dot(direction, params.LightDirection), 0.0f);
+    return color + params.LightColor * (ENVIRONMENT_GLOW_STRENGTH * powf(facing, ENVIRONMENT_GLOW_POWER));
+}
+
+//direction through the centre of texel (x, y) of a cube face, by the GL face conventions
+inline glm::vec3 CubeTexelDirection(int face, int x, int y, int size)
+{
+    float s = 2.0f * (x + 0.5f) / size - 1.0f;
+    float t = 2.0f * (y + 0.5f) / size - 1.0f;
+    glm::vec3 direction;
+    switch (face) {
+    case 0: direction = glm::vec3(1.0f, -t, -s); break;
+    case 1: direction = glm::vec3(-1.0f, -t, s); break;
+    case 2: direction = glm::vec3(s, 1.0f, t); break;
+    case 3: direction = glm::vec3(s, -1.0f, -t); break;
+    case 4: direction = glm::vec3(s, -t, 1.0f); break;
+    default: direction = glm::vec3(-s, -t, -1.0f); break;
+    }
+    return glm::normalize(direction);
+}
+
+//low discrepancy point i of count, radical inverse in base 2 for the second coordinate
+inline glm::vec2 Hammersley(uint32_t i, uint32_t count)
+{
+    uint32_t bits = i;
+    bits = (bits << 16u) | (bits >> 16u);
+    bits = ((bits & 0x55555555u) << 1u) | ((bits & 0xAAAAAAAAu) >> 1u);
+    bits = ((bits & 0x33333333u) << 2u) | ((bits & 0xCCCCCCCCu) >> 2u);
+    bits = ((bits & 0x0F0F0F0Fu) << 4u) | ((bits & 0xF0F0F0F0u) >> 4u);
+    bits = ((bits & 0x00FF00FFu) << 8u) | ((bits & 0xFF00FF00u) >> 8u);
+    return glm::vec2((float)i / count, bits * 2.3283064365386963e-10f);
+}
+
+//turns a direction around +Z into one around normal
+inline glm::vec3 TangentToWorld(const glm::vec3& direction, const glm::vec3& normal)
+{
+    glm::vec3 up = fabsf(normal.z) < 0.999f ? glm::vec3(0.0f, 0.0f, 1.0f) : glm::vec3(1.0f, 0.0f, 0.0f);
+    glm::vec3 tangent = glm::normalize(glm::cross(up, normal));
+    glm::vec3 bitangent = glm::cross(normal, tangent);
+    return tangent * direction.x + bitangent * direction.y + normal * direction.z;
+}
+
+//half vector distributed like GGX with alpha = roughness squared
+inline glm::vec3 ImportanceSampleGgx(const glm::vec2& point, const glm::vec3& normal, float roughness)
+{
+    float alpha = roughness * roughness;
+    float phi = 2.0f * 3.14159265f * point.x;
+    float cosTheta = sqrtf((1.0f - point.y) / (1.0f + (alpha * alpha - 1.0f) * point.y));
+    float sinTheta = sqrtf(std::max(1.0f - cosTheta * cosTheta, 0.0f));
+    return TangentToWorld(glm::vec3(cosf(phi) * sinTheta, sinf(phi) * sinTheta, cosTheta), normal);
+}
+
+//--- precomputation ---
+
+//cosine weighted mean of the environment around each texel's direction
+inline void BuildIrradiance(JobSystem& jobs, const EnvironmentParams& params, std::vector<uint16_t>& out)
+{
+    const int size = IBL_IRRADIANCE_SIZE;
+    out.resize((size_t)6 * size * size * 3);
+    jobs.ParallelFor((size_t)6 * size, 1, [&](size_t begin, size_t end) {
+        for (size_t row = begin; row < end; ++row) {
+            int face = (int)(row / size);
+            int y = (int)(row % size);
+            for (int x = 0; x < size; ++x) {
+                glm::vec3 normal = CubeTexelDirection(face, x, y, size);
+                glm::vec3 sum(0.0f);
+                for (int i = 0; i < IBL_SAMPLES; ++i) {
+                    //cosine weighted, so the mean of the samples is already E / pi
+                    glm::vec2 point = Hammersley((uint32_t)i, IBL_SAMPLES);
+                    float radius = sqrtf(point.y);
+                    float phi = 2.0f * 3.14159265f * point.x;
+                    glm::vec3 local(radius * cosf(phi), radius * sinf(phi), sqrtf(std::max(1.0f - point.y, 0.0f)));
+                    sum += EnvironmentRadiance(params, TangentToWorld(local, normal));
+                }
+                glm::vec3 mean = sum / (float)IBL_SAMPLES;
+                uint16_t* texel = &out[((row * size) + x) * 3];
+                for (int c = 0; c < 3; ++c) {
+                    texel[c] = FloatToHalf(mean[c]);
+                }
+            }
+        }
+    });
+}
+
+//radiance convolved with GGX for one roughness, with the normal, view and reflection taken as the
+//same direction (the split sum approximation), weighted by NdotL
+inline void BuildSpecularLevel(JobSystem& jobs, const EnvironmentParams& params, int level, std::vector<uint16_t>& out)
+{
+    const int size = IBL_SPECULAR_SIZE >> level;
+    const float roughness = (float)level / (IBL_SPECULAR_LEVELS - 1);
+    out.resize((size_t)6 * size * size * 3);
+    jobs.ParallelFor((size_t)6 * size, 1, [&](size_t begin, size_t end) {
+        for (size_t row = begin; row < end; ++row) {
+            int face = (int)(row / size);
+            int y = (int)(row % size);
+            for (int x = 0; x < size; ++x) {
+                glm::vec3 normal = CubeTexelDirection(face, x, y, size);
+                glm::vec3 color;
+                if (level == 0) {
+                    color = EnvironmentRadiance(params, normal);
+                }
+                else {
+                    glm::vec3 sum(0.0f);
+                    float weight = 0.0f;
+                    for (int i = 0; i < IBL_SAMPLES; ++i) {
+                        glm::vec3 half = ImportanceSampleGgx(Hammersley((uint32_t)i, IBL_SAMPLES), normal, roughness);
+                        glm::vec3 light = 2.0f * glm::dot(normal, half) * half - normal;
+                        float NdotL = glm::dot(normal, light);
+                        if (NdotL > 0.0f) {
+                            sum += EnvironmentRadiance(params, glm::normalize(light)) * NdotL;
+                            weight += NdotL;
+                        }
+                    }
+                    color = weight > 0.0f ? sum / weight : EnvironmentRadiance(params, normal);
+                }
+                uint16_t* texel = &out[((row * size) + x) * 3];
+                for (int c = 0; c < 3; ++c) {
+                    texel[c] = FloatToHalf(color[c]);
+                }
+            }
+        }
+    });
+}
+
+//scale and bias to F0 of the specular BRDF integrated over the hemisphere, Smith GGX with the image
+//based lighting k = roughness^2 / 2
+inline void BuildBrdfLut(JobSystem& jobs, std::vector<uint16_t>& out)
+{
+    const int size = IBL_BRDF_SIZE;
+    out.resize((size_t)size * size * 2);
+    jobs.ParallelFor(size, 1, [&](size_t begin, size_t end) {
+        for (size_t y = begin; y < end; ++y) {
+            float roughness = (y + 0.5f) / size;
+            float k = roughness * roughness / 2.0f;
+            for (int x = 0; x < size; ++x) {
+                float NdotV = (x + 0.5f) / size;
+                glm::vec3 view(sqrtf(1.0f - NdotV * NdotV), 0.0f, NdotV);
+                float scale = 0.0f, bias = 0.0f;
+                for (int i = 0; i < IBL_SAMPLES; ++i) {
+                    glm::vec3 half = ImportanceSampleGgx(Hammersley((uint32_t)i, IBL_SAMPLES), glm::vec3(0.0f, 0.0f, 1.0f), roughness);
+                    glm::vec3 light = 2.0f * glm::dot(view, half) * half - view;
+                    float NdotL = light.z;
+                    if (NdotL <= 0.0f) {
+                        continue;
+                    }
+                    float NdotH = std::max(half.z, 0.0f);
+                    float VdotH = std::max(glm::dot(view, half), 0.0f);
+                    float geometry = (NdotV / (NdotV * (1.0f - k) + k)) * (NdotL / (NdotL * (1.0f - k) + k));
+                    float visibility = geometry * VdotH / (NdotH * NdotV);
+                    float fresnel = powf(1.0f - VdotH, 5.0f);
+                    scale += (1.0f - fresnel) * visibility;
+                    bias += fresnel * visibility;
+                }
+                uint16_t* texel = &out[(y * size + x) * 2];
+                texel[0] = FloatToHalf(scale / IBL_SAMPLES);
+                texel[1] = FloatToHalf(bias / IBL_SAMPLES);
+            }
+        }
+    });
+}
+
+inline void BuildEnvironmentLighting(JobSystem& jobs, const EnvironmentParams& params, EnvironmentLighting& lighting)
+{
+    BuildIrradiance(jobs, params, lighting.Irradiance);
+    for (int level = 0; level < IBL_SPECULAR_LEVELS; ++level) {
+        BuildSpecularLevel(jobs, params, level, lighting.Specular[level]);
+    }
+    BuildBrdfLut(jobs, lighting.Brdf);
+}
+
+//--- cache ---
+
+//what a cache file has to match to be used
+struct EnvironmentCacheHeader {
+    char Magic[4];
+    uint32_t Version;
+    uint32_t Sizes[5];          // irradiance, specular, levels, brdf, samples
+    float Params[6];            // light direction and color
+};
+
+inline EnvironmentCacheHeader MakeEnvironmentCacheHeader(const EnvironmentParams& params)
+{
+    EnvironmentCacheHeader header = { { 'F', 'P', 'I', 'B' }, IBL_CACHE_VERSION,
+        { IBL_IRRADIANCE_SIZE, IBL_SPECULAR_SIZE, IBL_SPECULAR_LEVELS, IBL_BRDF_SIZE, IBL_SAMPLES },
+        { params.LightDirection.x, params.LightDirection.y, params.LightDirection.z, params.LightColor.x, params.LightColor.y, params.LightColor.z } };
+    return header;
+}
+
+//the tables one after the other, sizes follow from the header
+inline bool SaveEnvironmentLighting(const char* filename, const EnvironmentParams& params, const EnvironmentLighting& lighting)
+{
+    FILE* file = fopen(filename, "wb");
+    if (!file) {
+        return false;
+    }
+    EnvironmentCacheHeader header = MakeEnvironmentCacheHeader(params);
+    bool ok = fwrite(&header, sizeof(header), 1, file) == 1;
+    const std::vector<uint16_t>* tables[IBL_SPECULAR_LEVELS + 2] = { &lighting.Irradiance, &lighting.Brdf };
+    for (int level = 0; level < IBL_SPECULAR_LEVELS; ++level) {
+        tables[level + 2] = &lighting.Specular[level];
+    }
+    for (const std::vector<uint16_t>* table : tables) {
+        ok = ok && fwrite(table->data(), sizeof(uint16_t), table->size(), file) == table->size();
+    }
+    return fclose(file) == 0 && ok;
+}
+
+//false when there's no cache, or it was built from different params or sizes
+inline bool LoadEnvironmentLighting(const char* filename, const EnvironmentParams& params, EnvironmentLighting& lighting)
+{
+    FILE* file = fopen(filename, "rb");
+    if (!file) {
+        return false;
+    }
+    EnvironmentCacheHeader expected = MakeEnvironmentCacheHeader(params);
+    EnvironmentCacheHeader header;
+    bool ok = fread(&header, sizeof(header), 1, file) == 1 && memcmp(&header, &expected, sizeof(header)) == 0;
+
+    lighting.Irradiance.resize((size_t)6 * IBL_IRRADIANCE_SIZE * IBL_IRRADIANCE_SIZE * 3);
+    lighting.Brdf.resize((size_t)IBL_BRDF_SIZE * IBL_BRDF_SIZE * 2);
+    std::vector<uint16_t>* tables[IBL_SPECULAR_LEVELS + 2] = { &lighting.Irradiance, &lighting.Brdf };
+    for (int level = 0; level < IBL_SPECULAR_LEVELS; ++level) {
+        int size = IBL_SPECULAR_SIZE >> level;
+        lighting.Specular[level].resize((size_t)6 * size * size * 3);
+        tables[level + 2] = &lighting.Specular[level];
+    }
+    for (std::vector<uint16_t>* table : tables) {
+        ok = ok && fread(table->data(), sizeof(uint16_t), table->size(), file) == table->size();
+    }
+    fclose(file);
+    return ok;
+}
+#endif
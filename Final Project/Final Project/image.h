@@ -0,0 +1,440 @@
+#ifndef IMAGE_H
+#define IMAGE_H
+
+#include <stb_image.h>
+
+#include <algorithm>
+#include <cmath>
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+#include <functional>
+#include <vector>
+
+#include "jobsystem.h"
+
+#if defined(__AVX2__)
+#define IMAGE_AVX2 1
+#include <immintrin.h>
+#endif
+#if defined(__SSE2__) || defined(_M_X64) || (defined(_M_IX86_FP) && _M_IX86_FP >= 2)
+#define IMAGE_SSE2 1
+#include <emmintrin.h>
+#include <xmmintrin.h>
+#endif
+#if defined(__SSSE3__) || defined(__AVX2__)
+#define IMAGE_SSSE3 1
+#include <tmmintrin.h>
+#endif
+
+//image kernel values
+const size_t IMAGE_BYTES_PER_JOB = 256 * 1024;  // rows are handed out in chunks of about this much
+const size_t IMAGE_PARALLEL_BYTES = 1 << 20;    // smaller images aren't worth waking the workers for
+const float KAISER_RADIUS = 3.0f;               // filter half width in output pixels
+const float KAISER_BETA = 4.0f;                 // window shape, higher trades sharpness for less ringing
+
+//how mip levels are made from the one above
+enum MipFilter {
+    MIP_FILTER_BOX,     // average of each 2x2 block
+    MIP_FILTER_KAISER   // kaiser windowed sinc, sharper and without the box's aliasing
+};
+
+//one level of a mip chain, tightly packed RGBA8 rows
+struct MipLevel {
+    int Width;
+    int Height;
+    std::vector<unsigned char> Pixels;
+};
+
+//reads a texture file, rows top down as they're stored. the pixels are freed with stbi_image_free,
+//null means the file couldn't be read
+inline unsigned char* LoadTextureImage(const char* filename, int& width, int& height, int& channels)
+{
+    stbi_set_flip_vertically_on_load(false);
+    return stbi_load(filename, &width, &height, &channels, 0);
+}
+
+//runs body(begin, end) over the rows, split across the job system when the image is big enough
+inline void ForEachRows(JobSystem* jobs, size_t rows, size_t rowBytes, const std::function<void(size_t, size_t)>& body)
+{
+    if (jobs == nullptr || rows * rowBytes < IMAGE_PARALLEL_BYTES) {
+        body(0, rows);
+        return;
+    }
+    jobs->ParallelFor(rows, std::max<size_t>(1, IMAGE_BYTES_PER_JOB / std::max<size_t>(1, rowBytes)), body);
+}
+
+//--- vertical flip ---
+
+inline void SwapBytes(unsigned char* a, unsigned char* b, size_t count)
+{
+    size_t i = 0;
+#if IMAGE_AVX2
+    for (; i + 32 <= count; i += 32) {
+        __m256i x = _mm256_loadu_si256((const __m256i*)(a + i));
+        __m256i y = _mm256_loadu_si256((const __m256i*)(b + i));
+        _mm256_storeu_si256((__m256i*)(a + i), y);
+        _mm256_storeu_si256((__m256i*)(b + i), x);
+    }
+#endif
+#if IMAGE_SSE2
+    for (; i + 16 <= count; i += 16) {
+        __m128i x = _mm_loadu_si128((const __m128i*)(a + i));
+        __m128i y = _mm_loadu_si128((const __m128i*)(b + i));
+        _mm_storeu_si128((__m128i*)(a + i), y);
+        _mm_storeu_si128((__m128i*)(b + i), x);
+    }
+#endif
+    for (; i < count; ++i) {
+        unsigned char temp = a[i];
+        a[i] = b[i];
+        b[i] = temp;
+    }
+}
+
+//swaps the rows top to bottom in place, a whole row at a time
+inline void FlipImageVertically(unsigned char* image, int width, int height, int channels, JobSystem* jobs = nullptr)
+{
+    const size_t rowBytes = (size_t)width * channels;
+    ForEachRows(jobs, (size_t)height / 2, rowBytes * 2, [=](size_t begin, size_t end) {
+        for (size_t j = begin; j < end; ++j) {
+            SwapBytes(image + j * rowBytes, image + (height - 1 - j) * rowBytes, rowBytes);
+        }
+    });
+}
+
+//--- channel expansion ---
+
+//gray, gray + alpha, RGB or RGBA pixels to RGBA, missing alpha is opaque
+inline void ExpandPixelsToRgba(const unsigned char* source, int channels, unsigned char* destination, size_t pixels)
+{
+    size_t i = 0;
+    if (channels == 4) {
+        memcpy(destination, source, pixels * 4);
+        return;
+    }
+    if (channels == 3) {
+#if IMAGE_SSSE3
+        //four pixels per step, each 16 byte load covers 12 bytes of RGB. the load reads 4 bytes past
+        //the last pixel it uses, so the final few go through the scalar loop
+        const __m128i spread = _mm_setr_epi8(0, 1, 2, -1, 3, 4, 5, -1, 6, 7, 8, -1, 9, 10, 11, -1);
+        const __m128i alpha = _mm_set1_epi32((int)0xff000000u);
+        for (; i + 6 <= pixels; i += 4) {
+            __m128i rgb = _mm_loadu_si128((const __m128i*)(source + i * 3));
+            _mm_storeu_si128((__m128i*)(destination + i * 4), _mm_or_si128(_mm_shuffle_epi8(rgb, spread), alpha));
+        }
+#else
+        //without a byte shuffle a 4 byte load per pixel picks up its RGB and the next pixel's red,
+        //which the opaque alpha then covers. little endian only, as every target here is
+        for (; i + 2 <= pixels; ++i) {
+            uint32_t pixel;
+            memcpy(&pixel, source + i * 3, 4);
+            pixel |= 0xff000000u;
+            memcpy(destination + i * 4, &pixel, 4);
+        }
+#endif
+        for (; i < pixels; ++i) {
+            destination[i * 4] = source[i * 3];
+            destination[i * 4 + 1] = source[i * 3 + 1];
+            destination[i * 4 + 2] = source[i * 3 + 2];
+            destination[i * 4 + 3] = 255;
+        }
+        return;
+    }
+    for (; i < pixels; ++i) {
+        unsigned char gray = source[i * channels];
+        destination[i * 4] = gray;
+        destination[i * 4 + 1] = gray;
+        destination[i * 4 + 2] = gray;
+        destination[i * 4 + 3] = channels == 2 ? source[i * 2 + 1] : 255;
+    }
+}
+
+//whole image to RGBA, so the driver gets a format it can copy without converting
+inline void ExpandToRgba(const unsigned char* source, int width, int height, int channels, unsigned char* destination, JobSystem* jobs = nullptr)
+{
+    const size_t rowPixels = (size_t)width;
+    ForEachRows(jobs, (size_t)height, rowPixels * 4, [=](size_t begin, size_t end) {
+        ExpandPixelsToRgba(source + begin * rowPixels * channels, channels, destination + begin * rowPixels * 4, (end - begin) * rowPixels);
+    });
+}
+
+//--- premultiplied alpha ---
+
+//scales color by alpha, c * a / 255 rounded to nearest
+inline void PremultiplyPixels(unsigned char* rgba, size_t pixels)
+{
+    size_t i = 0;
+#if IMAGE_SSE2
+    //four pixels per step, widened to 16 bits. x / 255 is (x + 128 + ((x + 128) >> 8)) >> 8
+    const __m128i zero = _mm_setzero_si128();
+    const __m128i half = _mm_set1_epi16(128);
+    const __m128i keepAlpha = _mm_setr_epi16(0, 0, 0, -1, 0, 0, 0, -1);
+    for (; i + 4 <= pixels; i += 4) {
+        __m128i packed = _mm_loadu_si128((const __m128i*)(rgba + i * 4));
+        __m128i halves[2] = { _mm_unpacklo_epi8(packed, zero), _mm_unpackhi_epi8(packed, zero) };
+        for (int h = 0; h < 2; ++h) {
+            __m128i color = halves[h];
+            __m128i alpha = _mm_shufflehi_epi16(_mm_shufflelo_epi16(color, _MM_SHUFFLE(3, 3, 3, 3)), _MM_SHUFFLE(3, 3, 3, 3));
+            __m128i product = _mm_add_epi16(_mm_mullo_epi16(color, alpha), half);
+            product = _mm_srli_epi16(_mm_add_epi16(product, _mm_srli_epi16(product, 8)), 8);
+            halves[h] = _mm_or_si128(_mm_andnot_si128(keepAlpha, product), _mm_and_si128(keepAlpha, color));
+        }
+        _mm_storeu_si128((__m128i*)(rgba + i * 4), _mm_packus_epi16(halves[0], halves[1]));
+    }
+#endif
+    for (; i < pixels; ++i) {
+        unsigned int alpha = rgba[i * 4 + 3];
+        for (int c = 0; c < 3; ++c) {
+            unsigned int product = rgba[i * 4 + c] * alpha + 128;
+            rgba[i * 4 + c] = (unsigned char)((product + (product >> 8)) >> 8);
+        }
+    }
+}
+
+inline void PremultiplyAlpha(unsigned char* rgba, int width, int height, JobSystem* jobs = nullptr)
+{
+    const size_t rowPixels = (size_t)width;
+    ForEachRows(jobs, (size_t)height, rowPixels * 4, [=](size_t begin, size_t end) {
+        PremultiplyPixels(rgba + begin * rowPixels * 4, (end - begin) * rowPixels);
+    });
+}
+
+//--- sRGB <-> linear ---
+
+//decoding is a 256 entry table. encoding quantizes to 12 bits first, fine enough that every 8 bit
+//value round trips, and looks that up in a 4096 entry table
+struct SrgbTables {
+    static const int ENCODE_SIZE = 4096;
+    float Decode[256];
+    unsigned char Encode[ENCODE_SIZE];
+
+    SrgbTables() {
+        for (int i = 0; i < 256; ++i) {
+            float c = i / 255.0f;
+            Decode[i] = c <= 0.04045f ? c / 12.92f : powf((c + 0.055f) / 1.055f, 2.4f);
+        }
+        for (int i = 0; i < ENCODE_SIZE; ++i) {
+            float c = (float)i / (ENCODE_SIZE - 1);
+            float s = c <= 0.0031308f ? c * 12.92f : 1.055f * powf(c, 1.0f / 2.4f) - 0.055f;
+            Encode[i] = (unsigned char)std::min(255.0f, s * 255.0f + 0.5f);
+        }
+    }
+
+    static const SrgbTables& Get() {
+        static const SrgbTables tables;
+        return tables;
+    }
+};
+
+//sRGB RGBA8 to linear float RGBA, alpha is already linear and only rescaled
+inline void SrgbToLinear(const unsigned char* rgba, float* linear, size_t pixels)
+{
+    const float* decode = SrgbTables::Get().Decode;
+    for (size_t i = 0; i < pixels; ++i) {
+        linear[i * 4] = decode[rgba[i * 4]];
+        linear[i * 4 + 1] = decode[rgba[i * 4 + 1]];
+        linear[i * 4 + 2] = decode[rgba[i * 4 + 2]];
+        linear[i * 4 + 3] = rgba[i * 4 + 3] * (1.0f / 255.0f);
+    }
+}
+
+inline void LinearToSrgb(const float* linear, unsigned char* rgba, size_t pixels)
+{
+    const SrgbTables& tables = SrgbTables::Get();
+    const float scale = (float)(SrgbTables::ENCODE_SIZE - 1);
+    size_t i = 0;
+#if IMAGE_SSE2
+    //clamp and quantize a pixel at a time in one register, alpha goes straight to 8 bits
+    const __m128 zero = _mm_setzero_ps();
+    const __m128 one = _mm_set1_ps(1.0f);
+    const __m128 scales = _mm_setr_ps(scale, scale, scale, 255.0f);
+    const __m128 round = _mm_set1_ps(0.5f);
+    for (; i < pixels; ++i) {
+        __m128 value = _mm_min_ps(_mm_max_ps(_mm_loadu_ps(linear + i * 4), zero), one);
+        __m128i index = _mm_cvttps_epi32(_mm_add_ps(_mm_mul_ps(value, scales), round));
+        alignas(16) int indices[4];
+        _mm_store_si128((__m128i*)indices, index);
+        rgba[i * 4] = tables.Encode[indices[0]];
+        rgba[i * 4 + 1] = tables.Encode[indices[1]];
+        rgba[i * 4 + 2] = tables.Encode[indices[2]];
+        rgba[i * 4 + 3] = (unsigned char)indices[3];
+    }
+#endif
+    for (; i < pixels; ++i) {
+        for (int c = 0; c < 3; ++c) {
+            float value = std::min(std::max(linear[i * 4 + c], 0.0f), 1.0f);
+            rgba[i * 4 + c] = tables.Encode[(int)(value * scale + 0.5f)];
+        }
+        rgba[i * 4 + 3] = (unsigned char)(std::min(std::max(linear[i * 4 + 3], 0.0f), 1.0f) * 255.0f + 0.5f);
+    }
+}
+
+//--- mip downsampling, on linear float RGBA ---
+
+//half size in each direction, odd edges repeat their last pixel
+inline void DownsampleBox(const float* source, int width, int height, float* destination, int outWidth, int outHeight, JobSystem* jobs = nullptr)
+{
+    ForEachRows(jobs, (size_t)outHeight, (size_t)outWidth * 32, [=](size_t begin, size_t end) {
+        for (size_t y = begin; y < end; ++y) {
+            const float* row0 = source + (size_t)std::min(2 * (int)y, height - 1) * width * 4;
+            const float* row1 = source + (size_t)std::min(2 * (int)y + 1, height - 1) * width * 4;
+            float* out = destination + y * outWidth * 4;
+            for (int x = 0; x < outWidth; ++x) {
+                int x0 = std::min(2 * x, width - 1) * 4;
+                int x1 = std::min(2 * x + 1, width - 1) * 4;
+#if IMAGE_SSE2
+                __m128 sum = _mm_add_ps(_mm_add_ps(_mm_loadu_ps(row0 + x0), _mm_loadu_ps(row0 + x1)),
+                    _mm_add_ps(_mm_loadu_ps(row1 + x0), _mm_loadu_ps(row1 + x1)));
+                _mm_storeu_ps(out + x * 4, _mm_mul_ps(sum, _mm_set1_ps(0.25f)));
+#else
+                for (int c = 0; c < 4; ++c) {
+                    out[x * 4 + c] = 0.25f * (row0[x0 + c] + row0[x1 + c] + row1[x0 + c] + row1[x1 + c]);
+                }
+#endif
+            }
+        }
+    });
+}
+
+//taps of a 1D resampling filter, the same count for every output pixel
+struct ResampleTaps {
+    int Count;
+    std::vector<int> Indices;   // source pixel of each tap, wrapped since textures repeat
+    std::vector<float> Weights;
+};
+
+//modified bessel function of the first kind, order zero, as a power series
+inline float BesselI0(float x)
+{
+    float sum = 1.0f;
+    float term = 1.0f;
+    float quarter = x * x * 0.25f;
+    for (int k = 1; k < 20; ++k) {
+        term *= quarter / (float)(k * k);
+        sum += term;
+    }
+    return sum;
+}
+
+//kaiser windowed sinc from size pixels down to outSize, weights sum to one for every output pixel
+inline ResampleTaps MakeKaiserTaps(int size, int outSize)
+{
+    const float scale = (float)size / outSize;
+    const float support = KAISER_RADIUS * scale;
+    const float windowNorm = 1.0f / BesselI0(KAISER_BETA);
+
+    ResampleTaps taps;
+    taps.Count = (int)ceilf(support * 2.0f) + 1;
+    taps.Indices.resize((size_t)outSize * taps.Count);
+    taps.Weights.resize((size_t)outSize * taps.Count);
+    for (int o = 0; o < outSize; ++o) {
+        float center = (o + 0.5f) * scale - 0.5f;
+        int first = (int)floorf(center - support) + 1;
+        float total = 0.0f;
+        for (int t = 0; t < taps.Count; ++t) {
+            int index = first + t;
+            float distance = (index - center) / scale;     // in output pixels
+            float weight = 0.0f;
+            if (fabsf(distance) < KAISER_RADIUS) {
+                float ratio = distance / KAISER_RADIUS;
+                float window = BesselI0(KAISER_BETA * sqrtf(1.0f - ratio * ratio)) * windowNorm;
+                float x = 3.14159265f * distance;
+                weight = (fabsf(x) < 1.0e-6f ? 1.0f : sinf(x) / x) * window;
+            }
+            taps.Indices[(size_t)o * taps.Count + t] = ((index % size) + size) % size;
+            taps.Weights[(size_t)o * taps.Count + t] = weight;
+            total += weight;
+        }
+        for (int t = 0; t < taps.Count; ++t) {
+            taps.Weights[(size_t)o * taps.Count + t] /= total;
+        }
+    }
+    return taps;
+}
+
+//weighted sum of pixels along a row or column, stride in floats between neighbours
+inline void ResamplePixel(const float* source, size_t stride, const int* indices, const float* weights, int count, float* out)
+{
+#if IMAGE_SSE2
+    __m128 sum = _mm_setzero_ps();
+    for (int t = 0; t < count; ++t) {
+        sum = _mm_add_ps(sum, _mm_mul_ps(_mm_loadu_ps(source + indices[t] * stride), _mm_set1_ps(weights[t])));
+    }
+    _mm_storeu_ps(out, sum);
+#else
+    float sum[4] = {};
+    for (int t = 0; t < count; ++t) {
+        for (int c = 0; c < 4; ++c) {
+            sum[c] += source[indices[t] * stride + c] * weights[t];
+        }
+    }
+    memcpy(out, sum, sizeof(sum));
+#endif
+}
+
+//separable: rows to the new width into scratch, then columns to the new height
+inline void DownsampleKaiser(const float* source, int width, int height, float* destination, int outWidth, int outHeight,
+    std::vector<float>& scratch, JobSystem* jobs = nullptr)
+{
+    const ResampleTaps horizontal = MakeKaiserTaps(width, outWidth);
+    const ResampleTaps vertical = MakeKaiserTaps(height, outHeight);
+    scratch.resize((size_t)outWidth * height * 4);
+    float* rows = scratch.data();
+
+    ForEachRows(jobs, (size_t)height, (size_t)outWidth * 16, [&](size_t begin, size_t end) {
+        for (size_t y = begin; y < end; ++y) {
+            for (int x = 0; x < outWidth; ++x) {
+                size_t tap = (size_t)x * horizontal.Count;
+                ResamplePixel(source + y * width * 4, 4, &horizontal.Indices[tap], &horizontal.Weights[tap], horizontal.Count,
+                    rows + (y * outWidth + x) * 4);
+            }
+        }
+    });
+    ForEachRows(jobs, (size_t)outHeight, (size_t)outWidth * 16, [&](size_t begin, size_t end) {
+        for (size_t y = begin; y < end; ++y) {
+            size_t tap = y * vertical.Count;
+            for (int x = 0; x < outWidth; ++x) {
+                ResamplePixel(rows + (size_t)x * 4, (size_t)outWidth * 4, &vertical.Indices[tap], &vertical.Weights[tap], vertical.Count,
+                    destination + (y * outWidth + x) * 4);
+            }
+        }
+    });
+}
+
+//levels below an sRGB RGBA8 image down to 1x1. filtering happens in linear space so the smaller
+//levels don't darken, the base level isn't included
+inline void BuildMipChain(const unsigned char* rgba, int width, int height, MipFilter filter, std::vector<MipLevel>& levels, JobSystem* jobs = nullptr)
+{
+    levels.clear();
+    std::vector<float> current((size_t)width * height * 4);
+    std::vector<float> next;
+    std::vector<float> scratch;
+    ForEachRows(jobs, (size_t)height, (size_t)width * 16, [&](size_t begin, size_t end) {
+        SrgbToLinear(rgba + begin * width * 4, current.data() + begin * width * 4, (end - begin) * width);
+    });
+
+    while (width > 1 || height > 1) {
+        int outWidth = std::max(1, width / 2);
+        int outHeight = std::max(1, height / 2);
+        next.resize((size_t)outWidth * outHeight * 4);
+        if (filter == MIP_FILTER_KAISER) {
+            DownsampleKaiser(current.data(), width, height, next.data(), outWidth, outHeight, scratch, jobs);
+        }
+        else {
+            DownsampleBox(current.data(), width, height, next.data(), outWidth, outHeight, jobs);
+        }
+
+        levels.push_back(MipLevel{ outWidth, outHeight, std::vector<unsigned char>((size_t)outWidth * outHeight * 4) });
+        unsigned char* pixels = levels.back().Pixels.data();
+        const float* linear = next.data();
+        ForEachRows(jobs, (size_t)outHeight, (size_t)outWidth * 16, [=](size_t begin, size_t end) {
+            LinearToSrgb(linear + begin * outWidth * 4, pixels + begin * outWidth * 4, (end - begin) * outWidth);
+        });
+
+        current.swap(next);
+        width = outWidth;
+        height = outHeight;
+    }
+}
+#endif
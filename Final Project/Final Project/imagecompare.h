@@ -0,0 +1,137 @@
+#ifndef IMAGECOMPARE_H
+#define IMAGECOMPARE_H
+
+#include <algorithm>
+#include <cstddef>
+#include <cstdlib>
+#include <cstring>
+#include <vector>
+
+//image comparison values
+const int SSIM_WINDOW_RADIUS = 3;           // 7x7 windows
+const int SSIM_BLOCK_SIZE = 32;             // windows averaged together for the worst block
+const double SSIM_C1 = (0.01 * 255.0) * (0.01 * 255.0);
+const double SSIM_C2 = (0.03 * 255.0) * (0.03 * 255.0);
+const double DIFF_IMAGE_GAIN = 4.0;         // 1 - SSIM is scaled up by this in the diff image's red channel
+
+//how far an image is from a reference
+struct ImageDifference {
+    double Ssim;                // mean structural similarity of the luma, 1 for identical images
+    double WorstSsim;           // lowest of any pixel's window
+    double WorstBlockSsim;      // lowest mean over a block of windows, one pixel flipping on an edge barely moves it
+    double MeanDifference;      // per pixel, largest of the three channels
+    int LargestDifference;
+};
+
+//flips rows in place, GL reads back bottom up and image files are top down
+inline void FlipRows(unsigned char* pixels, int width, int height, int channels)
+{
+    size_t rowBytes = (size_t)width * channels;
+    std::vector<unsigned char> row(rowBytes);
+    for (int y = 0; y < height / 2; ++y) {
+        unsigned char* top = pixels + (size_t)y * rowBytes;
+        unsigned char* bottom = pixels + (size_t)(height - 1 - y) * rowBytes;
+        memcpy(row.data(), top, rowBytes);
+        memcpy(top, bottom, rowBytes);
+        memcpy(bottom, row.data(), rowBytes);
+    }
+}
+
+//SSIM over the luma in windows clamped at the image edges, each window's sums come from summed area
+//tables so the cost doesn't grow with the window. the windows are also averaged over blocks, the ones
+//left over at the right and bottom joining the last block. diff, when given, gets an RGB image of the
+//reference darkened with dissimilar areas in red. both images are 8 bit with the same size and channel
+//count, only the first three channels are compared
+inline ImageDifference CompareImages(const unsigned char* reference, const unsigned char* image, int width, int height, int channels,
+    std::vector<unsigned char>* diff = nullptr)
+{
+    ImageDifference result = { 1.0, 1.0, 1.0, 0.0, 0 };
+    size_t pixelCount = (size_t)width * height;
+    if (pixelCount == 0) {
+        return result;
+    }
+
+    //tables are one larger each way so a window's sum is four lookups without edge cases
+    size_t stride = (size_t)width + 1;
+    std::vector<double> sumA(stride * (height + 1)), sumB(sumA.size()), sumAA(sumA.size()), sumBB(sumA.size()), sumAB(sumA.size());
+    std::vector<float> lumaA(pixelCount);
+    double totalDifference = 0.0;
+    for (int y = 0; y < height; ++y) {
+        double rowA = 0.0, rowB = 0.0, rowAA = 0.0, rowBB = 0.0, rowAB = 0.0;
+        for (int x = 0; x < width; ++x) {
+            size_t pixel = (size_t)y * width + x;
+            const unsigned char* a = reference + pixel * channels;
+            const unsigned char* b = image + pixel * channels;
+            int difference = std::max(abs(a[0] - b[0]), std::max(abs(a[1] - b[1]), abs(a[2] - b[2])));
+            totalDifference += difference;
+            result.LargestDifference = std::max(result.LargestDifference, difference);
+
+            double la = 0.299 * a[0] + 0.587 * a[1] + 0.114 * a[2];
+            double lb = 0.299 * b[0] + 0.587 * b[1] + 0.114 * b[2];
+            lumaA[pixel] = (float)la;
+            rowA += la;
+            rowB += lb;
+            rowAA += la * la;
+            rowBB += lb * lb;
+            rowAB += la * lb;
+
+            size_t above = (size_t)y * stride + x + 1;
+            size_t here = above + stride;
+            sumA[here] = sumA[above] + rowA;
+            sumB[here] = sumB[above] + rowB;
+            sumAA[here] = sumAA[above] + rowAA;
+            sumBB[here] = sumBB[above] + rowBB;
+            sumAB[here] = sumAB[above] + rowAB;
+        }
+    }
+    result.MeanDifference = totalDifference / pixelCount;
+
+    if (diff) {
+        diff->resize(pixelCount * 3);
+    }
+    int blocksX = std::max(width / SSIM_BLOCK_SIZE, 1), blocksY = std::max(height / SSIM_BLOCK_SIZE, 1);
+    std::vector<double> blockSsim((size_t)blocksX * blocksY, 0.0);
+    std::vector<int> blockCount(blockSsim.size(), 0);
+    double totalSsim = 0.0;
+    for (int y = 0; y < height; ++y) {
+        size_t blockRow = (size_t)std::min(y / SSIM_BLOCK_SIZE, blocksY - 1) * blocksX;
+        int top = std::max(y - SSIM_WINDOW_RADIUS, 0);
+        int bottom = std::min(y + SSIM_WINDOW_RADIUS + 1, height);
+        for (int x = 0; x < width; ++x) {
+            int left = std::max(x - SSIM_WINDOW_RADIUS, 0);
+            int right = std::min(x + SSIM_WINDOW_RADIUS + 1, width);
+            size_t i00 = (size_t)top * stride + left, i01 = (size_t)top * stride + right;
+            size_t i10 = (size_t)bottom * stride + left, i11 = (size_t)bottom * stride + right;
+            double count = (double)(bottom - top) * (right - left);
+
+            double meanA = (sumA[i11] - sumA[i01] - sumA[i10] + sumA[i00]) / count;
+            double meanB = (sumB[i11] - sumB[i01] - sumB[i10] + sumB[i00]) / count;
+            double varianceA = (sumAA[i11] - sumAA[i01] - sumAA[i10] + sumAA[i00]) / count - meanA * meanA;
+            double varianceB = (sumBB[i11] - sumBB[i01] - sumBB[i10] + sumBB[i00]) / count - meanB * meanB;
+            double covariance = (sumAB[i11] - sumAB[i01] - sumAB[i10] + sumAB[i00]) / count - meanA * meanB;
+
+            double ssim = ((2.0 * meanA * meanB + SSIM_C1) * (2.0 * covariance + SSIM_C2))
+                / ((meanA * meanA + meanB * meanB + SSIM_C1) * (varianceA + varianceB + SSIM_C2));
+            totalSsim += ssim;
+            result.WorstSsim = std::min(result.WorstSsim, ssim);
+            size_t block = blockRow + std::min(x / SSIM_BLOCK_SIZE, blocksX - 1);
+            blockSsim[block] += ssim;
+            ++blockCount[block];
+
+            if (diff) {
+                size_t pixel = (size_t)y * width + x;
+                unsigned char dim = (unsigned char)(lumaA[pixel] * 0.25f);
+                double error = std::min(std::max((1.0 - ssim) * DIFF_IMAGE_GAIN, 0.0), 1.0);
+                (*diff)[pixel * 3] = (unsigned char)std::max((double)dim, error * 255.0);
+                (*diff)[pixel * 3 + 1] = dim;
+                (*diff)[pixel * 3 + 2] = dim;
+            }
+        }
+    }
+    result.Ssim = totalSsim / pixelCount;
+    for (size_t block = 0; block < blockSsim.size(); ++block) {
+        result.WorstBlockSsim = std::min(result.WorstBlockSsim, blockSsim[block] / blockCount[block]);
+    }
+    return result;
+}
+#endif
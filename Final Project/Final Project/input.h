@@ -0,0 +1,229 @@
+#ifndef INPUT_H
+#define INPUT_H
+
+#include <GLFW/glfw3.h>
+
+#include <cstring>
+#include <vector>
+
+//things the user can do, keys are bound to these instead of being checked directly
+enum InputAction {
+    ACTION_MOVE_FORWARD,
+    ACTION_MOVE_BACKWARD,
+    ACTION_MOVE_LEFT,
+    ACTION_MOVE_RIGHT,
+    ACTION_MOVE_UP,
+    ACTION_MOVE_DOWN,
+    ACTION_TURN_LEFT,
+    ACTION_TURN_RIGHT,
+    ACTION_TURN_UP,
+    ACTION_TURN_DOWN,
+    ACTION_ROLL_LEFT,
+    ACTION_ROLL_RIGHT,
+    ACTION_TOGGLE_PROJECTION,
+    ACTION_SAVE_VIEWPOINT,      // held with a viewpoint key to store instead of recall
+    ACTION_VIEWPOINT_1,
+    ACTION_VIEWPOINT_2,
+    ACTION_VIEWPOINT_3,
+    ACTION_VIEWPOINT_4,
+    ACTION_PICK,
+    ACTION_CYCLE_ANTIALIASING,
+    ACTION_QUIT,
+    ACTION_COUNT
+};
+
+//names used on the command line, same order as InputAction
+const char* const INPUT_ACTION_NAMES[ACTION_COUNT] = {
+    "forward", "backward", "left", "right", "up", "down",
+    "turn-left", "turn-right", "turn-up", "turn-down", "roll-left", "roll-right",
+    "projection", "save-viewpoint", "viewpoint-1", "viewpoint-2", "viewpoint-3", "viewpoint-4",
+    "pick", "antialiasing", "quit"
+};
+
+//mouse buttons share the key code space so they can be bound the same way
+const int INPUT_MOUSE_BUTTON_BASE = GLFW_KEY_LAST + 1;
+const int INPUT_CODE_COUNT = INPUT_MOUSE_BUTTON_BASE + GLFW_MOUSE_BUTTON_LAST + 1;
+
+inline int MouseButtonCode(int button)
+{
+    return INPUT_MOUSE_BUTTON_BASE + button;
+}
+
+//queues raw window events from the GLFW callbacks and turns them into per step action state.
+//mouse motion and scrolling are summed between updates so the camera sees one delta per step
+//however many events the OS delivers, and presses are kept as edges so a tap shorter than a
+//step is never missed
+class InputSystem {
+public:
+    InputSystem() : firstCursor(true), cursorX(0.0), cursorY(0.0), mouseDeltaX(0.0f), mouseDeltaY(0.0f), scrollDelta(0.0f),
+        pendingX(0.0), pendingY(0.0), pendingScroll(0.0) {
+        memset(codeDown, 0, sizeof(codeDown));
+        memset(held, 0, sizeof(held));
+        memset(pressed, 0, sizeof(pressed));
+        memset(released, 0, sizeof(released));
+    }
+
+    //--- binding table ---
+
+    void Bind(InputAction action, int code) {
+        for (int bound : bindings[action]) {
+            if (bound == code) {
+                return;
+            }
+        }
+        bindings[action].push_back(code);
+    }
+
+    void ClearBindings(InputAction action) {
+        bindings[action].clear();
+    }
+
+    const std::vector<int>& Bindings(InputAction action) const {
+        return bindings[action];
+    }
+
+    //action for a command line name, ACTION_COUNT if there is none
+    static InputAction FindAction(const char* name) {
+        for (int i = 0; i < ACTION_COUNT; ++i) {
+            if (strcmp(INPUT_ACTION_NAMES[i], name) == 0) {
+                return (InputAction)i;
+            }
+        }
+        return ACTION_COUNT;
+    }
+
+    //--- event queue, fed from the GLFW callbacks ---
+
+    void OnKey(int key, int action) {
+        if (action != GLFW_REPEAT && key >= 0 && key < INPUT_MOUSE_BUTTON_BASE) {
+            events.push_back(Event{ key, action == GLFW_PRESS });
+        }
+    }
+
+    void OnMouseButton(int button, int action) {
+        if (button >= 0 && button <= GLFW_MOUSE_BUTTON_LAST) {
+            events.push_back(Event{ MouseButtonCode(button), action == GLFW_PRESS });
+        }
+    }
+
+    //motion is folded in as it arrives, only the total matters
+    void OnCursor(double x, double y) {
+        if (firstCursor) {
+            firstCursor = false;
+        }
+        else {
+            pendingX += x - cursorX;
+            pendingY += cursorY - y; // reversed since y-coordinates go from bottom to top
+        }
+        cursorX = x;
+        cursorY = y;
+    }
+
+    void OnScroll(double yoffset) {
+        pendingScroll += yoffset;
+    }
+
+    //--- per step state ---
+
+    //applies everything queued since the last update, call once per simulation step
+    void Update() {
+        memset(pressed, 0, sizeof(pressed));
+        memset(released, 0, sizeof(released));
+
+        for (const Event& event : events) {
+            codeDown[event.Code] = event.Down;
+            for (int action = 0; action < ACTION_COUNT; ++action) {
+                if (isBound((InputAction)action, event.Code)) {
+                    if (event.Down) {
+                        pressed[action] = true;
+                    }
+                    else {
+                        released[action] = true;
+                    }
+                }
+            }
+        }
+        events.clear();
+
+        for (int action = 0; action < ACTION_COUNT; ++action) {
+            held[action] = false;
+            for (int code : bindings[action]) {
+                held[action] = held[action] || codeDown[code];
+            }
+        }
+
+        mouseDeltaX = (float)pendingX;
+        mouseDeltaY = (float)pendingY;
+        scrollDelta = (float)pendingScroll;
+        pendingX = pendingY = pendingScroll = 0.0;
+    }
+
+    //a bound key is down
+    bool Held(InputAction action) const {
+        return held[action];
+    }
+
+    //a bound key went down since the last update
+    bool Pressed(InputAction action) const {
+        return pressed[action];
+    }
+
+    //a bound key went up since the last update
+    bool Released(InputAction action) const {
+        return released[action];
+    }
+
+    float MouseDeltaX() const {
+        return mouseDeltaX;
+    }
+
+    float MouseDeltaY() const {
+        return mouseDeltaY;
+    }
+
+    float ScrollDelta() const {
+        return scrollDelta;
+    }
+
+    double CursorX() const {
+        return cursorX;
+    }
+
+    double CursorY() const {
+        return cursorY;
+    }
+
+private:
+    struct Event {
+        int Code;
+        bool Down;
+    };
+
+    std::vector<Event> events;
+    std::vector<int> bindings[ACTION_COUNT];
+    bool codeDown[INPUT_CODE_COUNT];
+
+    bool held[ACTION_COUNT];
+    bool pressed[ACTION_COUNT];
+    bool released[ACTION_COUNT];
+
+    bool firstCursor;
+    double cursorX;
+    double cursorY;
+    float mouseDeltaX;
+    float mouseDeltaY;
+    float scrollDelta;
+    double pendingX;
+    double pendingY;
+    double pendingScroll;
+
+    bool isBound(InputAction action, int code) const {
+        for (int bound : bindings[action]) {
+            if (bound == code) {
+                return true;
+            }
+        }
+        return false;
+    }
+};
+#endif
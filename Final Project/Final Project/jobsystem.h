@@ -0,0 +1,292 @@
+#ifndef JOBSYSTEM_H
+#define JOBSYSTEM_H
+
+#include <algorithm>
+#include <atomic>
+#include <condition_variable>
+#include <cstddef>
+#include <deque>
+#include <functional>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+//counts the jobs still running for a batch of work, anything waiting on it resumes once it reaches zero
+struct JobCounter {
+    std::atomic<int> Pending{ 0 };
+
+    bool Done() const {
+        return Pending.load(std::memory_order_acquire) == 0;
+    }
+};
+
+//unit of work handed to the worker threads
+struct Job {
+    std::function<void()> Task;
+    JobCounter* Counter;
+};
+
+//small work stealing scheduler. every thread owns a deque, it pushes and pops from the back
+//(newest work, still warm in cache) and idle threads steal from the front of someone else's
+class JobSystem {
+public:
+    //number of worker threads, the calling thread counts as one so zero means single threaded
+    explicit JobSystem(unsigned int threadCount = 0) : running(true), pendingJobs(0), sleepers(0) {
+        if (threadCount == 0) {
+            unsigned int hardware = std::thread::hardware_concurrency();
+            threadCount = hardware > 1 ? hardware : 1;
+        }
+
+        queues = std::vector<WorkQueue>(threadCount);
+
+        //thread 0 is whoever created the job system (the render thread)
+        threadIndex() = 0;
+        for (unsigned int i = 1; i < threadCount; ++i) {
+            workers.emplace_back([this, i]() { workerLoop(i); });
+        }
+    }
+
+    ~JobSystem() {
+        {
+            std::lock_guard<std::mutex> lock(sleepLock);
+            running = false;
+        }
+        wake.notify_all();
+
+        for (std::thread& worker : workers) {
+            worker.join();
+        }
+    }
+
+    JobSystem(const JobSystem&) = delete;
+    JobSystem& operator=(const JobSystem&) = delete;
+
+    unsigned int ThreadCount() const {
+        return (unsigned int)queues.size();
+    }
+
+    //queue a job on the calling thread's deque, counter (optional) is bumped until the job finishes
+    void Submit(std::function<void()> task, JobCounter* counter = nullptr) {
+        if (counter) {
+            counter->Pending.fetch_add(1, std::memory_order_relaxed);
+        }
+
+        //counted before it is visible so the pending count never undercounts the queues
+        pendingJobs.fetch_add(1);
+
+        WorkQueue& queue = queues[ownQueue()];
+        {
+            std::lock_guard<std::mutex> lock(queue.Lock);
+            queue.Jobs.push_back(Job{ std::move(task), counter });
+        }
+
+        //only pay for the wake up when somebody is actually asleep
+        if (sleepers.load() > 0) {
+            std::lock_guard<std::mutex> lock(sleepLock);
+            wake.notify_one();
+        }
+    }
+
+    //block until the counter drains, running queued jobs instead of idling
+    void Wait(const JobCounter& counter) {
+        unsigned int spins = 0;
+        while (!counter.Done()) {
+            if (runOne(ownQueue())) {
+                spins = 0;
+            }
+            else if (++spins > 64) {
+                std::this_thread::yield();
+            }
+        }
+    }
+
+    //split [0, count) into chunks of at least grainSize and run body(begin, end) on each, returns once all are done
+    void ParallelFor(size_t count, size_t grainSize, const std::function<void(size_t, size_t)>& body) {
+        if (count == 0) {
+            return;
+        }
+
+        //aim for a few chunks per thread so stealing can even out uneven objects
+        size_t chunks = (size_t)ThreadCount() * 4;
+        size_t chunkSize = std::max(grainSize, (count + chunks - 1) / chunks);
+        if (chunkSize >= count) {
+            body(0, count);
+            return;
+        }
+
+        JobCounter counter;
+        for (size_t begin = chunkSize; begin < count; begin += chunkSize) {
+            size_t end = std::min(count, begin + chunkSize);
+            Submit([&body, begin, end]() { body(begin, end); }, &counter);
+        }
+
+        //first chunk runs here while the others are picked up
+        body(0, std::min(count, chunkSize));
+        Wait(counter);
+    }
+
+private:
+    struct WorkQueue {
+        std::mutex Lock;
+        std::deque<Job> Jobs;
+    };
+
+    std::vector<WorkQueue> queues;
+    std::vector<std::thread> workers;
+
+    std::mutex sleepLock;
+    std::condition_variable wake;
+    bool running;
+    std::atomic<int> pendingJobs;
+    std::atomic<int> sleepers;
+
+    static int& threadIndex() {
+        static thread_local int index = -1;
+        return index;
+    }
+
+    //threads the job system doesn't know about share the render thread's queue
+    size_t ownQueue() const {
+        int index = threadIndex();
+        return index >= 0 && (size_t)index < queues.size() ? (size_t)index : 0;
+    }
+
+    bool popOwn(size_t index, Job& job) {
+        WorkQueue& queue = queues[index];
+        std::lock_guard<std::mutex> lock(queue.Lock);
+        if (queue.Jobs.empty()) {
+            return false;
+        }
+        job = std::move(queue.Jobs.back());
+        queue.Jobs.pop_back();
+        return true;
+    }
+
+    bool steal(size_t thief, Job& job) {
+        size_t count = queues.size();
+        for (size_t i = 1; i < count; ++i) {
+            WorkQueue& queue = queues[(thief + i) % count];
+            std::unique_lock<std::mutex> lock(queue.Lock, std::try_to_lock);
+            if (!lock.owns_lock() || queue.Jobs.empty()) {
+                continue;
+            }
+            job = std::move(queue.Jobs.front());
+            queue.Jobs.pop_front();
+            return true;
+        }
+        return false;
+    }
+
+    bool runOne(size_t index) {
+        if (pendingJobs.load(std::memory_order_acquire) == 0) {
+            return false;
+        }
+
+        Job job;
+        if (!popOwn(index, job) && !steal(index, job)) {
+            return false;
+        }
+        pendingJobs.fetch_sub(1, std::memory_order_acq_rel);
+
+        job.Task();
+        if (job.Counter) {
+            job.Counter->Pending.fetch_sub(1, std::memory_order_release);
+        }
+        return true;
+    }
+
+    void workerLoop(unsigned int index) {
+        threadIndex() = (int)index;
+
+        while (true) {
+            //spin briefly before sleeping, frame stages arrive in quick bursts
+            bool ranJob = false;
+            for (int spin = 0; spin < 256 && !ranJob; ++spin) {
+                ranJob = runOne(index);
+            }
+            if (ranJob) {
+                continue;
+            }
+
+            std::unique_lock<std::mutex> lock(sleepLock);
+            sleepers.fetch_add(1);
+            wake.wait(lock, [this]() {
+                return !running || pendingJobs.load() > 0;
+            });
+            sleepers.fetch_sub(1);
+
+            if (!running) {
+                return;
+            }
+        }
+    }
+};
+
+//per frame CPU work described as stages, a stage starts once every stage it depends on is finished.
+//stages with nothing in between them run at the same time on different threads
+class FrameGraph {
+public:
+    typedef int StageId;
+
+    StageId AddStage(const char* name, std::function<void()> work, const std::vector<StageId>& dependsOn = {}) {
+        Stage stage;
+        stage.Name = name;
+        stage.Work = std::move(work);
+        stage.DependencyCount = (int)dependsOn.size();
+        stages.push_back(std::move(stage));
+
+        StageId id = (StageId)stages.size() - 1;
+        for (StageId dependency : dependsOn) {
+            stages[dependency].Dependents.push_back(id);
+        }
+        return id;
+    }
+
+    const char* StageName(StageId id) const {
+        return stages[id].Name;
+    }
+
+    //run every stage once and return when the whole graph has finished
+    void Execute(JobSystem& jobs) {
+        JobCounter frame;
+        for (Stage& stage : stages) {
+            stage.Remaining.store(stage.DependencyCount, std::memory_order_relaxed);
+        }
+
+        for (StageId id = 0; id < (StageId)stages.size(); ++id) {
+            if (stages[id].DependencyCount == 0) {
+                launch(jobs, id, frame);
+            }
+        }
+        jobs.Wait(frame);
+    }
+
+private:
+    struct Stage {
+        const char* Name;
+        std::function<void()> Work;
+        int DependencyCount;
+        std::vector<StageId> Dependents;
+        std::atomic<int> Remaining{ 0 };
+
+        Stage() : Name(""), DependencyCount(0) {}
+        Stage(Stage&& other) noexcept : Name(other.Name), Work(std::move(other.Work)),
+            DependencyCount(other.DependencyCount), Dependents(std::move(other.Dependents)) {}
+    };
+
+    std::vector<Stage> stages;
+
+    void launch(JobSystem& jobs, StageId id, JobCounter& frame) {
+        jobs.Submit([this, &jobs, id, &frame]() {
+            stages[id].Work();
+
+            //last dependency to finish kicks off the dependent stage
+            for (StageId dependent : stages[id].Dependents) {
+                if (stages[dependent].Remaining.fetch_sub(1, std::memory_order_acq_rel) == 1) {
+                    launch(jobs, dependent, frame);
+                }
+            }
+        }, &frame);
+    }
+};
+#endif
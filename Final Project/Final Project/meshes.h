@@ -0,0 +1,501 @@
+#ifndef MESHES_H
+#define MESHES_H
+
+#include <glm/glm.hpp>
+
+#include <cstddef>
+#include <vector>
+
+//vertices are interleaved position, normal and texture coordinate, three of them to a triangle
+const int MESH_FLOATS_PER_VERTEX = 8;
+
+//triangle corners and their bounding box, for picking and culling
+inline void ExtractPositions(const float* vertices, size_t vertexCount, std::vector<glm::vec3>& positions,
+    glm::vec3& boundsMin, glm::vec3& boundsMax)
+{
+    positions.resize(vertexCount);
+    for (size_t i = 0; i < vertexCount; ++i) {
+        const float* vertex = vertices + i * MESH_FLOATS_PER_VERTEX;
+        positions[i] = glm::vec3(vertex[0], vertex[1], vertex[2]);
+    }
+
+    boundsMin = vertexCount > 0 ? positions[0] : glm::vec3(0.0f);
+    boundsMax = boundsMin;
+    for (size_t i = 1; i < vertexCount; ++i) {
+        boundsMin = glm::min(boundsMin, positions[i]);
+        boundsMax = glm::max(boundsMax, positions[i]);
+    }
+}
+
+//--- scene meshes ---
+
+//unit cube, drawn as the light marker
+inline void BuildCubeVertices(std::vector<float>& vertices)
+{
+    // Position and Color data
+    float verts[] = {
+        //Positions          //Normals
+        // ------------------------------------------------------
+        //Back Face          //Negative Z Normal  Texture Coords.
+       -0.5f, -0.5f, -0.5f,  0.0f,  0.0f, -1.0f,  0.0f, 0.0f,
+        0.5f, -0.5f, -0.5f,  0.0f,  0.0f, -1.0f,  1.0f, 0.0f,
+        0.5f,  0.5f, -0.5f,  0.0f,  0.0f, -1.0f,  1.0f, 1.0f,
+        0.5f,  0.5f, -0.5f,  0.0f,  0.0f, -1.0f,  1.0f, 1.0f,
+       -0.5f,  0.5f, -0.5f,  0.0f,  0.0f, -1.0f,  0.0f, 1.0f,
+       -0.5f, -0.5f, -0.5f,  0.0f,  0.0f, -1.0f,  0.0f, 0.0f,
+
+       //Front Face         //Positive Z Normal
+      -0.5f, -0.5f,  0.5f,  0.0f,  0.0f,  1.0f,  0.0f, 0.0f,
+       0.5f, -0.5f,  0.5f,  0.0f,  0.0f,  1.0f,  1.0f, 0.0f,
+       0.5f,  0.5f,  0.5f,  0.0f,  0.0f,  1.0f,  1.0f, 1.0f,
+       0.5f,  0.5f,  0.5f,  0.0f,  0.0f,  1.0f,  1.0f, 1.0f,
+      -0.5f,  0.5f,  0.5f,  0.0f,  0.0f,  1.0f,  0.0f, 1.0f,
+      -0.5f, -0.5f,  0.5f,  0.0f,  0.0f,  1.0f,  0.0f, 0.0f,
+
+      //Left Face          //Negative X Normal
+     -0.5f,  0.5f,  0.5f, -1.0f,  0.0f,  0.0f,  1.0f, 0.0f,
+     -0.5f,  0.5f, -0.5f, -1.0f,  0.0f,  0.0f,  1.0f, 1.0f,
+     -0.5f, -0.5f, -0.5f, -1.0f,  0.0f,  0.0f,  0.0f, 1.0f,
+     -0.5f, -0.5f, -0.5f, -1.0f,  0.0f,  0.0f,  0.0f, 1.0f,
+     -0.5f, -0.5f,  0.5f, -1.0f,  0.0f,  0.0f,  0.0f, 0.0f,
+     -0.5f,  0.5f,  0.5f, -1.0f,  0.0f,  0.0f,  1.0f, 0.0f,
+
+     //Right Face         //Positive X Normal
+     0.5f,  0.5f,  0.5f,  1.0f,  0.0f,  0.0f,  1.0f, 0.0f,
+     0.5f,  0.5f, -0.5f,  1.0f,  0.0f,  0.0f,  1.0f, 1.0f,
+     0.5f, -0.5f, -0.5f,  1.0f,  0.0f,  0.0f,  0.0f, 1.0f,
+     0.5f, -0.5f, -0.5f,  1.0f,  0.0f,  0.0f,  0.0f, 1.0f,
+     0.5f, -0.5f,  0.5f,  1.0f,  0.0f,  0.0f,  0.0f, 0.0f,
+     0.5f,  0.5f,  0.5f,  1.0f,  0.0f,  0.0f,  1.0f, 0.0f,
+
+     //Bottom Face        //Negative Y Normal
+    -0.5f, -0.5f, -0.5f,  0.0f, -1.0f,  0.0f,  0.0f, 1.0f,
+     0.5f, -0.5f, -0.5f,  0.0f, -1.0f,  0.0f,  1.0f, 1.0f,
+     0.5f, -0.5f,  0.5f,  0.0f, -1.0f,  0.0f,  1.0f, 0.0f,
+     0.5f, -0.5f,  0.5f,  0.0f, -1.0f,  0.0f,  1.0f, 0.0f,
+    -0.5f, -0.5f,  0.5f,  0.0f, -1.0f,  0.0f,  0.0f, 0.0f,
+    -0.5f, -0.5f, -0.5f,  0.0f, -1.0f,  0.0f,  0.0f, 1.0f,
+
+    //Top Face           //Positive Y Normal
+   -0.5f,  0.5f, -0.5f,  0.0f,  1.0f,  0.0f,  0.0f, 1.0f,
+    0.5f,  0.5f, -0.5f,  0.0f,  1.0f,  0.0f,  1.0f, 1.0f,
+    0.5f,  0.5f,  0.5f,  0.0f,  1.0f,  0.0f,  1.0f, 0.0f,
+    0.5f,  0.5f,  0.5f,  0.0f,  1.0f,  0.0f,  1.0f, 0.0f,
+   -0.5f,  0.5f,  0.5f,  0.0f,  1.0f,  0.0f,  0.0f, 0.0f,
+   -0.5f,  0.5f, -0.5f,  0.0f,  1.0f,  0.0f,  0.0f, 1.0f
+    };
+
+    vertices.assign(verts, verts + sizeof(verts) / sizeof(verts[0]));
+}
+
+//knife handle
+inline void BuildKnifeHandleVertices(std::vector<float>& vertices)
+{
+    // Position and Color data
+    float verts[] = {
+        //Positions          //Normals
+        // ------------------------------------------------------
+        //Back Face          //Negative Z Normal  Texture Coords.
+       -4.0f, -0.4f, 0.5f,  0.0f,  -1.0f, 0.0f,  0.0f, 0.0f,
+        0.0f, -0.4f, 0.5f,  0.0f,  -1.0f, 0.0f,  1.0f, 0.0f,
+        0.0f, -0.4f, -0.5f,  0.0f,  -1.0f, 0.0f,  1.0f, 1.0f,
+        0.0f, -0.4f, -0.5f,  0.0f,  -1.0f, 0.0f,  1.0f, 1.0f,
+       -4.0f, -0.4f, -0.5f,  0.0f,  -1.0f, 0.0f,  0.0f, 1.0f,
+       -4.0f, -0.4f, 0.5f,  0.0f,  -1.0f, 0.0f,  0.0f, 0.0f,
+
+       //Front Face         //Positive Z Normal
+      -4.0f,  0.4f, 0.5f,  0.0f,  1.0f,  0.0f,  0.0f, 0.0f,
+       0.0f,  0.4f, 0.5f,  0.0f,  1.0f,  0.0f,  1.0f, 0.0f,
+       0.0f,  0.4f, -0.5f,  0.0f,  1.0f,  0.0f,  1.0f, 1.0f,
+       0.0f,  0.4f, -0.5f,  0.0f,  1.0f,  0.0f,  1.0f, 1.0f,
+      -4.0f,  0.4f, -0.5f,  0.0f,  1.0f,  0.0f,  0.0f, 1.0f,
+      -4.0f,  0.4f, 0.5f,  0.0f,  1.0f,  0.0f,  0.0f, 0.0f,
+
+      //Left Face          //Negative X Normal
+      -4.0f, -0.4f, 0.5f, -1.0f,  0.0f,  0.0f,  1.0f, 0.0f,
+     -4.0f,  0.4f, 0.5f, -1.0f,  0.0f,  0.0f,  1.0f, 1.0f,
+     -4.0f,  0.4f, -0.5f, -1.0f,  0.0f,  0.0f,  0.0f, 1.0f,
+     -4.0f,  0.4f, -0.5f, -1.0f,  0.0f,  0.0f,  0.0f, 1.0f,
+      -4.0f, -0.4f, -0.5f, -1.0f,  0.0f,  0.0f,  0.0f, 0.0f,
+     -4.0f, -0.4f, 0.5f, -1.0f,  0.0f,  0.0f,  1.0f, 0.0f,
+
+     //Right Face         //Positive X Normal
+    0.0f, -0.4f, 0.5f,  1.0f,  0.0f,  0.0f,  1.0f, 0.0f,
+     0.0f,  0.4f, 0.5f,  1.0f,  0.0f,  0.0f,  1.0f, 1.0f,
+     0.0f,  0.4f, -0.5f,  1.0f,  0.0f,  0.0f,  0.0f, 1.0f,
+     0.0f,  0.4f, -0.5f,  1.0f,  0.0f,  0.0f,  0.0f, 1.0f,
+     0.0f, -0.4f, -0.5f,  1.0f,  0.0f,  0.0f,  0.0f, 0.0f,
+     0.0f, -0.4f, 0.5f,  1.0f,  0.0f,  0.0f,  1.0f, 0.0f,
+
+     //Bottom Face        //Negative Y Normal
+    -4.0f, -0.4f, -0.5f,  0.0f, 0.0f,  -1.0f,  0.0f, 1.0f,
+     0.0f, -0.4f, -0.5f,  0.0f, 0.0f,  -1.0f,  1.0f, 1.0f,
+     0.0f,  0.4f, -0.5f,  0.0f, 0.0f,  -1.0f,  1.0f, 0.0f,
+     0.0f,  0.4f, -0.5f,  0.0f, 0.0f,  -1.0f,  1.0f, 0.0f,
+    -4.0f,  0.4f, -0.5f,  0.0f, 0.0f,  -1.0f,  0.0f, 0.0f,
+    -4.0f, -0.4f, -0.5f,  0.0f, 0.0f,  -1.0f,  0.0f, 1.0f,
+
+    //Top Face           //Positive Y Normal
+   -4.0f, -0.4f, 0.5f,  0.0f,  0.0f,  1.0f,  0.0f, 1.0f,
+    0.0f, -0.4f, 0.5f,  0.0f,  0.0f,  1.0f,  1.0f, 1.0f,
+    0.0f,  0.4f, 0.5f,  0.0f,  0.0f,  1.0f,  1.0f, 0.0f,
+    0.0f,  0.4f, 0.5f,  0.0f,  0.0f,  1.0f,  1.0f, 0.0f,
+   -4.0f,  0.4f, 0.5f,  0.0f,  0.0f,  1.0f,  0.0f, 0.0f,
+   -4.0f, -0.4f, 0.5f,  0.0f,  0.0f,  1.0f,  0.0f, 1.0f
+    };
+
+    vertices.assign(verts, verts + sizeof(verts) / sizeof(verts[0]));
+}
+
+//knife blade
+inline void BuildKnifeBladeVertices(std::vector<float>& vertices)
+{
+    // Position and Color data
+    float verts[] = {
+        //Positions         //Normals
+        // ------------------------------------------------------
+        //Back Face        //Negative Z Normal  Texture Coords.
+      6.0f, -0.05f, -1.1f, 0.0f,  0.0f, -1.0f,  0.0f, 0.0f,
+      0.0f, -0.05f, -1.1f, 0.0f,  0.0f, -1.0f,  1.0f, 0.0f,
+      0.0f,  0.05f, -1.1f, 0.0f,  0.0f, -1.0f,  1.0f, 1.0f,
+      0.0f,  0.05f, -1.1f, 0.0f,  0.0f, -1.0f,  1.0f, 1.0f,
+      6.0f,  0.05f, -1.1f, 0.0f,  0.0f, -1.0f,  0.0f, 1.0f,
+      6.0f, -0.05f, -1.1f, 0.0f,  0.0f, -1.0f,  0.0f, 0.0f,
+
+      //Front Face         //Positive Z Normal
+     6.0f, -0.05f, 0.5f,  0.0f,  0.0f,  1.0f,  0.0f, 0.0f,
+     0.0f, -0.05f, 0.5f,  0.0f,  0.0f,  1.0f,  1.0f, 0.0f,
+     0.0f,  0.05f, 0.5f,  0.0f,  0.0f,  1.0f,  1.0f, 1.0f,
+     0.0f,  0.05f, 0.5f,  0.0f,  0.0f,  1.0f,  1.0f, 1.0f,
+     6.0f,  0.05f, 0.5f,  0.0f,  0.0f,  1.0f,  0.0f, 1.0f,
+     6.0f, -0.05f, 0.5f,  0.0f,  0.0f,  1.0f,  0.0f, 0.0f,
+
+     //Left Face          //Negative X Normal
+    0.0f, -0.05f,  0.5f, -1.0f,  0.0f,  0.0f,  1.0f, 0.0f,
+    0.0f,  0.05f,  0.5f, -1.0f,  0.0f,  0.0f,  1.0f, 1.0f,
+    0.0f,  0.05f, -1.1f, -1.0f,  0.0f,  0.0f,  0.0f, 1.0f,
+    0.0f,  0.05f, -1.1f, -1.0f,  0.0f,  0.0f,  0.0f, 1.0f,
+    0.0f, -0.05f, -1.1f, -1.0f,  0.0f,  0.0f,  0.0f, 0.0f,
+    0.0f, -0.05f,  0.5f, -1.0f,  0.0f,  0.0f,  1.0f, 0.0f,
+
+    //Bottom Face        //Negative Y Normal
+    6.0f, -0.05f, 0.5f,  0.0f, -1.0f,  0.0f,  0.0f, 1.0f,
+    0.0f, -0.05f, 0.5f,  0.0f, -1.0f,  0.0f,  1.0f, 1.0f,
+    0.0f, -0.05f, -1.1f, 0.0f, -1.0f,  0.0f,  1.0f, 0.0f,
+    0.0f, -0.05f, -1.1f, 0.0f, -1.0f,  0.0f,  1.0f, 0.0f,
+    6.0f, -0.05f, -1.1f, 0.0f, -1.0f,  0.0f,  0.0f, 0.0f,
+    6.0f, -0.05f, 0.5f,  0.0f, -1.0f,  0.0f,  0.0f, 1.0f,
+
+    //Top Face           //Positive Y Normal
+     6.0f,  0.05f, 0.5f,  0.0f,  1.0f,  0.0f,  0.0f, 1.0f,
+     0.0f,  0.05f, 0.5f,  0.0f,  1.0f,  0.0f,  1.0f, 1.0f,
+     0.0f,  0.05f, -1.1f, 0.0f,  1.0f,  0.0f,  1.0f, 0.0f,
+     0.0f,  0.05f, -1.1f, 0.0f,  1.0f,  0.0f,  1.0f, 0.0f,
+     6.0f,  0.05f, -1.1f, 0.0f,  1.0f,  0.0f,  0.0f, 0.0f,
+     6.0f,  0.05f, 0.5f,  0.0f,  1.0f,  0.0f,  0.0f, 1.0f,
+
+     //pyr side 1 top
+     6.0f,  0.05f, -1.1f, 0.0f,  1.0f,  0.0f, 0.0f, 1.0f,//4
+     6.0f,  0.05f,  0.5f, 0.0f,  1.0f,  0.0f, 0.0f, 0.0f,//8
+     8.0f, 0.0f ,  0.0f, 0.0f,  1.0f,  0.0f, 1.0f, 0.5f,//x
+
+     //pyr side 2 back
+     6.0f, -0.05f, -1.1f, 0.0f,  0.0f, -1.0f, 0.0f, 1.0f,//1
+     6.0f,  0.05f, -1.1f, 0.0f,  0.0f, -1.0f, 0.0f, 0.0f,//4
+     8.0f, 0.0f ,  0.0f, 0.0f,  0.0f, -1.0f, 1.0f, 0.5f,//x
+
+     //pyr side 3 front
+     6.0f,  0.05f, 0.5f, 0.0f,  0.0f, 1.0f, 0.0f, 1.0f,//8
+     6.0f, -0.05f, 0.5f, 0.0f,  0.0f, 1.0f, 0.0f, 0.0f,//5
+     8.0f, 0.0f , 0.0f, 0.0f,  0.0f, 1.0f, 1.0f, 0.5f,//x
+
+     //pyr side 4 bottom
+     6.0f, -0.05f, 0.5f, 0.0f,  -1.0f,  0.0f, 0.0f, 0.0f,//5
+     6.0f, -0.05f, -1.1f, 0.0f, -1.0f,  0.0f, 0.0f, 1.0f,//1
+     8.0f, 0.0f ,  0.0f, 0.0f, -1.0f,  0.0f, 1.0f, 0.5f//x
+    };
+
+    vertices.assign(verts, verts + sizeof(verts) / sizeof(verts[0]));
+}
+
+//cutting board
+inline void BuildCuttingBoardVertices(std::vector<float>& vertices)
+{
+    // Position and Color data
+    float verts[] = {
+        //Positions          //Normals
+        // ------------------------------------------------------
+        //Back Face          //Negative Z Normal  Texture Coords.
+       -4.0f,  0.0f, -3.0f,  0.0f,  0.0f, -1.0f,  0.15f, 0.2f,
+        4.0f,  0.0f, -3.0f,  0.0f,  0.0f, -1.0f,  0.15f, 0.9f,
+        4.0f,  0.5f, -3.0f,  0.0f,  0.0f, -1.0f,  0.18f, 0.9f,
+        4.0f,  0.5f, -3.0f,  0.0f,  0.0f, -1.0f,  0.18f, 0.9f,
+       -4.0f,  0.5f, -3.0f,  0.0f,  0.0f, -1.0f,  0.18f, 0.2f,
+       -4.0f,  0.0f, -3.0f,  0.0f,  0.0f, -1.0f,  0.15f, 0.2f,
+
+       //Front Face         //Positive Z Normal
+      -4.0f,  0.0f,  3.0f,  0.0f,  0.0f,  1.0f,  0.15f, 0.2f,
+       4.0f,  0.0f,  3.0f,  0.0f,  0.0f,  1.0f,  0.15f, 0.9f,
+       4.0f,  0.5f,  3.0f,  0.0f,  0.0f,  1.0f,  0.18f, 0.9f,
+       4.0f,  0.5f,  3.0f,  0.0f,  0.0f,  1.0f,  0.18f, 0.9f,
+      -4.0f,  0.5f,  3.0f,  0.0f,  0.0f,  1.0f,  0.18f, 0.2f,
+      -4.0f,  0.0f,  3.0f,  0.0f,  0.0f,  1.0f,  0.15f, 0.2f,
+
+      //Left Face          //Negative X Normal
+     -4.0f,  0.5f,  3.0f, -1.0f,  0.0f,  0.0f,  0.15f, 0.2f,
+     -4.0f,  0.5f, -3.0f, -1.0f,  0.0f,  0.0f,  0.15f, 0.9f,
+     -4.0f,  0.0f, -3.0f, -1.0f,  0.0f,  0.0f,  0.18f, 0.9f,
+     -4.0f,  0.0f, -3.0f, -1.0f,  0.0f,  0.0f,  0.18f, 0.9f,
+     -4.0f,  0.0f,  3.0f, -1.0f,  0.0f,  0.0f,  0.18f, 0.2f,
+     -4.0f,  0.5f,  3.0f, -1.0f,  0.0f,  0.0f,  0.15f, 0.2f,
+
+     //Right Face         //Positive X Normal
+     4.0f,  0.5f,  3.0f,  1.0f,  0.0f,  0.0f,  0.15f, 0.2f,
+     4.0f,  0.5f, -3.0f,  1.0f,  0.0f,  0.0f,  0.15f, 0.9f,
+     4.0f,  0.0f, -3.0f,  1.0f,  0.0f,  0.0f,  0.18f, 0.9f,
+     4.0f,  0.0f, -3.0f,  1.0f,  0.0f,  0.0f,  0.18f, 0.9f,
+     4.0f,  0.0f,  3.0f,  1.0f,  0.0f,  0.0f,  0.18f, 0.2f,
+     4.0f,  0.5f,  3.0f,  1.0f,  0.0f,  0.0f,  0.15f, 0.2f,
+
+     //Bottom Face        //Negative Y Normal
+    -4.0f,  0.0f, -3.0f,  0.0f,  1.0f,  0.0f,  0.15f, 0.1f,
+     4.0f,  0.0f, -3.0f,  0.0f,  1.0f,  0.0f,  0.15f, 0.9f,
+     4.0f,  0.0f,  3.0f,  0.0f,  1.0f,  0.0f,  0.85f, 0.9f,
+     4.0f,  0.0f,  3.0f,  0.0f,  1.0f,  0.0f,  0.85f, 0.9f,
+    -4.0f,  0.0f,  3.0f,  0.0f,  1.0f,  0.0f,  0.85f, 0.1f,
+    -4.0f,  0.0f, -3.0f,  0.0f,  1.0f,  0.0f,  0.15f, 0.1f,
+
+    //Top Face           //Positive Y Normal
+   -4.0f,  0.5f, -3.0f,  0.0f,  1.0f,  0.0f,  0.15f, 0.1f,
+    4.0f,  0.5f, -3.0f,  0.0f,  1.0f,  0.0f,  0.15f, 0.9f,
+    4.0f,  0.5f,  3.0f,  0.0f,  1.0f,  0.0f,  0.85f, 0.9f,
+    4.0f,  0.5f,  3.0f,  0.0f,  1.0f,  0.0f,  0.85f, 0.9f,
+   -4.0f,  0.5f,  3.0f,  0.0f,  1.0f,  0.0f,  0.85f, 0.1f,
+   -4.0f,  0.5f, -3.0f,  0.0f,  1.0f,  0.0f,  0.15f, 0.1f
+    };
+
+    vertices.assign(verts, verts + sizeof(verts) / sizeof(verts[0]));
+}
+
+//counter top, the uvs repeat the texture across it
+inline void BuildPlaneVertices(std::vector<float>& vertices)
+{
+    const float repeatUp = 2.0f;
+    const float RepeatHori = 3.0f;
+    // Position and Color data
+    float verts[] = {
+        //Positions            //Normals
+        // ------------------------------------------------------
+        //Top Face             //Positive Y Normal
+       -15.0f,  0.0f, -15.0f,  0.0f,  1.0f,  0.0f,  0.0f,     0.0f,
+        15.0f,  0.0f, -15.0f,  0.0f,  1.0f,  0.0f,  0.0f,     RepeatHori,
+        15.0f,  0.0f,  15.0f,  0.0f,  1.0f,  0.0f,  repeatUp, RepeatHori,
+        15.0f,  0.0f,  15.0f,  0.0f,  1.0f,  0.0f,  repeatUp, RepeatHori,
+       -15.0f,  0.0f,  15.0f,  0.0f,  1.0f,  0.0f,  repeatUp, 0.0f,
+       -15.0f,  0.0f, -15.0f,  0.0f,  1.0f,  0.0f,  0.0f,     0.0f
+    };
+
+    vertices.assign(verts, verts + sizeof(verts) / sizeof(verts[0]));
+}
+
+//salami ends
+inline void BuildSalamiEndsVertices(std::vector<float>& vertices)
+{
+    float verts[] = {
+        //Positions          //Normals
+        // ------------------------------------------------------
+
+        //Bottom Face        //Negative Y Normal
+       -0.4f, -1.0f, -1.0f,  0.0f, -1.0f,  0.0f,  0.33f, 1.0f,
+        0.4f, -1.0f, -1.0f,  0.0f, -1.0f,  0.0f,  0.66f, 1.0f,
+        0.0f, -1.0f,  0.0f,  0.0f, -1.0f,  0.0f,  0.5f, 0.5f,
+        0.4f, -1.0f, -1.0f,  0.0f, -1.0f,  0.0f,  0.66f, 1.0f,
+        1.0f, -1.0f, -0.4f,  0.0f, -1.0f,  0.0f,  1.0f, 0.66f,
+        0.0f, -1.0f,  0.0f,  0.0f, -1.0f,  0.0f,  0.5f, 0.5f,
+        1.0f, -1.0f,  0.4f,  0.0f, -1.0f,  0.0f,  1.00f, 0.33f,
+        1.0f, -1.0f, -0.4f,  0.0f, -1.0f,  0.0f,  1.0f, 0.66f,
+        0.0f, -1.0f,  0.0f,  0.0f, -1.0f,  0.0f,  0.5f, 0.5f,
+        0.4f, -1.0f,  1.0f,  0.0f, -1.0f,  0.0f,  0.66f, 0.0f,
+        1.0f, -1.0f,  0.4f,  0.0f, -1.0f,  0.0f,  1.00f, 0.33f,
+        0.0f, -1.0f,  0.0f,  0.0f, -1.0f,  0.0f,  0.5f, 0.5f,
+        0.4f, -1.0f,  1.0f,  0.0f, -1.0f,  0.0f,  0.66f, 0.0f,
+        1.0f, -1.0f,  0.4f,  0.0f, -1.0f,  0.0f,  1.00f, 0.33f,
+        0.0f, -1.0f,  0.0f,  0.0f, -1.0f,  0.0f,  0.5f, 0.5f,
+        0.4f, -1.0f,  1.0f,  0.0f, -1.0f,  0.0f,  0.66f, 0.0f,
+       -0.4f, -1.0f,  1.0f,  0.0f, -1.0f,  0.0f,  0.33f, 0.00f,
+        0.0f, -1.0f,  0.0f,  0.0f, -1.0f,  0.0f,  0.5f, 0.5f,
+       -1.0f, -1.0f,  0.4f,  0.0f, -1.0f,  0.0f,  0.0f, 0.33f,
+       -0.4f, -1.0f,  1.0f,  0.0f, -1.0f,  0.0f,  0.33f, 0.0f,
+        0.0f, -1.0f,  0.0f,  0.0f, -1.0f,  0.0f,  0.5f, 0.5f,
+       -1.0f, -1.0f,  0.4f,  0.0f, -1.0f,  0.0f,  0.0f, 0.33f,
+       -1.0f, -1.0f, -0.4f,  0.0f, -1.0f,  0.0f,  0.0f, 0.66f,
+        0.0f, -1.0f,  0.0f,  0.0f, -1.0f,  0.0f,  0.5f, 0.5f,
+       -0.4f, -1.0f, -1.0f,  0.0f, -1.0f,  0.0f,  0.33f, 1.0f,
+       -1.0f, -1.0f, -0.4f,  0.0f, -1.0f,  0.0f,  0.0f, 0.66f,
+        0.0f, -1.0f,  0.0f,  0.0f, -1.0f,  0.0f,  0.5f, 0.5f,
+
+        //Top Face        //Positive Y Normal
+       -0.4f,  1.0f, -1.0f,  0.0f,  1.0f,  0.0f,  0.33f, 1.0f,
+        0.4f,  1.0f, -1.0f,  0.0f,  1.0f,  0.0f,  0.66f, 1.0f,
+        0.0f,  1.0f,  0.0f,  0.0f,  1.0f,  0.0f,  0.5f, 0.5f,
+        0.4f,  1.0f, -1.0f,  0.0f,  1.0f,  0.0f,  0.66f, 1.0f,
+        1.0f,  1.0f, -0.4f,  0.0f,  1.0f,  0.0f,  1.0f, 0.66f,
+        0.0f,  1.0f,  0.0f,  0.0f,  1.0f,  0.0f,  0.5f, 0.5f,
+        1.0f,  1.0f,  0.4f,  0.0f,  1.0f,  0.0f,  1.00f, 0.33f,
+        1.0f,  1.0f, -0.4f,  0.0f,  1.0f,  0.0f,  1.0f, 0.66f,
+        0.0f,  1.0f,  0.0f,  0.0f,  1.0f,  0.0f,  0.5f, 0.5f,
+        0.4f,  1.0f,  1.0f,  0.0f,  1.0f,  0.0f,  0.66f, 0.0f,
+        1.0f,  1.0f,  0.4f,  0.0f,  1.0f,  0.0f,  1.00f, 0.33f,
+        0.0f,  1.0f,  0.0f,  0.0f,  1.0f,  0.0f,  0.5f, 0.5f,
+        0.4f,  1.0f,  1.0f,  0.0f,  1.0f,  0.0f,  0.66f, 0.0f,
+        1.0f,  1.0f,  0.4f,  0.0f,  1.0f,  0.0f,  1.00f, 0.33f,
+        0.0f,  1.0f,  0.0f,  0.0f,  1.0f,  0.0f,  0.5f, 0.5f,
+        0.4f,  1.0f,  1.0f,  0.0f,  1.0f,  0.0f,  0.66f, 0.0f,
+       -0.4f,  1.0f,  1.0f,  0.0f,  1.0f,  0.0f,  0.33f, 0.00f,
+        0.0f,  1.0f,  0.0f,  0.0f,  1.0f,  0.0f,  0.5f, 0.5f,
+       -1.0f,  1.0f,  0.4f,  0.0f,  1.0f,  0.0f,  0.0f, 0.33f,
+       -0.4f,  1.0f,  1.0f,  0.0f,  1.0f,  0.0f,  0.33f, 0.0f,
+        0.0f,  1.0f,  0.0f,  0.0f,  1.0f,  0.0f,  0.5f, 0.5f,
+       -1.0f,  1.0f,  0.4f,  0.0f,  1.0f,  0.0f,  0.0f, 0.33f,
+       -1.0f,  1.0f, -0.4f,  0.0f,  1.0f,  0.0f,  0.0f, 0.66f,
+        0.0f,  1.0f,  0.0f,  0.0f,  1.0f,  0.0f,  0.5f, 0.5f,
+       -0.4f,  1.0f, -1.0f,  0.0f,  1.0f,  0.0f,  0.33f, 1.0f,
+       -1.0f,  1.0f, -0.4f,  0.0f,  1.0f,  0.0f,  0.0f, 0.66f,
+        0.0f,  1.0f,  0.0f,  0.0f,  1.0f,  0.0f,  0.5f, 0.5f
+    };
+
+    vertices.assign(verts, verts + sizeof(verts) / sizeof(verts[0]));
+}
+
+//salami body
+inline void BuildSalamiBodyVertices(std::vector<float>& vertices)
+{
+    // Position and Color data
+    float verts[] = {
+        //South Face         //Positive Z Normal
+       -0.4f, -1.0f, 1.0f, 0.0f, 0.0f, 1.0f, 0.0f, 0.0f,
+        0.4f, -1.0f, 1.0f, 0.0f, 0.0f, 1.0f, 1.0f, 0.0f,
+        0.4f, 1.0f, 1.0f, 0.0f, 0.0f, 1.0f, 1.0f, 1.0f,
+        0.4f, 1.0f, 1.0f, 0.0f, 0.0f, 1.0f, 1.0f, 1.0f,
+       -0.4f, 1.0f, 1.0f, 0.0f, 0.0f, 1.0f, 0.0f, 1.0f,
+       -0.4f, -1.0f, 1.0f, 0.0f, 0.0f, 1.0f, 0.0f, 0.0f,
+
+       //North Face         //Negative Z Normal
+      -0.4f, -1.0f, -1.0f, 0.0f, 0.0f, -1.0f, 0.0f, 0.0f,
+       0.4f, -1.0f, -1.0f, 0.0f, 0.0f, -1.0f, 1.0f, 0.0f,
+       0.4f, 1.0f, -1.0f, 0.0f, 0.0f, -1.0f, 1.0f, 1.0f,
+       0.4f, 1.0f, -1.0f, 0.0f, 0.0f, -1.0f, 1.0f, 1.0f,
+      -0.4f, 1.0f, -1.0f, 0.0f, 0.0f, -1.0f, 0.0f, 1.0f,
+      -0.4f, -1.0f, -1.0f, 0.0f, 0.0f, -1.0f, 0.0f, 0.0f,
+
+      //East Face         //Positive X Normal
+      1.0f, 1.0f, 0.4f, 1.0f, 0.0f, 0.0f, 0.0f, 0.0f,
+      1.0f, 1.0f, -0.4f, 1.0f, 0.0f, 0.0f, 1.0f, 0.0f,
+      1.0f, -1.0f, -0.4f, 1.0f, 0.0f, 0.0f, 1.0f, 1.0f,
+      1.0f, -1.0f, -0.4f, 1.0f, 0.0f, 0.0f, 1.0f, 1.0f,
+      1.0f, -1.0f, 0.4f, 1.0f, 0.0f, 0.0f, 0.0f, 1.0f,
+      1.0f, 1.0f, 0.4f, 1.0f, 0.0f, 0.0f, 0.0f, 0.0f,
+
+      //West Face         //Negative X Normal
+    -1.0f, 1.0f, 0.4f, -1.0f, 0.0f, 0.0f, 0.0f, 0.0f,
+    -1.0f, 1.0f, -0.4f, -1.0f, 0.0f, 0.0f, 1.0f, 0.0f,
+    -1.0f, -1.0f, -0.4f, -1.0f, 0.0f, 0.0f, 1.0f, 1.0f,
+    -1.0f, -1.0f, -0.4f, -1.0f, 0.0f, 0.0f, 1.0f, 1.0f,
+    -1.0f, -1.0f, 0.4f, -1.0f, 0.0f, 0.0f, 0.0f, 1.0f,
+    -1.0f, 1.0f, 0.4f, -1.0f, 0.0f, 0.0f, 0.0f, 0.0f,
+
+    //NorthEst Face       
+    1.0f, -1.0f, -0.4f, 0.5f, 0.0f, -0.5f, 0.0f, 0.0f,
+    0.4f, -1.0f, -1.0f, 0.5f, 0.0f, -0.5f, 1.0f, 0.0f,
+    0.4f, 1.0f, -1.0f, 0.5f, 0.0f, -0.5f, 1.0f, 1.0f,
+    0.4f, 1.0f, -1.0f, 0.5f, 0.0f, -0.5f, 1.0f, 1.0f,
+    1.0f, 1.0f, -0.4f, 0.5f, 0.0f, -0.5f, 0.0f, 1.0f,
+    1.0f, -1.0f, -0.4f, 0.5f, 0.0f, -0.5f, 0.0f, 0.0f,
+
+    //Southwest Face       
+    -0.4f, -1.0f, 1.0f, -0.5f, 0.0f, 0.5f, 0.0f, 0.0f,
+    -1.0f, -1.0f, 0.4f, -0.5f, 0.0f, 0.5f, 1.0f, 0.0f,
+    -1.0f, 1.0f, 0.4f, -0.5f, 0.0f, 0.5f, 1.0f, 1.0f,
+    -1.0f, 1.0f, 0.4f, -0.5f, 0.0f, 0.5f, 1.0f, 1.0f,
+    -0.4f, 1.0f, 1.0f, -0.5f, 0.0f, 0.5f, 0.0f, 1.0f,
+    -0.4f, -1.0f, 1.0f, -0.5f, 0.0f, 0.5f, 0.0f, 0.0f,
+
+    //Northwest Face
+    -1.0f, -1.0f, -0.4f, -0.5f, 0.0f, -0.5f, 0.0f, 0.0f,
+    -0.4f, -1.0f, -1.0f, -0.5f, 0.0f, -0.5f, 1.0f, 0.0f,
+    -0.4f, 1.0f, -1.0f, -0.5f, 0.0f, -0.5f, 1.0f, 1.0f,
+    -0.4f, 1.0f, -1.0f, -0.5f, 0.0f, -0.5f, 1.0f, 1.0f,
+    -1.0f, 1.0f, -0.4f, -0.5f, 0.0f, -0.5f, 0.0f, 1.0f,
+    -1.0f, -1.0f, -0.4f, -0.5f, 0.0f, -0.5f, 0.0f, 0.0f,
+
+    //Southeast Face
+    1.0f, -1.0f, 0.4f, 0.5f, 0.0f, 0.5f, 0.0f, 0.0f,
+    0.4f, -1.0f, 1.0f, 0.5f, 0.0f, 0.5f, 1.0f, 0.0f,
+    0.4f, 1.0f, 1.0f, 0.5f, 0.0f, 0.5f, 1.0f, 1.0f,
+    0.4f, 1.0f, 1.0f, 0.5f, 0.0f, 0.5f, 1.0f, 1.0f,
+    1.0f, 1.0f, 0.4f, 0.5f, 0.0f, 0.5f, 0.0f, 1.0f,
+    1.0f, -1.0f, 0.4f, 0.5f, 0.0f, 0.5f, 0.0f, 0.0f,
+    };
+
+    vertices.assign(verts, verts + sizeof(verts) / sizeof(verts[0]));
+}
+
+//wedge of cheese
+inline void BuildCheeseVertices(std::vector<float>& vertices)
+{
+    // Position and Color data
+    float verts[] = {
+        //Positions          //Normals
+        // ------------------------------------------------------
+        //Back Face          //Negative Z Normal  Texture Coords.
+       -0.5f, -0.5f, -0.5f,  0.0f,  0.0f, -1.0f,  0.0f, 0.0f,
+        0.5f, -0.5f, -0.5f,  0.0f,  0.0f, -1.0f,  1.0f, 0.0f,
+        0.5f,  0.5f, -0.5f,  0.0f,  0.0f, -1.0f,  1.0f, 1.0f,
+        0.5f,  0.5f, -0.5f,  0.0f,  0.0f, -1.0f,  1.0f, 1.0f,
+       -0.5f,  0.5f, -0.5f,  0.0f,  0.0f, -1.0f,  0.0f, 1.0f,
+       -0.5f, -0.5f, -0.5f,  0.0f,  0.0f, -1.0f,  0.0f, 0.0f,
+
+       //Front Face         //Positive Z Normal
+      -0.5f, -0.5f,  0.5f,  0.0f,  0.0f,  1.0f,  0.0f, 0.0f,
+       0.5f, -0.5f,  0.5f,  0.0f,  0.0f,  1.0f,  1.0f, 0.0f,
+       0.5f,  0.5f,  0.5f,  0.0f,  0.0f,  1.0f,  1.0f, 1.0f,
+       0.5f,  0.5f,  0.5f,  0.0f,  0.0f,  1.0f,  1.0f, 1.0f,
+      -0.5f,  0.5f,  0.5f,  0.0f,  0.0f,  1.0f,  0.0f, 1.0f,
+      -0.5f, -0.5f,  0.5f,  0.0f,  0.0f,  1.0f,  0.0f, 0.0f,
+
+      //Left Face          //Negative X Normal
+     -0.5f,  0.5f,  0.5f, -1.0f,  0.0f,  0.0f,  1.0f, 0.0f,
+     -0.5f,  0.5f, -0.5f, -1.0f,  0.0f,  0.0f,  1.0f, 1.0f,
+     -0.5f, -0.5f, -0.5f, -1.0f,  0.0f,  0.0f,  0.0f, 1.0f,
+     -0.5f, -0.5f, -0.5f, -1.0f,  0.0f,  0.0f,  0.0f, 1.0f,
+     -0.5f, -0.5f,  0.5f, -1.0f,  0.0f,  0.0f,  0.0f, 0.0f,
+     -0.5f,  0.5f,  0.5f, -1.0f,  0.0f,  0.0f,  1.0f, 0.0f,
+
+     //Right Face         //Positive X Normal
+     0.5f,  0.5f,  0.5f,  1.0f,  0.0f,  0.0f,  1.0f, 0.0f,
+     0.5f,  0.5f, -0.5f,  1.0f,  0.0f,  0.0f,  1.0f, 1.0f,
+     0.5f, -0.5f, -0.5f,  1.0f,  0.0f,  0.0f,  0.0f, 1.0f,
+     0.5f, -0.5f, -0.5f,  1.0f,  0.0f,  0.0f,  0.0f, 1.0f,
+     0.5f, -0.5f,  0.5f,  1.0f,  0.0f,  0.0f,  0.0f, 0.0f,
+     0.5f,  0.5f,  0.5f,  1.0f,  0.0f,  0.0f,  1.0f, 0.0f,
+
+     //Bottom Face        //Negative Y Normal
+    -0.5f, -0.5f, -0.5f,  0.0f, -1.0f,  0.0f,  0.0f, 1.0f,
+     0.5f, -0.5f, -0.5f,  0.0f, -1.0f,  0.0f,  1.0f, 1.0f,
+     0.5f, -0.5f,  0.5f,  0.0f, -1.0f,  0.0f,  1.0f, 0.0f,
+     0.5f, -0.5f,  0.5f,  0.0f, -1.0f,  0.0f,  1.0f, 0.0f,
+    -0.5f, -0.5f,  0.5f,  0.0f, -1.0f,  0.0f,  0.0f, 0.0f,
+    -0.5f, -0.5f, -0.5f,  0.0f, -1.0f,  0.0f,  0.0f, 1.0f,
+
+    //Top Face           //Positive Y Normal
+   -0.5f,  0.5f, -0.5f,  0.0f,  1.0f,  0.0f,  0.0f, 1.0f,
+    0.5f,  0.5f, -0.5f,  0.0f,  1.0f,  0.0f,  1.0f, 1.0f,
+    0.5f,  0.5f,  0.5f,  0.0f,  1.0f,  0.0f,  1.0f, 0.0f,
+    0.5f,  0.5f,  0.5f,  0.0f,  1.0f,  0.0f,  1.0f, 0.0f,
+   -0.5f,  0.5f,  0.5f,  0.0f,  1.0f,  0.0f,  0.0f, 0.0f,
+   -0.5f,  0.5f, -0.5f,  0.0f,  1.0f,  0.0f,  0.0f, 1.0f
+    };
+
+    vertices.assign(verts, verts + sizeof(verts) / sizeof(verts[0]));
+}
+#endif
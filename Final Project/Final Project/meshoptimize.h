@@ -0,0 +1,469 @@
+#ifndef MESHOPTIMIZE_H
+#define MESHOPTIMIZE_H
+
+#include <glm/glm.hpp>
+
+#include <algorithm>
+#include <cfloat>
+#include <cmath>
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+#include <unordered_map>
+#include <vector>
+
+//post transform cache the ACMR/ATVR figures are measured against, FIFO like most hardware
+const int VERTEX_CACHE_SIZE = 16;
+
+//LRU cache the Forsyth scores assume, bigger than the real one so it doesn't overfit it
+const int FORSYTH_CACHE_SIZE = 32;
+
+//how much worse than the cache optimized order a cluster may get before overdraw ordering splits it
+const float OVERDRAW_THRESHOLD = 1.05f;
+
+//meshlet limits, the sizes mesh shading hardware is built around
+const size_t MESHLET_MAX_VERTICES = 64;
+const size_t MESHLET_MAX_TRIANGLES = 124;
+
+//cache misses of an index buffer. ACMR is misses per triangle (0.5 is the ideal for a regular grid,
+//3 means no reuse at all), ATVR misses per vertex (1 means each vertex is transformed once)
+struct VertexCacheStats {
+    size_t Triangles = 0;
+    size_t Vertices = 0;
+    size_t Misses = 0;
+
+    float Acmr() const { return Triangles > 0 ? (float)Misses / Triangles : 0.0f; }
+    float Atvr() const { return Vertices > 0 ? (float)Misses / Vertices : 0.0f; }
+
+    VertexCacheStats& operator+=(const VertexCacheStats& other) {
+        Triangles += other.Triangles;
+        Vertices += other.Vertices;
+        Misses += other.Misses;
+        return *this;
+    }
+};
+
+//a run of consecutive triangles in the optimized index buffer, with what a culling pass needs to
+//throw it away. it faces away from the camera entirely when
+//dot(Center - eye, ConeAxis) >= ConeCutoff * length(Center - eye) + Radius
+struct Meshlet {
+    uint32_t FirstIndex;
+    uint32_t IndexCount;
+    uint32_t VertexCount;       // distinct vertices the run references
+    glm::vec3 Center;
+    float Radius;
+    glm::vec3 ConeAxis;
+    float ConeCutoff;           // 1 when the normals spread too far to ever cull it
+};
+
+//an indexed mesh after OptimizeMesh, vertices in the interleaved layout they came in
+struct OptimizedMesh {
+    std::vector<float> Vertices;
+    std::vector<uint32_t> Indices;
+    std::vector<Meshlet> Meshlets;
+    VertexCacheStats Before;    // welded, in the order the triangles were written
+    VertexCacheStats After;
+};
+
+//--- analysis ---
+
+inline VertexCacheStats AnalyzeVertexCache(const uint32_t* indices, size_t indexCount, size_t vertexCount, int cacheSize = VERTEX_CACHE_SIZE)
+{
+    VertexCacheStats stats;
+    stats.Triangles = indexCount / 3;
+
+    //a vertex is still cached while fewer than cacheSize misses happened since it was loaded
+    std::vector<size_t> loadedAt(vertexCount, 0);
+    std::vector<bool> referenced(vertexCount, false);
+    size_t time = cacheSize + 1;
+    for (size_t i = 0; i < stats.Triangles * 3; ++i) {
+        uint32_t vertex = indices[i];
+        if (time - loadedAt[vertex] > (size_t)cacheSize) {
+            loadedAt[vertex] = time++;
+            ++stats.Misses;
+        }
+        if (!referenced[vertex]) {
+            referenced[vertex] = true;
+            ++stats.Vertices;
+        }
+    }
+    return stats;
+}
+
+//--- welding ---
+
+//merges vertices whose every component is equal, the non indexed meshes repeat each shared corner
+inline void WeldVertices(const float* vertices, size_t vertexCount, int stride, std::vector<float>& unique, std::vector<uint32_t>& indices)
+{
+    struct Hash {
+        const float* Data;
+        int Stride;
+        size_t operator()(uint32_t vertex) const {
+            uint64_t hash = 1469598103934665603ull;
+            for (int i = 0; i < Stride; ++i) {
+                //adding zero turns -0 into 0 so equal values hash the same
+                float value = Data[(size_t)vertex * Stride + i] + 0.0f;
+                uint32_t bits;
+                memcpy(&bits, &value, sizeof(bits));
+                hash = (hash ^ bits) * 1099511628211ull;
+            }
+            return (size_t)hash;
+        }
+    };
+    struct Equal {
+        const float* Data;
+        int Stride;
+        bool operator()(uint32_t a, uint32_t b) const {
+            for (int i = 0; i < Stride; ++i) {
+                if (Data[(size_t)a * Stride + i] != Data[(size_t)b * Stride + i]) {
+                    return false;
+                }
+            }
+            return true;
+        }
+    };
+
+    //keys are source vertex numbers, values the unique vertex they became
+    std::unordered_map<uint32_t, uint32_t, Hash, Equal> seen(vertexCount * 2, Hash{ vertices, stride }, Equal{ vertices, stride });
+    unique.clear();
+    indices.resize(vertexCount);
+    for (size_t i = 0; i < vertexCount; ++i) {
+        std::pair<std::unordered_map<uint32_t, uint32_t, Hash, Equal>::iterator, bool> result =
+            seen.insert(std::make_pair((uint32_t)i, (uint32_t)(unique.size() / stride)));
+        if (result.second) {
+            unique.insert(unique.end(), vertices + i * stride, vertices + (i + 1) * stride);
+        }
+        indices[i] = result.first->second;
+    }
+}
+
+//--- vertex cache ---
+
+//Forsyth's score: the last triangle's corners a flat 0.75, older entries fading with their position,
+//plus a boost for vertices with few triangles left so they get finished off instead of stranded
+inline float ForsythVertexScore(int cachePosition, uint32_t remaining)
+{
+    if (remaining == 0) {
+        return -1.0f;
+    }
+    float score = 0.0f;
+    if (cachePosition >= 0) {
+        score = cachePosition < 3 ? 0.75f : powf(1.0f - (cachePosition - 3) / (float)(FORSYTH_CACHE_SIZE - 3), 1.5f);
+    }
+    return score + 2.0f / sqrtf((float)remaining);
+}
+
+//reorders triangles so consecutive ones share vertices, Forsyth's linear speed algorithm
+inline void OptimizeVertexCache(std::vector<uint32_t>& indices, size_t vertexCount)
+{
+    const size_t triangleCount = indices.size() / 3;
+
+    //triangles touching each vertex, the live ones first so removing one is a swap
+    std::vector<uint32_t> remaining(vertexCount, 0);
+    for (size_t i = 0; i < triangleCount * 3; ++i) {
+        ++remaining[indices[i]];
+    }
+    std::vector<uint32_t> offsets(vertexCount + 1, 0);
+    for (size_t v = 0; v < vertexCount; ++v) {
+        offsets[v + 1] = offsets[v] + remaining[v];
+    }
+    std::vector<uint32_t> adjacency(offsets[vertexCount]);
+    std::vector<uint32_t> fill(offsets.begin(), offsets.end() - 1);
+    for (size_t t = 0; t < triangleCount; ++t) {
+        for (int c = 0; c < 3; ++c) {
+            adjacency[fill[indices[t * 3 + c]]++] = (uint32_t)t;
+        }
+    }
+
+    std::vector<int> cachePosition(vertexCount, -1);
+    std::vector<float> vertexScore(vertexCount);
+    for (size_t v = 0; v < vertexCount; ++v) {
+        vertexScore[v] = ForsythVertexScore(-1, remaining[v]);
+    }
+    std::vector<float> triangleScore(triangleCount);
+    for (size_t t = 0; t < triangleCount; ++t) {
+        triangleScore[t] = vertexScore[indices[t * 3]] + vertexScore[indices[t * 3 + 1]] + vertexScore[indices[t * 3 + 2]];
+    }
+
+    std::vector<bool> emitted(triangleCount, false);
+    std::vector<uint32_t> cache, nextCache;
+    std::vector<uint32_t> result;
+    result.reserve(triangleCount * 3);
+    size_t scan = 0;
+    long best = triangleCount > 0 ? 0 : -1;
+
+    while (result.size() < triangleCount * 3) {
+        if (best < 0) {
+            //nothing in the cache touches a live triangle, start again from the first one left
+            while (emitted[scan]) {
+                ++scan;
+            }
+            best = (long)scan;
+        }
+
+        const uint32_t* corners = &indices[best * 3];
+        emitted[best] = true;
+        result.insert(result.end(), corners, corners + 3);
+
+        //the triangle leaves its vertices' live lists
+        for (int c = 0; c < 3; ++c) {
+            uint32_t vertex = corners[c];
+            uint32_t* first = &adjacency[offsets[vertex]];
+            uint32_t* last = first + remaining[vertex];
+            uint32_t* found = std::find(first, last, (uint32_t)best);
+            if (found != last) {
+                std::swap(*found, *(last - 1));
+                --remaining[vertex];
+            }
+        }
+
+        //its corners move to the front of the cache, whatever falls off the end is forgotten
+        nextCache.assign(corners, corners + 3);
+        nextCache.erase(std::unique(nextCache.begin(), nextCache.end()), nextCache.end());
+        if (nextCache.size() == 3 && nextCache[0] == nextCache[2]) {
+            nextCache.pop_back();
+        }
+        for (uint32_t vertex : cache) {
+            if (std::find(nextCache.begin(), nextCache.end(), vertex) == nextCache.end()) {
+                nextCache.push_back(vertex);
+            }
+        }
+
+        //rescore everything that moved, including what fell out, and pick the best triangle they touch
+        float bestScore = -1.0f;
+        best = -1;
+        for (size_t i = 0; i < nextCache.size(); ++i) {
+            uint32_t vertex = nextCache[i];
+            int position = i < (size_t)FORSYTH_CACHE_SIZE ? (int)i : -1;
+            cachePosition[vertex] = position;
+            float score = ForsythVertexScore(position, remaining[vertex]);
+            float change = score - vertexScore[vertex];
+            vertexScore[vertex] = score;
+            for (uint32_t k = offsets[vertex]; k < offsets[vertex] + remaining[vertex]; ++k) {
+                triangleScore[adjacency[k]] += change;
+            }
+        }
+        for (size_t i = 0; i < nextCache.size() && i < (size_t)FORSYTH_CACHE_SIZE; ++i) {
+            uint32_t vertex = nextCache[i];
+            for (uint32_t k = offsets[vertex]; k < offsets[vertex] + remaining[vertex]; ++k) {
+                if (triangleScore[adjacency[k]] > bestScore) {
+                    bestScore = triangleScore[adjacency[k]];
+                    best = (long)adjacency[k];
+                }
+            }
+        }
+
+        nextCache.resize(std::min(nextCache.size(), (size_t)FORSYTH_CACHE_SIZE));
+        cache.swap(nextCache);
+    }
+    indices.swap(result);
+}
+
+//--- overdraw ---
+
+//Sander, Nehab and Barczak's ordering: cut the cache optimized order into clusters where the cache
+//was flushed anyway (or where the cluster's own ACMR is still within threshold of the whole mesh's),
+//then draw the clusters facing out from the middle first since those are the ones that occlude
+inline void OptimizeOverdraw(std::vector<uint32_t>& indices, const float* vertices, int stride, size_t vertexCount,
+    float threshold = OVERDRAW_THRESHOLD)
+{
+    const size_t triangleCount = indices.size() / 3;
+    if (triangleCount < 2) {
+        return;
+    }
+    const float meshAcmr = AnalyzeVertexCache(indices.data(), indices.size(), vertexCount).Acmr();
+
+    //cluster starts, in triangles
+    std::vector<size_t> starts;
+    std::vector<size_t> loadedAt(vertexCount, 0);
+    size_t time = VERTEX_CACHE_SIZE + 1;
+    size_t clusterMisses = 0;
+    size_t clusterStart = 0;
+    for (size_t t = 0; t < triangleCount; ++t) {
+        int misses = 0;
+        for (int c = 0; c < 3; ++c) {
+            uint32_t vertex = indices[t * 3 + c];
+            if (time - loadedAt[vertex] > (size_t)VERTEX_CACHE_SIZE) {
+                loadedAt[vertex] = time++;
+                ++misses;
+            }
+        }
+        if (t == 0 || misses == 3) {
+            starts.push_back(t);
+            clusterStart = t;
+            clusterMisses = 0;
+        }
+        clusterMisses += misses;
+        if (t + 1 < triangleCount && t > clusterStart
+            && (float)clusterMisses / (t + 1 - clusterStart) <= meshAcmr * threshold) {
+            starts.push_back(t + 1);
+            clusterStart = t + 1;
+            clusterMisses = 0;
+        }
+    }
+    starts.erase(std::unique(starts.begin(), starts.end()), starts.end());
+    starts.push_back(triangleCount);
+
+    //area weighted centroid and normal of each cluster and of the whole mesh
+    struct Cluster {
+        size_t First;
+        size_t Last;
+        float Key;
+    };
+    std::vector<Cluster> clusters(starts.size() - 1);
+    std::vector<glm::vec3> centroids(clusters.size(), glm::vec3(0.0f));
+    std::vector<glm::vec3> normals(clusters.size(), glm::vec3(0.0f));
+    glm::vec3 meshCentroid(0.0f);
+    float meshArea = 0.0f;
+    for (size_t k = 0; k + 1 < starts.size(); ++k) {
+        float clusterArea = 0.0f;
+        for (size_t t = starts[k]; t < starts[k + 1]; ++t) {
+            glm::vec3 corner[3];
+            for (int c = 0; c < 3; ++c) {
+                const float* position = vertices + (size_t)indices[t * 3 + c] * stride;
+                corner[c] = glm::vec3(position[0], position[1], position[2]);
+            }
+            glm::vec3 normal = glm::cross(corner[1] - corner[0], corner[2] - corner[0]);
+            float area = glm::length(normal);
+            glm::vec3 center = (corner[0] + corner[1] + corner[2]) / 3.0f;
+            centroids[k] += center * area;
+            normals[k] += normal;
+            clusterArea += area;
+        }
+        meshCentroid += centroids[k];
+        meshArea += clusterArea;
+        centroids[k] = clusterArea > 0.0f ? centroids[k] / clusterArea : centroids[k];
+        clusters[k].First = starts[k];
+        clusters[k].Last = starts[k + 1];
+    }
+    meshCentroid = meshArea > 0.0f ? meshCentroid / meshArea : meshCentroid;
+
+    for (size_t k = 0; k < clusters.size(); ++k) {
+        float length = glm::length(normals[k]);
+        clusters[k].Key = length > 0.0f ? glm::dot(centroids[k] - meshCentroid, normals[k] / length) : 0.0f;
+    }
+    std::stable_sort(clusters.begin(), clusters.end(), [](const Cluster& a, const Cluster& b) {
+        return a.Key > b.Key;
+    });
+
+    std::vector<uint32_t> result;
+    result.reserve(triangleCount * 3);
+    for (const Cluster& cluster : clusters) {
+        result.insert(result.end(), indices.begin() + cluster.First * 3, indices.begin() + cluster.Last * 3);
+    }
+    indices.swap(result);
+}
+
+//--- vertex fetch ---
+
+//renumbers vertices in the order the indices first use them so fetches walk the buffer forward,
+//vertices nothing references are dropped
+inline void OptimizeVertexFetch(std::vector<float>& vertices, int stride, std::vector<uint32_t>& indices)
+{
+    const size_t vertexCount = vertices.size() / stride;
+    const uint32_t unused = ~0u;
+    std::vector<uint32_t> remap(vertexCount, unused);
+    std::vector<float> result;
+    result.reserve(vertices.size());
+    for (uint32_t& index : indices) {
+        if (remap[index] == unused) {
+            remap[index] = (uint32_t)(result.size() / stride);
+            result.insert(result.end(), vertices.begin() + (size_t)index * stride, vertices.begin() + ((size_t)index + 1) * stride);
+        }
+        index = remap[index];
+    }
+    vertices.swap(result);
+}
+
+//--- meshlets ---
+
+inline void MeshletBounds(const std::vector<uint32_t>& indices, const float* vertices, int stride, Meshlet& meshlet)
+{
+    glm::vec3 boundsMin(FLT_MAX), boundsMax(-FLT_MAX);
+    glm::vec3 axis(0.0f);
+    std::vector<glm::vec3> normals;
+    for (uint32_t i = meshlet.FirstIndex; i < meshlet.FirstIndex + meshlet.IndexCount; i += 3) {
+        glm::vec3 corner[3];
+        for (int c = 0; c < 3; ++c) {
+            const float* position = vertices + (size_t)indices[i + c] * stride;
+            corner[c] = glm::vec3(position[0], position[1], position[2]);
+            boundsMin = glm::min(boundsMin, corner[c]);
+            boundsMax = glm::max(boundsMax, corner[c]);
+        }
+        glm::vec3 normal = glm::cross(corner[1] - corner[0], corner[2] - corner[0]);
+        float length = glm::length(normal);
+        if (length > 0.0f) {
+            normals.push_back(normal / length);
+            axis += normal / length;
+        }
+    }
+
+    meshlet.Center = (boundsMin + boundsMax) * 0.5f;
+    meshlet.Radius = 0.0f;
+    for (uint32_t i = meshlet.FirstIndex; i < meshlet.FirstIndex + meshlet.IndexCount; ++i) {
+        const float* position = vertices + (size_t)indices[i] * stride;
+        meshlet.Radius = std::max(meshlet.Radius, glm::length(glm::vec3(position[0], position[1], position[2]) - meshlet.Center));
+    }
+
+    //the cone holds every triangle normal, cutoff is the sine of its half angle
+    float axisLength = glm::length(axis);
+    meshlet.ConeAxis = axisLength > 0.0f ? axis / axisLength : glm::vec3(0.0f, 0.0f, 1.0f);
+    float minDot = axisLength > 0.0f ? 1.0f : -1.0f;
+    for (const glm::vec3& normal : normals) {
+        minDot = std::min(minDot, glm::dot(normal, meshlet.ConeAxis));
+    }
+    meshlet.ConeCutoff = minDot <= 0.0f ? 1.0f : sqrtf(1.0f - minDot * minDot);
+}
+
+//splits the index buffer, in its current order, into runs within the meshlet limits
+inline void BuildMeshlets(const std::vector<uint32_t>& indices, const float* vertices, int stride, size_t vertexCount,
+    std::vector<Meshlet>& meshlets)
+{
+    meshlets.clear();
+    std::vector<uint32_t> seenBy(vertexCount, ~0u);
+    Meshlet current = {};
+    for (size_t i = 0; i + 2 < indices.size(); i += 3) {
+        uint32_t added = 0;
+        for (int c = 0; c < 3; ++c) {
+            added += seenBy[indices[i + c]] != (uint32_t)meshlets.size() ? 1 : 0;
+        }
+        if (current.IndexCount > 0 && (current.VertexCount + added > MESHLET_MAX_VERTICES
+            || current.IndexCount / 3 + 1 > MESHLET_MAX_TRIANGLES)) {
+            MeshletBounds(indices, vertices, stride, current);
+            meshlets.push_back(current);
+            current = Meshlet();
+            current.FirstIndex = (uint32_t)i;
+        }
+        for (int c = 0; c < 3; ++c) {
+            uint32_t& seen = seenBy[indices[i + c]];
+            if (seen != (uint32_t)meshlets.size()) {
+                seen = (uint32_t)meshlets.size();
+                ++current.VertexCount;
+            }
+        }
+        current.IndexCount += 3;
+    }
+    if (current.IndexCount > 0) {
+        MeshletBounds(indices, vertices, stride, current);
+        meshlets.push_back(current);
+    }
+}
+
+//--- pipeline ---
+
+//welds a non indexed triangle list and orders it for the vertex cache, then for overdraw, then for
+//vertex fetch, and cuts the result into meshlets
+inline void OptimizeMesh(const float* vertices, size_t vertexCount, int stride, OptimizedMesh& mesh)
+{
+    WeldVertices(vertices, vertexCount - vertexCount % 3, stride, mesh.Vertices, mesh.Indices);
+    const size_t uniqueCount = mesh.Vertices.size() / stride;
+    mesh.Before = AnalyzeVertexCache(mesh.Indices.data(), mesh.Indices.size(), uniqueCount);
+
+    OptimizeVertexCache(mesh.Indices, uniqueCount);
+    OptimizeOverdraw(mesh.Indices, mesh.Vertices.data(), stride, uniqueCount);
+    OptimizeVertexFetch(mesh.Vertices, stride, mesh.Indices);
+
+    mesh.After = AnalyzeVertexCache(mesh.Indices.data(), mesh.Indices.size(), mesh.Vertices.size() / stride);
+    BuildMeshlets(mesh.Indices, mesh.Vertices.data(), stride, mesh.Vertices.size() / stride, mesh.Meshlets);
+}
+#endif
@@ -0,0 +1,180 @@
+#ifndef OCCLUSION_H
+#define OCCLUSION_H
+
+#include <GL/glew.h>
+#include <glm/glm.hpp>
+#include <glm/gtc/matrix_transform.hpp>
+#include <glm/gtc/type_ptr.hpp>
+
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+
+#include "glstate.h"
+
+//occlusion query values
+const float OCCLUSION_BOX_MARGIN = 1.01f;   // proxies are grown a little so they never sit behind their own object
+
+//objects the culling removed, summed over the run
+struct OcclusionStats {
+    uint64_t Frames;
+    uint64_t Objects;           // every object, every frame
+    uint64_t FrustumCulled;
+    uint64_t OcclusionCulled;   // skipped by a conditional draw whose query had come back empty
+    uint64_t Tested;            // proxy boxes drawn
+};
+
+//hardware occlusion culling with a frame of latency. each visible object is drawn conditionally on
+//the query its bounding box ran the frame before, and after the scene its box is drawn again, without
+//writing anything, into a new query against this frame's depth. GL_QUERY_NO_WAIT draws the object
+//anyway if the result isn't back yet, so the CPU never waits on the GPU. something that comes out
+//from behind an occluder can be missing for that one frame. the box program is compiled by the caller
+class OcclusionCulling {
+public:
+    bool Enabled;
+
+    OcclusionCulling() : Enabled(true), program(0), vao(0), vbo(0), ebo(0), transformLocation(-1), frame(1), stats() {}
+
+    //program takes a position at location 0 and a boxTransform matrix, and writes no color
+    void Create(GLStateCache& state, GLuint boxProgram) {
+        program = boxProgram;
+        transformLocation = glGetUniformLocation(program, "boxTransform");
+
+        //corners of the -1..1 cube, and its 12 triangles
+        const GLfloat corners[] = {
+            -1.0f, -1.0f, -1.0f,   1.0f, -1.0f, -1.0f,   -1.0f, 1.0f, -1.0f,   1.0f, 1.0f, -1.0f,
+            -1.0f, -1.0f, 1.0f,    1.0f, -1.0f, 1.0f,    -1.0f, 1.0f, 1.0f,    1.0f, 1.0f, 1.0f
+        };
+        const GLubyte triangles[] = {
+            0, 2, 1, 1, 2, 3,   4, 5, 6, 5, 7, 6,   0, 1, 4, 1, 5, 4,
+            2, 6, 3, 3, 6, 7,   0, 4, 2, 2, 4, 6,   1, 3, 5, 3, 7, 5
+        };
+        glGenVertexArrays(1, &vao);
+        state.BindVertexArray(vao);
+        glGenBuffers(1, &vbo);
+        glBindBuffer(GL_ARRAY_BUFFER, vbo);
+        glBufferData(GL_ARRAY_BUFFER, sizeof(corners), corners, GL_STATIC_DRAW);
+        glGenBuffers(1, &ebo);
+        glBindBuffer(GL_ELEMENT_ARRAY_BUFFER, ebo);
+        glBufferData(GL_ELEMENT_ARRAY_BUFFER, sizeof(triangles), triangles, GL_STATIC_DRAW);
+        glVertexAttribPointer(0, 3, GL_FLOAT, GL_FALSE, 3 * sizeof(GLfloat), nullptr);
+        glEnableVertexAttribArray(0);
+        state.BindVertexArray(0);
+        glBindBuffer(GL_ARRAY_BUFFER, 0);
+    }
+
+    void Destroy() {
+        for (Query& query : queries) {
+            glDeleteQueries(1, &query.Id);
+        }
+        queries.clear();
+        glDeleteVertexArrays(1, &vao);
+        glDeleteBuffers(1, &vbo);
+        glDeleteBuffers(1, &ebo);
+        vao = vbo = ebo = 0;
+    }
+
+    //one query per object that can be drawn, objects are identified by their index below this
+    void Resize(size_t objectCount) {
+        size_t first = queries.size();
+        queries.resize(objectCount);
+        for (size_t i = first; i < objectCount; ++i) {
+            glGenQueries(1, &queries[i].Id);
+        }
+    }
+
+    //starts a frame of objectCount objects of which frustumCulled were outside the view
+    void BeginFrame(size_t objectCount, size_t frustumCulled) {
+        ++frame;
+        ++stats.Frames;
+        stats.Objects += objectCount;
+        stats.FrustumCulled += frustumCulled;
+    }
+
+    //starts the object's conditional draw, false when it wasn't tested last frame and is drawn as usual
+    bool BeginDraw(uint32_t object) {
+        Query& query = queries[object];
+        if (!Enabled || query.Frame + 1 != frame) {
+            return false;
+        }
+
+        //only a result that has already come back is counted, the conditional draw uses the same one
+        GLint available = 0;
+        glGetQueryObjectiv(query.Id, GL_QUERY_RESULT_AVAILABLE, &available);
+        if (available) {
+            GLuint passed = 0;
+            glGetQueryObjectuiv(query.Id, GL_QUERY_RESULT, &passed);
+            if (passed == 0) {
+                ++stats.OcclusionCulled;
+            }
+        }
+        glBeginConditionalRender(query.Id, GL_QUERY_NO_WAIT);
+        return true;
+    }
+
+    void EndDraw(bool conditional) {
+        if (conditional) {
+            glEndConditionalRender();
+        }
+    }
+
+    //proxies test depth without writing color or depth
+    void BeginTests(GLStateCache& state) {
+        state.UseProgram(program);
+        state.BindVertexArray(vao);
+        glColorMask(GL_FALSE, GL_FALSE, GL_FALSE, GL_FALSE);
+        glDepthMask(GL_FALSE);
+        glDepthFunc(GL_LEQUAL);
+    }
+
+    //queries whether any of the object's local bounding box would be visible in this frame's depth
+    void Test(uint32_t object, const glm::mat4& modelViewProjection, const glm::vec3& boundsMin, const glm::vec3& boundsMax) {
+        glm::vec3 center = (boundsMin + boundsMax) * 0.5f;
+        glm::vec3 extent = (boundsMax - boundsMin) * 0.5f * OCCLUSION_BOX_MARGIN + glm::vec3(1.0e-4f);
+        glm::mat4 transform = modelViewProjection * glm::translate(glm::mat4(1.0f), center) * glm::scale(glm::mat4(1.0f), extent);
+
+        //a box reaching through the near plane is clipped open and could pass nothing while the object
+        //is in plain view, such objects skip the test and are drawn next frame
+        for (int i = 0; i < 8; ++i) {
+            glm::vec4 clip = transform * glm::vec4((i & 1) ? 1.0f : -1.0f, (i & 2) ? 1.0f : -1.0f, (i & 4) ? 1.0f : -1.0f, 1.0f);
+            if (clip.z < -clip.w) {
+                return;
+            }
+        }
+
+        Query& query = queries[object];
+        glUniformMatrix4fv(transformLocation, 1, GL_FALSE, glm::value_ptr(transform));
+        glBeginQuery(GL_ANY_SAMPLES_PASSED_CONSERVATIVE, query.Id);
+        glDrawElements(GL_TRIANGLES, 36, GL_UNSIGNED_BYTE, nullptr);
+        glEndQuery(GL_ANY_SAMPLES_PASSED_CONSERVATIVE);
+        query.Frame = frame;
+        ++stats.Tested;
+    }
+
+    void EndTests() {
+        glColorMask(GL_TRUE, GL_TRUE, GL_TRUE, GL_TRUE);
+        glDepthMask(GL_TRUE);
+        glDepthFunc(GL_LESS);
+    }
+
+    const OcclusionStats& Stats() const {
+        return stats;
+    }
+
+private:
+    struct Query {
+        GLuint Id;
+        uint64_t Frame;     // when it was last issued, 0 for never
+    };
+
+    GLuint program;
+    GLuint vao;
+    GLuint vbo;
+    GLuint ebo;
+    GLint transformLocation;
+
+    std::vector<Query> queries;
+    uint64_t frame;
+    OcclusionStats stats;
+};
+#endif
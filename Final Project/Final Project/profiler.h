@@ -0,0 +1,442 @@
+#ifndef PROFILER_H
+#define PROFILER_H
+
+#include <GL/glew.h>
+
+#include <algorithm>
+#include <chrono>
+#include <cstdint>
+#include <cstring>
+#include <fstream>
+#include <memory>
+#include <mutex>
+#include <sstream>
+#include <string>
+#include <unordered_map>
+#include <vector>
+
+//set to 0 to compile every marker out, the scopes then cost nothing at all
+#ifndef PROFILER_ENABLED
+#define PROFILER_ENABLED 1
+#endif
+
+//profiler values
+const int PROFILER_GPU_FRAMES = 4;                  // frames of timer queries in flight before results are read back
+const int PROFILER_GPU_RANGES = 256;                // timed GPU ranges per frame, past this they're skipped
+const size_t PROFILER_MAX_CAPTURED = 1 << 20;       // events kept for the trace file
+const double PROFILER_STAT_SMOOTHING = 0.05;        // weight of the newest frame in the rolling averages
+const uint32_t PROFILER_GPU_THREAD = 0xffffffffu;   // thread id GPU events are filed under
+
+//one timed range, times are nanoseconds since the profiler started
+struct ProfileEvent {
+    const char* Name;
+    int64_t Start;
+    int64_t End;
+    uint32_t Depth;
+    uint32_t Thread;
+};
+
+//rolling timings for everything recorded under one name, in milliseconds per frame
+struct ProfileStat {
+    const char* Name;
+    uint32_t Depth;     // nesting of the first occurrence, used to indent the overlay
+    double Cpu;
+    double CpuMax;      // decays slowly so a spike stays visible for a while
+    double Gpu;
+    double CpuFrame;    // totals for the frame being recorded
+    double GpuFrame;
+    bool HasGpu;
+};
+
+//markers recorded by one thread, each thread only ever appends to its own
+struct ProfileThread {
+    std::vector<ProfileEvent> Events;
+    uint32_t Index;
+    uint32_t Depth;
+};
+
+//collects nested CPU ranges from any thread and GPU ranges from the GL thread. GPU ranges are
+//timestamp queries kept in a ring a few frames deep, so they are read back once the GPU has
+//long finished with them and never make the CPU wait
+class Profiler {
+public:
+    bool Enabled;       // recording at all, markers are a single branch when this is off
+    bool Capture;       // keep every event for WriteTrace
+
+    static Profiler& Instance() {
+        static Profiler profiler;
+        return profiler;
+    }
+
+    //call with the GL context current. gpu = false keeps to CPU markers
+    void Initialize(bool gpu) {
+        Enabled = Enabled && PROFILER_ENABLED;
+        if (!Enabled) {
+            return;
+        }
+
+        if (gpu) {
+            for (GpuFrame& frame : gpuFrames) {
+                frame.Queries.resize(PROFILER_GPU_RANGES * 2);
+                glGenQueries((GLsizei)frame.Queries.size(), frame.Queries.data());
+            }
+            //lines GPU timestamps up with the CPU clock, drift over a run is small enough to ignore
+            GLint64 gpuNow = 0;
+            glGetInteger64v(GL_TIMESTAMP, &gpuNow);
+            gpuOffset = Now() - gpuNow;
+            gpuEnabled = true;
+        }
+
+        measureOverhead();
+    }
+
+    void Shutdown() {
+        if (gpuEnabled) {
+            for (GpuFrame& frame : gpuFrames) {
+                glDeleteQueries((GLsizei)frame.Queries.size(), frame.Queries.data());
+                frame.Queries.clear();
+            }
+            gpuEnabled = false;
+        }
+    }
+
+    int64_t Now() const {
+        return std::chrono::duration_cast<std::chrono::nanoseconds>(Clock::now() - epoch).count();
+    }
+
+    //--- frame boundaries, called from the main thread ---
+
+    void BeginFrame() {
+        if (!Enabled) {
+            return;
+        }
+        frameStart = Now();
+
+        //the oldest slot is reused, anything it still holds is read back first
+        if (gpuEnabled) {
+            GpuFrame& frame = gpuFrames[frameIndex % PROFILER_GPU_FRAMES];
+            readGpuFrame(frame);
+            frame.Ranges.clear();
+        }
+        gpuDepth = 0;
+    }
+
+    //gathers the frame's markers. the other threads must be idle, which they are once the frame graph is done
+    void EndFrame() {
+        if (!Enabled) {
+            return;
+        }
+
+        ProfileEvent frame = { "frame", frameStart, Now(), 0, threadState().Index };
+        record(frame);
+        {
+            std::lock_guard<std::mutex> lock(threadsMutex);
+            for (std::unique_ptr<ProfileThread>& thread : threads) {
+                //scopes are recorded as they close, sorting by start puts parents ahead of their children
+                std::sort(thread->Events.begin(), thread->Events.end(), [](const ProfileEvent& a, const ProfileEvent& b) {
+                    return a.Start < b.Start;
+                });
+                frameMarkers += thread->Events.size();
+                for (const ProfileEvent& event : thread->Events) {
+                    addCpu(event);
+                }
+                thread->Events.clear();
+            }
+        }
+
+        for (ProfileStat& stat : stats) {
+            fold(stat.Cpu, stat.CpuFrame);
+            stat.CpuMax = std::max(stat.CpuFrame, stat.CpuMax * (1.0 - PROFILER_STAT_SMOOTHING));
+            stat.CpuFrame = 0.0;
+        }
+        ++frameIndex;
+    }
+
+    //--- markers, normally through the PROFILE_ macros ---
+
+    ProfileThread& threadState() {
+        static thread_local ProfileThread* state = nullptr;
+        if (state == nullptr) {
+            std::lock_guard<std::mutex> lock(threadsMutex);
+            threads.emplace_back(new ProfileThread());
+            state = threads.back().get();
+            state->Index = (uint32_t)threads.size() - 1;
+            state->Depth = 1;   // everything nests inside the frame
+        }
+        return *state;
+    }
+
+    void record(const ProfileEvent& event) {
+        threadState().Events.push_back(event);
+    }
+
+    //starts a GPU range, returns its slot or -1 when the frame has no queries left
+    int BeginGpu(const char* name) {
+        if (!gpuEnabled) {
+            return -1;
+        }
+        GpuFrame& frame = gpuFrames[frameIndex % PROFILER_GPU_FRAMES];
+        if (frame.Ranges.size() >= PROFILER_GPU_RANGES) {
+            ++gpuSkipped;
+            return -1;
+        }
+        int range = (int)frame.Ranges.size();
+        frame.Ranges.push_back(GpuRange{ name, gpuDepth++ });
+        glQueryCounter(frame.Queries[range * 2], GL_TIMESTAMP);
+        return range;
+    }
+
+    void EndGpu(int range) {
+        if (range < 0) {
+            return;
+        }
+        GpuFrame& frame = gpuFrames[frameIndex % PROFILER_GPU_FRAMES];
+        glQueryCounter(frame.Queries[range * 2 + 1], GL_TIMESTAMP);
+        --gpuDepth;
+    }
+
+    //--- results ---
+
+    //rolling stats as text, one line per name in first seen order
+    std::string Summary() const {
+        std::ostringstream text;
+        text.setf(std::ios::fixed);
+        text.precision(2);
+        for (const ProfileStat& stat : stats) {
+            text << std::string(stat.Depth * 2, ' ') << stat.Name << "  cpu " << stat.Cpu << " ms (max " << stat.CpuMax << ")";
+            if (stat.HasGpu) {
+                text << "  gpu " << stat.Gpu << " ms";
+            }
+            text << "\n";
+        }
+        return text.str();
+    }
+
+    //stats for a marker name, null until it has been recorded
+    const ProfileStat* Find(const char* name) const {
+        for (const ProfileStat& stat : stats) {
+            if (strcmp(stat.Name, name) == 0) {
+                return &stat;
+            }
+        }
+        return nullptr;
+    }
+
+    const std::vector<ProfileStat>& Stats() const {
+        return stats;
+    }
+
+    //cost of one marker measured at startup, and how many markers a frame records on average
+    double MarkerCost() const {
+        return markerCost;
+    }
+
+    double MarkersPerFrame() const {
+        return frameIndex > 0 ? (double)frameMarkers / frameIndex : 0.0;
+    }
+
+    uint64_t GpuRangesSkipped() const {
+        return gpuSkipped;
+    }
+
+    uint64_t GpuFramesDropped() const {
+        return gpuDropped;
+    }
+
+    //captured events as Chrome trace JSON, which Perfetto and chrome://tracing both open
+    bool WriteTrace(const char* filename) const {
+        std::ofstream file(filename);
+        if (!file) {
+            return false;
+        }
+
+        file << "{\"displayTimeUnit\":\"ms\",\"traceEvents\":[\n";
+        file << "{\"name\":\"thread_name\",\"ph\":\"M\",\"pid\":1,\"tid\":" << PROFILER_GPU_THREAD << ",\"args\":{\"name\":\"GPU\"}}";
+        for (size_t i = 0; i < threads.size(); ++i) {
+            file << ",\n{\"name\":\"thread_name\",\"ph\":\"M\",\"pid\":1,\"tid\":" << i << ",\"args\":{\"name\":\""
+                << (i == 0 ? "main" : "worker") << " " << i << "\"}}";
+        }
+        file.setf(std::ios::fixed);
+        file.precision(3);
+        for (const ProfileEvent& event : captured) {
+            file << ",\n{\"name\":\"" << event.Name << "\",\"ph\":\"X\",\"pid\":1,\"tid\":" << event.Thread
+                << ",\"ts\":" << event.Start / 1000.0 << ",\"dur\":" << (event.End - event.Start) / 1000.0 << "}";
+        }
+        file << "\n]}\n";
+        return (bool)file;
+    }
+
+    size_t CapturedEvents() const {
+        return captured.size();
+    }
+
+private:
+    typedef std::chrono::steady_clock Clock;
+
+    struct GpuRange {
+        const char* Name;
+        uint32_t Depth;
+    };
+
+    struct GpuFrame {
+        std::vector<GLuint> Queries;    // start and end timestamp for each range
+        std::vector<GpuRange> Ranges;
+    };
+
+    Clock::time_point epoch;
+    int64_t frameStart;
+    uint64_t frameIndex;
+    uint64_t frameMarkers;
+    double markerCost;
+
+    std::mutex threadsMutex;
+    std::vector<std::unique_ptr<ProfileThread>> threads;
+
+    std::vector<ProfileStat> stats;
+    std::unordered_map<const char*, size_t> statIndex;
+    std::vector<ProfileEvent> captured;
+
+    GpuFrame gpuFrames[PROFILER_GPU_FRAMES];
+    bool gpuEnabled;
+    uint32_t gpuDepth;
+    int64_t gpuOffset;
+    uint64_t gpuSkipped;
+    uint64_t gpuDropped;
+
+    Profiler() : Enabled(false), Capture(false), epoch(Clock::now()), frameStart(0), frameIndex(0), frameMarkers(0), markerCost(0.0),
+        gpuEnabled(false), gpuDepth(0), gpuOffset(0), gpuSkipped(0), gpuDropped(0) {}
+
+    ProfileStat& stat(const char* name, uint32_t depth) {
+        std::unordered_map<const char*, size_t>::iterator found = statIndex.find(name);
+        if (found != statIndex.end()) {
+            return stats[found->second];
+        }
+        statIndex[name] = stats.size();
+        stats.push_back(ProfileStat{ name, depth, 0.0, 0.0, 0.0, 0.0, 0.0, false });
+        return stats.back();
+    }
+
+    static void fold(double& average, double value) {
+        average += (value - average) * PROFILER_STAT_SMOOTHING;
+    }
+
+    void addCpu(const ProfileEvent& event) {
+        stat(event.Name, event.Depth).CpuFrame += (event.End - event.Start) / 1000000.0;
+        if (Capture && captured.size() < PROFILER_MAX_CAPTURED) {
+            captured.push_back(event);
+        }
+    }
+
+    //a slot is read a few frames after it was written, by then the results are normally in.
+    //if the GPU is that far behind the slot's results are dropped rather than waited for
+    void readGpuFrame(GpuFrame& frame) {
+        if (frame.Ranges.empty()) {
+            return;
+        }
+
+        GLint available = 0;
+        glGetQueryObjectiv(frame.Queries[frame.Ranges.size() * 2 - 1], GL_QUERY_RESULT_AVAILABLE, &available);
+        if (!available) {
+            ++gpuDropped;
+            return;
+        }
+
+        for (size_t i = 0; i < frame.Ranges.size(); ++i) {
+            GLuint64 start = 0, end = 0;
+            glGetQueryObjectui64v(frame.Queries[i * 2], GL_QUERY_RESULT, &start);
+            glGetQueryObjectui64v(frame.Queries[i * 2 + 1], GL_QUERY_RESULT, &end);
+
+            ProfileStat& gpuStat = stat(frame.Ranges[i].Name, frame.Ranges[i].Depth);
+            gpuStat.GpuFrame += (double)(end - start) / 1000000.0;
+            gpuStat.HasGpu = true;
+
+            if (Capture && captured.size() < PROFILER_MAX_CAPTURED) {
+                ProfileEvent event = { frame.Ranges[i].Name, (int64_t)start + gpuOffset, (int64_t)end + gpuOffset,
+                    frame.Ranges[i].Depth, PROFILER_GPU_THREAD };
+                captured.push_back(event);
+            }
+        }
+
+        for (ProfileStat& stat : stats) {
+            if (stat.HasGpu) {
+                fold(stat.Gpu, stat.GpuFrame);
+                stat.GpuFrame = 0.0;
+            }
+        }
+    }
+
+    //times a batch of markers against an empty loop so the cost per marker can be reported
+    void measureOverhead();
+};
+
+//times the enclosing block on the calling thread
+class ProfileScope {
+public:
+    explicit ProfileScope(const char* name) : name(name), start(0), depth(0), active(Profiler::Instance().Enabled) {
+        if (active) {
+            Profiler& profiler = Profiler::Instance();
+            depth = profiler.threadState().Depth++;
+            start = profiler.Now();
+        }
+    }
+
+    ~ProfileScope() {
+        if (active) {
+            Profiler& profiler = Profiler::Instance();
+            ProfileThread& thread = profiler.threadState();
+            --thread.Depth;
+            thread.Events.push_back(ProfileEvent{ name, start, profiler.Now(), depth, thread.Index });
+        }
+    }
+
+private:
+    const char* name;
+    int64_t start;
+    uint32_t depth;
+    bool active;
+};
+
+//times the enclosing block on the CPU and the GL commands it issues on the GPU
+class GpuProfileScope {
+public:
+    explicit GpuProfileScope(const char* name) : cpu(name), range(-1) {
+        Profiler& profiler = Profiler::Instance();
+        if (profiler.Enabled) {
+            range = profiler.BeginGpu(name);
+        }
+    }
+
+    ~GpuProfileScope() {
+        Profiler::Instance().EndGpu(range);
+    }
+
+private:
+    ProfileScope cpu;
+    int range;
+};
+
+inline void Profiler::measureOverhead() {
+    const int samples = 100000;
+    ProfileThread& thread = threadState();
+    size_t recorded = thread.Events.size();
+
+    int64_t start = Now();
+    for (int i = 0; i < samples; ++i) {
+        ProfileScope scope("overhead");
+    }
+    int64_t end = Now();
+
+    thread.Events.resize(recorded);
+    markerCost = (double)(end - start) / samples;
+}
+
+#if PROFILER_ENABLED
+#define PROFILE_CONCAT_INNER(a, b) a##b
+#define PROFILE_CONCAT(a, b) PROFILE_CONCAT_INNER(a, b)
+#define PROFILE_SCOPE(name) ProfileScope PROFILE_CONCAT(profileScope, __LINE__)(name)
+#define PROFILE_GPU_SCOPE(name) GpuProfileScope PROFILE_CONCAT(profileScope, __LINE__)(name)
+#else
+#define PROFILE_SCOPE(name)
+#define PROFILE_GPU_SCOPE(name)
+#endif
+#endif
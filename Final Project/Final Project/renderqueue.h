@@ -0,0 +1,172 @@
+#ifndef RENDERQUEUE_H
+#define RENDERQUEUE_H
+
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+#include <unordered_map>
+#include <utility>
+#include <vector>
+
+//passes run in this order, the pass is the top of the sort key
+enum RenderPass {
+    PASS_OPAQUE,
+    PASS_TRANSPARENT    // sorted back to front instead of by state
+};
+
+//sort key layout, from the top bit down: pass | program | material | mesh | depth.
+//opaque draws group by state first and go front to back within a group for early depth rejection
+const int SORT_KEY_PASS_BITS = 4;
+const int SORT_KEY_PROGRAM_BITS = 8;
+const int SORT_KEY_MATERIAL_BITS = 12;
+const int SORT_KEY_MESH_BITS = 16;
+const int SORT_KEY_DEPTH_BITS = 24;
+
+const int SORT_KEY_DEPTH_SHIFT = 0;
+const int SORT_KEY_MESH_SHIFT = SORT_KEY_DEPTH_SHIFT + SORT_KEY_DEPTH_BITS;
+const int SORT_KEY_MATERIAL_SHIFT = SORT_KEY_MESH_SHIFT + SORT_KEY_MESH_BITS;
+const int SORT_KEY_PROGRAM_SHIFT = SORT_KEY_MATERIAL_SHIFT + SORT_KEY_MATERIAL_BITS;
+const int SORT_KEY_PASS_SHIFT = SORT_KEY_PROGRAM_SHIFT + SORT_KEY_PROGRAM_BITS;
+
+inline uint64_t SortKeyField(uint64_t value, int shift, int bits) {
+    return (value & ((1ull << bits) - 1)) << shift;
+}
+
+inline uint32_t SortKeyValue(uint64_t key, int shift, int bits) {
+    return (uint32_t)((key >> shift) & ((1ull << bits) - 1));
+}
+
+//whether walking from one item to the next changes the given field
+inline bool SortKeyChanged(uint64_t key, uint64_t previous, int shift, int bits) {
+    return SortKeyValue(key, shift, bits) != SortKeyValue(previous, shift, bits);
+}
+
+//everything but the depth, fixed for an object so it can be built once
+inline uint64_t MakeStateKey(RenderPass pass, uint32_t program, uint32_t material, uint32_t mesh) {
+    return SortKeyField(pass, SORT_KEY_PASS_SHIFT, SORT_KEY_PASS_BITS)
+        | SortKeyField(program, SORT_KEY_PROGRAM_SHIFT, SORT_KEY_PROGRAM_BITS)
+        | SortKeyField(material, SORT_KEY_MATERIAL_SHIFT, SORT_KEY_MATERIAL_BITS)
+        | SortKeyField(mesh, SORT_KEY_MESH_SHIFT, SORT_KEY_MESH_BITS);
+}
+
+//adds the view depth, 0 at the camera and 1 at the far plane. transparent draws invert it so the
+//farthest comes first
+inline uint64_t AddSortDepth(uint64_t stateKey, float depth) {
+    const uint32_t maxDepth = (1u << SORT_KEY_DEPTH_BITS) - 1;
+    depth = depth < 0.0f ? 0.0f : depth > 1.0f ? 1.0f : depth;
+    uint32_t quantized = (uint32_t)(depth * maxDepth);
+    if (SortKeyValue(stateKey, SORT_KEY_PASS_SHIFT, SORT_KEY_PASS_BITS) == PASS_TRANSPARENT) {
+        quantized = maxDepth - quantized;
+    }
+    return stateKey | SortKeyField(quantized, SORT_KEY_DEPTH_SHIFT, SORT_KEY_DEPTH_BITS);
+}
+
+//hands out small dense ids for GL names and pointers so they fit in the key's fields
+class SortKeyIds {
+public:
+    uint32_t Id(uintptr_t handle) {
+        std::unordered_map<uintptr_t, uint32_t>::iterator found = ids.find(handle);
+        if (found != ids.end()) {
+            return found->second;
+        }
+        uint32_t id = (uint32_t)ids.size();
+        ids[handle] = id;
+        return id;
+    }
+
+private:
+    std::unordered_map<uintptr_t, uint32_t> ids;
+};
+
+//one draw waiting in the queue, Item is whatever the submitter uses to find it again
+struct RenderItem {
+    uint64_t Key;
+    uint32_t Item;
+};
+
+//state switches made while walking a frame's queue
+struct RenderQueueStats {
+    uint32_t Items;
+    uint32_t ProgramSwitches;
+    uint32_t MaterialSwitches;
+    uint32_t MeshSwitches;
+};
+
+//draws for a frame, sorted by key with an LSD radix sort. the sort is linear in the number of
+//draws and skips any byte that is the same in every key, which most of the high ones are
+class RenderQueue {
+public:
+    void Clear() {
+        items.clear();
+    }
+
+    void Submit(uint64_t key, uint32_t item) {
+        items.push_back(RenderItem{ key, item });
+    }
+
+    void Sort() {
+        size_t count = items.size();
+        if (count < 2) {
+            return;
+        }
+
+        //a handful of draws is cheaper to insertion sort than to clear eight histograms for
+        if (count <= INSERTION_SORT_LIMIT) {
+            for (size_t i = 1; i < count; ++i) {
+                RenderItem item = items[i];
+                size_t j = i;
+                for (; j > 0 && items[j - 1].Key > item.Key; --j) {
+                    items[j] = items[j - 1];
+                }
+                items[j] = item;
+            }
+            return;
+        }
+
+        //every byte's histogram in one pass over the keys
+        size_t histograms[8][256];
+        memset(histograms, 0, sizeof(histograms));
+        for (const RenderItem& item : items) {
+            for (int digit = 0; digit < 8; ++digit) {
+                ++histograms[digit][(item.Key >> (digit * 8)) & 0xff];
+            }
+        }
+
+        scratch.resize(count);
+        RenderItem* source = items.data();
+        RenderItem* destination = scratch.data();
+        for (int digit = 0; digit < 8; ++digit) {
+            size_t* histogram = histograms[digit];
+            int shift = digit * 8;
+            if (histogram[(source[0].Key >> shift) & 0xff] == count) {
+                continue;
+            }
+
+            size_t offset = 0;
+            for (int bucket = 0; bucket < 256; ++bucket) {
+                size_t bucketCount = histogram[bucket];
+                histogram[bucket] = offset;
+                offset += bucketCount;
+            }
+            for (size_t i = 0; i < count; ++i) {
+                destination[histogram[(source[i].Key >> shift) & 0xff]++] = source[i];
+            }
+            std::swap(source, destination);
+        }
+
+        if (source != items.data()) {
+            items.swap(scratch);
+        }
+    }
+
+    const std::vector<RenderItem>& Items() const {
+        return items;
+    }
+
+private:
+    static const size_t INSERTION_SORT_LIMIT = 32;
+
+    std::vector<RenderItem> items;
+    std::vector<RenderItem> scratch;
+};
+#endif
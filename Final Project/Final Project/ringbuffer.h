@@ -0,0 +1,189 @@
+#ifndef RINGBUFFER_H
+#define RINGBUFFER_H
+
+#include <GL/glew.h>
+
+#include <chrono>
+#include <cstddef>
+
+//how often the CPU had to stop and wait for the GPU to release a segment
+struct RingBufferStats {
+    unsigned long long Frames = 0;
+    unsigned long long FenceWaits = 0;     // frames that found their segment still in use
+    double WaitTime = 0.0;                 // seconds spent blocked in total
+    double LastWaitTime = 0.0;             // seconds blocked at the start of the latest frame
+    size_t PeakBytesUsed = 0;              // most bytes handed out in a single frame
+    unsigned long long Overflows = 0;      // allocations that didn't fit in the segment
+};
+
+//piece of the ring handed out for one upload
+struct RingAllocation {
+    void* Data;         // where to write, nullptr when the segment is full
+    GLintptr Offset;    // from the start of the buffer, for glBindBufferRange / attribute offsets
+};
+
+//one buffer mapped for the life of the program and split into a segment per frame in flight.
+//each frame writes into its own segment and fences it once the draws are submitted, the segment
+//is only reused after the GPU has passed that fence so nothing ever waits on an implicit sync.
+//the same buffer can be bound as uniform, storage or vertex data so it covers per draw matrices,
+//light lists and instance attributes
+class RingBuffer {
+public:
+    static const int FRAMES_IN_FLIGHT = 3;
+
+    RingBuffer() : buffer(0), mapped(nullptr), segmentSize(0), alignment(256), segment(0), head(0) {
+        for (int i = 0; i < FRAMES_IN_FLIGHT; ++i) {
+            fences[i] = 0;
+        }
+    }
+
+    ~RingBuffer() {
+        Destroy();
+    }
+
+    RingBuffer(const RingBuffer&) = delete;
+    RingBuffer& operator=(const RingBuffer&) = delete;
+
+    //allocates bytesPerFrame for every frame in flight, needs a current GL 4.4 context
+    bool Create(size_t bytesPerFrame) {
+        Destroy();
+
+        alignment = OffsetAlignment();
+        segmentSize = alignUp(bytesPerFrame);
+        GLsizeiptr totalSize = (GLsizeiptr)(segmentSize * FRAMES_IN_FLIGHT);
+
+        //coherent so writes are visible without explicit flushes
+        const GLbitfield flags = GL_MAP_WRITE_BIT | GL_MAP_PERSISTENT_BIT | GL_MAP_COHERENT_BIT;
+        glGenBuffers(1, &buffer);
+        glBindBuffer(GL_COPY_WRITE_BUFFER, buffer);
+        glBufferStorage(GL_COPY_WRITE_BUFFER, totalSize, nullptr, flags);
+        mapped = (unsigned char*)glMapBufferRange(GL_COPY_WRITE_BUFFER, 0, totalSize, flags);
+        glBindBuffer(GL_COPY_WRITE_BUFFER, 0);
+
+        if (!mapped) {
+            Destroy();
+            return false;
+        }
+
+        segment = 0;
+        head = 0;
+        return true;
+    }
+
+    void Destroy() {
+        for (int i = 0; i < FRAMES_IN_FLIGHT; ++i) {
+            if (fences[i]) {
+                glDeleteSync(fences[i]);
+                fences[i] = 0;
+            }
+        }
+
+        if (buffer) {
+            if (mapped) {
+                glBindBuffer(GL_COPY_WRITE_BUFFER, buffer);
+                glUnmapBuffer(GL_COPY_WRITE_BUFFER);
+                glBindBuffer(GL_COPY_WRITE_BUFFER, 0);
+            }
+            glDeleteBuffers(1, &buffer);
+        }
+
+        buffer = 0;
+        mapped = nullptr;
+    }
+
+    //uniform buffer offsets have the strictest alignment, every allocation is rounded up to it
+    static size_t OffsetAlignment() {
+        GLint uniformAlignment = 256;
+        glGetIntegerv(GL_UNIFORM_BUFFER_OFFSET_ALIGNMENT, &uniformAlignment);
+        return uniformAlignment > 0 ? (size_t)uniformAlignment : 256;
+    }
+
+    //what an allocation of size bytes takes out of a segment, for sizing one before Create
+    static size_t AllocationSize(size_t size) {
+        size_t offsetAlignment = OffsetAlignment();
+        return (size + offsetAlignment - 1) / offsetAlignment * offsetAlignment;
+    }
+
+    GLuint Buffer() const {
+        return buffer;
+    }
+
+    size_t Alignment() const {
+        return alignment;
+    }
+
+    const RingBufferStats& Stats() const {
+        return stats;
+    }
+
+    //moves to the next segment, blocking only if the GPU is still reading it from three frames ago
+    void BeginFrame() {
+        segment = (segment + 1) % FRAMES_IN_FLIGHT;
+        head = 0;
+        stats.LastWaitTime = 0.0;
+        ++stats.Frames;
+
+        GLsync fence = fences[segment];
+        if (!fence) {
+            return;
+        }
+
+        //poll first, the common case is the GPU finished long ago
+        GLenum result = glClientWaitSync(fence, 0, 0);
+        if (result == GL_TIMEOUT_EXPIRED) {
+            ++stats.FenceWaits;
+
+            std::chrono::steady_clock::time_point before = std::chrono::steady_clock::now();
+            do {
+                //flush so the fence can actually be reached
+                result = glClientWaitSync(fence, GL_SYNC_FLUSH_COMMANDS_BIT, 1000000);
+            } while (result == GL_TIMEOUT_EXPIRED);
+
+            stats.LastWaitTime = std::chrono::duration<double>(std::chrono::steady_clock::now() - before).count();
+            stats.WaitTime += stats.LastWaitTime;
+        }
+
+        glDeleteSync(fence);
+        fences[segment] = 0;
+    }
+
+    //space for size bytes in this frame's segment. offsets are aligned for glBindBufferRange
+    RingAllocation Allocate(size_t size) {
+        size_t aligned = alignUp(size);
+        if (!mapped || head + aligned > segmentSize) {
+            ++stats.Overflows;
+            return RingAllocation{ nullptr, 0 };
+        }
+
+        size_t offset = segment * segmentSize + head;
+        head += aligned;
+        if (head > stats.PeakBytesUsed) {
+            stats.PeakBytesUsed = head;
+        }
+        return RingAllocation{ mapped + offset, (GLintptr)offset };
+    }
+
+    //call after the last draw reading this frame's data has been submitted
+    void EndFrame() {
+        if (buffer) {
+            fences[segment] = glFenceSync(GL_SYNC_GPU_COMMANDS_COMPLETE, 0);
+        }
+    }
+
+private:
+    GLuint buffer;
+    unsigned char* mapped;
+    size_t segmentSize;
+    size_t alignment;
+
+    int segment;    // segment the current frame writes to
+    size_t head;    // bytes used in it so far
+
+    GLsync fences[FRAMES_IN_FLIGHT];
+    RingBufferStats stats;
+
+    size_t alignUp(size_t size) const {
+        return (size + alignment - 1) / alignment * alignment;
+    }
+};
+#endif
@@ -0,0 +1,596 @@
+#ifndef SOFTRENDER_H
+#define SOFTRENDER_H
+
+#include <glm/glm.hpp>
+
+#include <algorithm>
+#include <cfloat>
+#include <cmath>
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+
+#include "jobsystem.h"
+#include "vertexformat.h"
+
+#if defined(__SSE2__) || defined(_M_X64) || (defined(_M_IX86_FP) && _M_IX86_FP >= 2)
+#define SOFTRENDER_SSE 1
+#include <emmintrin.h>
+#include <xmmintrin.h>
+#endif
+
+//image kept on the CPU for the software renderer, rows bottom up like a GL texture
+struct SoftTexture {
+    int Width = 0;
+    int Height = 0;
+    int Channels = 0;
+    std::vector<unsigned char> Texels;
+};
+
+struct SoftLight {
+    glm::vec3 Position;
+    glm::vec3 Color;
+};
+
+//renders the scene without a GPU. draws are queued, then EndFrame transforms and bins every
+//triangle into screen tiles and shades the tiles in parallel on the job system. a tile belongs
+//to one job from clear to finish so no locking is needed on the color or depth buffers.
+//matches the GL path: same Phong terms as the cube shader, bilinear GL_REPEAT sampling,
+//GL_LESS depth, pixel centers at +0.5 and no face culling
+class SoftRenderer {
+public:
+    static const int TILE_SIZE = 64;
+    static const int MAX_LIGHTS = 8;
+
+    //screen positions snap to 1/256 of a pixel, the subpixel precision GL implementations commonly use
+    static const int SUBPIXEL_BITS = 8;
+
+    SoftRenderer() : width(0), height(0), tilesX(0), tilesY(0), lightCount(0), totalVertices(0), totalIndices(0) {}
+
+    void Resize(int newWidth, int newHeight) {
+        if (newWidth == width && newHeight == height) {
+            return;
+        }
+        width = std::max(newWidth, 1);
+        height = std::max(newHeight, 1);
+        tilesX = (width + TILE_SIZE - 1) / TILE_SIZE;
+        tilesY = (height + TILE_SIZE - 1) / TILE_SIZE;
+
+        //a group of four pixels at the right edge may read past the last row
+        color.assign((size_t)width * height + 4, 0);
+        depth.assign((size_t)width * height + 4, 1.0f);
+    }
+
+    int Width() const {
+        return width;
+    }
+
+    int Height() const {
+        return height;
+    }
+
+    //RGBA8, bottom row first, same layout as glReadPixels
+    const uint32_t* Pixels() const {
+        return color.data();
+    }
+
+    void BeginFrame(const glm::mat4& view, const glm::mat4& projection, const glm::vec3& cameraPosition,
+        const SoftLight* frameLights, int frameLightCount, const glm::vec3& clear) {
+        viewProjection = projection * view;
+        viewPosition = cameraPosition;
+        lightCount = std::min(frameLightCount, MAX_LIGHTS);
+        for (int i = 0; i < lightCount; ++i) {
+            lights[i] = frameLights[i];
+        }
+        clearColor = packColor(clear);
+        draws.clear();
+        totalVertices = 0;
+        totalIndices = 0;
+    }
+
+    //queues an indexed triangle list, 8 floats per vertex (position, normal, uv). null indices draw
+    //the vertices as a plain triangle list. vertices, indices and texture have to stay alive until
+    //EndFrame. unlit draws come out white like the lamp shader
+    void Draw(const float* vertices, size_t vertexCount, const uint32_t* indices, size_t indexCount,
+        const glm::mat4& model, const SoftTexture* texture, const glm::vec2& uvScale, bool lit) {
+        DrawCall draw;
+        draw.Vertices = vertices;
+        draw.Packed = nullptr;
+        draw.PositionModel = model;
+        draw.VertexCount = vertexCount;
+        draw.FirstVertex = totalVertices;
+        draw.Indices = indices;
+        draw.IndexCount = indices ? indexCount - indexCount % 3 : vertexCount - vertexCount % 3;
+        draw.FirstIndex = totalIndices;
+        draw.Model = model;
+        draw.NormalMatrix = glm::transpose(glm::inverse(glm::mat3(model)));
+        draw.Texture = texture && !texture->Texels.empty() ? texture : nullptr;
+        draw.UVScale = uvScale;
+        draw.Lit = lit;
+        draws.push_back(draw);
+        totalVertices += draw.VertexCount;
+        totalIndices += draw.IndexCount;
+    }
+
+    //same for 16 byte packed vertices, half the memory the vertex stage has to read. the position
+    //decode is folded into the model matrix so it costs nothing per vertex
+    void Draw(const PackedVertex* vertices, size_t vertexCount, const uint32_t* indices, size_t indexCount,
+        const glm::vec3& positionOffset, const glm::vec3& positionScale,
+        const glm::mat4& model, const SoftTexture* texture, const glm::vec2& uvScale, bool lit) {
+        Draw((const float*)nullptr, vertexCount, indices, indexCount, model, texture, uvScale, lit);
+        DrawCall& draw = draws.back();
+        draw.Packed = vertices;
+        glm::mat4 decode(1.0f);
+        for (int i = 0; i < 3; ++i) {
+            decode[i][i] = positionScale[i] / POSITION_QUANT_MAX;
+            decode[3][i] = positionOffset[i];
+        }
+        draw.PositionModel = model * decode;
+    }
+
+    //renders everything queued since BeginFrame, returns once the image is complete
+    void EndFrame(JobSystem& jobs) {
+        //vertex stage, every vertex on its own so it splits anywhere. shared vertices are done once
+        transformed.resize(totalVertices);
+        for (const DrawCall& draw : draws) {
+            jobs.ParallelFor(draw.VertexCount, 1024, [this, &draw](size_t begin, size_t end) {
+                for (size_t i = begin; i < end; ++i) {
+                    transformVertex(draw, i);
+                }
+            });
+        }
+
+        //setup and binning in contiguous runs of triangles, tiles walk the runs in order so
+        //draw order (and which of two equal depths wins) is the same as on the GPU
+        size_t triangleCount = totalIndices / 3;
+        size_t chunkCount = std::max<size_t>(1, std::min<size_t>(jobs.ThreadCount() * 4, (triangleCount + 255) / 256));
+        if (chunks.size() < chunkCount) {
+            chunks.resize(chunkCount);
+        }
+        size_t tileCount = (size_t)tilesX * tilesY;
+        jobs.ParallelFor(chunkCount, 1, [this, triangleCount, chunkCount, tileCount](size_t begin, size_t end) {
+            for (size_t c = begin; c < end; ++c) {
+                binChunk(chunks[c], triangleCount * c / chunkCount, triangleCount * (c + 1) / chunkCount, tileCount);
+            }
+        });
+
+        jobs.ParallelFor(tileCount, 1, [this, chunkCount](size_t begin, size_t end) {
+            for (size_t tile = begin; tile < end; ++tile) {
+                rasterizeTile((int)tile, chunkCount);
+            }
+        });
+    }
+
+private:
+    struct DrawCall {
+        const float* Vertices;
+        const PackedVertex* Packed;     // set instead of Vertices for packed draws
+        size_t VertexCount;
+        size_t FirstVertex;
+        const uint32_t* Indices;        // null for a plain triangle list
+        size_t IndexCount;
+        size_t FirstIndex;
+        glm::mat4 Model;
+        glm::mat4 PositionModel;        // Model with the packed position decode in front of it
+        glm::mat3 NormalMatrix;
+        const SoftTexture* Texture;
+        glm::vec2 UVScale;
+        bool Lit;
+    };
+
+    //world position, normal and uv, interpolated perspective correct
+    static const int ATTRIBUTES = 8;
+
+    struct ClipVertex {
+        glm::vec4 Clip;
+        float Attributes[ATTRIBUTES];
+    };
+
+    //a triangle ready to rasterize. edge i is opposite vertex i and reads as
+    //twice the signed area of the sub triangle, so edge / area is the barycentric weight.
+    //edges are doubles so they come out exact on the snapped positions
+    struct SetupTriangle {
+        double EdgeA[3];
+        double EdgeB[3];
+        double EdgeC[3];
+        double Threshold[3];        // owned edges count pixels exactly on them, the neighbour's don't
+        float DepthA, DepthB, DepthC;
+        float InverseArea;
+        float InverseW[3];
+        float Attributes[3][ATTRIBUTES];
+        int MinX, MinY, MaxX, MaxY;
+        const DrawCall* Draw;
+    };
+
+    struct Chunk {
+        std::vector<SetupTriangle> Triangles;
+        std::vector<std::vector<uint32_t>> Bins;   // per tile, indices into Triangles
+    };
+
+    int width;
+    int height;
+    int tilesX;
+    int tilesY;
+    std::vector<uint32_t> color;
+    std::vector<float> depth;
+    uint32_t clearColor;
+
+    glm::mat4 viewProjection;
+    glm::vec3 viewPosition;
+    SoftLight lights[MAX_LIGHTS];
+    int lightCount;
+
+    std::vector<DrawCall> draws;
+    size_t totalVertices;
+    size_t totalIndices;
+    std::vector<ClipVertex> transformed;
+    std::vector<Chunk> chunks;
+
+    static uint32_t packColor(const glm::vec3& value) {
+        uint32_t r = (uint32_t)(std::min(std::max(value.x, 0.0f), 1.0f) * 255.0f + 0.5f);
+        uint32_t g = (uint32_t)(std::min(std::max(value.y, 0.0f), 1.0f) * 255.0f + 0.5f);
+        uint32_t b = (uint32_t)(std::min(std::max(value.z, 0.0f), 1.0f) * 255.0f + 0.5f);
+        return r | (g << 8) | (b << 16) | 0xff000000u;
+    }
+
+    void transformVertex(const DrawCall& draw, size_t i) {
+        glm::vec4 world;
+        glm::vec3 normal;
+        glm::vec2 uv;
+        if (draw.Packed) {
+            const PackedVertex& source = draw.Packed[i];
+            world = draw.PositionModel * glm::vec4(source.Position[0], source.Position[1], source.Position[2], 1.0f);
+            normal = draw.NormalMatrix * UnpackSnorm1010102(source.Normal);
+            uv = glm::vec2(HalfToFloat(source.TexCoord[0]), HalfToFloat(source.TexCoord[1]));
+        }
+        else {
+            const float* source = draw.Vertices + i * 8;
+            world = draw.Model * glm::vec4(source[0], source[1], source[2], 1.0f);
+            normal = draw.NormalMatrix * glm::vec3(source[3], source[4], source[5]);
+            uv = glm::vec2(source[6], source[7]);
+        }
+
+        ClipVertex& out = transformed[draw.FirstVertex + i];
+        out.Clip = viewProjection * world;
+        out.Attributes[0] = world.x;
+        out.Attributes[1] = world.y;
+        out.Attributes[2] = world.z;
+        out.Attributes[3] = normal.x;
+        out.Attributes[4] = normal.y;
+        out.Attributes[5] = normal.z;
+        out.Attributes[6] = uv.x * draw.UVScale.x;
+        out.Attributes[7] = uv.y * draw.UVScale.y;
+    }
+
+    //the draw an index of the whole frame belongs to
+    size_t drawForIndex(size_t index) const {
+        size_t low = 0, high = draws.size();
+        while (high - low > 1) {
+            size_t middle = (low + high) / 2;
+            if (draws[middle].FirstIndex <= index) {
+                low = middle;
+            }
+            else {
+                high = middle;
+            }
+        }
+        return low;
+    }
+
+    //clips against one plane, distance > 0 is kept. x and y are left to the screen bounds
+    static int clipPolygon(const ClipVertex* in, int count, ClipVertex* out, float sign) {
+        int outCount = 0;
+        for (int i = 0; i < count; ++i) {
+            const ClipVertex& a = in[i];
+            const ClipVertex& b = in[(i + 1) % count];
+            float da = a.Clip.w + sign * a.Clip.z;
+            float db = b.Clip.w + sign * b.Clip.z;
+
+            if (da >= 0.0f) {
+                out[outCount++] = a;
+            }
+            if ((da >= 0.0f) != (db >= 0.0f)) {
+                float t = da / (da - db);
+                ClipVertex& v = out[outCount++];
+                v.Clip = a.Clip + (b.Clip - a.Clip) * t;
+                for (int k = 0; k < ATTRIBUTES; ++k) {
+                    v.Attributes[k] = a.Attributes[k] + (b.Attributes[k] - a.Attributes[k]) * t;
+                }
+            }
+        }
+        return outCount;
+    }
+
+    void binChunk(Chunk& chunk, size_t first, size_t last, size_t tileCount) {
+        chunk.Triangles.clear();
+        if (chunk.Bins.size() != tileCount) {
+            chunk.Bins.assign(tileCount, std::vector<uint32_t>());
+        }
+        for (std::vector<uint32_t>& bin : chunk.Bins) {
+            bin.clear();
+        }
+
+        //triangles are walked in order so the draw only has to be searched for once
+        size_t drawIndex = first < last ? drawForIndex(first * 3) : 0;
+        for (size_t t = first; t < last; ++t) {
+            while (drawIndex + 1 < draws.size() && draws[drawIndex + 1].FirstIndex <= t * 3) {
+                ++drawIndex;
+            }
+            const DrawCall* draw = &draws[drawIndex];
+            size_t corner = t * 3 - draw->FirstIndex;
+            ClipVertex v[3];
+            for (int c = 0; c < 3; ++c) {
+                v[c] = transformed[draw->FirstVertex + (draw->Indices ? draw->Indices[corner + c] : corner + c)];
+            }
+
+            //whole triangle outside one side of the view volume
+            bool outside = false;
+            for (int axis = 0; axis < 3 && !outside; ++axis) {
+                outside = (v[0].Clip[axis] > v[0].Clip.w && v[1].Clip[axis] > v[1].Clip.w && v[2].Clip[axis] > v[2].Clip.w)
+                    || (v[0].Clip[axis] < -v[0].Clip.w && v[1].Clip[axis] < -v[1].Clip.w && v[2].Clip[axis] < -v[2].Clip.w);
+            }
+            if (outside) {
+                continue;
+            }
+
+            //near and far clipping can turn the triangle into a polygon of up to five corners
+            ClipVertex polygon[8];
+            ClipVertex clipped[8];
+            int count = clipPolygon(v, 3, clipped, 1.0f);
+            count = clipPolygon(clipped, count, polygon, -1.0f);
+            for (int i = 1; i + 1 < count; ++i) {
+                setupTriangle(chunk, polygon[0], polygon[i], polygon[i + 1], draw);
+            }
+        }
+    }
+
+    static float snapToSubpixel(float value) {
+        const float steps = (float)(1 << SUBPIXEL_BITS);
+        return floorf(value * steps + 0.5f) / steps;
+    }
+
+    void setupTriangle(Chunk& chunk, const ClipVertex& v0, const ClipVertex& v1, const ClipVertex& v2, const DrawCall* draw) {
+        const ClipVertex* v[3] = { &v0, &v1, &v2 };
+        SetupTriangle tri;
+        float x[3], y[3], z[3];
+        for (int i = 0; i < 3; ++i) {
+            float inverseW = 1.0f / v[i]->Clip.w;
+            x[i] = snapToSubpixel((v[i]->Clip.x * inverseW * 0.5f + 0.5f) * width);
+            y[i] = snapToSubpixel((v[i]->Clip.y * inverseW * 0.5f + 0.5f) * height);
+            z[i] = v[i]->Clip.z * inverseW * 0.5f + 0.5f;
+            tri.InverseW[i] = inverseW;
+            for (int k = 0; k < ATTRIBUTES; ++k) {
+                tri.Attributes[i][k] = v[i]->Attributes[k] * inverseW;
+            }
+        }
+
+        //on positions that are multiples of 1/256 every product and sum below is a multiple of 1/2^16
+        //that fits a double's mantissa, for corners out to 2^17 pixels from the screen. a pixel centre
+        //right on a shared edge or vertex is then settled by the ownership rule alone, rounding can't
+        //hand it to two triangles around a vertex or to none
+        double area = ((double)x[1] - x[0]) * ((double)y[2] - y[0]) - ((double)x[2] - x[0]) * ((double)y[1] - y[0]);
+        if (!(fabs(area) > 0.0)) {
+            return;
+        }
+        double orientation = area > 0.0 ? 1.0 : -1.0;
+        area *= orientation;
+
+        for (int i = 0; i < 3; ++i) {
+            int j = (i + 1) % 3;
+            int k = (i + 2) % 3;
+            double a = -((double)y[k] - y[j]) * orientation;
+            double b = ((double)x[k] - x[j]) * orientation;
+            tri.EdgeA[i] = a;
+            tri.EdgeB[i] = b;
+
+            //anchor on the same end of the edge whichever triangle it belongs to, so the neighbour's
+            //edge function is the exact negation of this one
+            int anchor = (x[j] < x[k] || (x[j] == x[k] && y[j] < y[k])) ? j : k;
+            tri.EdgeC[i] = -(a * x[anchor] + b * y[anchor]);
+
+            //of two triangles sharing an edge exactly one owns it, so there are no gaps or double hits
+            bool owned = a > 0.0 || (a == 0.0 && b > 0.0);
+            tri.Threshold[i] = owned ? -DBL_MIN : 0.0;
+        }
+
+        tri.InverseArea = (float)(1.0 / area);
+        tri.DepthA = (float)((tri.EdgeA[0] * z[0] + tri.EdgeA[1] * z[1] + tri.EdgeA[2] * z[2]) / area);
+        tri.DepthB = (float)((tri.EdgeB[0] * z[0] + tri.EdgeB[1] * z[1] + tri.EdgeB[2] * z[2]) / area);
+        tri.DepthC = (float)((tri.EdgeC[0] * z[0] + tri.EdgeC[1] * z[1] + tri.EdgeC[2] * z[2]) / area);
+
+        tri.MinX = std::max(0, (int)floorf(std::min(x[0], std::min(x[1], x[2]))));
+        tri.MinY = std::max(0, (int)floorf(std::min(y[0], std::min(y[1], y[2]))));
+        tri.MaxX = std::min(width - 1, (int)ceilf(std::max(x[0], std::max(x[1], x[2]))));
+        tri.MaxY = std::min(height - 1, (int)ceilf(std::max(y[0], std::max(y[1], y[2]))));
+        if (tri.MinX > tri.MaxX || tri.MinY > tri.MaxY) {
+            return;
+        }
+        tri.Draw = draw;
+
+        uint32_t index = (uint32_t)chunk.Triangles.size();
+        chunk.Triangles.push_back(tri);
+        for (int ty = tri.MinY / TILE_SIZE; ty <= tri.MaxY / TILE_SIZE; ++ty) {
+            for (int tx = tri.MinX / TILE_SIZE; tx <= tri.MaxX / TILE_SIZE; ++tx) {
+                chunk.Bins[(size_t)ty * tilesX + tx].push_back(index);
+            }
+        }
+    }
+
+    void rasterizeTile(int tile, size_t chunkCount) {
+        int tileX0 = (tile % tilesX) * TILE_SIZE;
+        int tileY0 = (tile / tilesX) * TILE_SIZE;
+        int tileX1 = std::min(tileX0 + TILE_SIZE, width) - 1;
+        int tileY1 = std::min(tileY0 + TILE_SIZE, height) - 1;
+
+        for (int y = tileY0; y <= tileY1; ++y) {
+            std::fill(&color[(size_t)y * width + tileX0], &color[(size_t)y * width + tileX1] + 1, clearColor);
+            std::fill(&depth[(size_t)y * width + tileX0], &depth[(size_t)y * width + tileX1] + 1, 1.0f);
+        }
+
+        for (size_t c = 0; c < chunkCount; ++c) {
+            const Chunk& chunk = chunks[c];
+            for (uint32_t index : chunk.Bins[tile]) {
+                const SetupTriangle& tri = chunk.Triangles[index];
+                int x0 = std::max(tri.MinX, tileX0) & ~3;
+                int x1 = std::min(tri.MaxX, tileX1);
+                int y0 = std::max(tri.MinY, tileY0);
+                int y1 = std::min(tri.MaxY, tileY1);
+                for (int y = y0; y <= y1; ++y) {
+                    for (int x = x0; x <= x1; x += 4) {
+                        int mask = coverage(tri, x, y) & laneMask(x, x1);
+                        while (mask) {
+                            int lane = lowestBit(mask);
+                            mask &= mask - 1;
+                            shadePixel(tri, x + lane, y);
+                        }
+                    }
+                }
+            }
+        }
+    }
+
+    static int laneMask(int x, int lastX) {
+        int lanes = lastX - x + 1;
+        return lanes >= 4 ? 0xf : (1 << lanes) - 1;
+    }
+
+    static int lowestBit(int mask) {
+        int lane = 0;
+        while (!(mask & (1 << lane))) {
+            ++lane;
+        }
+        return lane;
+    }
+
+    //which of the four pixels at (x..x+3, y) are inside the triangle and in front of the depth buffer
+    int coverage(const SetupTriangle& tri, int x, int y) const {
+        float py = y + 0.5f;
+        float px = x + 0.5f;
+        const float* depthRow = &depth[(size_t)y * width + x];
+
+#if SOFTRENDER_SSE
+        //edges two pixels at a time in double, the depth four at a time in float
+        __m128d xsLow = _mm_add_pd(_mm_set1_pd(px), _mm_set_pd(1.0, 0.0));
+        __m128d xsHigh = _mm_add_pd(_mm_set1_pd(px), _mm_set_pd(3.0, 2.0));
+        __m128d insideLow = _mm_castsi128_pd(_mm_set1_epi32(-1));
+        __m128d insideHigh = insideLow;
+        for (int i = 0; i < 3; ++i) {
+            __m128d a = _mm_set1_pd(tri.EdgeA[i]);
+            __m128d row = _mm_set1_pd(tri.EdgeB[i] * py + tri.EdgeC[i]);
+            __m128d threshold = _mm_set1_pd(tri.Threshold[i]);
+            insideLow = _mm_and_pd(insideLow, _mm_cmpgt_pd(_mm_add_pd(_mm_mul_pd(a, xsLow), row), threshold));
+            insideHigh = _mm_and_pd(insideHigh, _mm_cmpgt_pd(_mm_add_pd(_mm_mul_pd(a, xsHigh), row), threshold));
+        }
+        int inside = _mm_movemask_pd(insideLow) | (_mm_movemask_pd(insideHigh) << 2);
+        if (inside == 0) {
+            return 0;
+        }
+
+        const __m128 laneOffsets = _mm_set_ps(3.0f, 2.0f, 1.0f, 0.0f);
+        __m128 xs = _mm_add_ps(_mm_set1_ps(px), laneOffsets);
+        __m128 z = _mm_add_ps(_mm_add_ps(_mm_mul_ps(_mm_set1_ps(tri.DepthA), xs), _mm_mul_ps(_mm_set1_ps(tri.DepthB), _mm_set1_ps(py))), _mm_set1_ps(tri.DepthC));
+        return inside & _mm_movemask_ps(_mm_cmplt_ps(z, _mm_loadu_ps(depthRow)));
+#else
+        int mask = 0;
+        for (int lane = 0; lane < 4; ++lane) {
+            float sx = px + lane;
+            bool inside = true;
+            for (int i = 0; i < 3; ++i) {
+                inside = inside && tri.EdgeA[i] * sx + (tri.EdgeB[i] * py + tri.EdgeC[i]) > tri.Threshold[i];
+            }
+            float z = tri.DepthA * sx + tri.DepthB * py + tri.DepthC;
+            if (inside && z < depthRow[lane]) {
+                mask |= 1 << lane;
+            }
+        }
+        return mask;
+#endif
+    }
+
+    //bilinear, repeat wrap, texel centers at +0.5 like GL_LINEAR on the base level
+    static glm::vec3 sample(const SoftTexture& texture, float u, float v) {
+        float fx = u * texture.Width - 0.5f;
+        float fy = v * texture.Height - 0.5f;
+        float floorX = floorf(fx);
+        float floorY = floorf(fy);
+        float tx = fx - floorX;
+        float ty = fy - floorY;
+
+        int x0 = wrap((int)floorX, texture.Width);
+        int y0 = wrap((int)floorY, texture.Height);
+        int x1 = wrap(x0 + 1, texture.Width);
+        int y1 = wrap(y0 + 1, texture.Height);
+
+        glm::vec3 c00 = texel(texture, x0, y0);
+        glm::vec3 c10 = texel(texture, x1, y0);
+        glm::vec3 c01 = texel(texture, x0, y1);
+        glm::vec3 c11 = texel(texture, x1, y1);
+        glm::vec3 bottom = c00 + (c10 - c00) * tx;
+        glm::vec3 top = c01 + (c11 - c01) * tx;
+        return bottom + (top - bottom) * ty;
+    }
+
+    static int wrap(int value, int size) {
+        int result = value % size;
+        return result < 0 ? result + size : result;
+    }
+
+    static glm::vec3 texel(const SoftTexture& texture, int x, int y) {
+        const unsigned char* p = &texture.Texels[((size_t)y * texture.Width + x) * texture.Channels];
+        const float scale = 1.0f / 255.0f;
+        if (texture.Channels < 3) {
+            return glm::vec3(p[0] * scale);
+        }
+        return glm::vec3(p[0] * scale, p[1] * scale, p[2] * scale);
+    }
+
+    void shadePixel(const SetupTriangle& tri, int x, int y) {
+        float px = x + 0.5f;
+        float py = y + 0.5f;
+        size_t pixel = (size_t)y * width + x;
+
+        //perspective correct weights from the screen space ones
+        float weights[3];
+        float sum = 0.0f;
+        for (int i = 0; i < 3; ++i) {
+            float barycentric = (float)(tri.EdgeA[i] * px + tri.EdgeB[i] * py + tri.EdgeC[i]) * tri.InverseArea;
+            weights[i] = barycentric * tri.InverseW[i];
+            sum += weights[i];
+        }
+        float inverseSum = 1.0f / sum;
+
+        float attributes[ATTRIBUTES];
+        for (int k = 0; k < ATTRIBUTES; ++k) {
+            attributes[k] = (tri.Attributes[0][k] * weights[0] + tri.Attributes[1][k] * weights[1] + tri.Attributes[2][k] * weights[2]) * inverseSum;
+        }
+
+        depth[pixel] = tri.DepthA * px + tri.DepthB * py + tri.DepthC;
+
+        const DrawCall& draw = *tri.Draw;
+        if (!draw.Lit) {
+            color[pixel] = 0xffffffffu;
+            return;
+        }
+
+        //Phong, term for term the same as the cube fragment shader
+        glm::vec3 position(attributes[0], attributes[1], attributes[2]);
+        glm::vec3 norm = glm::normalize(glm::vec3(attributes[3], attributes[4], attributes[5]));
+        glm::vec3 viewDir = glm::normalize(viewPosition - position);
+        const float ambientStrength = 0.1f;
+        const float specularIntensity = 0.8f;
+        const float highlightSize = 16.0f;
+
+        glm::vec3 lighting(0.0f);
+        for (int i = 0; i < lightCount; ++i) {
+            glm::vec3 lightDirection = glm::normalize(lights[i].Position - position);
+            float impact = std::max(glm::dot(norm, lightDirection), 0.0f);
+            glm::vec3 reflectDir = lightDirection * -1.0f - norm * (2.0f * glm::dot(norm, lightDirection * -1.0f));
+            float specularComponent = powf(std::max(glm::dot(viewDir, reflectDir), 0.0f), highlightSize);
+            lighting += lights[i].Color * (ambientStrength + impact + specularIntensity * specularComponent);
+        }
+
+        glm::vec3 textureColor = draw.Texture ? sample(*draw.Texture, attributes[6], attributes[7]) : glm::vec3(0.0f);
+        color[pixel] = packColor(lighting * textureColor);
+    }
+};
+#endif
@@ -0,0 +1,403 @@
+#ifndef TRANSFORMS_H
+#define TRANSFORMS_H
+
+#include <glm/glm.hpp>
+#include <glm/gtc/quaternion.hpp>
+
+#include <cmath>
+#include <cstddef>
+#include <cstdlib>
+#include <new>
+#include <vector>
+
+#if defined(__AVX__)
+#define TRANSFORMS_AVX 1
+#include <immintrin.h>
+#endif
+#if defined(__SSE2__) || defined(_M_X64) || (defined(_M_IX86_FP) && _M_IX86_FP >= 2)
+#define TRANSFORMS_SSE 1
+#include <emmintrin.h>
+#include <xmmintrin.h>
+#endif
+
+#if defined(_MSC_VER)
+#include <malloc.h>
+#endif
+
+//order the scale, rotation and translation of an object are multiplied in
+enum TransformOrder {
+    TRANSLATE_ROTATE_SCALE,
+    TRANSLATE_SCALE_ROTATE,
+    SCALE_ROTATE_TRANSLATE
+};
+
+//allocator that lines arrays up on a cache line so SIMD loads never split one
+template <typename T>
+struct AlignedAllocator {
+    typedef T value_type;
+    static const size_t ALIGNMENT = 64;
+
+    AlignedAllocator() {}
+    template <typename U> AlignedAllocator(const AlignedAllocator<U>&) {}
+
+    T* allocate(size_t count) {
+        size_t bytes = (count * sizeof(T) + ALIGNMENT - 1) / ALIGNMENT * ALIGNMENT;
+#if defined(_MSC_VER)
+        void* memory = _aligned_malloc(bytes, ALIGNMENT);
+#else
+        void* memory = aligned_alloc(ALIGNMENT, bytes);
+#endif
+        if (!memory) {
+            throw std::bad_alloc();
+        }
+        return static_cast<T*>(memory);
+    }
+
+    void deallocate(T* memory, size_t) {
+#if defined(_MSC_VER)
+        _aligned_free(memory);
+#else
+        free(memory);
+#endif
+    }
+
+    template <typename U> bool operator==(const AlignedAllocator<U>&) const { return true; }
+    template <typename U> bool operator!=(const AlignedAllocator<U>&) const { return false; }
+};
+
+typedef std::vector<float, AlignedAllocator<float> > AlignedFloats;
+
+//object transforms kept as structure of arrays, one array per component.
+//arrays are padded to a whole number of SIMD lanes with identity transforms
+class TransformSoA {
+public:
+    static const size_t LANES = 8;
+
+    //position
+    AlignedFloats PositionX, PositionY, PositionZ;
+    //rotation quaternion
+    AlignedFloats RotationX, RotationY, RotationZ, RotationW;
+    //scale
+    AlignedFloats ScaleX, ScaleY, ScaleZ;
+    //TransformOrder as a float so it loads with the rest of the lane
+    AlignedFloats Order;
+
+    TransformSoA() : count(0) {}
+
+    size_t Size() const {
+        return count;
+    }
+
+    //length of the arrays including the padding
+    size_t Capacity() const {
+        return PositionX.size();
+    }
+
+    //returns the index of the new transform
+    size_t Add(const glm::vec3& position, const glm::quat& rotation, const glm::vec3& scale, TransformOrder order = TRANSLATE_ROTATE_SCALE) {
+        size_t index = count++;
+        if (PositionX.size() < count) {
+            grow((count + LANES - 1) / LANES * LANES);
+        }
+        Set(index, position, rotation, scale, order);
+        return index;
+    }
+
+    void Set(size_t index, const glm::vec3& position, const glm::quat& rotation, const glm::vec3& scale, TransformOrder order) {
+        SetPosition(index, position);
+        SetRotation(index, rotation);
+        ScaleX[index] = scale.x;
+        ScaleY[index] = scale.y;
+        ScaleZ[index] = scale.z;
+        Order[index] = (float)order;
+    }
+
+    void SetPosition(size_t index, const glm::vec3& position) {
+        PositionX[index] = position.x;
+        PositionY[index] = position.y;
+        PositionZ[index] = position.z;
+    }
+
+    void SetRotation(size_t index, const glm::quat& rotation) {
+        RotationX[index] = rotation.x;
+        RotationY[index] = rotation.y;
+        RotationZ[index] = rotation.z;
+        RotationW[index] = rotation.w;
+    }
+
+    glm::vec3 Position(size_t index) const {
+        return glm::vec3(PositionX[index], PositionY[index], PositionZ[index]);
+    }
+
+    glm::quat Rotation(size_t index) const {
+        return glm::quat(RotationW[index], RotationX[index], RotationY[index], RotationZ[index]);
+    }
+
+    glm::vec3 Scale(size_t index) const {
+        return glm::vec3(ScaleX[index], ScaleY[index], ScaleZ[index]);
+    }
+
+private:
+    size_t count;
+
+    void grow(size_t capacity) {
+        PositionX.resize(capacity, 0.0f);
+        PositionY.resize(capacity, 0.0f);
+        PositionZ.resize(capacity, 0.0f);
+        RotationX.resize(capacity, 0.0f);
+        RotationY.resize(capacity, 0.0f);
+        RotationZ.resize(capacity, 0.0f);
+        RotationW.resize(capacity, 1.0f);
+        ScaleX.resize(capacity, 1.0f);
+        ScaleY.resize(capacity, 1.0f);
+        ScaleZ.resize(capacity, 1.0f);
+        Order.resize(capacity, (float)TRANSLATE_ROTATE_SCALE);
+    }
+};
+
+//one transform done the slow way, used for the tail of a batch and on CPUs without SSE
+inline void ComposeWorldMatrix(const TransformSoA& transforms, size_t i, float* out)
+{
+    float x = transforms.RotationX[i], y = transforms.RotationY[i], z = transforms.RotationZ[i], w = transforms.RotationW[i];
+    float scale[3] = { transforms.ScaleX[i], transforms.ScaleY[i], transforms.ScaleZ[i] };
+    float position[3] = { transforms.PositionX[i], transforms.PositionY[i], transforms.PositionZ[i] };
+
+    //rotation matrix from the quaternion, r[row][column]
+    float r[3][3] = {
+        { 1.0f - 2.0f * (y * y + z * z), 2.0f * (x * y - w * z), 2.0f * (x * z + w * y) },
+        { 2.0f * (x * y + w * z), 1.0f - 2.0f * (x * x + z * z), 2.0f * (y * z - w * x) },
+        { 2.0f * (x * z - w * y), 2.0f * (y * z + w * x), 1.0f - 2.0f * (x * x + y * y) }
+    };
+
+    //rotation * scale scales the columns, scale * rotation scales the rows
+    bool scaleRows = transforms.Order[i] != (float)TRANSLATE_ROTATE_SCALE;
+    for (int row = 0; row < 3; ++row) {
+        for (int column = 0; column < 3; ++column) {
+            out[column * 4 + row] = r[row][column] * (scaleRows ? scale[row] : scale[column]);
+        }
+        out[row * 4 + 3] = 0.0f;
+    }
+
+    //scale * rotation * translation moves the translation through the other two
+    bool translateFirst = transforms.Order[i] == (float)SCALE_ROTATE_TRANSLATE;
+    for (int row = 0; row < 3; ++row) {
+        out[12 + row] = translateFirst
+            ? out[row] * position[0] + out[4 + row] * position[1] + out[8 + row] * position[2]
+            : position[row];
+    }
+    out[15] = 1.0f;
+}
+
+#if TRANSFORMS_SSE
+//writes 4 matrices given their elements as (row, column) registers with one object per lane
+inline void StoreTransposed(const __m128 m[4][4], float* out, size_t stride, size_t count)
+{
+    for (int column = 0; column < 4; ++column) {
+        __m128 a = m[0][column], b = m[1][column], c = m[2][column], d = m[3][column];
+        _MM_TRANSPOSE4_PS(a, b, c, d);
+
+        __m128 lanes[4] = { a, b, c, d };
+        for (size_t lane = 0; lane < count; ++lane) {
+            _mm_storeu_ps(out + lane * stride + column * 4, lanes[lane]);
+        }
+    }
+}
+#endif
+
+//builds world matrices for transforms [begin, end) into out[begin, end).
+//processes 8 objects at a time with AVX, 4 with SSE
+inline void ComposeWorldMatrices(const TransformSoA& transforms, size_t begin, size_t end, glm::mat4* out)
+{
+    size_t i = begin;
+
+#if TRANSFORMS_SSE
+#if TRANSFORMS_AVX
+    typedef __m256 Wide;
+    const size_t WIDTH = 8;
+#define W_LOAD(p) _mm256_loadu_ps(p)
+#define W_SET1(v) _mm256_set1_ps(v)
+#define W_ADD(a, b) _mm256_add_ps(a, b)
+#define W_SUB(a, b) _mm256_sub_ps(a, b)
+#define W_MUL(a, b) _mm256_mul_ps(a, b)
+#define W_EQ(a, b) _mm256_cmp_ps(a, b, _CMP_EQ_OQ)
+#define W_BLEND(a, b, mask) _mm256_blendv_ps(a, b, mask)
+#else
+    typedef __m128 Wide;
+    const size_t WIDTH = 4;
+#define W_LOAD(p) _mm_loadu_ps(p)
+#define W_SET1(v) _mm_set1_ps(v)
+#define W_ADD(a, b) _mm_add_ps(a, b)
+#define W_SUB(a, b) _mm_sub_ps(a, b)
+#define W_MUL(a, b) _mm_mul_ps(a, b)
+#define W_EQ(a, b) _mm_cmpeq_ps(a, b)
+#define W_BLEND(a, b, mask) _mm_or_ps(_mm_andnot_ps(mask, a), _mm_and_ps(mask, b))
+#endif
+
+    const Wide one = W_SET1(1.0f);
+    const Wide two = W_SET1(2.0f);
+    const Wide zero = W_SET1(0.0f);
+    const Wide orderTRS = W_SET1((float)TRANSLATE_ROTATE_SCALE);
+    const Wide orderSRT = W_SET1((float)SCALE_ROTATE_TRANSLATE);
+
+    //the arrays are padded to whole lanes, so a partial batch at the end of the set can still load a full
+    //register. a range ending inside the set leaves its tail to the scalar loop, the lanes past end belong
+    //to another job's range and may be written while this one reads
+    size_t simdEnd = end == transforms.Size() ? end : end - (end - i) % WIDTH;
+    for (; i < simdEnd && i + WIDTH <= transforms.Capacity(); i += WIDTH) {
+        Wide x = W_LOAD(&transforms.RotationX[i]);
+        Wide y = W_LOAD(&transforms.RotationY[i]);
+        Wide z = W_LOAD(&transforms.RotationZ[i]);
+        Wide w = W_LOAD(&transforms.RotationW[i]);
+        Wide scale[3] = { W_LOAD(&transforms.ScaleX[i]), W_LOAD(&transforms.ScaleY[i]), W_LOAD(&transforms.ScaleZ[i]) };
+        Wide position[3] = { W_LOAD(&transforms.PositionX[i]), W_LOAD(&transforms.PositionY[i]), W_LOAD(&transforms.PositionZ[i]) };
+        Wide order = W_LOAD(&transforms.Order[i]);
+
+        Wide xx = W_MUL(x, x), yy = W_MUL(y, y), zz = W_MUL(z, z);
+        Wide xy = W_MUL(x, y), xz = W_MUL(x, z), yz = W_MUL(y, z);
+        Wide wx = W_MUL(w, x), wy = W_MUL(w, y), wz = W_MUL(w, z);
+
+        Wide r[3][3] = {
+            { W_SUB(one, W_MUL(two, W_ADD(yy, zz))), W_MUL(two, W_SUB(xy, wz)), W_MUL(two, W_ADD(xz, wy)) },
+            { W_MUL(two, W_ADD(xy, wz)), W_SUB(one, W_MUL(two, W_ADD(xx, zz))), W_MUL(two, W_SUB(yz, wx)) },
+            { W_MUL(two, W_SUB(xz, wy)), W_MUL(two, W_ADD(yz, wx)), W_SUB(one, W_MUL(two, W_ADD(xx, yy))) }
+        };
+
+        //pick row or column scaling per lane instead of branching per object
+        Wide scaleColumns = W_EQ(order, orderTRS);
+        Wide translateFirst = W_EQ(order, orderSRT);
+
+        Wide m[4][4];
+        for (int row = 0; row < 3; ++row) {
+            for (int column = 0; column < 3; ++column) {
+                m[row][column] = W_MUL(r[row][column], W_BLEND(scale[row], scale[column], scaleColumns));
+            }
+        }
+        for (int row = 0; row < 3; ++row) {
+            Wide moved = W_ADD(W_ADD(W_MUL(m[row][0], position[0]), W_MUL(m[row][1], position[1])), W_MUL(m[row][2], position[2]));
+            m[row][3] = W_BLEND(position[row], moved, translateFirst);
+        }
+        m[3][0] = zero;
+        m[3][1] = zero;
+        m[3][2] = zero;
+        m[3][3] = one;
+
+        size_t count = end - i < WIDTH ? end - i : WIDTH;
+        float* destination = &out[i][0][0];
+#if TRANSFORMS_AVX
+        __m128 low[4][4], high[4][4];
+        for (int row = 0; row < 4; ++row) {
+            for (int column = 0; column < 4; ++column) {
+                low[row][column] = _mm256_castps256_ps128(m[row][column]);
+                high[row][column] = _mm256_extractf128_ps(m[row][column], 1);
+            }
+        }
+        StoreTransposed(low, destination, 16, count < 4 ? count : 4);
+        if (count > 4) {
+            StoreTransposed(high, destination + 4 * 16, 16, count - 4);
+        }
+#else
+        StoreTransposed(m, destination, 16, count);
+#endif
+    }
+
+#undef W_LOAD
+#undef W_SET1
+#undef W_ADD
+#undef W_SUB
+#undef W_MUL
+#undef W_EQ
+#undef W_BLEND
+#endif
+
+    for (; i < end; ++i) {
+        ComposeWorldMatrix(transforms, i, &out[i][0][0]);
+    }
+}
+
+//blends transforms [begin, end) between two states of the same set, quaternions are nlerped along the shorter arc
+inline void InterpolateTransforms(const TransformSoA& from, const TransformSoA& to, float alpha, size_t begin, size_t end, TransformSoA& out)
+{
+    const AlignedFloats* fromArrays[] = { &from.PositionX, &from.PositionY, &from.PositionZ, &from.ScaleX, &from.ScaleY, &from.ScaleZ };
+    const AlignedFloats* toArrays[] = { &to.PositionX, &to.PositionY, &to.PositionZ, &to.ScaleX, &to.ScaleY, &to.ScaleZ };
+    AlignedFloats* outArrays[] = { &out.PositionX, &out.PositionY, &out.PositionZ, &out.ScaleX, &out.ScaleY, &out.ScaleZ };
+
+    //plain loops over each array, the compiler vectorizes these
+    for (int array = 0; array < 6; ++array) {
+        const float* a = fromArrays[array]->data();
+        const float* b = toArrays[array]->data();
+        float* result = outArrays[array]->data();
+        for (size_t i = begin; i < end; ++i) {
+            result[i] = a[i] + (b[i] - a[i]) * alpha;
+        }
+    }
+
+    for (size_t i = begin; i < end; ++i) {
+        float x = to.RotationX[i], y = to.RotationY[i], z = to.RotationZ[i], w = to.RotationW[i];
+        float dot = from.RotationX[i] * x + from.RotationY[i] * y + from.RotationZ[i] * z + from.RotationW[i] * w;
+        float sign = dot < 0.0f ? -1.0f : 1.0f;
+
+        x = from.RotationX[i] + (x * sign - from.RotationX[i]) * alpha;
+        y = from.RotationY[i] + (y * sign - from.RotationY[i]) * alpha;
+        z = from.RotationZ[i] + (z * sign - from.RotationZ[i]) * alpha;
+        w = from.RotationW[i] + (w * sign - from.RotationW[i]) * alpha;
+
+        float length = std::sqrt(x * x + y * y + z * z + w * w);
+        out.RotationX[i] = x / length;
+        out.RotationY[i] = y / length;
+        out.RotationZ[i] = z / length;
+        out.RotationW[i] = w / length;
+        out.Order[i] = to.Order[i];
+    }
+}
+
+//out[i] = viewProjection * models[i] for count matrices
+inline void MultiplyViewProjection(const glm::mat4& viewProjection, const glm::mat4* models, size_t count, glm::mat4* out)
+{
+#if TRANSFORMS_SSE
+#if TRANSFORMS_AVX
+    //two columns of the model per register, the view projection columns repeated in both halves
+    __m256 columns[4];
+    for (int c = 0; c < 4; ++c) {
+        __m128 column = _mm_loadu_ps(&viewProjection[c][0]);
+        columns[c] = _mm256_insertf128_ps(_mm256_castps128_ps256(column), column, 1);
+    }
+
+    for (size_t i = 0; i < count; ++i) {
+        const float* model = &models[i][0][0];
+        float* result = &out[i][0][0];
+        for (int c = 0; c < 4; c += 2) {
+            const float* a = model + c * 4;
+            const float* b = model + (c + 1) * 4;
+            __m256 sum = _mm256_mul_ps(columns[0], _mm256_setr_ps(a[0], a[0], a[0], a[0], b[0], b[0], b[0], b[0]));
+            sum = _mm256_add_ps(sum, _mm256_mul_ps(columns[1], _mm256_setr_ps(a[1], a[1], a[1], a[1], b[1], b[1], b[1], b[1])));
+            sum = _mm256_add_ps(sum, _mm256_mul_ps(columns[2], _mm256_setr_ps(a[2], a[2], a[2], a[2], b[2], b[2], b[2], b[2])));
+            sum = _mm256_add_ps(sum, _mm256_mul_ps(columns[3], _mm256_setr_ps(a[3], a[3], a[3], a[3], b[3], b[3], b[3], b[3])));
+            _mm256_storeu_ps(result + c * 4, sum);
+        }
+    }
+#else
+    __m128 columns[4];
+    for (int c = 0; c < 4; ++c) {
+        columns[c] = _mm_loadu_ps(&viewProjection[c][0]);
+    }
+
+    for (size_t i = 0; i < count; ++i) {
+        const float* model = &models[i][0][0];
+        float* result = &out[i][0][0];
+        for (int c = 0; c < 4; ++c) {
+            const float* a = model + c * 4;
+            __m128 sum = _mm_mul_ps(columns[0], _mm_set1_ps(a[0]));
+            sum = _mm_add_ps(sum, _mm_mul_ps(columns[1], _mm_set1_ps(a[1])));
+            sum = _mm_add_ps(sum, _mm_mul_ps(columns[2], _mm_set1_ps(a[2])));
+            sum = _mm_add_ps(sum, _mm_mul_ps(columns[3], _mm_set1_ps(a[3])));
+            _mm_storeu_ps(result + c * 4, sum);
+        }
+    }
+#endif
+#else
+    for (size_t i = 0; i < count; ++i) {
+        out[i] = viewProjection * models[i];
+    }
+#endif
+}
+#endif
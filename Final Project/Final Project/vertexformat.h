@@ -0,0 +1,210 @@
+#ifndef VERTEXFORMAT_H
+#define VERTEXFORMAT_H
+
+#include <glm/glm.hpp>
+
+#include <algorithm>
+#include <cmath>
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+#include <vector>
+
+#if defined(__F16C__)
+#define VERTEXFORMAT_F16C 1
+#include <immintrin.h>
+#endif
+
+//largest value of a 16 bit normalized position
+const float POSITION_QUANT_MAX = 65535.0f;
+
+//16 byte vertex. the position is 16 bit unsigned normalized within the mesh's bounding box, the
+//normal is 10:10:10:2 signed normalized (GL_INT_2_10_10_10_REV) and the uv is two half floats
+struct PackedVertex {
+    uint16_t Position[3];
+    uint16_t Padding;       // keeps the normal on a 4 byte boundary
+    uint32_t Normal;
+    uint16_t TexCoord[2];
+};
+static_assert(sizeof(PackedVertex) == 16, "packed vertices are 16 bytes");
+
+//a mesh's packed vertices, and what turns the stored position back into the mesh's own space:
+//position = Offset + stored / 65535 * Scale
+struct PackedMesh {
+    std::vector<PackedVertex> Vertices;
+    glm::vec3 PositionOffset;
+    glm::vec3 PositionScale;
+    float MaxPositionError;     // largest distance any corner moved, in mesh units
+    float MaxNormalError;       // largest angle any normal turned, in degrees
+    float MaxTexCoordError;     // largest change in any uv component
+};
+
+//--- half floats ---
+
+//round to nearest even, overflow goes to infinity and tiny values to signed zero or a denormal
+inline uint16_t FloatToHalf(float value)
+{
+#if VERTEXFORMAT_F16C
+    return (uint16_t)_cvtss_sh(value, 0);
+#else
+    uint32_t bits;
+    memcpy(&bits, &value, sizeof(bits));
+    uint32_t sign = (bits >> 16) & 0x8000u;
+    uint32_t magnitude = bits & 0x7fffffffu;
+
+    if (magnitude >= 0x7f800000u) {
+        //infinity stays infinity, NaN stays a quiet NaN
+        return (uint16_t)(sign | 0x7c00u | (magnitude > 0x7f800000u ? 0x200u : 0u));
+    }
+    if (magnitude >= 0x477ff000u) {
+        return (uint16_t)(sign | 0x7c00u);
+    }
+    if (magnitude < 0x38800000u) {
+        //denormal half, shift the mantissa with its implicit bit into place and round
+        if (magnitude < 0x33000000u) {
+            return (uint16_t)sign;
+        }
+        uint32_t exponent = magnitude >> 23;
+        uint32_t mantissa = (magnitude & 0x7fffffu) | 0x800000u;
+        uint32_t shift = 126 - exponent;
+        uint32_t half = mantissa >> shift;
+        uint32_t remainder = mantissa & ((1u << shift) - 1);
+        uint32_t halfway = 1u << (shift - 1);
+        if (remainder > halfway || (remainder == halfway && (half & 1u))) {
+            ++half;
+        }
+        return (uint16_t)(sign | half);
+    }
+
+    //normal half, rebias the exponent and round the 13 dropped bits
+    uint32_t half = ((magnitude - 0x38000000u) >> 13);
+    uint32_t remainder = magnitude & 0x1fffu;
+    if (remainder > 0x1000u || (remainder == 0x1000u && (half & 1u))) {
+        ++half;
+    }
+    return (uint16_t)(sign | half);
+#endif
+}
+
+inline float HalfToFloat(uint16_t value)
+{
+#if VERTEXFORMAT_F16C
+    return _cvtsh_ss(value);
+#else
+    uint32_t sign = (uint32_t)(value & 0x8000u) << 16;
+    uint32_t exponent = (value >> 10) & 0x1fu;
+    uint32_t mantissa = value & 0x3ffu;
+    uint32_t bits;
+    if (exponent == 0x1fu) {
+        bits = sign | 0x7f800000u | (mantissa << 13);
+    }
+    else if (exponent != 0) {
+        bits = sign | ((exponent + 112) << 23) | (mantissa << 13);
+    }
+    else if (mantissa != 0) {
+        //denormal half, normalize it
+        exponent = 113;
+        while ((mantissa & 0x400u) == 0) {
+            mantissa <<= 1;
+            --exponent;
+        }
+        bits = sign | (exponent << 23) | ((mantissa & 0x3ffu) << 13);
+    }
+    else {
+        bits = sign;
+    }
+    float result;
+    memcpy(&result, &bits, sizeof(result));
+    return result;
+#endif
+}
+
+//--- 10:10:10:2 normals ---
+
+//x in the low 10 bits, then y, then z, w is left at zero
+inline uint32_t PackSnorm1010102(const glm::vec3& value)
+{
+    uint32_t packed = 0;
+    for (int i = 0; i < 3; ++i) {
+        int component = (int)lroundf(std::min(std::max(value[i], -1.0f), 1.0f) * 511.0f);
+        packed |= ((uint32_t)component & 0x3ffu) << (i * 10);
+    }
+    return packed;
+}
+
+//the GL 4.2 rule, the most negative value clamps to -1
+inline glm::vec3 UnpackSnorm1010102(uint32_t packed)
+{
+    glm::vec3 value;
+    for (int i = 0; i < 3; ++i) {
+        int component = (int)((packed >> (i * 10)) & 0x3ffu);
+        if (component & 0x200) {
+            component -= 0x400;
+        }
+        value[i] = std::max(component / 511.0f, -1.0f);
+    }
+    return value;
+}
+
+//--- compression ---
+
+//unpacks to 8 floats, position in the mesh's own space, in the layout the float meshes use
+inline void UnpackVertex(const PackedMesh& mesh, const PackedVertex& vertex, float* out)
+{
+    for (int i = 0; i < 3; ++i) {
+        out[i] = mesh.PositionOffset[i] + vertex.Position[i] / POSITION_QUANT_MAX * mesh.PositionScale[i];
+    }
+    glm::vec3 normal = UnpackSnorm1010102(vertex.Normal);
+    out[3] = normal.x;
+    out[4] = normal.y;
+    out[5] = normal.z;
+    out[6] = HalfToFloat(vertex.TexCoord[0]);
+    out[7] = HalfToFloat(vertex.TexCoord[1]);
+}
+
+//packs interleaved position/normal/uv float vertices and measures how far the packing moved them
+inline void CompressMesh(const float* vertices, size_t vertexCount, PackedMesh& mesh)
+{
+    const int stride = 8;
+    glm::vec3 boundsMin(0.0f), boundsMax(0.0f);
+    for (size_t i = 0; i < vertexCount; ++i) {
+        glm::vec3 position(vertices[i * stride], vertices[i * stride + 1], vertices[i * stride + 2]);
+        boundsMin = i == 0 ? position : glm::min(boundsMin, position);
+        boundsMax = i == 0 ? position : glm::max(boundsMax, position);
+    }
+
+    //a flat axis still gets a non zero scale so decoding never divides anything by it
+    mesh.PositionOffset = boundsMin;
+    mesh.PositionScale = glm::max(boundsMax - boundsMin, glm::vec3(1.0e-6f));
+    mesh.MaxPositionError = 0.0f;
+    mesh.MaxNormalError = 0.0f;
+    mesh.MaxTexCoordError = 0.0f;
+    mesh.Vertices.resize(vertexCount);
+
+    for (size_t i = 0; i < vertexCount; ++i) {
+        const float* source = vertices + i * stride;
+        PackedVertex& packed = mesh.Vertices[i];
+        for (int c = 0; c < 3; ++c) {
+            float normalized = (source[c] - mesh.PositionOffset[c]) / mesh.PositionScale[c];
+            packed.Position[c] = (uint16_t)lroundf(std::min(std::max(normalized, 0.0f), 1.0f) * POSITION_QUANT_MAX);
+        }
+        packed.Padding = 0;
+
+        glm::vec3 normal(source[3], source[4], source[5]);
+        float length = glm::length(normal);
+        packed.Normal = PackSnorm1010102(length > 0.0f ? normal / length : normal);
+        packed.TexCoord[0] = FloatToHalf(source[6]);
+        packed.TexCoord[1] = FloatToHalf(source[7]);
+
+        float decoded[8];
+        UnpackVertex(mesh, packed, decoded);
+        mesh.MaxPositionError = std::max(mesh.MaxPositionError,
+            glm::length(glm::vec3(decoded[0], decoded[1], decoded[2]) - glm::vec3(source[0], source[1], source[2])));
+        if (length > 0.0f) {
+            float cosine = glm::dot(glm::normalize(glm::vec3(decoded[3], decoded[4], decoded[5])), normal / length);
+            mesh.MaxNormalError = std::max(mesh.MaxNormalError, glm::degrees(acosf(std::min(std::max(cosine, -1.0f), 1.0f))));
+        }
+        mesh.MaxTexCoordError = std::max(mesh.MaxTexCoordError, std::max(fabsf(decoded[6] - source[6]), fabsf(decoded[7] - source[7])));
+    }
+}
+#endif
@@ -0,0 +1,76 @@
+#!/usr/bin/env python3
+#compares Google Benchmark JSON results against a baseline run and fails when anything got slower
+#
+#  compare.py BASELINE CURRENT [--threshold PERCENT] [--metric cpu_time|real_time]
+#
+#BASELINE and CURRENT are either two JSON files or two folders of them, files are paired by name.
+#with --benchmark_repetitions the median of each benchmark is compared, otherwise the single run
+import argparse
+import json
+import os
+import sys
+
+
+def load(path):
+    #benchmark name -> its result entry, and the factor from each time unit to ns
+    with open(path) as file:
+        data = json.load(file)
+
+    scale = {"ns": 1.0, "us": 1.0e3, "ms": 1.0e6, "s": 1.0e9}
+    runs = {}
+    medians = {}
+    for entry in data.get("benchmarks", []):
+        if entry.get("error_occurred"):
+            continue
+        name = entry.get("run_name", entry["name"])
+        if entry.get("run_type") == "aggregate":
+            if entry.get("aggregate_name") == "median":
+                medians[name] = entry
+        elif name not in runs:
+            runs[name] = entry
+    runs.update(medians)
+    return runs, scale
+
+
+def pairs(baseline, current):
+    if os.path.isdir(baseline) != os.path.isdir(current):
+        sys.exit("baseline and current must both be files or both be folders")
+    if not os.path.isdir(baseline):
+        return [(baseline, current)]
+    names = sorted(name for name in os.listdir(current) if name.endswith(".json"))
+    return [(os.path.join(baseline, name), os.path.join(current, name)) for name in names
+            if os.path.exists(os.path.join(baseline, name))]
+
+
+def main():
+    parser = argparse.ArgumentParser(description=__doc__)
+    parser.add_argument("baseline")
+    parser.add_argument("current")
+    parser.add_argument("--threshold", type=float, default=10.0, help="percent slower that counts as a regression")
+    parser.add_argument("--metric", choices=["cpu_time", "real_time"], default="cpu_time")
+    args = parser.parse_args()
+
+    regressions = 0
+    compared = 0
+    for baseline_path, current_path in pairs(args.baseline, args.current):
+        baseline, scale = load(baseline_path)
+        current, _ = load(current_path)
+        print(os.path.basename(current_path))
+        for name, entry in current.items():
+            if name not in baseline:
+                print("  %-50s new" % name)
+                continue
+            before = baseline[name][args.metric] * scale[baseline[name].get("time_unit", "ns")]
+            after = entry[args.metric] * scale[entry.get("time_unit", "ns")]
+            change = (after - before) / before * 100.0 if before > 0.0 else 0.0
+            slower = change > args.threshold
+            regressions += slower
+            compared += 1
+            print("  %-50s %12.1f ns -> %12.1f ns  %+7.1f%%%s" % (name, before, after, change, "  REGRESSION" if slower else ""))
+
+    print("%d compared, %d more than %.1f%% slower" % (compared, regressions, args.threshold))
+    return 1 if regressions > 0 else 0
+
+
+if __name__ == "__main__":
+    sys.exit(main())
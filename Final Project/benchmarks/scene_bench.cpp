@@ -0,0 +1,363 @@
+//times the CPU side of loading the scene and of moving the camera: the mesh builders behind
+//UCreate*Mesh, mesh optimization and the vertex packing, the software renderer's vertex stage, the decode and conversions behind UCreateTexture, the image kernels on their own
+//and the camera's basis and view matrix. nothing here needs a GL context, the texture upload is
+//stood in for by the copy the driver makes of it
+#include <benchmark/benchmark.h>
+
+#include <glm/glm.hpp>
+#include <glm/gtc/matrix_transform.hpp>
+
+#include <cstring>
+#include <string>
+#include <vector>
+
+#include "../Final Project/camera.h"
+#include "../Final Project/ibl.h"
+#include "../Final Project/image.h"
+#include "../Final Project/meshes.h"
+#include "../Final Project/meshoptimize.h"
+#include "../Final Project/softrender.h"
+#include "../Final Project/vertexformat.h"
+
+//after image.h, which includes stb_image.h without the implementation
+#define STB_IMAGE_IMPLEMENTATION
+#include <stb_image.h>
+
+//textures are read from here, the build points it at the resources folder
+#ifndef FP_RESOURCE_DIR
+#define FP_RESOURCE_DIR "../resources"
+#endif
+
+namespace
+{
+    typedef void (*BuildVertices)(std::vector<float>& vertices);
+
+    //workers for the row parallel kernels, shared like the viewer's
+    JobSystem gJobs;
+
+    //square image with noisy contents, alpha included
+    std::vector<unsigned char> MakeImage(int size, int channels)
+    {
+        std::vector<unsigned char> image((size_t)size * size * channels);
+        for (size_t i = 0; i < image.size(); ++i) {
+            image[i] = (unsigned char)(i * 7 + (i >> 9));
+        }
+        return image;
+    }
+
+    std::string TexturePath(const char* name)
+    {
+        return std::string(FP_RESOURCE_DIR) + "/textures/" + name;
+    }
+}
+
+//vertex data plus the positions and bounds UCreateMeshBuffers derives from it
+static void BM_BuildMesh(benchmark::State& state, BuildVertices build)
+{
+    std::vector<float> vertices;
+    std::vector<glm::vec3> positions;
+    glm::vec3 boundsMin, boundsMax;
+    size_t vertexCount = 0;
+
+    for (auto _ : state) {
+        build(vertices);
+        vertexCount = vertices.size() / MESH_FLOATS_PER_VERTEX;
+        ExtractPositions(vertices.data(), vertexCount, positions, boundsMin, boundsMax);
+        benchmark::DoNotOptimize(positions.data());
+        benchmark::DoNotOptimize(boundsMin);
+        benchmark::DoNotOptimize(boundsMax);
+        benchmark::ClobberMemory();
+    }
+    state.SetItemsProcessed(state.iterations() * vertexCount);
+}
+BENCHMARK_CAPTURE(BM_BuildMesh, cube, BuildCubeVertices);
+BENCHMARK_CAPTURE(BM_BuildMesh, knife_handle, BuildKnifeHandleVertices);
+BENCHMARK_CAPTURE(BM_BuildMesh, knife_blade, BuildKnifeBladeVertices);
+BENCHMARK_CAPTURE(BM_BuildMesh, cutting_board, BuildCuttingBoardVertices);
+BENCHMARK_CAPTURE(BM_BuildMesh, plane, BuildPlaneVertices);
+BENCHMARK_CAPTURE(BM_BuildMesh, salami_ends, BuildSalamiEndsVertices);
+BENCHMARK_CAPTURE(BM_BuildMesh, salami_body, BuildSalamiBodyVertices);
+BENCHMARK_CAPTURE(BM_BuildMesh, cheese, BuildCheeseVertices);
+
+//welding plus the cache, overdraw and fetch ordering and the meshlets, for a scene mesh and for a
+//shuffled grid big enough that the cache ordering has real work to do
+static void BM_OptimizeMesh(benchmark::State& state, BuildVertices build)
+{
+    std::vector<float> vertices;
+    build(vertices);
+    const size_t vertexCount = vertices.size() / MESH_FLOATS_PER_VERTEX;
+    OptimizedMesh optimized;
+
+    for (auto _ : state) {
+        OptimizeMesh(vertices.data(), vertexCount, MESH_FLOATS_PER_VERTEX, optimized);
+        benchmark::DoNotOptimize(optimized.Indices.data());
+        benchmark::ClobberMemory();
+    }
+    state.SetItemsProcessed(state.iterations() * vertexCount / 3);
+    state.counters["acmr_before"] = optimized.Before.Acmr();
+    state.counters["acmr_after"] = optimized.After.Acmr();
+}
+
+//a 64x64 quad grid written out in a scrambled triangle order
+static void BuildShuffledGridVertices(std::vector<float>& vertices)
+{
+    const int size = 64;
+    vertices.clear();
+    for (int i = 0; i < size * size * 2; ++i) {
+        int cell = (int)(((unsigned)i * 2654435761u) % (unsigned)(size * size));
+        int x = cell % size, y = cell / size;
+        int corners[2][3][2] = { { { 0, 0 }, { 1, 0 }, { 1, 1 } }, { { 0, 0 }, { 1, 1 }, { 0, 1 } } };
+        for (int c = 0; c < 3; ++c) {
+            float px = (float)(x + corners[i & 1][c][0]), py = (float)(y + corners[i & 1][c][1]);
+            float vertex[MESH_FLOATS_PER_VERTEX] = { px, py, 0.0f, 0.0f, 0.0f, 1.0f, px / size, py / size };
+            vertices.insert(vertices.end(), vertex, vertex + MESH_FLOATS_PER_VERTEX);
+        }
+    }
+}
+BENCHMARK_CAPTURE(BM_OptimizeMesh, salami_body, BuildSalamiBodyVertices);
+BENCHMARK_CAPTURE(BM_OptimizeMesh, shuffled_grid, BuildShuffledGridVertices)->Unit(benchmark::kMillisecond);
+
+//what --vertex-format packed adds to each mesh upload
+static void BM_CompressMesh(benchmark::State& state, BuildVertices build)
+{
+    std::vector<float> vertices;
+    build(vertices);
+    const size_t vertexCount = vertices.size() / MESH_FLOATS_PER_VERTEX;
+    PackedMesh packed;
+
+    for (auto _ : state) {
+        CompressMesh(vertices.data(), vertexCount, packed);
+        benchmark::DoNotOptimize(packed.Vertices.data());
+        benchmark::ClobberMemory();
+    }
+    state.SetItemsProcessed(state.iterations() * vertexCount);
+}
+BENCHMARK_CAPTURE(BM_CompressMesh, salami_body, BuildSalamiBodyVertices);
+BENCHMARK_CAPTURE(BM_CompressMesh, cheese, BuildCheeseVertices);
+
+//software renders a grid of salami bodies small enough that the vertex stage dominates, from float
+//vertices or from packed ones (second argument)
+static void BM_SoftRenderVertices(benchmark::State& state)
+{
+    const int columns = (int)state.range(0);
+    const bool packed = state.range(1) != 0;
+    std::vector<float> source;
+    BuildSalamiBodyVertices(source);
+    OptimizedMesh mesh;
+    OptimizeMesh(source.data(), source.size() / MESH_FLOATS_PER_VERTEX, MESH_FLOATS_PER_VERTEX, mesh);
+    const size_t vertexCount = mesh.Vertices.size() / MESH_FLOATS_PER_VERTEX;
+    PackedMesh packedMesh;
+    CompressMesh(mesh.Vertices.data(), vertexCount, packedMesh);
+
+    const glm::mat4 view = glm::lookAt(glm::vec3(0.0f, 0.0f, (float)columns), glm::vec3(0.0f), glm::vec3(0.0f, 1.0f, 0.0f));
+    const glm::mat4 projection = glm::perspective(glm::radians(45.0f), 16.0f / 9.0f, 0.1f, 1000.0f);
+    SoftLight light = { glm::vec3(0.0f, 0.0f, 10.0f), glm::vec3(1.0f) };
+    SoftRenderer renderer;
+    renderer.Resize(320, 180);
+
+    for (auto _ : state) {
+        renderer.BeginFrame(view, projection, glm::vec3(0.0f, 0.0f, (float)columns), &light, 1, glm::vec3(0.0f));
+        for (int y = 0; y < columns; ++y) {
+            for (int x = 0; x < columns; ++x) {
+                glm::mat4 model = glm::translate(glm::mat4(1.0f), glm::vec3(x - columns * 0.5f, y - columns * 0.5f, 0.0f));
+                if (packed) {
+                    renderer.Draw(packedMesh.Vertices.data(), vertexCount, mesh.Indices.data(), mesh.Indices.size(),
+                        packedMesh.PositionOffset, packedMesh.PositionScale, model, nullptr, glm::vec2(1.0f), true);
+                }
+                else {
+                    renderer.Draw(mesh.Vertices.data(), vertexCount, mesh.Indices.data(), mesh.Indices.size(),
+                        model, nullptr, glm::vec2(1.0f), true);
+                }
+            }
+        }
+        renderer.EndFrame(gJobs);
+        benchmark::ClobberMemory();
+    }
+    state.SetItemsProcessed(state.iterations() * vertexCount * columns * columns);
+}
+BENCHMARK(BM_SoftRenderVertices)->ArgsProduct({ { 64, 256 }, { 0, 1 } })->Unit(benchmark::kMillisecond);
+
+//decode, flip and expand to RGBA as UCreateTexture does, then copy the result into a buffer the
+//size of the base level, which is what a synchronous glTexImage2D does with client memory
+static void BM_LoadTexture(benchmark::State& state, const char* name)
+{
+    const std::string path = TexturePath(name);
+    std::vector<unsigned char> pixels;
+    std::vector<unsigned char> upload;
+    size_t bytes = 0;
+
+    for (auto _ : state) {
+        int width, height, channels;
+        unsigned char* image = LoadTextureImage(path.c_str(), width, height, channels);
+        if (!image) {
+            state.SkipWithError(("can't read " + path).c_str());
+            break;
+        }
+        FlipImageVertically(image, width, height, channels, &gJobs);
+        bytes = (size_t)width * height * 4;
+        pixels.resize(bytes);
+        ExpandToRgba(image, width, height, channels, pixels.data(), &gJobs);
+        stbi_image_free(image);
+
+        upload.resize(bytes);
+        memcpy(upload.data(), pixels.data(), bytes);
+        benchmark::DoNotOptimize(upload.data());
+        benchmark::ClobberMemory();
+    }
+    state.SetBytesProcessed(state.iterations() * bytes);
+}
+BENCHMARK_CAPTURE(BM_LoadTexture, wood, "wood.jpg")->Unit(benchmark::kMillisecond);
+BENCHMARK_CAPTURE(BM_LoadTexture, metal, "metal.jpg")->Unit(benchmark::kMillisecond);
+BENCHMARK_CAPTURE(BM_LoadTexture, cutting_board, "CuttingBoard.jpg")->Unit(benchmark::kMillisecond);
+BENCHMARK_CAPTURE(BM_LoadTexture, counter, "Counter.jpg")->Unit(benchmark::kMillisecond);
+BENCHMARK_CAPTURE(BM_LoadTexture, cheese, "Cheese.jpg")->Unit(benchmark::kMillisecond);
+BENCHMARK_CAPTURE(BM_LoadTexture, salami_skin, "SalamiSkin.jpg")->Unit(benchmark::kMillisecond);
+BENCHMARK_CAPTURE(BM_LoadTexture, salami_inside, "SalamiInside.jpg")->Unit(benchmark::kMillisecond);
+
+//square RGB images, the layout the textures are loaded in. the second argument turns the job
+//system on so the single thread and the row parallel versions can be told apart
+static void BM_FlipImageVertically(benchmark::State& state)
+{
+    const int size = (int)state.range(0);
+    JobSystem* jobs = state.range(1) ? &gJobs : nullptr;
+    std::vector<unsigned char> image = MakeImage(size, 3);
+
+    for (auto _ : state) {
+        FlipImageVertically(image.data(), size, size, 3, jobs);
+        benchmark::DoNotOptimize(image.data());
+        benchmark::ClobberMemory();
+    }
+    state.SetBytesProcessed(state.iterations() * image.size() * 2);
+}
+BENCHMARK(BM_FlipImageVertically)->ArgsProduct({ { 256, 1024, 4096 }, { 0, 1 } });
+
+static void BM_ExpandRgbToRgba(benchmark::State& state)
+{
+    const int size = (int)state.range(0);
+    JobSystem* jobs = state.range(1) ? &gJobs : nullptr;
+    std::vector<unsigned char> image = MakeImage(size, 3);
+    std::vector<unsigned char> rgba((size_t)size * size * 4);
+
+    for (auto _ : state) {
+        ExpandToRgba(image.data(), size, size, 3, rgba.data(), jobs);
+        benchmark::DoNotOptimize(rgba.data());
+        benchmark::ClobberMemory();
+    }
+    state.SetBytesProcessed(state.iterations() * (image.size() + rgba.size()));
+}
+BENCHMARK(BM_ExpandRgbToRgba)->ArgsProduct({ { 256, 1024, 4096 }, { 0, 1 } });
+
+static void BM_PremultiplyAlpha(benchmark::State& state)
+{
+    const int size = (int)state.range(0);
+    JobSystem* jobs = state.range(1) ? &gJobs : nullptr;
+    const std::vector<unsigned char> source = MakeImage(size, 4);
+    std::vector<unsigned char> image = source;
+
+    for (auto _ : state) {
+        PremultiplyAlpha(image.data(), size, size, jobs);
+        benchmark::DoNotOptimize(image.data());
+        benchmark::ClobberMemory();
+    }
+    state.SetBytesProcessed(state.iterations() * image.size() * 2);
+}
+BENCHMARK(BM_PremultiplyAlpha)->ArgsProduct({ { 256, 1024, 4096 }, { 0, 1 } });
+
+//sRGB bytes to linear floats and back, the conversions either side of mip filtering
+static void BM_SrgbRoundTrip(benchmark::State& state)
+{
+    const int size = (int)state.range(0);
+    const std::vector<unsigned char> image = MakeImage(size, 4);
+    std::vector<float> linear(image.size());
+    std::vector<unsigned char> encoded(image.size());
+
+    for (auto _ : state) {
+        SrgbToLinear(image.data(), linear.data(), (size_t)size * size);
+        LinearToSrgb(linear.data(), encoded.data(), (size_t)size * size);
+        benchmark::DoNotOptimize(encoded.data());
+        benchmark::ClobberMemory();
+    }
+    state.SetItemsProcessed(state.iterations() * size * size);
+}
+BENCHMARK(BM_SrgbRoundTrip)->Arg(1024);
+
+//every level below the base, the work --mip-filter box|kaiser adds to each texture import
+static void BM_BuildMipChain(benchmark::State& state)
+{
+    const int size = (int)state.range(0);
+    const MipFilter filter = (MipFilter)state.range(1);
+    const std::vector<unsigned char> image = MakeImage(size, 4);
+    std::vector<MipLevel> levels;
+
+    for (auto _ : state) {
+        BuildMipChain(image.data(), size, size, filter, levels, &gJobs);
+        benchmark::DoNotOptimize(levels.data());
+        benchmark::ClobberMemory();
+    }
+    state.SetItemsProcessed(state.iterations() * size * size);
+}
+BENCHMARK(BM_BuildMipChain)->ArgsProduct({ { 1024, 2048 }, { MIP_FILTER_BOX, MIP_FILTER_KAISER } })->Unit(benchmark::kMillisecond);
+
+//what the viewer's first PBR run pays for its environment lighting, and every run after it from the cache
+static const EnvironmentParams BENCH_ENVIRONMENT = { glm::normalize(glm::vec3(4.0f, 8.5f, -3.0f)), glm::vec3(1.0f) };
+
+static void BM_BuildEnvironmentLighting(benchmark::State& state)
+{
+    EnvironmentLighting lighting;
+
+    for (auto _ : state) {
+        BuildEnvironmentLighting(gJobs, BENCH_ENVIRONMENT, lighting);
+        benchmark::DoNotOptimize(lighting.Brdf.data());
+        benchmark::ClobberMemory();
+    }
+}
+BENCHMARK(BM_BuildEnvironmentLighting)->Unit(benchmark::kMillisecond);
+
+static void BM_LoadEnvironmentLighting(benchmark::State& state)
+{
+    const char* filename = "environment_bench.ibl";
+    EnvironmentLighting lighting;
+    BuildEnvironmentLighting(gJobs, BENCH_ENVIRONMENT, lighting);
+    if (!SaveEnvironmentLighting(filename, BENCH_ENVIRONMENT, lighting)) {
+        state.SkipWithError("couldn't write the cache file");
+        return;
+    }
+
+    for (auto _ : state) {
+        bool loaded = LoadEnvironmentLighting(filename, BENCH_ENVIRONMENT, lighting);
+        benchmark::DoNotOptimize(loaded);
+    }
+    remove(filename);
+}
+BENCHMARK(BM_LoadEnvironmentLighting)->Unit(benchmark::kMillisecond);
+
+//a mouse move followed by the view matrix, which rebuilds the orientation and basis. the offsets
+//alternate so the pitch never sits on its clamp
+static void BM_CameraMouseAndView(benchmark::State& state)
+{
+    Camera camera(glm::vec3(0.0f, 0.0f, 7.0f));
+    float direction = 1.0f;
+
+    for (auto _ : state) {
+        camera.ProcessMouseMovement(3.0f * direction, 2.0f * direction);
+        direction = -direction;
+        benchmark::DoNotOptimize(camera.GetViewMatrix());
+    }
+    state.SetItemsProcessed(state.iterations());
+}
+BENCHMARK(BM_CameraMouseAndView);
+
+//the view matrix when nothing moved, it should only cost the check that it's up to date
+static void BM_CameraViewCached(benchmark::State& state)
+{
+    Camera camera(glm::vec3(0.0f, 0.0f, 7.0f));
+    camera.ProcessMouseMovement(3.0f, 2.0f);
+
+    for (auto _ : state) {
+        benchmark::DoNotOptimize(camera.GetViewMatrix());
+    }
+    state.SetItemsProcessed(state.iterations());
+}
+BENCHMARK(BM_CameraViewCached);
+
+BENCHMARK_MAIN();
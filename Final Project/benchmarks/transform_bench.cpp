@@ -0,0 +1,127 @@
+//compares building model matrices one object at a time with glm (the way URender used to)
+//against the batched structure of arrays kernel in transforms.h
+#include <benchmark/benchmark.h>
+
+#include <glm/glm.hpp>
+#include <glm/gtx/transform.hpp>
+#include <glm/gtc/quaternion.hpp>
+
+#include <random>
+#include <vector>
+
+#include "../Final Project/transforms.h"
+
+namespace
+{
+    //per object inputs for the glm path, same values as the SoA copy
+    struct ObjectTransform
+    {
+        glm::vec3 position;
+        float angle;
+        glm::vec3 axis;
+        glm::vec3 scale;
+    };
+
+    void MakeScene(size_t count, std::vector<ObjectTransform>& objects, TransformSoA& transforms)
+    {
+        std::mt19937 random(330);
+        std::uniform_real_distribution<float> position(-50.0f, 50.0f);
+        std::uniform_real_distribution<float> unit(-1.0f, 1.0f);
+        std::uniform_real_distribution<float> scale(0.25f, 4.0f);
+
+        objects.resize(count);
+        for (ObjectTransform& object : objects) {
+            object.position = glm::vec3(position(random), position(random), position(random));
+            object.angle = unit(random) * 3.14159f;
+            object.axis = glm::normalize(glm::vec3(unit(random), unit(random), unit(random)) + glm::vec3(0.0f, 0.01f, 0.0f));
+            object.scale = glm::vec3(scale(random), scale(random), scale(random));
+
+            transforms.Add(object.position, glm::angleAxis(object.angle, object.axis), object.scale, TRANSLATE_ROTATE_SCALE);
+        }
+    }
+
+    glm::mat4 MakeViewProjection()
+    {
+        glm::mat4 view = glm::lookAt(glm::vec3(0.0f, 3.0f, 7.0f), glm::vec3(0.0f), glm::vec3(0.0f, 1.0f, 0.0f));
+        return glm::perspective(45.0f, 1600.0f / 900.0f, 0.1f, 100.0f) * view;
+    }
+}
+
+static void BM_GlmModelMatrices(benchmark::State& state)
+{
+    std::vector<ObjectTransform> objects;
+    TransformSoA transforms;
+    MakeScene((size_t)state.range(0), objects, transforms);
+    std::vector<glm::mat4> models(objects.size());
+
+    for (auto _ : state) {
+        for (size_t i = 0; i < objects.size(); ++i) {
+            glm::mat4 scale = glm::scale(objects[i].scale);
+            glm::mat4 rotation = glm::rotate(objects[i].angle, objects[i].axis);
+            glm::mat4 translation = glm::translate(objects[i].position);
+            models[i] = translation * rotation * scale;
+        }
+        benchmark::DoNotOptimize(models.data());
+        benchmark::ClobberMemory();
+    }
+    state.SetItemsProcessed(state.iterations() * state.range(0));
+}
+BENCHMARK(BM_GlmModelMatrices)->RangeMultiplier(8)->Range(1 << 10, 1 << 17);
+
+static void BM_BatchModelMatrices(benchmark::State& state)
+{
+    std::vector<ObjectTransform> objects;
+    TransformSoA transforms;
+    MakeScene((size_t)state.range(0), objects, transforms);
+    std::vector<glm::mat4> models(transforms.Size());
+
+    for (auto _ : state) {
+        ComposeWorldMatrices(transforms, 0, transforms.Size(), models.data());
+        benchmark::DoNotOptimize(models.data());
+        benchmark::ClobberMemory();
+    }
+    state.SetItemsProcessed(state.iterations() * state.range(0));
+}
+BENCHMARK(BM_BatchModelMatrices)->RangeMultiplier(8)->Range(1 << 10, 1 << 17);
+
+static void BM_GlmViewProjection(benchmark::State& state)
+{
+    std::vector<ObjectTransform> objects;
+    TransformSoA transforms;
+    MakeScene((size_t)state.range(0), objects, transforms);
+    std::vector<glm::mat4> models(transforms.Size());
+    std::vector<glm::mat4> clip(transforms.Size());
+    ComposeWorldMatrices(transforms, 0, transforms.Size(), models.data());
+    const glm::mat4 viewProjection = MakeViewProjection();
+
+    for (auto _ : state) {
+        for (size_t i = 0; i < models.size(); ++i) {
+            clip[i] = viewProjection * models[i];
+        }
+        benchmark::DoNotOptimize(clip.data());
+        benchmark::ClobberMemory();
+    }
+    state.SetItemsProcessed(state.iterations() * state.range(0));
+}
+BENCHMARK(BM_GlmViewProjection)->RangeMultiplier(8)->Range(1 << 10, 1 << 17);
+
+static void BM_BatchViewProjection(benchmark::State& state)
+{
+    std::vector<ObjectTransform> objects;
+    TransformSoA transforms;
+    MakeScene((size_t)state.range(0), objects, transforms);
+    std::vector<glm::mat4> models(transforms.Size());
+    std::vector<glm::mat4> clip(transforms.Size());
+    ComposeWorldMatrices(transforms, 0, transforms.Size(), models.data());
+    const glm::mat4 viewProjection = MakeViewProjection();
+
+    for (auto _ : state) {
+        MultiplyViewProjection(viewProjection, models.data(), models.size(), clip.data());
+        benchmark::DoNotOptimize(clip.data());
+        benchmark::ClobberMemory();
+    }
+    state.SetItemsProcessed(state.iterations() * state.range(0));
+}
+BENCHMARK(BM_BatchViewProjection)->RangeMultiplier(8)->Range(1 << 10, 1 << 17);
+
+BENCHMARK_MAIN();
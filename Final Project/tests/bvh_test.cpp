@@ -0,0 +1,342 @@
+//the scene BVH against a plain loop over every triangle: closest ray hits, box queries and frustum
+//queries on a random scene, built and then again after objects move and the boxes are refit
+#include <glm/glm.hpp>
+#include <glm/gtc/matrix_transform.hpp>
+
+#include <algorithm>
+#include <cfloat>
+#include <cmath>
+#include <cstdint>
+#include <random>
+#include <vector>
+
+#include "../Final Project/bvh.h"
+#include "check.h"
+
+namespace
+{
+    const int OBJECT_COUNT = 60;
+    const int QUERY_COUNT = 2000;
+
+    struct Triangle {
+        glm::vec3 V0, V1, V2;
+        uint32_t Object;
+        uint32_t Index;
+    };
+
+    //local corners and model matrix of every object, kept alongside the BVH for the brute force side
+    struct Scene {
+        std::vector<std::vector<glm::vec3> > Corners;
+        std::vector<glm::mat4> Models;
+        Bvh Tree;
+    };
+
+    glm::mat4 RandomModel(std::mt19937& random, float spread)
+    {
+        std::uniform_real_distribution<float> position(-spread, spread);
+        std::uniform_real_distribution<float> unit(-1.0f, 1.0f);
+        std::uniform_real_distribution<float> scale(0.5f, 2.0f);
+        glm::vec3 axis(unit(random), unit(random), unit(random) + 1.5f);
+        glm::mat4 model = glm::translate(glm::mat4(1.0f), glm::vec3(position(random), position(random), position(random)));
+        model = glm::rotate(model, unit(random) * 3.0f, glm::normalize(axis));
+        return glm::scale(model, glm::vec3(scale(random), scale(random), scale(random)));
+    }
+
+    //clusters of up to a few dozen triangles, so leaves hold pieces of one object and of several
+    void BuildScene(unsigned int seed, Scene& scene)
+    {
+        std::mt19937 random(seed);
+        std::uniform_real_distribution<float> corner(-1.5f, 1.5f);
+        std::uniform_int_distribution<int> triangles(1, 30);
+        for (int object = 0; object < OBJECT_COUNT; ++object) {
+            std::vector<glm::vec3> corners((size_t)triangles(random) * 3);
+            for (glm::vec3& c : corners) {
+                c = glm::vec3(corner(random), corner(random), corner(random));
+            }
+            glm::mat4 model = RandomModel(random, 20.0f);
+            scene.Tree.AddObject(corners.data(), corners.size(), model);
+            scene.Corners.push_back(corners);
+            scene.Models.push_back(model);
+        }
+        scene.Tree.Build();
+    }
+
+    std::vector<Triangle> WorldTriangles(const Scene& scene)
+    {
+        std::vector<Triangle> triangles;
+        for (size_t object = 0; object < scene.Corners.size(); ++object) {
+            const std::vector<glm::vec3>& corners = scene.Corners[object];
+            const glm::mat4& model = scene.Models[object];
+            for (size_t i = 0; i < corners.size() / 3; ++i) {
+                Triangle t;
+                t.V0 = glm::vec3(model * glm::vec4(corners[i * 3], 1.0f));
+                t.V1 = glm::vec3(model * glm::vec4(corners[i * 3 + 1], 1.0f));
+                t.V2 = glm::vec3(model * glm::vec4(corners[i * 3 + 2], 1.0f));
+                t.Object = (uint32_t)object;
+                t.Index = (uint32_t)i;
+                triangles.push_back(t);
+            }
+        }
+        return triangles;
+    }
+
+    //moller trumbore, FLT_MAX on a miss
+    float RayDistance(const Ray& ray, const Triangle& t)
+    {
+        glm::vec3 edge1 = t.V1 - t.V0;
+        glm::vec3 edge2 = t.V2 - t.V0;
+        glm::vec3 p = glm::cross(ray.Direction, edge2);
+        float determinant = glm::dot(edge1, p);
+        if (fabsf(determinant) < 1e-12f) {
+            return FLT_MAX;
+        }
+        float inverseDeterminant = 1.0f / determinant;
+        glm::vec3 s = ray.Origin - t.V0;
+        float u = glm::dot(s, p) * inverseDeterminant;
+        glm::vec3 q = glm::cross(s, edge1);
+        float v = glm::dot(ray.Direction, q) * inverseDeterminant;
+        float distance = glm::dot(edge2, q) * inverseDeterminant;
+        if (u < 0.0f || u > 1.0f || v < 0.0f || u + v > 1.0f || distance <= 0.0f) {
+            return FLT_MAX;
+        }
+        return distance;
+    }
+
+    glm::vec3 TriangleMin(const Triangle& t)
+    {
+        return glm::min(t.V0, glm::min(t.V1, t.V2));
+    }
+
+    glm::vec3 TriangleMax(const Triangle& t)
+    {
+        return glm::max(t.V0, glm::max(t.V1, t.V2));
+    }
+
+    bool BoxesOverlap(const glm::vec3& aMin, const glm::vec3& aMax, const glm::vec3& bMin, const glm::vec3& bMax)
+    {
+        return aMin.x <= bMax.x && aMax.x >= bMin.x && aMin.y <= bMax.y && aMax.y >= bMin.y && aMin.z <= bMax.z && aMax.z >= bMin.z;
+    }
+
+    //a box clearly in front of all six clip planes, at least one corner past each by a margin so
+    //rounding right on a plane doesn't decide the outcome
+    bool BoxInFrustum(const glm::mat4& viewProjection, const glm::vec3& min, const glm::vec3& max)
+    {
+        for (int plane = 0; plane < 6; ++plane) {
+            int row = plane / 2;
+            float side = plane % 2 ? 1.0f : -1.0f;
+            bool anyInside = false;
+            for (int corner = 0; corner < 8 && !anyInside; ++corner) {
+                glm::vec4 point((corner & 1) ? max.x : min.x, (corner & 2) ? max.y : min.y, (corner & 4) ? max.z : min.z, 1.0f);
+                glm::vec4 clip = viewProjection * point;
+                anyInside = clip.w + side * clip[row] > 1.0e-3f * std::max(1.0f, fabsf(clip.w));
+            }
+            if (!anyInside) {
+                return false;
+            }
+        }
+        return true;
+    }
+
+    std::vector<bool> AsSet(const std::vector<uint32_t>& ids, bool& duplicates)
+    {
+        std::vector<bool> set(OBJECT_COUNT, false);
+        duplicates = false;
+        for (uint32_t id : ids) {
+            if (id >= (uint32_t)OBJECT_COUNT || set[id]) {
+                duplicates = true;
+                continue;
+            }
+            set[id] = true;
+        }
+        return set;
+    }
+
+    void CheckRays(const Scene& scene, unsigned int seed)
+    {
+        std::vector<Triangle> triangles = WorldTriangles(scene);
+        std::mt19937 random(seed);
+        std::uniform_real_distribution<float> position(-30.0f, 30.0f);
+        std::uniform_real_distribution<float> unit(-1.0f, 1.0f);
+        std::uniform_real_distribution<float> barycentric(0.05f, 0.45f);
+        std::uniform_int_distribution<size_t> pick(0, triangles.size() - 1);
+
+        int hits = 0;
+        for (int i = 0; i < QUERY_COUNT; ++i) {
+            Ray ray;
+            ray.Origin = glm::vec3(position(random), position(random), position(random));
+            if (i % 2 == 0) {
+                //aimed inside a triangle so most of these hit something, not always the one aimed at
+                const Triangle& t = triangles[pick(random)];
+                float u = barycentric(random), v = barycentric(random);
+                ray.Direction = t.V0 + (t.V1 - t.V0) * u + (t.V2 - t.V0) * v - ray.Origin;
+            }
+            else {
+                ray.Direction = glm::vec3(unit(random), unit(random), unit(random));
+            }
+            //every fourth ray is cut short, the rest run to the end
+            float maxDistance = i % 4 == 1 ? 0.5f : FLT_MAX;
+
+            float closest = maxDistance;
+            for (const Triangle& t : triangles) {
+                closest = std::min(closest, RayDistance(ray, t));
+            }
+            bool expected = closest < maxDistance;
+
+            RayHit hit = scene.Tree.Intersect(ray, maxDistance);
+            CHECK(hit.Hit == expected);
+            if (!hit.Hit || !expected) {
+                continue;
+            }
+            ++hits;
+            CHECK_NEAR(hit.Distance, closest, 1.0e-5 * std::max(1.0f, closest));
+
+            //the reported triangle is one at that distance, ties between objects can go either way
+            bool found = false;
+            for (const Triangle& t : triangles) {
+                if (t.Object == hit.Object && t.Index == hit.Triangle) {
+                    found = RayDistance(ray, t) == hit.Distance;
+                    CHECK(hit.Normal == glm::normalize(glm::cross(t.V1 - t.V0, t.V2 - t.V0)) || hit.Normal == -glm::normalize(glm::cross(t.V1 - t.V0, t.V2 - t.V0)));
+                }
+            }
+            CHECK(found);
+            CHECK(glm::dot(hit.Normal, ray.Direction) <= 0.0f);
+            CHECK(glm::length(hit.Position - (ray.Origin + ray.Direction * hit.Distance)) <= 1.0e-4f);
+        }
+        //the aimed rays have to have exercised the hit path
+        CHECK(hits > QUERY_COUNT / 4);
+    }
+
+    void CheckBoxes(const Scene& scene, unsigned int seed)
+    {
+        std::vector<Triangle> triangles = WorldTriangles(scene);
+        std::mt19937 random(seed);
+        std::uniform_real_distribution<float> position(-30.0f, 30.0f);
+        std::uniform_real_distribution<float> size(0.0f, 8.0f);
+
+        std::vector<uint32_t> ids;
+        for (int i = 0; i < QUERY_COUNT; ++i) {
+            glm::vec3 min(position(random), position(random), position(random));
+            glm::vec3 max = min + glm::vec3(size(random), size(random), size(random));
+
+            std::vector<bool> expected(OBJECT_COUNT, false);
+            for (const Triangle& t : triangles) {
+                if (BoxesOverlap(TriangleMin(t), TriangleMax(t), min, max)) {
+                    expected[t.Object] = true;
+                }
+            }
+
+            scene.Tree.QueryBox(min, max, ids);
+            bool duplicates;
+            CHECK(AsSet(ids, duplicates) == expected);
+            CHECK(!duplicates);
+        }
+    }
+
+    void CheckFrusta(const Scene& scene, unsigned int seed)
+    {
+        std::vector<Triangle> triangles = WorldTriangles(scene);
+        std::mt19937 random(seed);
+        std::uniform_real_distribution<float> position(-40.0f, 40.0f);
+        std::uniform_real_distribution<float> fov(0.2f, 1.5f);
+        std::uniform_real_distribution<float> aspect(0.5f, 2.5f);
+
+        std::vector<uint32_t> ids;
+        for (int i = 0; i < QUERY_COUNT / 4; ++i) {
+            glm::vec3 eye(position(random), position(random), position(random));
+            glm::vec3 target(position(random), position(random), position(random));
+            glm::mat4 view = glm::lookAt(eye, target, glm::vec3(0.0f, 1.0f, 0.0f));
+            glm::mat4 projection = i % 3 == 0
+                ? glm::ortho(-15.0f, 15.0f, -10.0f, 10.0f, 0.1f, 60.0f)
+                : glm::perspective(fov(random), aspect(random), 0.1f, 20.0f + position(random) + 40.0f);
+            glm::mat4 viewProjection = projection * view;
+
+            scene.Tree.QueryFrustum(viewProjection, ids);
+            bool duplicates;
+            std::vector<bool> visible = AsSet(ids, duplicates);
+            CHECK(!duplicates);
+
+            //whole subtrees are accepted at once, so objects near the view can come back too. anything
+            //with a triangle inside has to
+            for (const Triangle& t : triangles) {
+                if (BoxInFrustum(viewProjection, TriangleMin(t), TriangleMax(t))) {
+                    CHECK(visible[t.Object]);
+                }
+            }
+        }
+
+        //looking away from the whole scene sees nothing, backing off far enough sees all of it
+        glm::mat4 away = glm::perspective(0.5f, 1.0f, 0.1f, 10.0f) * glm::lookAt(glm::vec3(0.0f, 0.0f, 200.0f), glm::vec3(0.0f, 0.0f, 300.0f), glm::vec3(0.0f, 1.0f, 0.0f));
+        scene.Tree.QueryFrustum(away, ids);
+        CHECK(ids.empty());
+        glm::mat4 all = glm::perspective(1.2f, 1.0f, 0.1f, 1000.0f) * glm::lookAt(glm::vec3(0.0f, 0.0f, 200.0f), glm::vec3(0.0f), glm::vec3(0.0f, 1.0f, 0.0f));
+        scene.Tree.QueryFrustum(all, ids);
+        CHECK(ids.size() == (size_t)OBJECT_COUNT);
+    }
+
+    //moves every other object a little, the way animated objects drift from where the build put them
+    void MoveObjects(Scene& scene, unsigned int seed)
+    {
+        std::mt19937 random(seed);
+        for (size_t object = 0; object < scene.Models.size(); object += 2) {
+            scene.Models[object] = RandomModel(random, 3.0f) * scene.Models[object];
+            scene.Tree.SetObjectTransform((uint32_t)object, scene.Models[object]);
+        }
+        scene.Tree.Refit();
+    }
+}
+
+TEST_CASE(bvh, build)
+{
+    Scene scene;
+    BuildScene(1, scene);
+    CHECK(scene.Tree.TriangleCount() == WorldTriangles(scene).size());
+    CHECK(scene.Tree.NodeCount() > 1);
+
+    //empty trees answer every query with nothing
+    Bvh empty;
+    empty.Build();
+    Ray ray = { glm::vec3(0.0f), glm::vec3(0.0f, 0.0f, 1.0f) };
+    CHECK(!empty.Intersect(ray).Hit);
+    std::vector<uint32_t> ids(1, 7);
+    empty.QueryBox(glm::vec3(-1.0f), glm::vec3(1.0f), ids);
+    CHECK(ids.empty());
+}
+
+TEST_CASE(bvh, intersect)
+{
+    Scene scene;
+    BuildScene(2, scene);
+    CheckRays(scene, 20);
+}
+
+TEST_CASE(bvh, query_box)
+{
+    Scene scene;
+    BuildScene(3, scene);
+    CheckBoxes(scene, 30);
+}
+
+TEST_CASE(bvh, query_frustum)
+{
+    Scene scene;
+    BuildScene(4, scene);
+    CheckFrusta(scene, 40);
+}
+
+TEST_CASE(bvh, after_refit)
+{
+    //several rounds of moves, each refit on top of the last without a rebuild
+    Scene scene;
+    BuildScene(5, scene);
+    for (unsigned int round = 0; round < 3; ++round) {
+        MoveObjects(scene, 50 + round);
+        CheckRays(scene, 60 + round);
+        CheckBoxes(scene, 70 + round);
+        CheckFrusta(scene, 80 + round);
+    }
+
+    //setting the same matrix again leaves nothing to refit
+    scene.Tree.SetObjectTransform(1, scene.Models[1]);
+    scene.Tree.Refit();
+    CheckRays(scene, 90);
+}
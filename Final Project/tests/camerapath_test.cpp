@@ -0,0 +1,146 @@
+//recorded camera paths: the file round trip including older versions, idle stretches collapsing
+//into one key, and playback hitting the keys and resolving single steps late into a long run
+#include <cstdint>
+#include <cstdio>
+#include <string>
+#include <vector>
+
+#include "../Final Project/camerapath.h"
+#include "check.h"
+
+namespace
+{
+    //written next to the test binary, CTest runs it in the build folder
+    std::string TempPath(const char* name)
+    {
+        return std::string("camerapath_test_") + name;
+    }
+
+    void SetCamera(Camera& camera, float x, float yaw, float pitch, float roll)
+    {
+        camera.SetPose(glm::vec3(x, 1.0f, -x * 0.5f), yaw, pitch, roll);
+    }
+}
+
+TEST_CASE(camerapath, save_load)
+{
+    CameraPath path;
+    Camera camera;
+    for (int i = 0; i < 50; ++i) {
+        SetCamera(camera, i * 0.1f, -90.0f + i, i * 0.5f - 10.0f, i * 0.25f);
+        path.Record(1000.0 + i / 120.0, camera);
+    }
+
+    std::string file = TempPath("save_load.path");
+    CHECK(path.Save(file.c_str()));
+    CameraPath loaded;
+    CHECK(loaded.Load(file.c_str()));
+    CHECK(loaded.Keys.size() == path.Keys.size());
+    for (size_t i = 0; i < loaded.Keys.size() && i < path.Keys.size(); ++i) {
+        CHECK(loaded.Keys[i].Time == path.Keys[i].Time);
+        CHECK(loaded.Keys[i].Position == path.Keys[i].Position);
+        CHECK(loaded.Keys[i].Yaw == path.Keys[i].Yaw && loaded.Keys[i].Pitch == path.Keys[i].Pitch && loaded.Keys[i].Roll == path.Keys[i].Roll);
+    }
+    remove(file.c_str());
+
+    CHECK(!loaded.Load(TempPath("missing.path").c_str()));
+    CHECK(loaded.Keys.empty());
+}
+
+TEST_CASE(camerapath, older_versions)
+{
+    //version 1 keys are time, position, yaw and pitch, version 2 adds roll, both with a float time
+    const float keys[2][7] = { { 0.0f, 1.0f, 2.0f, 3.0f, -90.0f, 5.0f, 6.0f }, { 0.5f, 2.0f, 3.0f, 4.0f, -80.0f, 6.0f, 7.0f } };
+    for (uint32_t version = 1; version <= 2; ++version) {
+        std::string file = TempPath("old.path");
+        FILE* out = fopen(file.c_str(), "wb");
+        CHECK(out != nullptr);
+        if (out == nullptr) {
+            continue;
+        }
+        uint32_t count = 2;
+        fwrite(CAMERA_PATH_MAGIC, 1, sizeof(CAMERA_PATH_MAGIC), out);
+        fwrite(&version, sizeof(version), 1, out);
+        fwrite(&count, sizeof(count), 1, out);
+        for (const float* key : keys) {
+            fwrite(key, sizeof(float), version == 1 ? 6 : 7, out);
+        }
+        fclose(out);
+
+        CameraPath path;
+        CHECK(path.Load(file.c_str()));
+        CHECK(path.Keys.size() == 2);
+        if (path.Keys.size() == 2) {
+            CHECK(path.Keys[1].Time == 0.5);
+            CHECK(path.Keys[1].Position == glm::vec3(2.0f, 3.0f, 4.0f));
+            CHECK(path.Keys[1].Yaw == -80.0f && path.Keys[1].Pitch == 6.0f);
+            CHECK(path.Keys[1].Roll == (version == 1 ? 0.0f : 7.0f));
+        }
+        remove(file.c_str());
+    }
+}
+
+TEST_CASE(camerapath, idle_collapses)
+{
+    CameraPath path;
+    Camera camera;
+    SetCamera(camera, 0.0f, -90.0f, 0.0f, 0.0f);
+    for (int i = 0; i < 100; ++i) {
+        path.Record(i / 120.0, camera);
+    }
+    //the pose is held by two keys, the second stretched to the latest time
+    CHECK(path.Keys.size() == 2);
+    CHECK(path.Duration() == 99 / 120.0);
+
+    //times that don't move forward are ignored
+    SetCamera(camera, 1.0f, -90.0f, 0.0f, 0.0f);
+    path.Record(0.5, camera);
+    CHECK(path.Keys.size() == 2);
+}
+
+TEST_CASE(camerapath, sample)
+{
+    CameraPath path;
+    Camera camera;
+    for (int i = 0; i < 10; ++i) {
+        SetCamera(camera, (float)i, -90.0f + 2.0f * i, 0.0f, 0.0f);
+        path.Record(i * 0.5, camera);
+    }
+
+    //keys come back exactly, a straight path stays straight between them
+    Camera played;
+    for (int i = 0; i < 9; ++i) {
+        CHECK(path.Sample(i * 0.5, played));
+        CHECK_NEAR(played.Position.x, (float)i, 1.0e-5);
+        CHECK_NEAR(played.Yaw(), -90.0f + 2.0f * i, 1.0e-4);
+    }
+    CHECK(path.Sample(1.25, played));
+    CHECK_NEAR(played.Position.x, 2.5, 1.0e-5);
+    CHECK_NEAR(played.Yaw(), -85.0, 1.0e-4);
+
+    //before the start holds the first key, the end stops playback on the last
+    CHECK(path.Sample(-1.0, played));
+    CHECK_NEAR(played.Position.x, 0.0, 0.0);
+    CHECK(!path.Sample(100.0, played));
+    CHECK_NEAR(played.Position.x, 9.0, 0.0);
+}
+
+TEST_CASE(camerapath, long_run_resolves_steps)
+{
+    //a day into a run a float time can't tell 1/120 s steps apart, the recorded keys still can
+    const double start = 86400.0;
+    const double step = 1.0 / 120.0;
+    CameraPath path;
+    Camera camera;
+    for (int i = 0; i < 8; ++i) {
+        SetCamera(camera, (float)i, -90.0f, 0.0f, 0.0f);
+        path.Record(start + i * step, camera);
+    }
+    CHECK(path.Keys.size() == 8);
+
+    Camera played;
+    for (int i = 0; i < 7; ++i) {
+        CHECK(path.Sample(start + (i + 0.5) * step, played));
+        CHECK_NEAR(played.Position.x, i + 0.5, 1.0e-3);
+    }
+}
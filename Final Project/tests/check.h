@@ -0,0 +1,73 @@
+//a few macros standing in for a test framework, so the CPU tests build with nothing more than the
+//programs need. TEST_CASE registers a function under a suite, CHECK records a failure and carries
+//on so one run reports every broken case. main.cpp runs the suites named on its command line
+#ifndef CHECK_H
+#define CHECK_H
+
+#include <cmath>
+#include <cstdio>
+#include <vector>
+
+//failures past this many in one run are counted but not printed, a broken kernel in a loop would
+//otherwise flood the log
+const int MAX_PRINTED_FAILURES = 25;
+
+struct TestCase {
+    const char* Suite;
+    const char* Name;
+    void (*Run)();
+};
+
+inline std::vector<TestCase>& TestCases()
+{
+    static std::vector<TestCase> cases;
+    return cases;
+}
+
+inline int& TestFailures()
+{
+    static int failures = 0;
+    return failures;
+}
+
+inline void ReportFailure(const char* file, int line, const char* expression)
+{
+    if (++TestFailures() <= MAX_PRINTED_FAILURES) {
+        printf("%s:%d: CHECK(%s) failed\n", file, line, expression);
+    }
+}
+
+inline void ReportFailure(const char* file, int line, const char* expression, double actual, double expected)
+{
+    if (++TestFailures() <= MAX_PRINTED_FAILURES) {
+        printf("%s:%d: CHECK_NEAR(%s) failed, %.9g against %.9g\n", file, line, expression, actual, expected);
+    }
+}
+
+struct TestRegistration {
+    TestRegistration(const char* suite, const char* name, void (*run)()) {
+        TestCases().push_back(TestCase{ suite, name, run });
+    }
+};
+
+#define TEST_CASE(suite, name) \
+    static void suite##_##name(); \
+    static TestRegistration suite##_##name##_registration(#suite, #name, suite##_##name); \
+    static void suite##_##name()
+
+#define CHECK(condition) \
+    do { \
+        if (!(condition)) { \
+            ReportFailure(__FILE__, __LINE__, #condition); \
+        } \
+    } while (0)
+
+//passes when actual is within tolerance of expected, NaN never passes
+#define CHECK_NEAR(actual, expected, tolerance) \
+    do { \
+        double checkActual = (double)(actual), checkExpected = (double)(expected); \
+        if (!(std::fabs(checkActual - checkExpected) <= (double)(tolerance))) { \
+            ReportFailure(__FILE__, __LINE__, #actual ", " #expected, checkActual, checkExpected); \
+        } \
+    } while (0)
+#endif
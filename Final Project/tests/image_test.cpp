@@ -0,0 +1,202 @@
+//the texture kernels in image.h against plain per pixel versions of the same formulas, at sizes that
+//leave a tail after the SIMD loops and big enough to go through the job system
+#include <cstdint>
+#include <cstring>
+#include <random>
+#include <vector>
+
+#include "../Final Project/image.h"
+#include "check.h"
+
+namespace
+{
+    //four workers whatever the machine, so the row splitting is exercised on a single core too
+    JobSystem gJobs(4);
+
+    std::vector<unsigned char> RandomBytes(size_t count, unsigned int seed)
+    {
+        std::mt19937 random(seed);
+        std::vector<unsigned char> bytes(count);
+        for (unsigned char& byte : bytes) {
+            byte = (unsigned char)(random() & 0xff);
+        }
+        return bytes;
+    }
+}
+
+TEST_CASE(image, expand_to_rgba)
+{
+    for (int channels = 1; channels <= 4; ++channels) {
+        for (size_t pixels : { 1, 2, 3, 5, 6, 7, 17, 33 }) {
+            std::vector<unsigned char> source = RandomBytes(pixels * channels, (unsigned int)(pixels * 4 + channels));
+            std::vector<unsigned char> rgba(pixels * 4);
+            ExpandPixelsToRgba(source.data(), channels, rgba.data(), pixels);
+
+            for (size_t i = 0; i < pixels; ++i) {
+                const unsigned char* in = &source[i * channels];
+                unsigned char expected[4] = { in[0], in[0], in[0], 255 };
+                if (channels >= 3) {
+                    expected[1] = in[1];
+                    expected[2] = in[2];
+                }
+                if (channels == 2 || channels == 4) {
+                    expected[3] = in[channels - 1];
+                }
+                CHECK(memcmp(&rgba[i * 4], expected, 4) == 0);
+            }
+        }
+    }
+
+    //big enough to be split into rows across the workers
+    const int width = 1023, height = 700;
+    std::vector<unsigned char> source = RandomBytes((size_t)width * height * 3, 3);
+    std::vector<unsigned char> split((size_t)width * height * 4), whole(split.size());
+    ExpandToRgba(source.data(), width, height, 3, split.data(), &gJobs);
+    ExpandPixelsToRgba(source.data(), 3, whole.data(), (size_t)width * height);
+    CHECK(split == whole);
+}
+
+TEST_CASE(image, premultiply_every_value)
+{
+    //every color and alpha pair once, 256 pixels per alpha
+    std::vector<unsigned char> original(256 * 256 * 4);
+    for (int alpha = 0; alpha < 256; ++alpha) {
+        for (int color = 0; color < 256; ++color) {
+            unsigned char* pixel = &original[((size_t)alpha * 256 + color) * 4];
+            pixel[0] = (unsigned char)color;
+            pixel[1] = (unsigned char)(255 - color);
+            pixel[2] = (unsigned char)(color ^ 0x55);
+            pixel[3] = (unsigned char)alpha;
+        }
+    }
+
+    //all at once goes through the SIMD loop, three at a time through the scalar tail only
+    for (size_t piece : { (size_t)256 * 256, (size_t)3 }) {
+        std::vector<unsigned char> rgba = original;
+        for (size_t start = 0; start < 256 * 256; start += piece) {
+            PremultiplyPixels(&rgba[start * 4], std::min(piece, 256 * 256 - start));
+        }
+
+        for (size_t i = 0; i < 256 * 256; ++i) {
+            for (int c = 0; c < 3; ++c) {
+                CHECK(rgba[i * 4 + c] == (int)floor(original[i * 4 + c] * original[i * 4 + 3] / 255.0 + 0.5));
+            }
+            CHECK(rgba[i * 4 + 3] == original[i * 4 + 3]);
+        }
+    }
+}
+
+TEST_CASE(image, flip_vertically)
+{
+    for (int height : { 1, 2, 5, 700 }) {
+        const int width = 1001, channels = 3;
+        const size_t rowBytes = (size_t)width * channels;
+        std::vector<unsigned char> image = RandomBytes(rowBytes * height, (unsigned int)height);
+        std::vector<unsigned char> original = image;
+        FlipImageVertically(image.data(), width, height, channels, &gJobs);
+
+        for (int y = 0; y < height; ++y) {
+            CHECK(memcmp(&image[y * rowBytes], &original[(height - 1 - y) * rowBytes], rowBytes) == 0);
+        }
+    }
+}
+
+TEST_CASE(image, srgb_round_trip)
+{
+    //every 8 bit value decodes and encodes back to itself, in the SIMD loop and the tail
+    std::vector<unsigned char> rgba(256 * 4), back(256 * 4);
+    for (int i = 0; i < 256; ++i) {
+        for (int c = 0; c < 4; ++c) {
+            rgba[i * 4 + c] = (unsigned char)((i + c * 61) & 0xff);
+        }
+    }
+    std::vector<float> linear(256 * 4);
+    SrgbToLinear(rgba.data(), linear.data(), 256);
+    LinearToSrgb(linear.data(), back.data(), 256);
+    CHECK(back == rgba);
+
+    //the decode is the sRGB curve, out of range values clamp
+    CHECK_NEAR(linear[0], 0.0, 0.0);
+    CHECK_NEAR(SrgbTables::Get().Decode[128], pow((128 / 255.0 + 0.055) / 1.055, 2.4), 1.0e-6);
+    float outside[8] = { -1.0f, 2.0f, 0.5f, 3.0f, 1.0f, -0.5f, 0.0f, -2.0f };
+    unsigned char clamped[8];
+    LinearToSrgb(outside, clamped, 2);
+    CHECK(clamped[0] == 0 && clamped[1] == 255 && clamped[3] == 255);
+    CHECK(clamped[4] == 255 && clamped[5] == 0 && clamped[6] == 0 && clamped[7] == 0);
+}
+
+TEST_CASE(image, downsample_box)
+{
+    //odd sizes repeat their last row and column
+    const int width = 7, height = 5, outWidth = 3, outHeight = 2;
+    std::vector<float> source((size_t)width * height * 4);
+    for (size_t i = 0; i < source.size(); ++i) {
+        source[i] = (float)(i % 13) * 0.25f;
+    }
+    std::vector<float> destination((size_t)outWidth * outHeight * 4);
+    DownsampleBox(source.data(), width, height, destination.data(), outWidth, outHeight);
+
+    for (int y = 0; y < outHeight; ++y) {
+        for (int x = 0; x < outWidth; ++x) {
+            for (int c = 0; c < 4; ++c) {
+                float sum = 0.0f;
+                for (int dy = 0; dy < 2; ++dy) {
+                    for (int dx = 0; dx < 2; ++dx) {
+                        int sy = std::min(2 * y + dy, height - 1), sx = std::min(2 * x + dx, width - 1);
+                        sum += source[((size_t)sy * width + sx) * 4 + c];
+                    }
+                }
+                CHECK_NEAR(destination[((size_t)y * outWidth + x) * 4 + c], sum * 0.25f, 1.0e-6);
+            }
+        }
+    }
+}
+
+TEST_CASE(image, kaiser_taps)
+{
+    for (int size : { 2, 3, 17, 256 }) {
+        int outSize = std::max(1, size / 2);
+        ResampleTaps taps = MakeKaiserTaps(size, outSize);
+        for (int o = 0; o < outSize; ++o) {
+            double total = 0.0;
+            for (int t = 0; t < taps.Count; ++t) {
+                size_t tap = (size_t)o * taps.Count + t;
+                total += taps.Weights[tap];
+                CHECK(taps.Indices[tap] >= 0 && taps.Indices[tap] < size);
+            }
+            CHECK_NEAR(total, 1.0, 1.0e-5);
+        }
+    }
+}
+
+TEST_CASE(image, mip_chain)
+{
+    //a flat color stays that color all the way down with either filter
+    const int width = 37, height = 12;
+    std::vector<unsigned char> rgba((size_t)width * height * 4);
+    for (size_t i = 0; i < rgba.size(); i += 4) {
+        rgba[i] = 200;
+        rgba[i + 1] = 90;
+        rgba[i + 2] = 10;
+        rgba[i + 3] = 128;
+    }
+
+    for (MipFilter filter : { MIP_FILTER_BOX, MIP_FILTER_KAISER }) {
+        std::vector<MipLevel> levels;
+        BuildMipChain(rgba.data(), width, height, filter, levels, &gJobs);
+
+        //18x6, 9x3, 4x1, 2x1 and 1x1 below the 37x12 base
+        CHECK(levels.size() == 5);
+        int expectedWidth = width, expectedHeight = height;
+        for (const MipLevel& level : levels) {
+            expectedWidth = std::max(1, expectedWidth / 2);
+            expectedHeight = std::max(1, expectedHeight / 2);
+            CHECK(level.Width == expectedWidth && level.Height == expectedHeight);
+            CHECK(level.Pixels.size() == (size_t)level.Width * level.Height * 4);
+            for (size_t i = 0; i < level.Pixels.size(); i += 4) {
+                CHECK(abs(level.Pixels[i] - 200) <= 1 && abs(level.Pixels[i + 1] - 90) <= 1 && abs(level.Pixels[i + 2] - 10) <= 1);
+                CHECK(abs(level.Pixels[i + 3] - 128) <= 1);
+            }
+        }
+    }
+}
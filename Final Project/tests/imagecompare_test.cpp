@@ -0,0 +1,170 @@
+//the golden test's SSIM against a direct sum over every window, and the difference figures on
+//images with known changes
+#include <algorithm>
+#include <random>
+#include <vector>
+
+#include "../Final Project/imagecompare.h"
+#include "check.h"
+
+namespace
+{
+    std::vector<unsigned char> NoiseImage(int width, int height, int channels, unsigned int seed)
+    {
+        std::mt19937 random(seed);
+        std::vector<unsigned char> image((size_t)width * height * channels);
+        for (int y = 0; y < height; ++y) {
+            for (int x = 0; x < width; ++x) {
+                for (int c = 0; c < channels; ++c) {
+                    //a gradient with noise on top, so windows have both structure and variance
+                    int value = (x * 5 + y * 3 + c * 40) % 200 + (int)(random() % 56);
+                    image[((size_t)y * width + x) * channels + c] = (unsigned char)value;
+                }
+            }
+        }
+        return image;
+    }
+
+    double Luma(const unsigned char* pixel)
+    {
+        return 0.299 * pixel[0] + 0.587 * pixel[1] + 0.114 * pixel[2];
+    }
+
+    //SSIM of every window summed directly, the way the summed area tables are meant to match
+    void BruteForceSsim(const unsigned char* a, const unsigned char* b, int width, int height, int channels, double& mean, double& worst)
+    {
+        double total = 0.0;
+        worst = 1.0;
+        for (int y = 0; y < height; ++y) {
+            for (int x = 0; x < width; ++x) {
+                double sumA = 0.0, sumB = 0.0, sumAA = 0.0, sumBB = 0.0, sumAB = 0.0;
+                int count = 0;
+                for (int wy = std::max(y - SSIM_WINDOW_RADIUS, 0); wy <= std::min(y + SSIM_WINDOW_RADIUS, height - 1); ++wy) {
+                    for (int wx = std::max(x - SSIM_WINDOW_RADIUS, 0); wx <= std::min(x + SSIM_WINDOW_RADIUS, width - 1); ++wx) {
+                        double la = Luma(a + ((size_t)wy * width + wx) * channels);
+                        double lb = Luma(b + ((size_t)wy * width + wx) * channels);
+                        sumA += la;
+                        sumB += lb;
+                        sumAA += la * la;
+                        sumBB += lb * lb;
+                        sumAB += la * lb;
+                        ++count;
+                    }
+                }
+                double meanA = sumA / count, meanB = sumB / count;
+                double varianceA = sumAA / count - meanA * meanA;
+                double varianceB = sumBB / count - meanB * meanB;
+                double covariance = sumAB / count - meanA * meanB;
+                double ssim = ((2.0 * meanA * meanB + SSIM_C1) * (2.0 * covariance + SSIM_C2))
+                    / ((meanA * meanA + meanB * meanB + SSIM_C1) * (varianceA + varianceB + SSIM_C2));
+                total += ssim;
+                worst = std::min(worst, ssim);
+            }
+        }
+        mean = total / ((double)width * height);
+    }
+}
+
+TEST_CASE(imagecompare, identical)
+{
+    std::vector<unsigned char> image = NoiseImage(31, 17, 4, 1);
+    std::vector<unsigned char> diff;
+    ImageDifference difference = CompareImages(image.data(), image.data(), 31, 17, 4, &diff);
+    CHECK_NEAR(difference.Ssim, 1.0, 1.0e-9);
+    CHECK_NEAR(difference.WorstSsim, 1.0, 1.0e-9);
+    CHECK_NEAR(difference.WorstBlockSsim, 1.0, 1.0e-9);
+    CHECK(difference.MeanDifference == 0.0);
+    CHECK(difference.LargestDifference == 0);
+    CHECK(diff.size() == (size_t)31 * 17 * 3);
+}
+
+TEST_CASE(imagecompare, matches_direct_windows)
+{
+    //sizes smaller than a window, and windows clipped on every side
+    const int sizes[][2] = { { 1, 1 }, { 3, 2 }, { 8, 8 }, { 29, 13 } };
+    for (const int* size : sizes) {
+        int width = size[0], height = size[1];
+        for (int channels : { 3, 4 }) {
+            std::vector<unsigned char> a = NoiseImage(width, height, channels, 2);
+            std::vector<unsigned char> b = NoiseImage(width, height, channels, 3);
+            double mean, worst;
+            BruteForceSsim(a.data(), b.data(), width, height, channels, mean, worst);
+
+            ImageDifference difference = CompareImages(a.data(), b.data(), width, height, channels);
+            CHECK_NEAR(difference.Ssim, mean, 1.0e-6);
+            CHECK_NEAR(difference.WorstSsim, worst, 1.0e-6);
+            CHECK(difference.Ssim < 1.0);
+        }
+    }
+}
+
+TEST_CASE(imagecompare, local_change)
+{
+    //a small patch painted over, the mean barely moves but the worst window and the diff image show it
+    const int width = 64, height = 48;
+    std::vector<unsigned char> reference = NoiseImage(width, height, 3, 4);
+    std::vector<unsigned char> image = reference;
+    for (int y = 20; y < 24; ++y) {
+        for (int x = 30; x < 34; ++x) {
+            for (int c = 0; c < 3; ++c) {
+                image[((size_t)y * width + x) * 3 + c] = 255;
+            }
+        }
+    }
+
+    std::vector<unsigned char> diff;
+    ImageDifference difference = CompareImages(reference.data(), image.data(), width, height, 3, &diff);
+    CHECK(difference.Ssim > 0.9);
+    CHECK(difference.WorstSsim < 0.5);
+    CHECK(difference.LargestDifference > 0);
+    CHECK(difference.MeanDifference > 0.0 && difference.MeanDifference < 4.0);
+
+    //the diff image is red over the patch and dimmed reference far away from it
+    const unsigned char* inside = &diff[((size_t)22 * width + 32) * 3];
+    const unsigned char* outside = &diff[((size_t)2 * width + 2) * 3];
+    CHECK(inside[0] > 200 && inside[1] < 64);
+    CHECK(outside[0] == outside[1] && outside[1] == outside[2]);
+}
+
+TEST_CASE(imagecompare, worst_block)
+{
+    //one pixel flipping on a silhouette sinks its windows but hardly its block, a patch sinks both.
+    //the columns and rows past the last whole block join it, so a patch in them still counts in full
+    const int width = 2 * SSIM_BLOCK_SIZE + 7, height = SSIM_BLOCK_SIZE + 9;
+    std::vector<unsigned char> reference((size_t)width * height * 3, 40);
+    std::vector<unsigned char> pixel = reference;
+    for (int c = 0; c < 3; ++c) {
+        pixel[((size_t)5 * width + 5) * 3 + c] = 200;
+    }
+    ImageDifference difference = CompareImages(reference.data(), pixel.data(), width, height, 3);
+    CHECK(difference.WorstSsim < 0.5);
+    CHECK(difference.WorstBlockSsim > 0.95);
+
+    std::vector<unsigned char> patch = reference;
+    for (int y = height - 12; y < height; ++y) {
+        for (int x = width - 12; x < width; ++x) {
+            for (int c = 0; c < 3; ++c) {
+                patch[((size_t)y * width + x) * 3 + c] = 200;
+            }
+        }
+    }
+    difference = CompareImages(reference.data(), patch.data(), width, height, 3);
+    CHECK(difference.Ssim > 0.9);
+    CHECK(difference.WorstBlockSsim < 0.9);
+
+    //smaller than a block, the whole image is one
+    std::vector<unsigned char> small = NoiseImage(9, 5, 3, 6);
+    std::vector<unsigned char> other = NoiseImage(9, 5, 3, 7);
+    difference = CompareImages(small.data(), other.data(), 9, 5, 3);
+    CHECK_NEAR(difference.WorstBlockSsim, difference.Ssim, 1.0e-9);
+}
+
+TEST_CASE(imagecompare, flip_rows)
+{
+    std::vector<unsigned char> image = NoiseImage(5, 3, 4, 5);
+    std::vector<unsigned char> flipped = image;
+    FlipRows(flipped.data(), 5, 3, 4);
+    for (int y = 0; y < 3; ++y) {
+        CHECK(std::equal(&flipped[(size_t)y * 20], &flipped[(size_t)y * 20] + 20, &image[(size_t)(2 - y) * 20]));
+    }
+}
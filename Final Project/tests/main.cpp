@@ -0,0 +1,58 @@
+//runs the CPU tests. with no arguments every suite runs, otherwise only the suites named, which
+//is how CTest gives each one its own entry. --list prints the suites and their cases
+#include <cstdio>
+#include <cstring>
+#include <set>
+#include <string>
+
+#include "check.h"
+
+//what CTest counts as skipped rather than failed
+const int SKIPPED_EXIT_CODE = 77;
+
+int main(int argc, char* argv[])
+{
+#if defined(__AVX2__) && (defined(__GNUC__) || defined(__clang__))
+    //the AVX2 build of the tests on a CPU without it. every CPU with AVX2 also has F16C
+    if (!__builtin_cpu_supports("avx2")) {
+        printf("SKIPPED: this CPU can't run the AVX2 build of the tests\n");
+        return SKIPPED_EXIT_CODE;
+    }
+#endif
+
+    std::set<std::string> suites;
+    for (const TestCase& test : TestCases()) {
+        suites.insert(test.Suite);
+    }
+
+    std::set<std::string> selected;
+    for (int i = 1; i < argc; ++i) {
+        if (strcmp(argv[i], "--list") == 0) {
+            for (const TestCase& test : TestCases()) {
+                printf("%s.%s\n", test.Suite, test.Name);
+            }
+            return 0;
+        }
+        if (suites.count(argv[i]) == 0) {
+            printf("ERROR: no test suite called %s\n", argv[i]);
+            return 2;
+        }
+        selected.insert(argv[i]);
+    }
+
+    int failedCases = 0, ranCases = 0;
+    for (const TestCase& test : TestCases()) {
+        if (!selected.empty() && selected.count(test.Suite) == 0) {
+            continue;
+        }
+        int failuresBefore = TestFailures();
+        test.Run();
+        bool passed = TestFailures() == failuresBefore;
+        printf("%s %s.%s\n", passed ? "ok    " : "FAILED", test.Suite, test.Name);
+        failedCases += passed ? 0 : 1;
+        ++ranCases;
+    }
+
+    printf("%d of %d cases passed, %d failed checks\n", ranCases - failedCases, ranCases, TestFailures());
+    return failedCases == 0 ? 0 : 1;
+}
@@ -0,0 +1,158 @@
+//the mesh optimizer on the scene's meshes: the optimized index buffer draws the same triangles with the
+//same winding, the cache figures don't get worse and the meshlets cover it within their limits
+#include <algorithm>
+#include <cstdint>
+#include <set>
+#include <vector>
+
+#include "../Final Project/meshes.h"
+#include "../Final Project/meshoptimize.h"
+#include "check.h"
+
+namespace
+{
+    typedef void (*BuildVertices)(std::vector<float>& vertices);
+    typedef std::vector<float> Triangle;
+
+    const BuildVertices SCENE_MESHES[] = {
+        BuildCubeVertices, BuildKnifeHandleVertices, BuildKnifeBladeVertices, BuildCuttingBoardVertices,
+        BuildPlaneVertices, BuildSalamiEndsVertices, BuildSalamiBodyVertices, BuildCheeseVertices
+    };
+
+    //a triangle's corners, rotated to start at the smallest so the same triangle compares equal
+    //whichever corner it was written from. a flipped triangle still compares different
+    Triangle MakeTriangle(const float* a, const float* b, const float* c, int stride)
+    {
+        const float* corners[3] = { a, b, c };
+        int first = 0;
+        for (int i = 1; i < 3; ++i) {
+            if (std::lexicographical_compare(corners[i], corners[i] + stride, corners[first], corners[first] + stride)) {
+                first = i;
+            }
+        }
+        Triangle triangle;
+        for (int i = 0; i < 3; ++i) {
+            const float* corner = corners[(first + i) % 3];
+            triangle.insert(triangle.end(), corner, corner + stride);
+        }
+        return triangle;
+    }
+
+    std::multiset<Triangle> SourceTriangles(const std::vector<float>& vertices, int stride)
+    {
+        std::multiset<Triangle> triangles;
+        size_t vertexCount = vertices.size() / stride;
+        for (size_t i = 0; i + 2 < vertexCount; i += 3) {
+            const float* v = &vertices[i * stride];
+            triangles.insert(MakeTriangle(v, v + stride, v + 2 * stride, stride));
+        }
+        return triangles;
+    }
+
+    std::multiset<Triangle> IndexedTriangles(const std::vector<float>& vertices, const std::vector<uint32_t>& indices, int stride)
+    {
+        std::multiset<Triangle> triangles;
+        for (size_t i = 0; i + 2 < indices.size(); i += 3) {
+            triangles.insert(MakeTriangle(&vertices[(size_t)indices[i] * stride], &vertices[(size_t)indices[i + 1] * stride],
+                &vertices[(size_t)indices[i + 2] * stride], stride));
+        }
+        return triangles;
+    }
+}
+
+TEST_CASE(meshoptimize, same_triangles)
+{
+    const int stride = MESH_FLOATS_PER_VERTEX;
+    for (BuildVertices build : SCENE_MESHES) {
+        std::vector<float> vertices;
+        build(vertices);
+        OptimizedMesh mesh;
+        OptimizeMesh(vertices.data(), vertices.size() / stride, stride, mesh);
+
+        CHECK(mesh.Indices.size() == vertices.size() / stride / 3 * 3);
+        CHECK(IndexedTriangles(mesh.Vertices, mesh.Indices, stride) == SourceTriangles(vertices, stride));
+
+        //welded, and renumbered so the first use of each vertex comes in order
+        size_t uniqueCount = mesh.Vertices.size() / stride;
+        std::set<std::vector<float> > distinct;
+        for (size_t i = 0; i < uniqueCount; ++i) {
+            distinct.insert(std::vector<float>(&mesh.Vertices[i * stride], &mesh.Vertices[i * stride] + stride));
+        }
+        CHECK(distinct.size() == uniqueCount);
+        uint32_t nextNew = 0;
+        for (uint32_t index : mesh.Indices) {
+            CHECK(index <= nextNew);
+            if (index == nextNew) {
+                ++nextNew;
+            }
+        }
+        CHECK(nextNew == uniqueCount);
+    }
+}
+
+TEST_CASE(meshoptimize, cache_not_worse)
+{
+    const int stride = MESH_FLOATS_PER_VERTEX;
+    for (BuildVertices build : SCENE_MESHES) {
+        std::vector<float> vertices;
+        build(vertices);
+        OptimizedMesh mesh;
+        OptimizeMesh(vertices.data(), vertices.size() / stride, stride, mesh);
+
+        CHECK(mesh.After.Triangles == mesh.Before.Triangles);
+        CHECK(mesh.After.Vertices == mesh.Before.Vertices);
+        //overdraw ordering may give a little back, within its threshold of the cache optimized order
+        CHECK(mesh.After.Acmr() <= mesh.Before.Acmr() * OVERDRAW_THRESHOLD + 1.0e-6f);
+        CHECK(mesh.After.Atvr() >= 1.0f);
+        CHECK(mesh.After.Acmr() <= 3.0f);
+    }
+}
+
+TEST_CASE(meshoptimize, vertex_cache_analysis)
+{
+    //a fan around vertex 0: the centre stays cached, every other vertex is loaded once
+    std::vector<uint32_t> fan;
+    for (uint32_t i = 1; i < 10; ++i) {
+        fan.insert(fan.end(), { 0, i, i + 1 });
+    }
+    VertexCacheStats stats = AnalyzeVertexCache(fan.data(), fan.size(), 11);
+    CHECK(stats.Triangles == 9);
+    CHECK(stats.Vertices == 11);
+    CHECK(stats.Misses == 11);
+
+    //a cache of one reloads everything that isn't the previous corner
+    VertexCacheStats tiny = AnalyzeVertexCache(fan.data(), fan.size(), 11, 1);
+    CHECK(tiny.Misses == 27);
+}
+
+TEST_CASE(meshoptimize, meshlets_cover_indices)
+{
+    const int stride = MESH_FLOATS_PER_VERTEX;
+    for (BuildVertices build : SCENE_MESHES) {
+        std::vector<float> vertices;
+        build(vertices);
+        OptimizedMesh mesh;
+        OptimizeMesh(vertices.data(), vertices.size() / stride, stride, mesh);
+
+        uint32_t next = 0;
+        for (const Meshlet& meshlet : mesh.Meshlets) {
+            CHECK(meshlet.FirstIndex == next);
+            CHECK(meshlet.IndexCount > 0 && meshlet.IndexCount % 3 == 0);
+            CHECK(meshlet.IndexCount / 3 <= MESHLET_MAX_TRIANGLES);
+            next = meshlet.FirstIndex + meshlet.IndexCount;
+
+            std::set<uint32_t> used(mesh.Indices.begin() + meshlet.FirstIndex, mesh.Indices.begin() + next);
+            CHECK(meshlet.VertexCount == used.size());
+            CHECK(used.size() <= MESHLET_MAX_VERTICES);
+
+            //the bounding sphere holds every corner
+            for (uint32_t index : used) {
+                const float* position = &mesh.Vertices[(size_t)index * stride];
+                float distance = glm::length(glm::vec3(position[0], position[1], position[2]) - meshlet.Center);
+                CHECK(distance <= meshlet.Radius * 1.0001f + 1.0e-6f);
+            }
+            CHECK(meshlet.ConeCutoff >= 0.0f && meshlet.ConeCutoff <= 1.0f);
+        }
+        CHECK(next == mesh.Indices.size());
+    }
+}
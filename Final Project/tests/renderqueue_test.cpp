@@ -0,0 +1,162 @@
+//the render queue's radix sort against std::stable_sort, on both sides of the insertion sort cutoff
+//and with keys that share their high bytes the way real state keys do, plus the key layout itself
+#include <algorithm>
+#include <cstdint>
+#include <random>
+#include <vector>
+
+#include "../Final Project/renderqueue.h"
+#include "check.h"
+
+namespace
+{
+    //either side of the insertion sort limit of 32 and well past it
+    const size_t COUNTS[] = { 0, 1, 2, 3, 31, 32, 33, 34, 100, 257, 1000, 5000 };
+
+    typedef uint64_t (*MakeKey)(std::mt19937& random);
+
+    uint64_t RandomKey(std::mt19937& random)
+    {
+        return ((uint64_t)random() << 32) | random();
+    }
+
+    //a few hundred distinct values, so most keys have equal partners and the order among them shows
+    uint64_t FewKeys(std::mt19937& random)
+    {
+        return (uint64_t)(random() % 300) * 0x0101010101010101ull;
+    }
+
+    //what a frame submits: one pass, a couple of programs and materials, depth in the low bytes.
+    //the pass and program bytes are the same in every key and get skipped
+    uint64_t SceneKey(std::mt19937& random)
+    {
+        uint64_t state = MakeStateKey(PASS_OPAQUE, 1, random() % 3, random() % 8);
+        return AddSortDepth(state, (random() % 1000) / 1000.0f);
+    }
+
+    //only the top byte differs, a single pass that leaves the result in the scratch buffer
+    uint64_t TopByteKey(std::mt19937& random)
+    {
+        return ((uint64_t)(random() % 4) << 56) | 0x00123456789abcdeull;
+    }
+
+    //only the bottom two bytes differ, two passes that end back in the item buffer
+    uint64_t LowBytesKey(std::mt19937& random)
+    {
+        return 0x1234567800000000ull | (random() & 0xffff);
+    }
+
+    uint64_t SameKey(std::mt19937&)
+    {
+        return 0x0102030405060708ull;
+    }
+
+    const MakeKey KEY_KINDS[] = { RandomKey, FewKeys, SceneKey, TopByteKey, LowBytesKey, SameKey };
+
+    bool SameItems(const std::vector<RenderItem>& actual, const std::vector<RenderItem>& expected)
+    {
+        if (actual.size() != expected.size()) {
+            return false;
+        }
+        for (size_t i = 0; i < actual.size(); ++i) {
+            if (actual[i].Key != expected[i].Key || actual[i].Item != expected[i].Item) {
+                return false;
+            }
+        }
+        return true;
+    }
+
+    //submits the keys in order, Item is the submission index so a stable sort has one right answer
+    void CheckSort(RenderQueue& queue, const std::vector<uint64_t>& keys)
+    {
+        std::vector<RenderItem> expected;
+        queue.Clear();
+        for (size_t i = 0; i < keys.size(); ++i) {
+            queue.Submit(keys[i], (uint32_t)i);
+            expected.push_back(RenderItem{ keys[i], (uint32_t)i });
+        }
+        std::stable_sort(expected.begin(), expected.end(), [](const RenderItem& a, const RenderItem& b) {
+            return a.Key < b.Key;
+        });
+
+        queue.Sort();
+        CHECK(SameItems(queue.Items(), expected));
+    }
+}
+
+TEST_CASE(renderqueue, matches_stable_sort)
+{
+    unsigned int seed = 1;
+    for (MakeKey make : KEY_KINDS) {
+        for (size_t count : COUNTS) {
+            std::mt19937 random(seed++);
+            std::vector<uint64_t> keys(count);
+            for (uint64_t& key : keys) {
+                key = make(random);
+            }
+            RenderQueue queue;
+            CheckSort(queue, keys);
+        }
+    }
+}
+
+TEST_CASE(renderqueue, sorted_and_reversed)
+{
+    for (size_t count : COUNTS) {
+        std::mt19937 random((unsigned int)count);
+        std::vector<uint64_t> keys(count);
+        for (uint64_t& key : keys) {
+            key = SceneKey(random);
+        }
+        std::sort(keys.begin(), keys.end());
+        RenderQueue queue;
+        CheckSort(queue, keys);
+        std::reverse(keys.begin(), keys.end());
+        CheckSort(queue, keys);
+    }
+}
+
+TEST_CASE(renderqueue, reused_between_frames)
+{
+    //one queue across frames of changing size, the scratch buffer left over from a bigger one is reused
+    RenderQueue queue;
+    std::mt19937 random(7);
+    for (size_t count : { 5000, 40, 3, 1000, 33, 0, 257 }) {
+        std::vector<uint64_t> keys(count);
+        for (uint64_t& key : keys) {
+            key = count % 2 ? RandomKey(random) : SceneKey(random);
+        }
+        CheckSort(queue, keys);
+    }
+}
+
+TEST_CASE(renderqueue, key_order)
+{
+    //pass first, then state, then depth: front to back when opaque and back to front when transparent
+    uint64_t opaque = MakeStateKey(PASS_OPAQUE, 3, 2, 1);
+    uint64_t transparent = MakeStateKey(PASS_TRANSPARENT, 0, 0, 0);
+    CHECK(AddSortDepth(opaque, 0.1f) < AddSortDepth(opaque, 0.9f));
+    CHECK(AddSortDepth(transparent, 0.9f) < AddSortDepth(transparent, 0.1f));
+    CHECK(AddSortDepth(opaque, 1.0f) < AddSortDepth(transparent, 1.0f));
+    CHECK(MakeStateKey(PASS_OPAQUE, 1, 0, 0) < MakeStateKey(PASS_OPAQUE, 2, 0, 0));
+    CHECK(AddSortDepth(MakeStateKey(PASS_OPAQUE, 1, 5, 0), 1.0f) < AddSortDepth(MakeStateKey(PASS_OPAQUE, 1, 6, 0), 0.0f));
+
+    //depth outside [0, 1] clamps instead of spilling into the mesh field
+    CHECK(SortKeyValue(AddSortDepth(opaque, 2.0f), SORT_KEY_MESH_SHIFT, SORT_KEY_MESH_BITS) == 1);
+    CHECK(AddSortDepth(opaque, -1.0f) == AddSortDepth(opaque, 0.0f));
+
+    //fields come back out as they went in, wider values are cut to the field
+    uint64_t key = MakeStateKey(PASS_TRANSPARENT, 200, 4000, 60000);
+    CHECK(SortKeyValue(key, SORT_KEY_PASS_SHIFT, SORT_KEY_PASS_BITS) == PASS_TRANSPARENT);
+    CHECK(SortKeyValue(key, SORT_KEY_PROGRAM_SHIFT, SORT_KEY_PROGRAM_BITS) == 200);
+    CHECK(SortKeyValue(key, SORT_KEY_MATERIAL_SHIFT, SORT_KEY_MATERIAL_BITS) == 4000);
+    CHECK(SortKeyValue(key, SORT_KEY_MESH_SHIFT, SORT_KEY_MESH_BITS) == 60000);
+    CHECK(SortKeyValue(MakeStateKey(PASS_OPAQUE, 256 + 7, 0, 0), SORT_KEY_PROGRAM_SHIFT, SORT_KEY_PROGRAM_BITS) == 7);
+    CHECK(SortKeyChanged(key, MakeStateKey(PASS_TRANSPARENT, 200, 4001, 60000), SORT_KEY_MATERIAL_SHIFT, SORT_KEY_MATERIAL_BITS));
+    CHECK(!SortKeyChanged(key, MakeStateKey(PASS_TRANSPARENT, 200, 4001, 60000), SORT_KEY_PROGRAM_SHIFT, SORT_KEY_PROGRAM_BITS));
+
+    SortKeyIds ids;
+    CHECK(ids.Id(0x1000) == 0);
+    CHECK(ids.Id(0x2000) == 1);
+    CHECK(ids.Id(0x1000) == 0);
+}
@@ -0,0 +1,223 @@
+//the software rasterizer's fill rule: meshes that tile the screen are drawn one triangle per frame
+//and every pixel has to come out covered exactly once, so shared edges leave no gaps and no pixel
+//is drawn by both neighbours. sizes are odd and cross tiles so the 4 pixel groups end part way
+#include <glm/glm.hpp>
+#include <glm/gtc/matrix_transform.hpp>
+
+#include <cstdint>
+#include <random>
+#include <vector>
+
+#include "../Final Project/jobsystem.h"
+#include "../Final Project/softrender.h"
+#include "check.h"
+
+namespace
+{
+    const uint32_t WHITE = 0xffffffffu;
+
+    JobSystem gJobs(4);
+
+    struct Mesh {
+        std::vector<float> Vertices;    // position, normal, uv
+        std::vector<uint32_t> Indices;
+    };
+
+    void AddVertex(Mesh& mesh, float x, float y, float z)
+    {
+        mesh.Vertices.insert(mesh.Vertices.end(), { x, y, z, 0.0f, 0.0f, 1.0f, 0.0f, 0.0f });
+    }
+
+    //both windings, the renderer doesn't cull
+    void AddTriangle(Mesh& mesh, uint32_t a, uint32_t b, uint32_t c, bool flip)
+    {
+        mesh.Indices.insert(mesh.Indices.end(), { a, flip ? c : b, flip ? b : c });
+    }
+
+    //a grid from min to max with the inner corners moved by up to jitter cells and each cell cut
+    //along a random diagonal. the outer corners stay on the border so the mesh covers it all, and
+    //under a quarter cell of jitter keeps every cell convex so its two triangles can't overlap
+    Mesh GridMesh(int columns, int rows, glm::vec2 min, glm::vec2 max, float jitter, unsigned int seed)
+    {
+        std::mt19937 random(seed);
+        std::uniform_real_distribution<float> offset(-jitter, jitter);
+        glm::vec2 cell((max.x - min.x) / columns, (max.y - min.y) / rows);
+
+        Mesh mesh;
+        for (int y = 0; y <= rows; ++y) {
+            for (int x = 0; x <= columns; ++x) {
+                glm::vec2 position = min + cell * glm::vec2((float)x, (float)y);
+                if (x > 0 && x < columns && y > 0 && y < rows) {
+                    position += cell * glm::vec2(offset(random), offset(random));
+                }
+                AddVertex(mesh, position.x, position.y, 0.0f);
+            }
+        }
+        for (int y = 0; y < rows; ++y) {
+            for (int x = 0; x < columns; ++x) {
+                uint32_t a = (uint32_t)(y * (columns + 1) + x);
+                uint32_t b = a + 1;
+                uint32_t c = a + (uint32_t)columns + 1;
+                uint32_t d = c + 1;
+                if (random() % 2) {
+                    AddTriangle(mesh, a, b, d, random() % 2 != 0);
+                    AddTriangle(mesh, a, d, c, random() % 2 != 0);
+                }
+                else {
+                    AddTriangle(mesh, a, b, c, random() % 2 != 0);
+                    AddTriangle(mesh, b, d, c, random() % 2 != 0);
+                }
+            }
+        }
+        return mesh;
+    }
+
+    //triangles around a point, the rim walks the border through every corner
+    Mesh FanMesh(glm::vec2 center, int segmentsPerSide)
+    {
+        Mesh mesh;
+        AddVertex(mesh, center.x, center.y, 0.0f);
+        const glm::vec2 corners[4] = { { -1.0f, -1.0f }, { 1.0f, -1.0f }, { 1.0f, 1.0f }, { -1.0f, 1.0f } };
+        for (int side = 0; side < 4; ++side) {
+            for (int i = 0; i < segmentsPerSide; ++i) {
+                glm::vec2 position = corners[side] + (corners[(side + 1) % 4] - corners[side]) * ((float)i / segmentsPerSide);
+                AddVertex(mesh, position.x, position.y, 0.0f);
+            }
+        }
+        uint32_t rim = (uint32_t)(4 * segmentsPerSide);
+        for (uint32_t i = 0; i < rim; ++i) {
+            AddTriangle(mesh, 0, 1 + i, 1 + (i + 1) % rim, i % 3 == 0);
+        }
+        return mesh;
+    }
+
+    //draws each triangle in a frame of its own and counts how often every pixel was covered
+    std::vector<int> CoverageCounts(SoftRenderer& renderer, const Mesh& mesh, const glm::mat4& view, const glm::mat4& projection)
+    {
+        size_t pixelCount = (size_t)renderer.Width() * renderer.Height();
+        std::vector<int> counts(pixelCount, 0);
+        size_t vertexCount = mesh.Vertices.size() / 8;
+        for (size_t t = 0; t < mesh.Indices.size(); t += 3) {
+            renderer.BeginFrame(view, projection, glm::vec3(0.0f), nullptr, 0, glm::vec3(0.0f));
+            renderer.Draw(mesh.Vertices.data(), vertexCount, &mesh.Indices[t], 3, glm::mat4(1.0f), nullptr, glm::vec2(1.0f), false);
+            renderer.EndFrame(gJobs);
+            const uint32_t* pixels = renderer.Pixels();
+            for (size_t i = 0; i < pixelCount; ++i) {
+                counts[i] += pixels[i] == WHITE ? 1 : 0;
+            }
+        }
+        return counts;
+    }
+
+    //every pixel exactly once one triangle at a time, and all of them in one frame of the whole mesh
+    void CheckTiles(SoftRenderer& renderer, const Mesh& mesh, const glm::mat4& view, const glm::mat4& projection)
+    {
+        std::vector<int> counts = CoverageCounts(renderer, mesh, view, projection);
+        int gaps = 0, doubles = 0;
+        for (int count : counts) {
+            gaps += count == 0 ? 1 : 0;
+            doubles += count > 1 ? 1 : 0;
+        }
+        CHECK(gaps == 0);
+        CHECK(doubles == 0);
+
+        renderer.BeginFrame(view, projection, glm::vec3(0.0f), nullptr, 0, glm::vec3(0.0f));
+        renderer.Draw(mesh.Vertices.data(), mesh.Vertices.size() / 8, mesh.Indices.data(), mesh.Indices.size(), glm::mat4(1.0f), nullptr, glm::vec2(1.0f), false);
+        renderer.EndFrame(gJobs);
+        int uncovered = 0;
+        for (size_t i = 0; i < counts.size(); ++i) {
+            uncovered += renderer.Pixels()[i] == WHITE ? 0 : 1;
+        }
+        CHECK(uncovered == 0);
+    }
+
+    //sizes under one group of 4, odd ones, and ones spanning several 64 pixel tiles
+    const int SIZES[][2] = { { 1, 1 }, { 3, 2 }, { 7, 5 }, { 67, 9 }, { 131, 70 } };
+}
+
+TEST_CASE(softrender, jittered_grid)
+{
+    SoftRenderer renderer;
+    unsigned int seed = 1;
+    for (const int* size : SIZES) {
+        renderer.Resize(size[0], size[1]);
+        //exactly on the screen border, and reaching past it so triangles are cut by the screen bounds
+        CheckTiles(renderer, GridMesh(9, 7, glm::vec2(-1.0f), glm::vec2(1.0f), 0.2f, seed++), glm::mat4(1.0f), glm::mat4(1.0f));
+        CheckTiles(renderer, GridMesh(13, 11, glm::vec2(-1.3f, -1.1f), glm::vec2(1.2f, 1.4f), 0.24f, seed++), glm::mat4(1.0f), glm::mat4(1.0f));
+    }
+}
+
+TEST_CASE(softrender, pixel_aligned_grid)
+{
+    //corners on pixel centres and pixel corners, edges running straight through rows and columns of
+    //centres, so the tie rule alone decides who gets them. a power of two size keeps the positions exact
+    SoftRenderer renderer;
+    renderer.Resize(64, 32);
+    CheckTiles(renderer, GridMesh(8, 8, glm::vec2(-1.0f), glm::vec2(1.0f), 0.0f, 10), glm::mat4(1.0f), glm::mat4(1.0f));
+
+    //square cells a few pixels across with their corners on pixel centres, the diagonals pass through
+    //centres too. other sizes round the positions, the centres land a hair to either side of an edge
+    //and only the two triangles computing it as exact negatives keeps them agreeing
+    const int sizes[][3] = { { 64, 32, 4 }, { 60, 45, 3 }, { 67, 41, 5 }, { 131, 70, 7 } };
+    for (const int* size : sizes) {
+        int width = size[0], height = size[1], cellPixels = size[2];
+        renderer.Resize(width, height);
+        int columns = width / cellPixels + 1, rows = height / cellPixels + 1;
+        glm::vec2 min(-1.0f - 1.0f / width, -1.0f - 1.0f / height);
+        glm::vec2 max(-1.0f + (2.0f * columns * cellPixels - 1.0f) / width, -1.0f + (2.0f * rows * cellPixels - 1.0f) / height);
+        CheckTiles(renderer, GridMesh(columns, rows, min, max, 0.0f, (unsigned int)width), glm::mat4(1.0f), glm::mat4(1.0f));
+    }
+}
+
+TEST_CASE(softrender, subpixel_snap)
+{
+    //an edge less than half a subpixel off a column of pixel centres snaps onto it and the ownership
+    //rule decides: the left edge of a box takes the column, the right edge leaves it to the neighbour
+    SoftRenderer renderer;
+    renderer.Resize(64, 32);
+    const float halfSubpixel = 0.5f / (1 << SoftRenderer::SUBPIXEL_BITS);
+    for (float offset : { 0.0f, 1.0e-4f, -1.0e-4f, 0.003f, -0.003f }) {
+        float left = (4.5f + offset) * 2.0f / 64.0f - 1.0f;
+        float right = (20.5f + offset) * 2.0f / 64.0f - 1.0f;
+        Mesh mesh;
+        AddVertex(mesh, left, -1.1f, 0.0f);
+        AddVertex(mesh, right, -1.1f, 0.0f);
+        AddVertex(mesh, left, 1.1f, 0.0f);
+        AddVertex(mesh, right, 1.1f, 0.0f);
+        AddTriangle(mesh, 0, 1, 3, false);
+        AddTriangle(mesh, 0, 3, 2, true);
+
+        renderer.BeginFrame(glm::mat4(1.0f), glm::mat4(1.0f), glm::vec3(0.0f), nullptr, 0, glm::vec3(0.0f));
+        renderer.Draw(mesh.Vertices.data(), 4, mesh.Indices.data(), mesh.Indices.size(), glm::mat4(1.0f), nullptr, glm::vec2(1.0f), false);
+        renderer.EndFrame(gJobs);
+        const uint32_t* row = renderer.Pixels() + 10 * 64;
+        CHECK((row[4] == WHITE) == (offset < halfSubpixel));
+        CHECK((row[20] == WHITE) == (offset > halfSubpixel));
+        CHECK(row[3] != WHITE && row[5] == WHITE && row[19] == WHITE && row[21] != WHITE);
+    }
+}
+
+TEST_CASE(softrender, fan)
+{
+    //long thin triangles meeting at one vertex, the centre on a pixel centre and off it
+    SoftRenderer renderer;
+    for (const int* size : SIZES) {
+        renderer.Resize(size[0], size[1]);
+        CheckTiles(renderer, FanMesh(glm::vec2(0.13f, -0.27f), 11), glm::mat4(1.0f), glm::mat4(1.0f));
+        CheckTiles(renderer, FanMesh(glm::vec2(1.0f / size[0], 1.0f / size[1]), 7), glm::mat4(1.0f), glm::mat4(1.0f));
+    }
+}
+
+TEST_CASE(softrender, perspective)
+{
+    //a grid leaning away from a perspective camera, its corners at different w. it stays in front of
+    //the near plane, clipping there cuts shared edges differently on either side
+    SoftRenderer renderer;
+    renderer.Resize(131, 70);
+    glm::mat4 projection = glm::perspective(0.9f, 131.0f / 70.0f, 0.1f, 50.0f);
+    Mesh mesh = GridMesh(21, 17, glm::vec2(-10.0f, -8.0f), glm::vec2(10.0f, 8.0f), 0.25f, 20);
+    for (size_t i = 0; i < mesh.Vertices.size(); i += 8) {
+        mesh.Vertices[i + 2] = -6.0f - 0.3f * mesh.Vertices[i + 1] + 0.1f * mesh.Vertices[i];
+    }
+    CheckTiles(renderer, mesh, glm::mat4(1.0f), projection);
+}
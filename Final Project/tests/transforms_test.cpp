@@ -0,0 +1,200 @@
+//the batched SoA kernels in transforms.h against glm one matrix at a time. counts and ranges are
+//picked to end part way through a SIMD batch, both at the end of the set and inside it the way the
+//job chunks split it
+#include <glm/glm.hpp>
+#include <glm/gtc/quaternion.hpp>
+#include <glm/gtx/transform.hpp>
+
+#include <algorithm>
+#include <cmath>
+#include <random>
+#include <vector>
+
+#include "../Final Project/jobsystem.h"
+#include "../Final Project/transforms.h"
+#include "check.h"
+
+namespace
+{
+    const size_t COUNTS[] = { 1, 3, 4, 5, 7, 8, 9, 13, 31, 33, 1000, 1003 };
+    const float SENTINEL = -12345.0f;
+
+    JobSystem gJobs(4);
+
+    //random transforms in all three orders, rotations on both sides of w = 0
+    void MakeTransforms(size_t count, unsigned int seed, TransformSoA& transforms)
+    {
+        std::mt19937 random(seed);
+        std::uniform_real_distribution<float> position(-50.0f, 50.0f);
+        std::uniform_real_distribution<float> unit(-1.0f, 1.0f);
+        std::uniform_real_distribution<float> scale(0.25f, 4.0f);
+
+        for (size_t i = 0; i < count; ++i) {
+            glm::quat rotation = glm::normalize(glm::quat(unit(random), unit(random), unit(random), unit(random) + 0.01f));
+            transforms.Add(glm::vec3(position(random), position(random), position(random)), rotation,
+                glm::vec3(scale(random), scale(random), scale(random)), (TransformOrder)(i % 3));
+        }
+    }
+
+    glm::mat4 GlmWorldMatrix(const TransformSoA& transforms, size_t i)
+    {
+        glm::mat4 translation = glm::translate(transforms.Position(i));
+        glm::mat4 rotation = glm::mat4_cast(transforms.Rotation(i));
+        glm::mat4 scale = glm::scale(transforms.Scale(i));
+        switch ((TransformOrder)(int)transforms.Order[i]) {
+        case TRANSLATE_SCALE_ROTATE:
+            return translation * scale * rotation;
+        case SCALE_ROTATE_TRANSLATE:
+            return scale * rotation * translation;
+        default:
+            return translation * rotation * scale;
+        }
+    }
+
+    //element-wise, within a tolerance relative to the largest element. a small element can be the
+    //difference of large products, so its rounding is on the scale of those
+    bool SameMatrix(const glm::mat4& actual, const glm::mat4& expected)
+    {
+        float largest = 1.0f;
+        for (int column = 0; column < 4; ++column) {
+            for (int row = 0; row < 4; ++row) {
+                largest = std::max(largest, std::fabs(expected[column][row]));
+            }
+        }
+        for (int column = 0; column < 4; ++column) {
+            for (int row = 0; row < 4; ++row) {
+                if (!(std::fabs(actual[column][row] - expected[column][row]) <= 1.0e-5f * largest)) {
+                    return false;
+                }
+            }
+        }
+        return true;
+    }
+
+    bool IsSentinel(const glm::mat4& matrix)
+    {
+        return matrix == glm::mat4(SENTINEL);
+    }
+}
+
+TEST_CASE(transforms, compose_whole_set)
+{
+    for (size_t count : COUNTS) {
+        TransformSoA transforms;
+        MakeTransforms(count, (unsigned int)count, transforms);
+
+        //one past the end so a write beyond the set would show
+        std::vector<glm::mat4> out(transforms.Capacity() + 1, glm::mat4(SENTINEL));
+        ComposeWorldMatrices(transforms, 0, count, out.data());
+        for (size_t i = 0; i < count; ++i) {
+            CHECK(SameMatrix(out[i], GlmWorldMatrix(transforms, i)));
+        }
+        CHECK(IsSentinel(out.back()));
+    }
+}
+
+TEST_CASE(transforms, compose_ranges_stay_inside)
+{
+    //every range of a few sizes on its own: it writes its own matrices and nothing either side,
+    //which is what lets neighbouring jobs run at the same time
+    for (size_t count : { 5, 13, 33 }) {
+        TransformSoA transforms;
+        MakeTransforms(count, (unsigned int)count + 100, transforms);
+        std::vector<glm::mat4> expected(count);
+        for (size_t i = 0; i < count; ++i) {
+            expected[i] = GlmWorldMatrix(transforms, i);
+        }
+
+        for (size_t begin = 0; begin < count; ++begin) {
+            for (size_t end = begin + 1; end <= count; ++end) {
+                std::vector<glm::mat4> out(transforms.Capacity(), glm::mat4(SENTINEL));
+                ComposeWorldMatrices(transforms, begin, end, out.data());
+                for (size_t i = 0; i < out.size(); ++i) {
+                    CHECK(i >= begin && i < end ? SameMatrix(out[i], expected[i]) : IsSentinel(out[i]));
+                }
+            }
+        }
+    }
+}
+
+TEST_CASE(transforms, compose_chunked)
+{
+    //chunk sizes that aren't multiples of either SIMD width, run back to back and through the job system
+    for (size_t count : COUNTS) {
+        TransformSoA transforms;
+        MakeTransforms(count, (unsigned int)count + 200, transforms);
+
+        for (size_t chunk : { 1, 3, 5, 6, 9, 17 }) {
+            std::vector<glm::mat4> out(transforms.Capacity(), glm::mat4(SENTINEL));
+            for (size_t begin = 0; begin < count; begin += chunk) {
+                ComposeWorldMatrices(transforms, begin, std::min(count, begin + chunk), out.data());
+            }
+            for (size_t i = 0; i < out.size(); ++i) {
+                CHECK(i < count ? SameMatrix(out[i], GlmWorldMatrix(transforms, i)) : IsSentinel(out[i]));
+            }
+
+            //the frame's transform stage: each job blends its own range into the shared render set, then
+            //reads it back. a thread sanitizer build flags any job reading lanes another one is writing
+            TransformSoA render = transforms;
+            std::vector<glm::mat4> parallel(transforms.Capacity(), glm::mat4(SENTINEL));
+            gJobs.ParallelFor(count, chunk, [&](size_t begin, size_t end) {
+                InterpolateTransforms(transforms, transforms, 1.0f, begin, end, render);
+                ComposeWorldMatrices(render, begin, end, parallel.data());
+            });
+            for (size_t i = 0; i < parallel.size(); ++i) {
+                CHECK(i < count ? SameMatrix(parallel[i], GlmWorldMatrix(render, i)) : IsSentinel(parallel[i]));
+            }
+        }
+    }
+}
+
+TEST_CASE(transforms, multiply_view_projection)
+{
+    glm::mat4 view = glm::lookAt(glm::vec3(3.0f, 4.0f, 7.0f), glm::vec3(0.0f), glm::vec3(0.0f, 1.0f, 0.0f));
+    glm::mat4 viewProjection = glm::perspective(0.8f, 16.0f / 9.0f, 0.1f, 100.0f) * view;
+
+    for (size_t count : COUNTS) {
+        TransformSoA transforms;
+        MakeTransforms(count + 1, (unsigned int)count + 300, transforms);
+        std::vector<glm::mat4> models(count + 1);
+        ComposeWorldMatrices(transforms, 0, count + 1, models.data());
+
+        //starting one matrix in, so the source and destination aren't on their usual alignment
+        std::vector<glm::mat4> out(count + 2, glm::mat4(SENTINEL));
+        MultiplyViewProjection(viewProjection, &models[1], count, &out[1]);
+        CHECK(IsSentinel(out[0]));
+        CHECK(IsSentinel(out[count + 1]));
+        for (size_t i = 0; i < count; ++i) {
+            CHECK(SameMatrix(out[i + 1], viewProjection * models[i + 1]));
+        }
+    }
+}
+
+TEST_CASE(transforms, interpolate)
+{
+    //the ends of the blend are the two states, quaternions come back unit length on the shorter arc
+    const size_t count = 13;
+    TransformSoA from, to, out;
+    MakeTransforms(count, 400, from);
+    MakeTransforms(count, 401, to);
+    MakeTransforms(count, 402, out);
+
+    InterpolateTransforms(from, to, 0.0f, 0, count, out);
+    for (size_t i = 0; i < count; ++i) {
+        CHECK(SameMatrix(glm::translate(out.Position(i)), glm::translate(from.Position(i))));
+        CHECK_NEAR(std::fabs(glm::dot(out.Rotation(i), from.Rotation(i))), 1.0, 1.0e-5);
+        CHECK(out.Order[i] == to.Order[i]);
+    }
+
+    InterpolateTransforms(from, to, 0.5f, 0, count, out);
+    for (size_t i = 0; i < count; ++i) {
+        glm::quat rotation = out.Rotation(i);
+        CHECK_NEAR(glm::dot(rotation, rotation), 1.0, 1.0e-5);
+        glm::vec3 middle = (from.Position(i) + to.Position(i)) * 0.5f;
+        CHECK_NEAR(glm::length(out.Position(i) - middle), 0.0, 1.0e-4);
+
+        //nlerp lands on the same great circle as slerp, between the two
+        glm::quat target = glm::dot(from.Rotation(i), to.Rotation(i)) < 0.0f ? -to.Rotation(i) : to.Rotation(i);
+        CHECK(glm::dot(rotation, from.Rotation(i)) > 0.0f && glm::dot(rotation, target) > 0.0f);
+    }
+}
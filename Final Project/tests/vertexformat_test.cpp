@@ -0,0 +1,110 @@
+//the packed vertex format: half floats against every half value, the 10:10:10:2 normals and the
+//error bounds CompressMesh reports on the scene's meshes
+#include <algorithm>
+#include <cmath>
+#include <cstdint>
+#include <cstring>
+#include <vector>
+
+#include "../Final Project/meshes.h"
+#include "../Final Project/vertexformat.h"
+#include "check.h"
+
+namespace
+{
+    typedef void (*BuildVertices)(std::vector<float>& vertices);
+
+    const BuildVertices SCENE_MESHES[] = {
+        BuildCubeVertices, BuildKnifeHandleVertices, BuildKnifeBladeVertices, BuildCuttingBoardVertices,
+        BuildPlaneVertices, BuildSalamiEndsVertices, BuildSalamiBodyVertices, BuildCheeseVertices
+    };
+
+    uint32_t FloatBits(float value)
+    {
+        uint32_t bits;
+        memcpy(&bits, &value, sizeof(bits));
+        return bits;
+    }
+}
+
+TEST_CASE(vertexformat, half_round_trip)
+{
+    //every half that isn't a NaN converts to a float and back to itself
+    for (uint32_t half = 0; half <= 0xffffu; ++half) {
+        bool nan = (half & 0x7c00u) == 0x7c00u && (half & 0x3ffu) != 0;
+        float value = HalfToFloat((uint16_t)half);
+        if (nan) {
+            CHECK(value != value);
+            CHECK(FloatToHalf(value) != FloatToHalf(0.0f));
+            continue;
+        }
+        CHECK(FloatToHalf(value) == half);
+    }
+}
+
+TEST_CASE(vertexformat, half_rounding)
+{
+    //halfway between two halves rounds to the even one, anything past halfway rounds up
+    float one = HalfToFloat(0x3c00u), next = HalfToFloat(0x3c01u), after = HalfToFloat(0x3c02u);
+    CHECK(FloatToHalf((one + next) * 0.5f) == 0x3c00u);
+    CHECK(FloatToHalf((next + after) * 0.5f) == 0x3c02u);
+    uint32_t aboveHalfway = FloatBits((one + next) * 0.5f) + 1;
+    float above;
+    memcpy(&above, &aboveHalfway, sizeof(above));
+    CHECK(FloatToHalf(above) == 0x3c01u);
+
+    //overflow goes to infinity, tiny values to a denormal or signed zero
+    CHECK(FloatToHalf(65504.0f) == 0x7bffu);
+    CHECK(FloatToHalf(65520.0f) == 0x7c00u);
+    CHECK(FloatToHalf(-1.0e9f) == 0xfc00u);
+    CHECK(FloatToHalf(5.9604645e-8f) == 0x0001u);
+    CHECK(FloatToHalf(1.0e-9f) == 0x0000u);
+    CHECK(FloatToHalf(-1.0e-9f) == 0x8000u);
+}
+
+TEST_CASE(vertexformat, snorm_normals)
+{
+    //every representable component round trips, and the most negative one clamps to -1
+    for (int component = -511; component <= 511; ++component) {
+        float value = component / 511.0f;
+        glm::vec3 unpacked = UnpackSnorm1010102(PackSnorm1010102(glm::vec3(value, -value, 0.5f)));
+        CHECK_NEAR(unpacked.x, value, 1.0e-6);
+        CHECK_NEAR(unpacked.y, -value, 1.0e-6);
+        CHECK_NEAR(unpacked.z, 0.5f, 0.5 / 511.0);
+    }
+    CHECK_NEAR(UnpackSnorm1010102(0x200u).x, -1.0, 0.0);
+    CHECK(PackSnorm1010102(glm::vec3(2.0f, -2.0f, 0.0f)) == PackSnorm1010102(glm::vec3(1.0f, -1.0f, 0.0f)));
+}
+
+TEST_CASE(vertexformat, compress_scene_meshes)
+{
+    for (BuildVertices build : SCENE_MESHES) {
+        std::vector<float> vertices;
+        build(vertices);
+        size_t vertexCount = vertices.size() / MESH_FLOATS_PER_VERTEX;
+        PackedMesh mesh;
+        CompressMesh(vertices.data(), vertexCount, mesh);
+        CHECK(mesh.Vertices.size() == vertexCount);
+
+        //half a quantization step on each axis at most, a fraction of a degree for the normals and
+        //half a half float ulp for the uvs, which is at most the value / 2048
+        float largestUv = 0.0f;
+        for (size_t i = 0; i < vertexCount; ++i) {
+            largestUv = std::max(largestUv, std::max(fabsf(vertices[i * MESH_FLOATS_PER_VERTEX + 6]), fabsf(vertices[i * MESH_FLOATS_PER_VERTEX + 7])));
+        }
+        float stepDiagonal = glm::length(mesh.PositionScale) / POSITION_QUANT_MAX;
+        CHECK(mesh.MaxPositionError <= 0.5f * stepDiagonal * 1.001f);
+        CHECK(mesh.MaxNormalError < 0.2f);
+        CHECK(mesh.MaxTexCoordError <= std::max(largestUv / 2048.0f, 1.0e-7f));
+
+        //the reported figures are the largest of the per vertex errors
+        float largest = 0.0f;
+        for (size_t i = 0; i < vertexCount; ++i) {
+            float decoded[8];
+            UnpackVertex(mesh, mesh.Vertices[i], decoded);
+            const float* source = &vertices[i * MESH_FLOATS_PER_VERTEX];
+            largest = std::max(largest, glm::length(glm::vec3(decoded[0], decoded[1], decoded[2]) - glm::vec3(source[0], source[1], source[2])));
+        }
+        CHECK_NEAR(largest, mesh.MaxPositionError, 1.0e-7);
+    }
+}